@@ -17,49 +17,40 @@ cumulants.
 .. _In International Conference on Machine Learning (pp. 1-10): http://proceedings.mlr.press/v70/achab17a.html
 """
 
-skip = True
-try:
-    import tensorflow
-    skip = False
-except ImportError:
-    print("tensorflow not found, skipping HawkesCumulantMatching")
+import numpy as np
 
-if not skip:
+from tick.hawkes import (HawkesCumulantMatching, SimuHawkesExpKernels,
+                         SimuHawkesMulti)
+from tick.plot import plot_hawkes_kernel_norms
 
-    import numpy as np
+np.random.seed(7168)
 
-    from tick.hawkes import (HawkesCumulantMatching, SimuHawkesExpKernels,
-                             SimuHawkesMulti)
-    from tick.plot import plot_hawkes_kernel_norms
+n_nodes = 3
+baselines = 0.3 * np.ones(n_nodes)
+decays = 0.5 + np.random.rand(n_nodes, n_nodes)
+adjacency = np.array([
+    [1, 1, -0.5],
+    [0, 1, 0],
+    [0, 0, 2],
+], dtype=float)
 
-    np.random.seed(7168)
+adjacency /= 4
 
-    n_nodes = 3
-    baselines = 0.3 * np.ones(n_nodes)
-    decays = 0.5 + np.random.rand(n_nodes, n_nodes)
-    adjacency = np.array([
-        [1, 1, -0.5],
-        [0, 1, 0],
-        [0, 0, 2],
-    ], dtype=float)
+end_time = 1e5
+integration_support = 5
+n_realizations = 5
 
-    adjacency /= 4
+simu_hawkes = SimuHawkesExpKernels(baseline=baselines, adjacency=adjacency,
+                                   decays=decays, end_time=end_time,
+                                   verbose=False, seed=7168)
+simu_hawkes.threshold_negative_intensity(True)
 
-    end_time = 1e5
-    integration_support = 5
-    n_realizations = 5
+multi = SimuHawkesMulti(simu_hawkes, n_simulations=n_realizations,
+                        n_threads=-1)
+multi.simulate()
 
-    simu_hawkes = SimuHawkesExpKernels(baseline=baselines, adjacency=adjacency,
-                                       decays=decays, end_time=end_time,
-                                       verbose=False, seed=7168)
-    simu_hawkes.threshold_negative_intensity(True)
+nphc = HawkesCumulantMatching(integration_support, cs_ratio=.15, tol=1e-10,
+                              step=0.3)
 
-    multi = SimuHawkesMulti(simu_hawkes, n_simulations=n_realizations,
-                            n_threads=-1)
-    multi.simulate()
-
-    nphc = HawkesCumulantMatching(integration_support, cs_ratio=.15, tol=1e-10,
-                                  step=0.3)
-
-    nphc.fit(multi.timestamps)
-    plot_hawkes_kernel_norms(nphc)
+nphc.fit(multi.timestamps)
+plot_hawkes_kernel_norms(nphc)
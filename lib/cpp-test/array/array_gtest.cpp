@@ -626,6 +626,24 @@ TYPED_TEST(Array2dTest, SerializationBinary) {
                         TypeParam>();
 }
 
+TEST(ArrayAllocationTest, CountsAllocations) {
+  const ulong n_allocations = tick::AllocationCounter::get_n_allocations();
+  const ulong n_frees = tick::AllocationCounter::get_n_frees();
+  const ulong n_bytes = tick::AllocationCounter::get_n_bytes_allocated();
+  {
+    ArrayDouble array(10);
+    ArrayFloat2d array2d(3, 4);
+    // Views do not allocate
+    ArrayFloat row = view_row(array2d, 1);
+    EXPECT_EQ(tick::AllocationCounter::get_n_allocations(),
+              n_allocations + 2);
+    EXPECT_EQ(tick::AllocationCounter::get_n_bytes_allocated(),
+              n_bytes + 10 * sizeof(double) + 12 * sizeof(float));
+    EXPECT_EQ(tick::array_bytes(array2d), 12 * sizeof(float));
+  }
+  EXPECT_EQ(tick::AllocationCounter::get_n_frees(), n_frees + 2);
+}
+
 #ifdef ADD_MAIN
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
@@ -12,6 +12,7 @@
 
 #include "tick/array/array2d.h"
 #include "tick/base/base.h"
+#include "tick/base/math/fenwick_tree.h"
 #include "tick/base/parallel/parallel.h"
 #include "tick/base/time_func.h"
 
@@ -247,6 +248,51 @@ TEST(ParallelTest, TooManyThreads) {
   parallel_run(8, 4, &CalcFibo::DoIt, &c);
 }
 
+TEST(ParallelTest, Trace) {
+  CalcFibo c;
+  tick::Tracer &tracer = tick::Tracer::instance();
+
+  tracer.enable(100);
+  parallel_run(4, 100, &CalcFibo::DoIt, &c);
+  {
+    TICK_TRACE_REGION("test_region");
+  }
+  tracer.disable();
+  // Not recorded once disabled
+  parallel_run(4, 100, &CalcFibo::DoIt, &c);
+
+  // Capacity is rounded to a power of two
+  EXPECT_EQ(tracer.get_n_recorded(), 5u);
+  const auto events = tracer.get_events();
+  ASSERT_EQ(events.size(), 5u);
+
+  // Tasks cover all indices without overlapping
+  std::vector<int> n_visits(100, 0);
+  for (ulong e = 0; e < 4; ++e) {
+    EXPECT_STREQ(events[e].name, "parallel_run");
+    EXPECT_LE(events[e].start_ns, events[e].end_ns);
+    for (ulong i = events[e].first_index; i < events[e].last_index; ++i) {
+      n_visits[i]++;
+    }
+  }
+  EXPECT_EQ(n_visits, std::vector<int>(100, 1));
+  EXPECT_STREQ(events[4].name, "test_region");
+
+  const std::string trace = tracer.to_chrome_trace();
+  EXPECT_PRED_FORMAT2(testing::IsSubstring, "\"traceEvents\"", trace);
+  EXPECT_PRED_FORMAT2(testing::IsSubstring, "\"name\": \"test_region\"",
+                      trace);
+
+  // Oldest events are overwritten once the buffer is full
+  tracer.enable(2);
+  parallel_run(4, 100, &CalcFibo::DoIt, &c);
+  tracer.disable();
+  EXPECT_EQ(tracer.get_n_recorded(), 4u);
+  EXPECT_EQ(tracer.get_events().size(), 2u);
+
+  EXPECT_THROW(tracer.enable(0), std::runtime_error);
+}
+
 TEST(DebugTest, WarningDebug) {
   testing::internal::CaptureStdout();
 
@@ -337,6 +383,37 @@ TEST(DebugTest, PrintSparseArray) {
   EXPECT_PRED_FORMAT2(testing::IsSubstring, "SparseArray", msg);
 }
 
+TEST(FenwickTreeTest, UpdateAndFind) {
+  ArrayDouble weights{0.5, 0., 2., 1., 0., 3., 0.25};
+  FenwickTree tree(weights.size());
+  for (ulong i = 0; i < weights.size(); ++i) tree.add(i, weights[i]);
+  // Updates are incremental
+  tree.add(3, 0.5);
+  weights[3] += 0.5;
+
+  FenwickTree built;
+  built.build(weights);
+
+  double cumulative = 0;
+  for (ulong i = 0; i < weights.size(); ++i) {
+    SCOPED_TRACE(i);
+    EXPECT_DOUBLE_EQ(tree.prefix_sum(i), cumulative);
+    EXPECT_DOUBLE_EQ(built.prefix_sum(i), cumulative);
+    cumulative += weights[i];
+
+    // A value within the weight of i is found in i, zero weights are skipped
+    if (weights[i] > 0) {
+      double value = cumulative - weights[i] / 3;
+      EXPECT_EQ(tree.find(value), i);
+      EXPECT_NEAR(value, 2 * weights[i] / 3, 1e-12);
+    }
+  }
+  EXPECT_DOUBLE_EQ(tree.total(), weights.sum());
+
+  double value = 2 * weights.sum();
+  EXPECT_EQ(tree.find(value), weights.size() - 1);
+}
+
 #ifdef ADD_MAIN
 int main(int argc, char **argv) {
 #ifdef _WIN32
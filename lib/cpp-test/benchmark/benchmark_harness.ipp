@@ -0,0 +1,246 @@
+// License: BSD 3 clause
+
+//
+// Shared harness of the C++ benchmarks. Each benchmark case is run a few
+// times to warm up caches, then timed over several repetitions. A summary
+// line is printed for each case and, if requested, all timings are written
+// to a JSON file so that runs can be compared across revisions.
+//
+// The command line arguments common to all benchmarks are
+// --size=N : problem size, its meaning depends on the benchmark
+// --threads=N : number of threads used by the benchmarked code when relevant
+// --warmup=N : number of untimed runs of each case (default 1)
+// --repeats=N : number of timed runs of each case (default 5)
+// --json=PATH : JSON output file, "-" to write it on stdout
+//
+// Example
+// ./solver_epoch --size=100000 --threads=4 --repeats=10 --json=solvers.json
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "tick/base/base.h"
+#include "tick/random/rand.h"
+#include "tick/random/test_rand.h"
+
+struct BenchmarkResult {
+  std::string name;
+  std::map<std::string, double> params;
+  // Number of processed items (events, samples, ...) in one run, 0 if the
+  // throughput is not meaningful
+  double n_items;
+  std::vector<double> times;
+
+  double min() const { return *std::min_element(times.begin(), times.end()); }
+
+  double mean() const {
+    double sum = 0;
+    for (double time : times) sum += time;
+    return sum / times.size();
+  }
+
+  double median() const {
+    std::vector<double> sorted_times(times);
+    std::sort(sorted_times.begin(), sorted_times.end());
+    const ulong middle = sorted_times.size() / 2;
+    if (sorted_times.size() % 2 == 1) return sorted_times[middle];
+    return (sorted_times[middle - 1] + sorted_times[middle]) / 2;
+  }
+
+  double stddev() const {
+    if (times.size() < 2) return 0;
+    const double times_mean = mean();
+    double sum_sq = 0;
+    for (double time : times) {
+      sum_sq += (time - times_mean) * (time - times_mean);
+    }
+    return std::sqrt(sum_sq / (times.size() - 1));
+  }
+};
+
+class BenchmarkSuite {
+ public:
+  std::string name;
+  ulong size;
+  unsigned int n_threads = 1;
+  ulong warmup = 1;
+  ulong repeats = 5;
+  std::string json_path;
+
+ private:
+  std::vector<BenchmarkResult> results;
+
+  static bool parse_arg(const std::string &arg, const std::string &key,
+                        std::string &value) {
+    const std::string prefix = "--" + key + "=";
+    if (arg.compare(0, prefix.size(), prefix) != 0) return false;
+    value = arg.substr(prefix.size());
+    return true;
+  }
+
+ public:
+  BenchmarkSuite(const std::string &name, int nargs, char *args[],
+                 ulong default_size)
+      : name(name), size(default_size) {
+    for (int i = 1; i < nargs; ++i) {
+      const std::string arg(args[i]);
+      std::string value;
+      if (parse_arg(arg, "size", value)) {
+        size = std::stoul(value);
+      } else if (parse_arg(arg, "threads", value)) {
+        n_threads = std::stoul(value);
+      } else if (parse_arg(arg, "warmup", value)) {
+        warmup = std::stoul(value);
+      } else if (parse_arg(arg, "repeats", value)) {
+        repeats = std::stoul(value);
+      } else if (parse_arg(arg, "json", value)) {
+        json_path = value;
+      } else {
+        TICK_ERROR("Unknown benchmark argument " << arg);
+      }
+    }
+    if (repeats == 0) TICK_ERROR("At least one repetition is needed");
+  }
+
+  ~BenchmarkSuite() {
+    if (!json_path.empty()) write_json();
+  }
+
+  // Times run() and records the result under the given name. setup() is
+  // called untimed before each run, so that runs that consume their input
+  // (a simulation for instance) start from the same state
+  template <typename SETUP, typename RUN>
+  const BenchmarkResult &run(const std::string &case_name,
+                             const std::map<std::string, double> &params,
+                             double n_items, SETUP setup, RUN run) {
+    for (ulong i = 0; i < warmup; ++i) {
+      setup();
+      run();
+    }
+    BenchmarkResult result{case_name, params, n_items, {}};
+    for (ulong i = 0; i < repeats; ++i) {
+      setup();
+      const auto start = std::chrono::steady_clock::now();
+      run();
+      const auto end = std::chrono::steady_clock::now();
+      const std::chrono::duration<double> elapsed = end - start;
+      result.times.push_back(elapsed.count());
+    }
+    results.push_back(result);
+    print(results.back());
+    return results.back();
+  }
+
+  template <typename RUN>
+  const BenchmarkResult &run(const std::string &case_name,
+                             const std::map<std::string, double> &params,
+                             double n_items, RUN run) {
+    return this->run(case_name, params, n_items, [] {}, run);
+  }
+
+  void print(const BenchmarkResult &result) const {
+    std::cout << name << '\t' << result.name << '\t' << result.median()
+              << '\t' << result.min() << '\t' << result.stddev();
+    if (result.n_items > 0) {
+      std::cout << '\t' << result.n_items / result.median() << " items/s";
+    }
+    std::cout << std::endl;
+  }
+
+  void write_json() const {
+    std::ostringstream os;
+    os.precision(10);
+    os << "{\"benchmark\": \"" << name << "\", \"size\": " << size
+       << ", \"n_threads\": " << n_threads << ", \"warmup\": " << warmup
+       << ", \"repeats\": " << repeats << ", \"results\": [";
+    for (ulong r = 0; r < results.size(); ++r) {
+      const BenchmarkResult &result = results[r];
+      os << (r == 0 ? "" : ", ") << "{\"name\": \"" << result.name
+         << "\", \"params\": {";
+      ulong p = 0;
+      for (const auto &param : result.params) {
+        os << (p++ == 0 ? "" : ", ") << "\"" << param.first
+           << "\": " << param.second;
+      }
+      os << "}, \"times\": [";
+      for (ulong i = 0; i < result.times.size(); ++i) {
+        os << (i == 0 ? "" : ", ") << result.times[i];
+      }
+      os << "], \"min\": " << result.min() << ", \"median\": "
+         << result.median() << ", \"mean\": " << result.mean()
+         << ", \"stddev\": " << result.stddev();
+      if (result.n_items > 0) {
+        os << ", \"items_per_second\": " << result.n_items / result.median();
+      }
+      os << "}";
+    }
+    os << "]}" << std::endl;
+
+    if (json_path == "-") {
+      std::cout << os.str();
+    } else {
+      std::ofstream file(json_path);
+      file << os.str();
+    }
+  }
+};
+
+// Keeps the compiler from discarding computations whose result is unused
+inline void do_not_optimize(double value) {
+  static volatile double sink;
+  sink = value;
+  (void)sink;
+}
+
+inline SArrayDouble2dPtr dense_features(ulong n_rows, ulong n_cols,
+                                        int seed) {
+  const auto sample = test_gaussian(n_rows * n_cols, seed);
+  ArrayDouble2d features(n_rows, n_cols, sample->data());
+  return SArrayDouble2d::new_ptr(features);
+}
+
+// Sparse features with n_nonzeros_per_row entries per row, spread over the
+// columns
+inline SSparseArrayDouble2dPtr sparse_features(ulong n_rows, ulong n_cols,
+                                               ulong n_nonzeros_per_row,
+                                               int seed) {
+  n_nonzeros_per_row =
+      std::max(ulong{1}, std::min(n_nonzeros_per_row, n_cols));
+  auto features = SSparseArrayDouble2d::new_ptr(n_rows, n_cols,
+                                                n_rows * n_nonzeros_per_row);
+  Rand rand(seed);
+  const ulong spacing = n_cols / n_nonzeros_per_row;
+  for (ulong i = 0; i <= n_rows; ++i) {
+    features->row_indices()[i] = i * n_nonzeros_per_row;
+  }
+  for (ulong i = 0; i < n_rows; ++i) {
+    const ulong offset = rand.uniform_int(ulong{0}, spacing - 1);
+    for (ulong k = 0; k < n_nonzeros_per_row; ++k) {
+      const ulong position = i * n_nonzeros_per_row + k;
+      features->indices()[position] = k * spacing + offset;
+      features->data()[position] = rand.gaussian();
+    }
+  }
+  return features;
+}
+
+// Labels in {-1, 1} drawn from a logistic model with random coefficients
+inline SArrayDoublePtr binary_labels(BaseArrayDouble2d &features,
+                                     int seed) {
+  const auto coeffs = test_gaussian(features.n_cols(), seed);
+  Rand rand(seed);
+  SArrayDoublePtr labels = SArrayDouble::new_ptr(features.n_rows());
+  for (ulong i = 0; i < features.n_rows(); ++i) {
+    const double z = view_row(features, i).dot(*coeffs);
+    (*labels)[i] = rand.uniform() < 1 / (1 + std::exp(-z)) ? 1 : -1;
+  }
+  return labels;
+}
@@ -0,0 +1,36 @@
+// License: BSD 3 clause
+
+//
+// Hawkes process shared by the Hawkes benchmarks. Its kernels are
+// exponential with a total norm of 0.6, so that the process is stable for
+// any number of nodes
+//
+
+#include "tick/hawkes/simulation/simu_hawkes.h"
+
+inline std::unique_ptr<Hawkes> benchmark_hawkes(ulong n_nodes, double decay,
+                                                int seed) {
+  std::unique_ptr<Hawkes> hawkes(new Hawkes(n_nodes, seed));
+  for (ulong i = 0; i < n_nodes; ++i) {
+    hawkes->set_baseline(i, 0.5 + 0.1 * (i % 3));
+    for (ulong j = 0; j < n_nodes; ++j) {
+      HawkesKernelPtr kernel = std::make_shared<HawkesKernelExp>(
+          (0.5 + 0.2 * ((i + j) % 2)) / n_nodes, decay);
+      hawkes->set_kernel(i, j, kernel);
+    }
+  }
+  return hawkes;
+}
+
+inline SArrayDoublePtrList1D simulate_hawkes(ulong n_nodes, double end_time,
+                                             double decay, int seed) {
+  auto hawkes = benchmark_hawkes(n_nodes, decay, seed);
+  hawkes->simulate(end_time);
+  return hawkes->get_timestamps();
+}
+
+inline ulong count_events(const SArrayDoublePtrList1D &timestamps) {
+  ulong n_events = 0;
+  for (const auto &timestamps_i : timestamps) n_events += timestamps_i->size();
+  return n_events;
+}
@@ -0,0 +1,50 @@
+// License: BSD 3 clause
+
+#include "tick/hawkes/inference/hawkes_em.h"
+
+#include "benchmark_harness.ipp"
+#include "hawkes_data.ipp"
+
+//
+// Benchmark iterations of the non parametric EM algorithm for Hawkes
+// processes
+// --size is the end time of the simulated 10 nodes Hawkes process (default
+// 2000). --threads is given to the EM
+//
+// Example
+// ./hawkes_em --size=10000 --threads=4
+//
+
+int main(int nargs, char *args[]) {
+  BenchmarkSuite suite("hawkes_em", nargs, args, 2000);
+  const ulong n_nodes = 10;
+  const double end_time = suite.size;
+  const double kernel_support = 4.;
+  const ulong kernel_size = 30;
+
+  SArrayDoublePtrList2D timestamps_list{
+      simulate_hawkes(n_nodes, end_time, 2., 1337)};
+  VArrayDoublePtr end_times = VArrayDouble::new_ptr(1);
+  (*end_times)[0] = end_time;
+  const double n_events = count_events(timestamps_list[0]);
+
+  HawkesEM em(kernel_support, kernel_size, suite.n_threads);
+  em.set_data(timestamps_list, end_times);
+
+  ArrayDouble mu(n_nodes);
+  ArrayDouble2d kernels(n_nodes, n_nodes * kernel_size);
+  const std::map<std::string, double> params = {
+      {"n_nodes", static_cast<double>(n_nodes)},
+      {"end_time", end_time},
+      {"n_events", n_events},
+      {"kernel_size", static_cast<double>(kernel_size)},
+      {"n_threads", static_cast<double>(suite.n_threads)}};
+  // Every run performs one EM iteration from the same starting point
+  suite.run("em_iteration", params, n_events,
+            [&] {
+              mu.fill(0.1);
+              kernels.fill(0.01);
+            },
+            [&] { em.solve(mu, kernels); });
+  return 0;
+}
@@ -0,0 +1,53 @@
+// License: BSD 3 clause
+
+#include "tick/hawkes/model/model_hawkes_expkern_leastsq_single.h"
+#include "tick/hawkes/model/model_hawkes_expkern_loglik_single.h"
+#include "tick/hawkes/model/model_hawkes_sumexpkern_leastsq_single.h"
+
+#include "benchmark_harness.ipp"
+#include "hawkes_data.ipp"
+
+//
+// Benchmark the precomputation of weights of Hawkes models, which dominates
+// their fitting time
+// --size is the end time of the simulated 10 nodes Hawkes process (default
+// 2000). --threads is given to the models
+//
+// Example
+// ./hawkes_leastsq_weights --size=10000 --threads=4
+//
+
+int main(int nargs, char *args[]) {
+  BenchmarkSuite suite("hawkes_weights", nargs, args, 2000);
+  const ulong n_nodes = 10;
+  const double end_time = suite.size;
+  const double decay = 2.;
+
+  const auto timestamps = simulate_hawkes(n_nodes, end_time, decay, 1337);
+  const double n_events = count_events(timestamps);
+  const std::map<std::string, double> params = {
+      {"n_nodes", static_cast<double>(n_nodes)},
+      {"end_time", end_time},
+      {"n_events", n_events},
+      {"n_threads", static_cast<double>(suite.n_threads)}};
+
+  auto decays = SArrayDouble2d::new_ptr(n_nodes, n_nodes);
+  decays->fill(decay);
+  ModelHawkesExpKernLeastSqSingle exp_leastsq(decays, suite.n_threads);
+  exp_leastsq.set_data(timestamps, end_time);
+  suite.run("expkern_leastsq", params, n_events,
+            [&] { exp_leastsq.compute_weights(); });
+
+  ArrayDouble sum_decays{0.5, 2., 8.};
+  ModelHawkesSumExpKernLeastSqSingle sumexp_leastsq(sum_decays, 1, end_time,
+                                                    suite.n_threads);
+  sumexp_leastsq.set_data(timestamps, end_time);
+  suite.run("sumexpkern_leastsq", params, n_events,
+            [&] { sumexp_leastsq.compute_weights(); });
+
+  ModelHawkesExpKernLogLikSingle exp_loglik(decay, suite.n_threads);
+  exp_loglik.set_data(timestamps, end_time);
+  suite.run("expkern_loglik", params, n_events,
+            [&] { exp_loglik.compute_weights(); });
+  return 0;
+}
@@ -0,0 +1,40 @@
+// License: BSD 3 clause
+
+#include "benchmark_harness.ipp"
+#include "hawkes_data.ipp"
+
+//
+// Benchmark the simulation throughput of Hawkes processes, in events per
+// second
+// --size is the end time of the simulation (default 10000). Simulation is
+// sequential, --threads is ignored
+//
+// Example
+// ./hawkes_simulation --size=100000
+//
+
+int main(int nargs, char *args[]) {
+  BenchmarkSuite suite("hawkes_simulation", nargs, args, 10000);
+  const double end_time = suite.size;
+
+  for (ulong n_nodes : {1, 10, 50}) {
+    for (double decay : {1., 100.}) {
+      // With the same seed every run simulates the same events
+      const double n_events =
+          count_events(simulate_hawkes(n_nodes, end_time, decay, 1337));
+      const std::map<std::string, double> params = {
+          {"n_nodes", static_cast<double>(n_nodes)},
+          {"decay", decay},
+          {"end_time", end_time},
+          {"n_events", n_events}};
+
+      std::unique_ptr<Hawkes> hawkes;
+      std::ostringstream case_name;
+      case_name << "exp_kernels_" << n_nodes << "_nodes_decay_" << decay;
+      suite.run(case_name.str(), params, n_events,
+                [&] { hawkes = benchmark_hawkes(n_nodes, decay, 1337); },
+                [&] { hawkes->simulate(end_time); });
+    }
+  }
+  return 0;
+}
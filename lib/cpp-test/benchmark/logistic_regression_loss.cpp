@@ -0,0 +1,51 @@
+// License: BSD 3 clause
+
+#include "tick/linear_model/model_linreg.h"
+#include "tick/linear_model/model_logreg.h"
+
+#include "benchmark_harness.ipp"
+
+//
+// Benchmark full loss and gradient computations of generalized linear
+// models on dense and sparse data
+// --size is the number of samples (default 100000), with 100 features. Sparse
+// features have 10 non zeros per sample. --threads is given to the models
+//
+// Example
+// ./logistic_regression_loss --size=1000000 --threads=4
+//
+
+template <class MODEL>
+void run_model(BenchmarkSuite &suite, const std::string &name,
+               std::shared_ptr<BaseArrayDouble2d> features,
+               SArrayDoublePtr labels) {
+  const ulong n_samples = features->n_rows();
+  MODEL model(features, labels, false, suite.n_threads);
+  const ArrayDouble coeffs = *test_gaussian(model.get_n_coeffs(), 7);
+  ArrayDouble grad(model.get_n_coeffs());
+  const std::map<std::string, double> params = {
+      {"n_samples", static_cast<double>(n_samples)},
+      {"n_features", static_cast<double>(features->n_cols())},
+      {"n_threads", static_cast<double>(suite.n_threads)}};
+  suite.run(name + "_loss", params, n_samples,
+            [&] { do_not_optimize(model.loss(coeffs)); });
+  suite.run(name + "_grad", params, n_samples,
+            [&] { model.grad(coeffs, grad); });
+}
+
+int main(int nargs, char *args[]) {
+  BenchmarkSuite suite("glm_loss_grad", nargs, args, 100000);
+  const ulong n_samples = suite.size;
+  const ulong n_features = 100;
+
+  const auto dense = dense_features(n_samples, n_features, 1);
+  const auto dense_labels = binary_labels(*dense, 2);
+  const auto sparse = sparse_features(n_samples, n_features, 10, 3);
+  const auto sparse_labels = binary_labels(*sparse, 4);
+
+  run_model<ModelLogReg>(suite, "logreg_dense", dense, dense_labels);
+  run_model<ModelLogReg>(suite, "logreg_sparse", sparse, sparse_labels);
+  run_model<ModelLinReg>(suite, "linreg_dense", dense, dense_labels);
+  run_model<ModelLinReg>(suite, "linreg_sparse", sparse, sparse_labels);
+  return 0;
+}
@@ -0,0 +1,56 @@
+// License: BSD 3 clause
+
+#include "benchmark_harness.ipp"
+
+//
+// Benchmark array kernels : dense dot product, mult_incr, sparse dot product
+// and dense and sparse matrix vector products
+// --size is the size of the vectors (default 1000000). Matrices have --size
+// entries spread over 1000 columns, sparse ones have 10% of non zeros
+//
+// Example
+// ./matrix_vector_dotproduct --size=10000000 --json=array_kernels.json
+//
+
+int main(int nargs, char *args[]) {
+  BenchmarkSuite suite("array_kernels", nargs, args, 1000000);
+  const ulong size = suite.size;
+  const ulong n_cols = std::min(size, ulong{1000});
+  const ulong n_rows = std::max(ulong{1}, size / n_cols);
+  const std::map<std::string, double> params = {
+      {"size", static_cast<double>(size)}};
+
+  const ArrayDouble x = *test_gaussian(size, 1);
+  ArrayDouble y = *test_gaussian(size, 2);
+
+  suite.run("dot", params, size, [&] { do_not_optimize(x.dot(y)); });
+  suite.run("mult_incr", params, size, [&] { y.mult_incr(x, 1e-3); });
+
+  // A single sparse vector of the same size with 10% of non zeros
+  const auto sparse_row = sparse_features(1, size, size / 10, 3);
+  const BaseArrayDouble sparse_x = view_row(*sparse_row, 0);
+  suite.run("sparse_dot", params, size / 10,
+            [&] { do_not_optimize(sparse_x.dot(y)); });
+  suite.run("sparse_mult_incr", params, size / 10,
+            [&] { y.mult_incr(sparse_x, 1e-3); });
+
+  const auto matrix = dense_features(n_rows, n_cols, 4);
+  const auto sparse_matrix = sparse_features(n_rows, n_cols, n_cols / 10, 5);
+  const ArrayDouble vector = view(y, 0, n_cols);
+  ArrayDouble out(n_rows);
+  const std::map<std::string, double> matrix_params = {
+      {"n_rows", static_cast<double>(n_rows)},
+      {"n_cols", static_cast<double>(n_cols)}};
+  suite.run("matrix_vector", matrix_params, n_rows * n_cols, [&] {
+    for (ulong i = 0; i < n_rows; ++i) {
+      out[i] = view_row(*matrix, i).dot(vector);
+    }
+  });
+  suite.run("sparse_matrix_vector", matrix_params, sparse_matrix->size_sparse(),
+            [&] {
+              for (ulong i = 0; i < n_rows; ++i) {
+                out[i] = view_row(*sparse_matrix, i).dot(vector);
+              }
+            });
+  return 0;
+}
@@ -0,0 +1,75 @@
+// License: BSD 3 clause
+
+#include "tick/linear_model/model_logreg.h"
+#include "tick/prox/prox_l2sq.h"
+#include "tick/solver/saga.h"
+#include "tick/solver/sdca.h"
+#include "tick/solver/sgd.h"
+#include "tick/solver/svrg.h"
+
+#include "benchmark_harness.ipp"
+
+//
+// Benchmark one epoch of stochastic solvers on logistic regression with
+// dense and sparse synthetic data
+// --size is the number of samples (default 100000), with 100 features. Sparse
+// features have 10 non zeros per sample. --threads is given to the model and
+// to SVRG, the other solvers are sequential
+//
+// Example
+// ./solver_epoch --size=1000000 --threads=4 --json=solvers.json
+//
+
+const constexpr int SEED = 1933;
+
+void run_solver(BenchmarkSuite &suite, const std::string &name,
+                const BaseArrayDouble2d &features,
+                std::shared_ptr<ModelLogReg> model, StoSolver &solver) {
+  const ulong n_samples = features.n_rows();
+  solver.set_rand_max(n_samples);
+  solver.set_model(model);
+  const std::map<std::string, double> params = {
+      {"n_samples", static_cast<double>(n_samples)},
+      {"n_features", static_cast<double>(features.n_cols())},
+      {"sparse", features.is_sparse() ? 1. : 0.},
+      {"n_threads", static_cast<double>(suite.n_threads)}};
+  suite.run(name, params, n_samples, [&] { solver.solve_one_epoch(); });
+}
+
+void run_solvers(BenchmarkSuite &suite, const std::string &data_name,
+                 std::shared_ptr<BaseArrayDouble2d> features,
+                 SArrayDoublePtr labels) {
+  const ulong n_samples = features->n_rows();
+  auto model = std::make_shared<ModelLogReg>(features, labels, false,
+                                             suite.n_threads);
+  auto prox = std::make_shared<ProxL2Sq>(1. / n_samples, false);
+  const double step = 1. / model->get_lip_max();
+
+  SAGA saga(n_samples, 0, RandType::unif, step, 1, SEED);
+  saga.set_prox(prox);
+  run_solver(suite, "saga_" + data_name, *features, model, saga);
+
+  SVRG svrg(n_samples, 0, RandType::unif, step, 1, SEED, suite.n_threads);
+  svrg.set_prox(prox);
+  run_solver(suite, "svrg_" + data_name, *features, model, svrg);
+
+  SGD sgd(n_samples, 0, RandType::unif, step, 1, SEED);
+  sgd.set_prox(prox);
+  run_solver(suite, "sgd_" + data_name, *features, model, sgd);
+
+  SDCA sdca(1. / n_samples, n_samples, 0, RandType::unif, 1, SEED);
+  run_solver(suite, "sdca_" + data_name, *features, model, sdca);
+}
+
+int main(int nargs, char *args[]) {
+  BenchmarkSuite suite("solver_epoch", nargs, args, 100000);
+  const ulong n_samples = suite.size;
+  const ulong n_features = 100;
+
+  const auto dense = dense_features(n_samples, n_features, 1);
+  run_solvers(suite, "dense", dense, binary_labels(*dense, 2));
+
+  const auto sparse = sparse_features(n_samples, n_features, 10, 3);
+  run_solvers(suite, "sparse", sparse, binary_labels(*sparse, 4));
+  return 0;
+}
@@ -0,0 +1,131 @@
+// License: BSD 3 clause
+
+#include <gtest/gtest.h>
+
+#include "tick/hawkes/inference/hawkes_accelerated_em.h"
+#include "tick/hawkes/simulation/simu_hawkes.h"
+
+class HawkesAcceleratedEMTest : public ::testing::Test {
+ protected:
+  const ulong n_nodes = 2;
+  const double end_time = 300;
+  SArrayDoublePtrList2D timestamps_list;
+  VArrayDoublePtr end_times;
+
+  void SetUp() override {
+    for (int r = 0; r < 2; ++r) {
+      Hawkes hawkes(n_nodes, 1234 + r);
+      for (ulong i = 0; i < n_nodes; ++i) {
+        hawkes.set_baseline(i, 0.3 + 0.1 * i);
+        for (ulong j = 0; j < n_nodes; ++j) {
+          HawkesKernelPtr kernel =
+              std::make_shared<HawkesKernelExp>(0.2 + 0.1 * (i == j), 2.);
+          hawkes.set_kernel(i, j, kernel);
+        }
+      }
+      hawkes.simulate(end_time);
+      timestamps_list.push_back(hawkes.get_timestamps());
+    }
+    end_times = VArrayDouble::new_ptr(timestamps_list.size());
+    end_times->fill(end_time);
+  }
+};
+
+namespace {
+
+typedef AbstractArray1d2d<double> Params;
+
+// Relative distance between the concatenations of the given arrays
+double relative_distance(std::initializer_list<const Params *> new_x,
+                         std::initializer_list<const Params *> old_x) {
+  double diff_sq = 0, norm_sq = 0;
+  auto old_it = old_x.begin();
+  for (const Params *x : new_x) {
+    const double *y = (*(old_it++))->data();
+    for (ulong k = 0; k < x->size(); ++k) {
+      diff_sq += (x->data()[k] - y[k]) * (x->data()[k] - y[k]);
+      norm_sq += y[k] * y[k];
+    }
+  }
+  return std::sqrt(diff_sq / norm_sq);
+}
+
+}  // namespace
+
+// Plain BasisKernels iterations converge slowly (about 1e4 steps for a 1e-10
+// tolerance). The accelerated iterate is hence checked to be a fixed point of
+// the plain iteration, which, run from the same starting point with as many
+// solve calls, gets close to it
+TEST_F(HawkesAcceleratedEMTest, basis_kernels_fixed_point) {
+  const ulong kernel_size = 3, n_basis = 2, max_iter_gdm = 10;
+  const double max_tol_gdm = 1e-10;
+  HawkesBasisKernels learner(3., kernel_size, n_basis, 1.);
+  learner.set_data(timestamps_list, end_times);
+
+  ArrayDouble mu(n_nodes);
+  ArrayDouble2d gdm(n_basis, kernel_size), auvd(n_nodes, n_nodes * n_basis);
+  mu.fill(0.5);
+  for (ulong k = 0; k < gdm.size(); ++k) gdm[k] = 0.1 + 0.01 * (k % 7);
+  for (ulong k = 0; k < auvd.size(); ++k) auvd[k] = 0.5 + 0.05 * (k % 5);
+
+  ArrayDouble plain_mu = mu;
+  ArrayDouble2d plain_gdm = gdm, plain_auvd = auvd;
+
+  HawkesAcceleratedEM accelerated_em(10000, 1e-10);
+  accelerated_em.solve(learner, mu, gdm, auvd, max_iter_gdm, max_tol_gdm);
+  EXPECT_LE(accelerated_em.get_rel_change(), 1e-10);
+
+  const double start_distance = relative_distance(
+      {&plain_mu, &plain_gdm, &plain_auvd}, {&mu, &gdm, &auvd});
+  const ulong n_plain_steps = accelerated_em.get_n_solve_calls();
+  for (ulong t = 0; t < n_plain_steps; ++t)
+    learner.solve(plain_mu, plain_gdm, plain_auvd, max_iter_gdm, max_tol_gdm);
+  EXPECT_LT(relative_distance({&plain_mu, &plain_gdm, &plain_auvd},
+                              {&mu, &gdm, &auvd}),
+            5e-2 * start_distance);
+
+  ArrayDouble next_mu = mu;
+  ArrayDouble2d next_gdm = gdm, next_auvd = auvd;
+  learner.solve(next_mu, next_gdm, next_auvd, max_iter_gdm, max_tol_gdm);
+  EXPECT_LT(relative_distance({&next_mu, &next_gdm, &next_auvd},
+                              {&mu, &gdm, &auvd}),
+            1e-9);
+}
+
+TEST_F(HawkesAcceleratedEMTest, sum_gaussians_fixed_point) {
+  const ulong n_gaussians = 3;
+  HawkesSumGaussians learner(n_gaussians, 2., 1e-4, 1e-3, 1e-3, 1);
+  learner.set_data(timestamps_list, end_times);
+
+  ArrayDouble mu(n_nodes);
+  ArrayDouble2d amplitudes(n_nodes, n_nodes * n_gaussians);
+  mu.fill(0.5);
+  for (ulong k = 0; k < amplitudes.size(); ++k)
+    amplitudes[k] = 0.5 + 0.05 * (k % 5);
+
+  ArrayDouble plain_mu = mu;
+  ArrayDouble2d plain_amplitudes = amplitudes;
+  for (ulong t = 0; t < 10000; ++t) {
+    ArrayDouble prev_mu = plain_mu;
+    ArrayDouble2d prev_amplitudes = plain_amplitudes;
+    learner.solve(plain_mu, plain_amplitudes);
+    if (relative_distance({&plain_mu, &plain_amplitudes},
+                          {&prev_mu, &prev_amplitudes}) <= 1e-10)
+      break;
+  }
+
+  HawkesAcceleratedEM accelerated_em(10000, 1e-10);
+  accelerated_em.solve(learner, mu, amplitudes);
+  EXPECT_LE(accelerated_em.get_rel_change(), 1e-10);
+
+  EXPECT_LT(relative_distance({&mu, &amplitudes},
+                              {&plain_mu, &plain_amplitudes}),
+            1e-8);
+}
+
+#ifdef ADD_MAIN
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+#endif  // ADD_MAIN
@@ -0,0 +1,71 @@
+// License: BSD 3 clause
+
+#include <gtest/gtest.h>
+
+#include "tick/hawkes/inference/hawkes_conditional_law.h"
+
+namespace {
+
+SArrayDoublePtr make_sarray(std::initializer_list<double> values) {
+  ArrayDouble array(values.size());
+  ulong i = 0;
+  for (double value : values) array[i++] = value;
+  return array.as_sarray_ptr();
+}
+
+}  // namespace
+
+// Y = times[0] ends long before Z = times[1], so that the loop on the jumps of
+// Z stops on different jumps for each mark interval of Z
+TEST(HawkesConditionalLaw, BatchMatchesPointProcessCondLaw) {
+  const double T = 30.;
+
+  SArrayDoublePtrList1D times, marks, mark_intervals;
+  times.push_back(make_sarray({0.3, 0.9, 1.4, 2.2, 2.5, 3.1, 4.0, 4.6}));
+  marks.push_back(make_sarray({1., 2., 3., 4., 5., 6., 7., 8.}));
+  mark_intervals.push_back(make_sarray({0., 0.}));
+
+  times.push_back(make_sarray({0.1, 0.7, 1.2, 1.9, 2.8, 3.5, 4.9, 5.2, 6.6,
+                               8.1, 9.4, 11.0, 13.7, 16.2, 19.5, 24.0}));
+  marks.push_back(make_sarray({1., 2., 4., 5., 7., 8., 9., 11., 12., 14., 17.,
+                               18., 20., 23., 24., 26.}));
+  mark_intervals.push_back(
+      make_sarray({0.5, 1.5, 1.5, 2.5, 2.5, 3.5, 0., 0.}));
+
+  ArrayDouble lags{0., 0.25, 0.5, 1., 2.};
+  const ulong n_lags = lags.size() - 1;
+  const ulong n_index_i = 1 + 4;
+
+  for (int n_threads : {1, 2}) {
+    ArrayDouble res_X(n_lags);
+    ArrayDouble2d res_Y(times.size() * n_index_i, n_lags);
+    PointProcessCondLawBatch(times, marks, mark_intervals, lags, T, res_X,
+                             res_Y, n_threads);
+
+    ulong row = 0;
+    for (ulong i = 0; i < times.size(); ++i) {
+      ArrayDouble &y_time = *times[i];
+      for (ulong j = 0; j < times.size(); ++j) {
+        ArrayDouble &intervals = *mark_intervals[j];
+        for (ulong l = 0; l < intervals.size() / 2; ++l, ++row) {
+          ArrayDouble expected_X(n_lags), expected_Y(n_lags);
+          PointProcessCondLaw(y_time, *times[j], *marks[j], lags,
+                              intervals[2 * l], intervals[2 * l + 1], T,
+                              y_time.size() / T, expected_X, expected_Y);
+          for (ulong k = 0; k < n_lags; ++k) {
+            EXPECT_DOUBLE_EQ(res_X[k], expected_X[k]);
+            EXPECT_DOUBLE_EQ(res_Y(row, k), expected_Y[k])
+                << "i=" << i << ", j=" << j << ", l=" << l << ", k=" << k;
+          }
+        }
+      }
+    }
+  }
+}
+
+#ifdef ADD_MAIN
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+#endif  // ADD_MAIN
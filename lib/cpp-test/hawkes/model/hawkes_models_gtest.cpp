@@ -723,6 +723,105 @@ TEST_F(HawkesModelTest, compute_hessian_sumexp_loglikelihood) {
   EXPECT_DOUBLE_EQ(out[9], 0.001582373650788027);
 }
 
+TEST_F(HawkesModelTest, compensator_increments_sumexp_loglikelihood) {
+  ArrayDouble decays{1., 2.};
+  const ulong n_nodes = 2, n_decays = decays.size();
+
+  ModelHawkesSumExpKernLogLikSingle model(decays, 2);
+  model.set_data(timestamps, 4.25);
+
+  ArrayDouble coeffs = ArrayDouble{1., 3., 2., 3., 4., 1., 5., 3., 2., 4.};
+  auto increments = model.get_compensator_increments(coeffs);
+
+  // Compensator computed from its definition
+  auto compensator = [&](ulong i, double t) {
+    double value = coeffs[i] * t;
+    for (ulong j = 0; j < n_nodes; ++j) {
+      for (ulong l = 0; l < timestamps[j]->size(); ++l) {
+        const double t_j_l = (*timestamps[j])[l];
+        if (t_j_l >= t) break;
+        for (ulong u = 0; u < n_decays; ++u) {
+          const double alpha = coeffs[n_nodes + i * n_nodes * n_decays +
+                                      j * n_decays + u];
+          value += alpha * (1 - std::exp(-decays[u] * (t - t_j_l)));
+        }
+      }
+    }
+    return value;
+  };
+
+  ASSERT_EQ(increments.size(), n_nodes);
+  for (ulong i = 0; i < n_nodes; ++i) {
+    ASSERT_EQ(increments[i]->size(), timestamps[i]->size());
+    double t_i_k_minus_one = 0;
+    for (ulong k = 0; k < timestamps[i]->size(); ++k) {
+      SCOPED_TRACE(k);
+      const double t_i_k = (*timestamps[i])[k];
+      EXPECT_NEAR((*increments[i])[k],
+                  compensator(i, t_i_k) - compensator(i, t_i_k_minus_one),
+                  1e-12);
+      t_i_k_minus_one = t_i_k;
+    }
+  }
+}
+
+TEST_F(HawkesModelTest, compensator_increments_loglik_list) {
+  const double decay = 2.;
+  ArrayDouble coeffs = ArrayDouble{1., 3., 2., 3., 4., 1};
+
+  ModelHawkesExpKernLogLik model(decay, 2);
+  model.incremental_set_data(timestamps, 5.65);
+  model.incremental_set_data(timestamps, 5.87);
+  auto increments = model.get_compensator_increments(coeffs);
+
+  ModelHawkesExpKernLogLikSingle model_single(decay, 1);
+  model_single.set_data(timestamps, 5.65);
+  auto increments_single = model_single.get_compensator_increments(coeffs);
+
+  ArrayDouble wrong_size_coeffs(coeffs.size() - 1);
+  EXPECT_THROW(model.get_compensator_increments(wrong_size_coeffs),
+               std::runtime_error);
+  EXPECT_THROW(model_single.get_compensator_increments(wrong_size_coeffs),
+               std::runtime_error);
+
+  ASSERT_EQ(increments.size(), 2u);
+  for (ulong r = 0; r < increments.size(); ++r) {
+    for (ulong i = 0; i < increments_single.size(); ++i) {
+      ASSERT_EQ(increments[r][i]->size(), increments_single[i]->size());
+      for (ulong k = 0; k < increments_single[i]->size(); ++k) {
+        EXPECT_DOUBLE_EQ((*increments[r][i])[k], (*increments_single[i])[k]);
+      }
+    }
+  }
+}
+
+TEST_F(HawkesModelTest, leastsq_memory_footprint) {
+  const ulong n_nodes = timestamps.size();
+  auto decays = SArrayDouble2d::new_ptr(n_nodes, n_nodes);
+  decays->fill(2.);
+
+  ModelHawkesExpKernLeastSqSingle model_single(decays, 1);
+  model_single.set_data(timestamps, 5.65);
+  const ulong footprint_single = model_single.memory_footprint();
+  EXPECT_EQ(model_single.memory_usage(), 0u);
+  model_single.compute_weights();
+  EXPECT_EQ(model_single.memory_usage(), footprint_single);
+
+  auto timestamps_list = SArrayDoublePtrList2D(0);
+  timestamps_list.push_back(timestamps);
+  timestamps_list.push_back(timestamps);
+  auto end_times = VArrayDouble::new_ptr(2);
+  (*end_times)[0] = 5.65;
+  (*end_times)[1] = 5.87;
+
+  // Weights of both realizations are computed before being aggregated
+  ModelHawkesExpKernLeastSq model(decays, 1);
+  model.set_data(timestamps_list, end_times);
+  EXPECT_EQ(model.memory_footprint(), 3 * footprint_single);
+  model.compute_weights();
+  EXPECT_EQ(model.memory_usage(), footprint_single);
+}
+
 #ifdef ADD_MAIN
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
@@ -54,6 +54,33 @@ TEST_F(HawkesKernelPowerLawTest, invalid_constructor_parameters) {
                std::invalid_argument);
 }
 
+TEST_F(HawkesKernelPowerLawTest, sum_exp_approximation) {
+  for (double relative_error : {1e-2, 1e-4}) {
+    HawkesKernelPowerLaw kernel(multiplier, cutoff, exponent, -1, 1e-5);
+    std::shared_ptr<HawkesKernelSumExp> approximation =
+        kernel.get_sum_exp_approximation(relative_error);
+
+    for (double test_time : test_times) {
+      EXPECT_NEAR(approximation->get_value(test_time) /
+                      kernel.get_value(test_time),
+                  1., relative_error);
+    }
+    const double last_time = 0.99 * kernel.get_support();
+    EXPECT_NEAR(
+        approximation->get_value(last_time) / kernel.get_value(last_time), 1.,
+        relative_error);
+    EXPECT_LE(approximation->get_n_decays(), 200u);
+
+    // Convolutions of the approximation are computed recursively
+    EXPECT_NEAR(approximation->get_convolution(5., timestamps, nullptr) /
+                    kernel.get_convolution(5., timestamps, nullptr),
+                1., relative_error);
+  }
+
+  EXPECT_THROW(hawkes_kernel_power_law.get_sum_exp_approximation(1e-12, 10),
+               std::runtime_error);
+}
+
 #ifdef ADD_MAIN
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
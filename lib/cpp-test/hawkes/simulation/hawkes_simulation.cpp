@@ -1,7 +1,12 @@
 // License: BSD 3 clause
 
 #include <gtest/gtest.h>
+#include <cstdio>
+#include "tick/base/serialization.h"
 #include "tick/hawkes/simulation/simu_hawkes.h"
+#include "tick/hawkes/simulation/simu_hawkes_multi.h"
+#include "tick/hawkes/simulation/simu_inhomogeneous_poisson.h"
+#include "tick/hawkes/model/model_hawkes_sumexpkern_loglik_single.h"
 
 TEST(SimuHawkesTest, constant_baseline) {
   Hawkes hawkes(1);
@@ -24,3 +29,560 @@ TEST(SimuHawkesTest, tuple_baseline) {
   // Check that intensity TimeFunction is cycled
   EXPECT_GT(hawkes.timestamps[0]->last(), 10);
 }
+
+TEST(SimuHawkesTest, compensator_increments) {
+  ArrayDouble decays{1., 3.};
+  const ulong n_nodes = 2;
+  ArrayDouble coeffs{0.5, 0.8, 0.2, 0.1, 0., 0.3, 0.1, 0.2, 0.3, 0.};
+
+  Hawkes hawkes(n_nodes, 1234);
+  for (ulong i = 0; i < n_nodes; ++i) {
+    hawkes.set_baseline(i, coeffs[i]);
+    for (ulong j = 0; j < n_nodes; ++j) {
+      ArrayDouble intensities = view(
+          coeffs, n_nodes + (i * n_nodes + j) * decays.size(),
+          n_nodes + (i * n_nodes + j + 1) * decays.size());
+      HawkesKernelPtr kernel =
+          std::make_shared<HawkesKernelSumExp>(intensities, decays);
+      hawkes.set_kernel(i, j, kernel);
+    }
+  }
+  hawkes.simulate(2000.);
+
+  auto increments = hawkes.get_compensator_increments(2);
+
+  // Same compensator as the one computed by the log-likelihood model
+  ModelHawkesSumExpKernLogLikSingle model(decays, 1);
+  model.set_data(hawkes.get_timestamps(), hawkes.get_time());
+  auto model_increments = model.get_compensator_increments(coeffs);
+
+  for (ulong i = 0; i < n_nodes; ++i) {
+    ASSERT_EQ(increments[i]->size(), hawkes.get_timestamps()[i]->size());
+    for (ulong k = 0; k < increments[i]->size(); ++k) {
+      ASSERT_NEAR((*increments[i])[k], (*model_increments[i])[k], 1e-9);
+    }
+    // Time-rescaled inter-arrival times are standard exponentials
+    EXPECT_NEAR(increments[i]->sum() / increments[i]->size(), 1., 0.1);
+  }
+}
+
+TEST(SimuHawkesTest, compensator_increments_unsupported_baseline) {
+  ArrayDouble t_values{1., 2., 4., 5.3};
+  ArrayDouble y_values{1., 3., 2., 0.};
+  Hawkes hawkes(1);
+  hawkes.set_baseline(0, t_values, y_values);
+  hawkes.simulate(10.);
+  EXPECT_THROW(hawkes.get_compensator_increments(), std::runtime_error);
+}
+
+TEST(SimuHawkesTest, intensity_on_grid) {
+  const ulong n_nodes = 2;
+  Hawkes hawkes(n_nodes, 1234);
+  ArrayDouble t_values{0., 5., 10.};
+  ArrayDouble y_values{0.5, 1., 0.5};
+  hawkes.set_baseline(0, t_values, y_values);
+  hawkes.set_baseline(1, 0.3);
+
+  ArrayDouble decays{1., 4.};
+  ArrayDouble intensities{0.2, 0.1};
+  HawkesKernelPtr kernel_exp = std::make_shared<HawkesKernelExp>(0.3, 2.);
+  HawkesKernelPtr kernel_sum_exp =
+      std::make_shared<HawkesKernelSumExp>(intensities, decays);
+  HawkesKernelPtr kernel_power_law =
+      std::make_shared<HawkesKernelPowerLaw>(0.1, 1., 2., 3.);
+  hawkes.set_kernel(0, 0, kernel_exp);
+  hawkes.set_kernel(0, 1, kernel_power_law);
+  hawkes.set_kernel(1, 0, kernel_sum_exp);
+  hawkes.simulate(100.);
+
+  const auto timestamps = hawkes.get_timestamps();
+  ArrayDouble times(1000);
+  for (ulong p = 0; p < times.size(); p++) times[p] = 0.1 * p;
+
+  auto intensity = hawkes.get_intensity(timestamps, times, 2);
+
+  ASSERT_EQ(intensity.size(), n_nodes);
+  for (ulong i = 0; i < n_nodes; ++i) {
+    ASSERT_EQ(intensity[i]->size(), times.size());
+    for (ulong p = 0; p < times.size(); p++) {
+      double expected = hawkes.get_baseline(i, times[p]);
+      for (ulong j = 0; j < n_nodes; ++j) {
+        for (ulong k = 0; k < timestamps[j]->size(); ++k) {
+          const double t_j_k = (*timestamps[j])[k];
+          if (t_j_k >= times[p]) break;
+          expected += hawkes.get_kernel(i, j)->get_value(times[p] - t_j_k);
+        }
+      }
+      ASSERT_NEAR((*intensity[i])[p], expected, 1e-10);
+    }
+  }
+}
+
+TEST(SimuHawkesTest, event_driven_simulation) {
+  const ulong n_nodes = 3, n_simulations = 50;
+  const double end_time = 200.;
+
+  // Number of jumps of each node in every simulation, intensity is not track
+  // recorded in event-driven simulation
+  auto simulate_n_jumps = [&](bool event_driven) {
+    ArrayDouble2d n_jumps(n_simulations, n_nodes);
+    for (ulong r = 0; r < n_simulations; ++r) {
+      Hawkes hawkes(n_nodes, 1000 + r);
+      ArrayDouble decays{1., 4.};
+      for (ulong i = 0; i < n_nodes; ++i) {
+        hawkes.set_baseline(i, 0.2);
+        ArrayDouble intensities{0.3, 0.1};
+        HawkesKernelPtr kernel =
+            std::make_shared<HawkesKernelSumExp>(intensities, decays);
+        hawkes.set_kernel(i, (i + 1) % n_nodes, kernel);
+      }
+      if (!event_driven) hawkes.activate_itr(end_time);
+      // Simulation in two steps resumes from already simulated jumps
+      hawkes.simulate(end_time / 2);
+      hawkes.simulate(end_time);
+      for (ulong i = 0; i < n_nodes; ++i) {
+        n_jumps(r, i) = hawkes.get_timestamps()[i]->size();
+      }
+    }
+    return n_jumps;
+  };
+
+  const ArrayDouble2d event_driven_n_jumps = simulate_n_jumps(true);
+  const ArrayDouble2d thinning_n_jumps = simulate_n_jumps(false);
+
+  // Mean intensity is 0.2 / (1 - 0.4) on each node
+  const double expected_n_jumps = end_time * 0.2 / 0.6;
+  for (ulong i = 0; i < n_nodes; ++i) {
+    SCOPED_TRACE(i);
+    ArrayDouble mean(2), variance(2);
+    mean.init_to_zero();
+    variance.init_to_zero();
+    for (ulong r = 0; r < n_simulations; ++r) {
+      mean[0] += event_driven_n_jumps(r, i) / n_simulations;
+      mean[1] += thinning_n_jumps(r, i) / n_simulations;
+    }
+    for (ulong r = 0; r < n_simulations; ++r) {
+      variance[0] += std::pow(event_driven_n_jumps(r, i) - mean[0], 2) /
+                     (n_simulations - 1);
+      variance[1] += std::pow(thinning_n_jumps(r, i) - mean[1], 2) /
+                     (n_simulations - 1);
+    }
+
+    EXPECT_NEAR(mean[0], expected_n_jumps, 0.1 * expected_n_jumps);
+    EXPECT_NEAR(mean[1], expected_n_jumps, 0.1 * expected_n_jumps);
+
+    // Both paths sample the same law, their means and variances agree
+    EXPECT_NEAR(mean[0], mean[1],
+                3 * std::sqrt((variance[0] + variance[1]) / n_simulations));
+    EXPECT_GT(variance[0] / variance[1], 0.5);
+    EXPECT_LT(variance[0] / variance[1], 2.);
+  }
+}
+
+TEST(SimuHawkesTest, cluster_simulation) {
+  const ulong n_nodes = 3, n_simulations = 50;
+  const double end_time = 200.;
+
+  auto make_kernel = [](bool power_law) -> HawkesKernelPtr {
+    if (power_law) {
+      return std::make_shared<HawkesKernelPowerLaw>(0.2, 0.5, 2., 10.);
+    }
+    ArrayDouble intensities{0.3, 0.1}, decays{1., 4.};
+    return std::make_shared<HawkesKernelSumExp>(intensities, decays);
+  };
+
+  auto mean_n_jumps = [&](bool power_law, bool cluster) {
+    double n_jumps = 0;
+    for (ulong r = 0; r < n_simulations; ++r) {
+      Hawkes hawkes(n_nodes, 1000 + r);
+      for (ulong i = 0; i < n_nodes; ++i) {
+        hawkes.set_baseline(i, 0.2);
+        HawkesKernelPtr kernel = make_kernel(power_law);
+        hawkes.set_kernel(i, (i + 1) % n_nodes, kernel);
+      }
+      if (cluster) {
+        hawkes.simulate_cluster(end_time, 2);
+      } else {
+        hawkes.simulate(end_time);
+      }
+      n_jumps += hawkes.get_n_total_jumps();
+    }
+    return n_jumps / n_simulations;
+  };
+
+  for (bool power_law : {false, true}) {
+    // Mean intensity is 0.2 / (1 - norm) on each node
+    const double norm = make_kernel(power_law)->get_norm();
+    const double expected_n_jumps = n_nodes * end_time * 0.2 / (1 - norm);
+    const double cluster_n_jumps = mean_n_jumps(power_law, true);
+    const double thinning_n_jumps = mean_n_jumps(power_law, false);
+    EXPECT_NEAR(cluster_n_jumps, expected_n_jumps, 0.05 * expected_n_jumps);
+    EXPECT_NEAR(cluster_n_jumps, thinning_n_jumps, 0.05 * expected_n_jumps);
+  }
+
+  // Realization does not depend on the number of threads, timestamps are
+  // sorted and rescaled inter-arrival times are standard exponential
+  Hawkes hawkes_1(n_nodes, 7), hawkes_4(n_nodes, 7);
+  for (Hawkes *hawkes : {&hawkes_1, &hawkes_4}) {
+    for (ulong i = 0; i < n_nodes; ++i) {
+      hawkes->set_baseline(i, 0.2);
+      HawkesKernelPtr kernel = make_kernel(false);
+      hawkes->set_kernel(i, (i + 1) % n_nodes, kernel);
+    }
+  }
+  hawkes_1.simulate_cluster(10000., 1);
+  hawkes_4.simulate_cluster(10000., 4);
+  EXPECT_EQ(hawkes_1.get_time(), 10000.);
+  EXPECT_EQ(hawkes_1.get_n_total_jumps(), hawkes_4.get_n_total_jumps());
+
+  SArrayDoublePtrList1D increments = hawkes_1.get_compensator_increments();
+  double sum = 0, sum_sq = 0;
+  ulong count = 0;
+  for (ulong i = 0; i < n_nodes; ++i) {
+    ArrayDouble &timestamps_1 = *hawkes_1.get_timestamps()[i];
+    ArrayDouble &timestamps_4 = *hawkes_4.get_timestamps()[i];
+    ASSERT_EQ(timestamps_1.size(), timestamps_4.size());
+    for (ulong k = 0; k < timestamps_1.size(); ++k) {
+      EXPECT_EQ(timestamps_1[k], timestamps_4[k]);
+      if (k > 0) {
+        EXPECT_LE(timestamps_1[k - 1], timestamps_1[k]);
+      }
+    }
+    for (ulong k = 0; k < increments[i]->size(); ++k) {
+      sum += (*increments[i])[k];
+      sum_sq += (*increments[i])[k] * (*increments[i])[k];
+      count++;
+    }
+  }
+  const double mean = sum / count;
+  EXPECT_NEAR(mean, 1., 0.05);
+  EXPECT_NEAR(sum_sq / count - mean * mean, 1., 0.1);
+
+  // Cluster simulation starts from an empty realization
+  EXPECT_THROW(hawkes_1.simulate_cluster(20000.), std::runtime_error);
+}
+
+TEST(SimuHawkesTest, cluster_simulation_time_function_baseline) {
+  const ulong n_nodes = 2, n_simulations = 50;
+  const double end_time = 500.;
+  ArrayDouble T{0., 100., 200., 500.}, Y{0.5, 0.1, 0.3, 0.3};
+  TimeFunction baseline(T, Y);
+
+  auto mean_n_jumps = [&](bool cluster) {
+    double n_jumps = 0;
+    for (ulong r = 0; r < n_simulations; ++r) {
+      Hawkes hawkes(n_nodes, 1000 + r);
+      for (ulong i = 0; i < n_nodes; ++i) {
+        hawkes.set_baseline(i, baseline);
+        HawkesKernelPtr kernel = std::make_shared<HawkesKernelExp>(0.5, 2.);
+        hawkes.set_kernel(i, 1 - i, kernel);
+      }
+      if (cluster) {
+        hawkes.simulate_cluster(end_time);
+      } else {
+        hawkes.simulate(end_time);
+      }
+      n_jumps += hawkes.get_n_total_jumps();
+    }
+    return n_jumps / n_simulations;
+  };
+
+  // Up to border effects, mean intensity is baseline / (1 - 0.5)
+  const double expected_n_jumps = n_nodes * baseline.get_norm() / 0.5;
+  EXPECT_NEAR(mean_n_jumps(true), expected_n_jumps, 0.05 * expected_n_jumps);
+  EXPECT_NEAR(mean_n_jumps(false), expected_n_jumps, 0.05 * expected_n_jumps);
+}
+
+TEST(SimuHawkesTest, multi_simulation) {
+  const ulong n_nodes = 2, n_realizations = 20;
+  Hawkes model(n_nodes);
+  for (ulong i = 0; i < n_nodes; ++i) {
+    model.set_baseline(i, 0.5);
+    for (ulong j = 0; j < n_nodes; ++j) {
+      HawkesKernelPtr kernel = std::make_shared<HawkesKernelExp>(0.2, 2.);
+      model.set_kernel(i, j, kernel);
+    }
+  }
+
+  // Realizations only depend on the seed
+  HawkesMulti multi_1(model, n_realizations, 123);
+  HawkesMulti multi_4(model, n_realizations, 123);
+  multi_1.simulate(100., 1);
+  multi_4.simulate(100., 4);
+
+  SArrayDoublePtrList2D timestamps_1 = multi_1.get_timestamps();
+  SArrayDoublePtrList2D timestamps_4 = multi_4.get_timestamps();
+  ASSERT_EQ(timestamps_1.size(), n_realizations);
+  for (ulong r = 0; r < n_realizations; ++r) {
+    EXPECT_EQ((*multi_1.get_simulation_times())[r], 100.);
+    for (ulong i = 0; i < n_nodes; ++i) {
+      ASSERT_EQ(timestamps_1[r][i]->size(), timestamps_4[r][i]->size());
+      for (ulong k = 0; k < timestamps_1[r][i]->size(); ++k) {
+        EXPECT_EQ((*timestamps_1[r][i])[k], (*timestamps_4[r][i])[k]);
+      }
+    }
+  }
+
+  // Realizations are independent and kernels are not shared
+  ArrayULong n_total_jumps = *multi_1.get_n_total_jumps();
+  EXPECT_NE(n_total_jumps[0], n_total_jumps[1]);
+  EXPECT_NE(multi_1.get_realization(0).get_kernel(0, 0),
+            multi_1.get_realization(1).get_kernel(0, 0));
+  EXPECT_EQ(model.get_n_total_jumps(), 0u);
+
+  // Mean intensity is 0.5 / (1 - 0.4) on each node
+  const double expected_n_jumps = n_nodes * 100. * 0.5 / 0.6;
+  EXPECT_NEAR(n_total_jumps.sum() / n_realizations, expected_n_jumps,
+              0.1 * expected_n_jumps);
+
+  // Each realization has its own end time and maximum number of jumps
+  multi_1.reset();
+  ArrayDouble end_times(n_realizations);
+  for (ulong r = 0; r < n_realizations; ++r) end_times[r] = 10. * (r + 1);
+  multi_1.simulate(end_times, 50, 2);
+  for (ulong r = 0; r < n_realizations; ++r) {
+    EXPECT_LE((*multi_1.get_n_total_jumps())[r], 50u);
+    EXPECT_LE((*multi_1.get_simulation_times())[r], end_times[r]);
+  }
+
+  EXPECT_THROW(multi_1.simulate(ArrayDouble(3), 50), std::runtime_error);
+}
+
+TEST(SimuHawkesTest, multi_simulation_track_record) {
+  const ulong n_nodes = 2, n_realizations = 3;
+  Hawkes model(n_nodes);
+  for (ulong i = 0; i < n_nodes; ++i) {
+    model.set_baseline(i, 0.5);
+    for (ulong j = 0; j < n_nodes; ++j) {
+      HawkesKernelPtr kernel = std::make_shared<HawkesKernelExp>(0.2, 2.);
+      model.set_kernel(i, j, kernel);
+    }
+  }
+
+  // Realizations track record their intensity like the model
+  model.activate_itr(0.5, 50);
+  HawkesMulti multi(model, n_realizations, 123);
+  multi.simulate(100., 2);
+
+  for (ulong r = 0; r < n_realizations; ++r) {
+    SCOPED_TRACE(r);
+    VArrayDoublePtrList1D itr = multi.get_itr(r);
+    VArrayDoublePtr itr_times = multi.get_itr_times(r);
+    ASSERT_EQ(itr.size(), n_nodes);
+    EXPECT_GT(itr_times->size(), 1u);
+    EXPECT_LT(itr_times->size(), 50u);
+    EXPECT_LE(itr_times->last(), 100.);
+    for (ulong i = 0; i < n_nodes; ++i) {
+      ASSERT_EQ(itr[i]->size(), itr_times->size());
+      EXPECT_GE(itr[i]->min(), 0.5);
+    }
+  }
+  EXPECT_THROW(multi.get_itr(n_realizations), std::out_of_range);
+
+  model.activate_itr(-1);
+  HawkesMulti multi_no_itr(model, n_realizations, 123);
+  multi_no_itr.simulate(100., 2);
+  EXPECT_THROW(multi_no_itr.get_itr(0), std::runtime_error);
+}
+
+TEST(SimuHawkesTest, multi_simulation_serialization) {
+  const ulong n_nodes = 2, n_realizations = 3;
+  Hawkes model(n_nodes);
+  for (ulong i = 0; i < n_nodes; ++i) {
+    model.set_baseline(i, 0.5);
+    for (ulong j = 0; j < n_nodes; ++j) {
+      HawkesKernelPtr kernel = std::make_shared<HawkesKernelExp>(0.2, 2.);
+      model.set_kernel(i, j, kernel);
+    }
+  }
+  HawkesMulti multi(model, n_realizations, 123);
+  multi.simulate(100., 2);
+
+  Hawkes empty_model(0);
+  HawkesMulti restored(empty_model, 1);
+  tick::object_from_string(&restored, tick::object_to_string(&multi));
+
+  ASSERT_EQ(restored.get_n_realizations(), n_realizations);
+  const SArrayDoublePtrList2D timestamps = multi.get_timestamps();
+  const SArrayDoublePtrList2D restored_timestamps = restored.get_timestamps();
+  for (ulong r = 0; r < n_realizations; ++r) {
+    SCOPED_TRACE(r);
+    EXPECT_EQ((*restored.get_seeds())[r], (*multi.get_seeds())[r]);
+    EXPECT_EQ((*restored.get_simulation_times())[r], 100.);
+    for (ulong i = 0; i < n_nodes; ++i) {
+      ASSERT_EQ(restored_timestamps[r][i]->size(), timestamps[r][i]->size());
+      for (ulong k = 0; k < timestamps[r][i]->size(); ++k) {
+        EXPECT_EQ((*restored_timestamps[r][i])[k], (*timestamps[r][i])[k]);
+      }
+    }
+  }
+}
+
+TEST(SimuHawkesTest, event_sink) {
+  const ulong n_nodes = 2;
+  auto build_model = [&]() {
+    std::unique_ptr<Hawkes> model(new Hawkes(n_nodes, 7));
+    for (ulong i = 0; i < n_nodes; ++i) {
+      model->set_baseline(i, 0.5 + i);
+      for (ulong j = 0; j < n_nodes; ++j) {
+        HawkesKernelPtr kernel = std::make_shared<HawkesKernelExp>(0.3, 2.);
+        model->set_kernel(i, j, kernel);
+      }
+    }
+    return model;
+  };
+
+  auto in_memory = build_model();
+  in_memory->simulate(100.);
+  in_memory->simulate(200.);
+  SArrayDoublePtrList1D expected = in_memory->get_timestamps();
+
+  // Streamed jumps are the ones simulated in memory, even if batches are
+  // smaller than the number of jumps
+  const std::string path = "simu_hawkes_event_sink_test.bin";
+  auto streamed = build_model();
+  streamed->set_event_sink(std::make_shared<PPFileEventSink>(path, 10));
+  streamed->simulate(100.);
+  streamed->simulate(200.);
+  EXPECT_EQ(streamed->get_n_total_jumps(), in_memory->get_n_total_jumps());
+  SArrayDoublePtrList1D read = PPFileEventSink::read(path, n_nodes);
+  std::remove(path.c_str());
+  for (ulong i = 0; i < n_nodes; ++i) {
+    EXPECT_EQ(streamed->get_timestamps()[i]->size(), 0u);
+    ASSERT_EQ(read[i]->size(), expected[i]->size());
+    for (ulong k = 0; k < read[i]->size(); ++k) {
+      EXPECT_EQ((*read[i])[k], (*expected[i])[k]);
+    }
+  }
+
+  // Batches reach the callback in chronological order
+  ulong n_events = 0;
+  double last_time = 0;
+  bool sorted = true;
+  auto callback = [&](const ArrayDouble &times, const ArrayULong &nodes) {
+    for (ulong k = 0; k < times.size(); ++k) {
+      sorted &= last_time <= times[k] && nodes[k] < n_nodes;
+      last_time = times[k];
+    }
+    n_events += times.size();
+  };
+  auto clustered = build_model();
+  clustered->set_event_sink(std::make_shared<PPCallbackEventSink>(callback, 7));
+  clustered->simulate_cluster(200.);
+  EXPECT_TRUE(sorted);
+  EXPECT_EQ(n_events, clustered->get_n_total_jumps());
+  EXPECT_GT(n_events, 0u);
+
+  // Jumps must be kept when kernels are convolved with them
+  auto power_law = build_model();
+  HawkesKernelPtr kernel =
+      std::make_shared<HawkesKernelPowerLaw>(0.1, 1., 2., 10.);
+  power_law->set_kernel(0, 0, kernel);
+  power_law->set_event_sink(std::make_shared<PPCallbackEventSink>(callback));
+  EXPECT_THROW(power_law->simulate(10.), std::runtime_error);
+
+  // Excitation of streamed jumps cannot be rebuilt once a kernel has changed
+  HawkesKernelPtr other_kernel = std::make_shared<HawkesKernelExp>(0.2, 2.);
+  streamed->set_kernel(0, 0, other_kernel);
+  EXPECT_THROW(streamed->simulate(300.), std::runtime_error);
+  streamed->set_baseline(0, 1.);
+  EXPECT_THROW(streamed->simulate(300.), std::runtime_error);
+  streamed->reset();
+  streamed->set_event_sink(nullptr);
+  streamed->simulate(100.);
+  EXPECT_GT(streamed->get_n_total_jumps(), 0u);
+}
+
+TEST(SimuHawkesTest, bounded_intensity_track_record) {
+  Hawkes hawkes(1, 3);
+  hawkes.set_baseline(0, 1.);
+  HawkesKernelPtr kernel = std::make_shared<HawkesKernelExp>(0.5, 1.);
+  hawkes.set_kernel(0, 0, kernel);
+
+  const ulong max_size = 100;
+  hawkes.activate_itr(0.01, max_size);
+  hawkes.simulate(1000.);
+
+  VArrayDoublePtr itr_times = hawkes.get_itr_times();
+  EXPECT_LT(itr_times->size(), max_size);
+  EXPECT_GE(itr_times->size(), max_size / 2 - 1);
+  EXPECT_EQ(hawkes.get_itr()[0]->size(), itr_times->size());
+  for (ulong k = 1; k < itr_times->size(); ++k) {
+    EXPECT_LE((*itr_times)[k - 1], (*itr_times)[k]);
+  }
+  // Records still span the whole simulation
+  EXPECT_GT((*itr_times)[itr_times->size() - 1], 900.);
+
+  // Step has been doubled at each decimation
+  const double n_doublings = std::log2(hawkes.get_itr_step() / 0.01);
+  EXPECT_GT(n_doublings, 5.);
+  EXPECT_NEAR(n_doublings, std::round(n_doublings), 1e-9);
+
+  hawkes.reset();
+  EXPECT_DOUBLE_EQ(hawkes.get_itr_step(), 0.01);
+  EXPECT_THROW(hawkes.activate_itr(0.01, 1), std::runtime_error);
+}
+
+TEST(SimuInhomogeneousPoissonTest, exact_simulation) {
+  ArrayDouble T{0., 1., 2., 3., 10.}, Y{0., 5., 0., 1., 0.};
+  TimeFunction spiky(T, Y);
+  ArrayDouble T_cyclic{0., 1., 2.}, Y_cyclic{1., 3., 1.};
+  TimeFunction cyclic(T_cyclic, Y_cyclic, TimeFunction::BorderType::Cyclic,
+                      TimeFunction::InterMode::InterConstRight);
+  const std::vector<TimeFunction> functions{spiky, cyclic};
+  const double end_time = 20.;
+  const ulong n_simulations = 1000;
+
+  ArrayDouble breakpoints = cyclic.get_breakpoints(1.5, 5.);
+  EXPECT_DOUBLE_EQ(breakpoints[0], 1.5);
+  EXPECT_DOUBLE_EQ(breakpoints[breakpoints.size() - 1], 5.);
+  for (ulong k = 1; k < breakpoints.size(); ++k) {
+    EXPECT_LT(breakpoints[k - 1], breakpoints[k]);
+  }
+
+  // Thinning is used if intensity is track recorded. Jumps in [0, 1] of the
+  // first node and in [0, end_time] of the second node are counted
+  auto mean_n_jumps = [&](bool exact) {
+    ArrayDouble n_jumps(2);
+    n_jumps.init_to_zero();
+    for (ulong r = 0; r < n_simulations; ++r) {
+      InhomogeneousPoisson poisson(functions, 100 + r);
+      if (!exact) poisson.activate_itr(end_time);
+      // Simulation in two steps resumes from already simulated jumps
+      poisson.simulate(end_time / 4);
+      poisson.simulate(end_time);
+      ArrayDouble &timestamps = *poisson.get_timestamps()[0];
+      for (ulong k = 0; k < timestamps.size(); ++k) {
+        n_jumps[0] += timestamps[k] <= 1.;
+      }
+      n_jumps[1] += poisson.get_timestamps()[1]->size();
+    }
+    n_jumps.mult_fill(n_jumps, 1. / n_simulations);
+    return n_jumps;
+  };
+
+  const ArrayDouble exact_n_jumps = mean_n_jumps(true);
+  const ArrayDouble thinning_n_jumps = mean_n_jumps(false);
+  EXPECT_NEAR(exact_n_jumps[0], 2.5, 0.15);
+  EXPECT_NEAR(thinning_n_jumps[0], 2.5, 0.15);
+  EXPECT_NEAR(exact_n_jumps[1], 40., 1.);
+  EXPECT_NEAR(thinning_n_jumps[1], 40., 1.);
+
+  // Realization does not depend on the number of threads
+  InhomogeneousPoisson poisson_1(functions, 3), poisson_2(functions, 3);
+  poisson_2.set_n_threads(2);
+  poisson_1.simulate(end_time);
+  poisson_2.simulate(end_time);
+  EXPECT_EQ(poisson_1.get_time(), end_time);
+  for (ulong i = 0; i < 2; ++i) {
+    ArrayDouble &timestamps_1 = *poisson_1.get_timestamps()[i];
+    ArrayDouble &timestamps_2 = *poisson_2.get_timestamps()[i];
+    ASSERT_EQ(timestamps_1.size(), timestamps_2.size());
+    for (ulong k = 0; k < timestamps_1.size(); ++k) {
+      EXPECT_EQ(timestamps_1[k], timestamps_2[k]);
+      if (k > 0) {
+        EXPECT_LT(timestamps_1[k - 1], timestamps_1[k]);
+      }
+    }
+  }
+}
@@ -0,0 +1,116 @@
+// License: BSD 3 clause
+
+#include <gtest/gtest.h>
+
+#include "tick/random/alias_table.h"
+#include "tick/random/rand.h"
+
+namespace {
+
+double mean(const ArrayDouble &sample) { return sample.sum() / sample.size(); }
+
+double variance(const ArrayDouble &sample) {
+  const double sample_mean = mean(sample);
+  double sum = 0;
+  for (ulong k = 0; k < sample.size(); ++k) {
+    sum += (sample[k] - sample_mean) * (sample[k] - sample_mean);
+  }
+  return sum / sample.size();
+}
+
+}  // namespace
+
+TEST(RandTest, substream) {
+  Rand rand(12);
+  Rand rand_other_seed(13);
+
+  // Substreams do not depend on values already drawn
+  const double first = rand.substream(3).uniform();
+  for (int k = 0; k < 10; ++k) rand.uniform();
+  EXPECT_EQ(rand.substream(3).uniform(), first);
+
+  EXPECT_NE(rand.substream(4).uniform(), first);
+  EXPECT_NE(rand_other_seed.substream(3).uniform(), first);
+  EXPECT_NE(rand.substream(3).substream(0).uniform(), first);
+  EXPECT_NE(rand.substream(3).substream(0).uniform(),
+            rand.substream(0).substream(3).uniform());
+
+  // Generators built from a generator have substreams as well
+  Rand child = rand.substream(3);
+  EXPECT_EQ(child.substream(1).uniform(),
+            rand.substream(3).substream(1).uniform());
+}
+
+TEST(RandTest, batched_samples) {
+  const ulong size = 100001;
+  Rand rand(5);
+
+  ArrayDouble uniforms(size);
+  rand.uniform(uniforms);
+  EXPECT_GE(uniforms.min(), 0.);
+  EXPECT_LT(uniforms.max(), 1.);
+  EXPECT_NEAR(mean(uniforms), 0.5, 0.01);
+  EXPECT_NEAR(variance(uniforms), 1. / 12, 0.005);
+
+  ArrayDouble gaussians(size);
+  rand.gaussian(gaussians);
+  EXPECT_NEAR(mean(gaussians), 0., 0.02);
+  EXPECT_NEAR(variance(gaussians), 1., 0.02);
+
+  ArrayDouble exponentials(size);
+  rand.exponential(2., exponentials);
+  EXPECT_GE(exponentials.min(), 0.);
+  EXPECT_NEAR(mean(exponentials), 0.5, 0.01);
+  EXPECT_NEAR(variance(exponentials), 0.25, 0.01);
+
+  for (const double rate : {0., 0.3, 4., 40.}) {
+    ArrayInt poissons(size);
+    rand.poisson(rate, poissons);
+    ArrayDouble poissons_double(size);
+    for (ulong k = 0; k < size; ++k) poissons_double[k] = poissons[k];
+    EXPECT_NEAR(mean(poissons_double), rate, 0.02 * (1 + rate));
+    EXPECT_NEAR(variance(poissons_double), rate, 0.03 * (1 + rate));
+  }
+
+  // Integers are the ones drawn one by one
+  Rand rand_1(7), rand_2(7);
+  ArrayULong integers(1000);
+  rand_1.uniform_int(ulong{3}, ulong{10}, integers);
+  for (ulong k = 0; k < integers.size(); ++k) {
+    EXPECT_EQ(integers[k], rand_2.uniform_int(ulong{3}, ulong{10}));
+  }
+}
+
+TEST(RandTest, alias_table) {
+  const ArrayDouble weights{2.0, 0.1, 0., 5, 7};
+  AliasTable table(weights);
+  EXPECT_EQ(table.size(), weights.size());
+
+  Rand rand(3);
+  const ulong size = 200000;
+  ArrayULong sample(size);
+  table.sample(rand, sample);
+  ArrayDouble frequencies(weights.size());
+  frequencies.init_to_zero();
+  for (ulong k = 0; k < size; ++k) frequencies[sample[k]] += 1. / size;
+  for (ulong k = 0; k < size / 10; ++k) {
+    frequencies[table.sample(rand)] += 1. / size;
+  }
+  frequencies.mult_fill(frequencies, 1. / 1.1);
+
+  for (ulong i = 0; i < weights.size(); ++i) {
+    EXPECT_NEAR(frequencies[i], weights[i] / weights.sum(), 0.005);
+  }
+  EXPECT_EQ(frequencies[2], 0.);
+
+  EXPECT_THROW(AliasTable(ArrayDouble{1., -1.}), std::runtime_error);
+  EXPECT_THROW(AliasTable(ArrayDouble{0., 0.}), std::runtime_error);
+  EXPECT_THROW(AliasTable(ArrayDouble(0)), std::runtime_error);
+}
+
+#ifdef ADD_MAIN
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+#endif  // ADD_MAIN
@@ -90,6 +90,107 @@ TEST(SAGA, test_saga_sparse_convergence) {
   EXPECT_LE(objective_asaga - objective300, 0.0001);
 }
 
+TEST(SAGA, test_saga_importance_sampling) {
+  SArrayDoublePtr labels_ptr = get_labels();
+  SBaseArrayDouble2dPtr features_ptr = get_sparse_features();
+
+  ulong n_samples = features_ptr->n_rows();
+
+  auto model = std::make_shared<ModelLinReg>(features_ptr, labels_ptr, false, 1);
+  auto prox = std::make_shared<ProxL2Sq>(1e-1, false);
+  auto get_objective = [&](RandType rand_type) {
+    SAGA saga(n_samples, 0, rand_type, model->get_lip_max() / 300, 1, 1309);
+    saga.set_rand_max(n_samples);
+    saga.set_model(model);
+    saga.set_prox(prox);
+    saga.solve(300);
+    ArrayDouble iterate(model->get_n_coeffs());
+    saga.get_iterate(iterate);
+    return model->loss(iterate) + prox->value(iterate);
+  };
+  EXPECT_NEAR(get_objective(RandType::importance),
+              get_objective(RandType::unif), 1e-4);
+
+  ASAGA asaga(n_samples, 0, RandType::importance, model->get_lip_max() / 300, 1,
+              1309);
+  asaga.set_rand_max(n_samples);
+  asaga.set_model(model);
+  asaga.set_prox(prox);
+  EXPECT_THROW(asaga.solve(1), std::runtime_error);
+}
+
+TEST(SAGA, test_saga_sparse_importance_sampling_unbiased) {
+  // Columns 0 and 1 only appear in a few rows with large norms, which are
+  // sampled much more often than the others with importance sampling
+  const ulong n_samples = 60, n_features = 5, n_nnz_per_row = 3;
+  ArrayDouble2d dense_features(n_samples, n_features);
+  dense_features.init_to_zero();
+  ArrayDouble labels(n_samples);
+  double *data = new double[n_samples * n_nnz_per_row];
+  INDICE_TYPE *indices = new INDICE_TYPE[n_samples * n_nnz_per_row];
+  INDICE_TYPE *row_indices = new INDICE_TYPE[n_samples + 1];
+  Rand rand(1309);
+  for (ulong i = 0; i < n_samples; ++i) {
+    const bool large_row = i % 6 == 0;
+    row_indices[i] = i * n_nnz_per_row;
+    for (ulong k = 0; k < n_nnz_per_row; ++k) {
+      const ulong j = large_row ? k : 2 + k;
+      const double x_ij = (large_row ? 5 : 0.5) * (1 + rand.uniform());
+      data[i * n_nnz_per_row + k] = x_ij;
+      indices[i * n_nnz_per_row + k] = j;
+      dense_features(i, j) = x_ij;
+    }
+    labels[i] = rand.gaussian();
+  }
+  row_indices[n_samples] = n_samples * n_nnz_per_row;
+  auto sparse_features = SSparseArrayDouble2d::new_ptr(0, 0, 0);
+  sparse_features->set_data_indices_rowindices(data, indices, row_indices,
+                                                n_samples, n_features);
+
+  SArrayDoublePtr labels_ptr = labels.as_sarray_ptr();
+
+  auto prox = std::make_shared<ProxL2Sq>(1e-1, false);
+  // Exact minimizer of the ridge regression
+  const double l_l2sq = prox->get_strength();
+  ArrayDouble2d normal_matrix(n_features, n_features);
+  ArrayDouble minimizer(n_features);
+  for (ulong j = 0; j < n_features; ++j) {
+    ArrayDouble column_j(n_samples);
+    for (ulong i = 0; i < n_samples; ++i) column_j[i] = dense_features(i, j);
+    minimizer[j] = column_j.dot(*labels_ptr) / n_samples;
+    for (ulong k = 0; k < n_features; ++k) {
+      double sum = 0;
+      for (ulong i = 0; i < n_samples; ++i) {
+        sum += column_j[i] * dense_features(i, k);
+      }
+      normal_matrix(j, k) = sum / n_samples + (j == k ? l_l2sq : 0);
+    }
+  }
+  tick::vector_operations<double>{}.solve_linear_system(
+      n_features, normal_matrix.data(), minimizer.data());
+
+  auto model =
+      std::make_shared<ModelLinReg>(sparse_features, labels_ptr, false, 1);
+  SAGA saga(n_samples, 0, RandType::importance, 0, 1, 1309);
+  saga.set_rand_max(n_samples);
+  saga.set_model(model);
+  saga.set_prox(prox);
+  // The reweighted gradients are smoother than the worst sample
+  const double importance_lip_max = saga.get_importance_lip_max();
+  EXPECT_LT(importance_lip_max, model->get_lip_max());
+  EXPECT_LE(importance_lip_max, 2 * model->get_lip_mean() * (1 + 1e-12));
+
+  // With step corrections computed for uniform sampling, the columns of the
+  // large rows would get a step more than three times too large and diverge
+  saga.set_step(1. / importance_lip_max);
+  saga.solve(1000);
+  ArrayDouble iterate(n_features);
+  saga.get_iterate(iterate);
+  for (ulong j = 0; j < n_features; ++j) {
+    EXPECT_NEAR(iterate[j], minimizer[j], 1e-8) << "coordinate " << j;
+  }
+}
+
 TEST(SAGA, test_saga_serialization) {
   SArrayDoublePtr labels_ptr = get_labels();
   SBaseArrayDouble2dPtr features_ptr = get_features();
@@ -72,6 +72,188 @@ TEST(SVRG, test_history) {
   ASSERT_LE(get_objective(2), get_objective(1));
 }
 
+TEST(SVRG, test_importance_sampling) {
+  SArrayDoublePtr labels_ptr = get_labels();
+  SArrayDouble2dPtr features_ptr = get_features();
+
+  ulong n_samples = features_ptr->n_rows();
+
+  auto model =
+      std::make_shared<ModelLinReg>(features_ptr, labels_ptr, false, 1);
+  auto prox = std::make_shared<ProxL2Sq>(1e-3, false);
+  auto get_objective = [&](RandType rand_type) {
+    TSVRG<double, double> svrg(n_samples, 0, rand_type,
+                               model->get_lip_max() / 100, 1, 1309);
+    svrg.set_rand_max(n_samples);
+    svrg.set_model(model);
+    svrg.set_prox(prox);
+    svrg.solve(60);
+    ArrayDouble iterate(model->get_n_coeffs());
+    svrg.get_iterate(iterate);
+    return model->loss(iterate) + prox->value(iterate);
+  };
+
+  // Reweighted gradients make importance sampling converge to the same
+  // minimizer
+  EXPECT_NEAR(get_objective(RandType::importance),
+              get_objective(RandType::unif), 1e-5);
+
+  // Probabilities mix uniform sampling with the Lipschitz constants
+  TSVRG<double, double> svrg(n_samples, 0, RandType::importance, 1., 1, 1309);
+  svrg.set_rand_max(n_samples);
+  svrg.set_model(model);
+  svrg.set_prox(prox);
+  svrg.solve(1);
+  const ArrayDouble lip_consts = model->get_lip_consts();
+  for (ulong i = 0; i < n_samples; ++i) {
+    const double probability =
+        0.5 / n_samples + 0.5 * lip_consts[i] / lip_consts.sum();
+    EXPECT_NEAR(svrg.get_sample_weight(i), 1 / (n_samples * probability),
+                1e-10);
+  }
+}
+
+TEST(SVRG, test_block_permutation) {
+  SArrayDoublePtr labels_ptr = get_labels();
+  SArrayDouble2dPtr features_ptr = get_features();
+
+  ulong n_samples = features_ptr->n_rows();
+  const ulong block_size = 3;
+
+  auto model =
+      std::make_shared<ModelLinReg>(features_ptr, labels_ptr, false, 1);
+  auto prox = std::make_shared<ProxL2Sq>(1e-3, false);
+
+  TSVRG<double, double> svrg(n_samples, 0, RandType::block_perm, 1., 1, 1309);
+  svrg.set_rand_max(n_samples);
+  svrg.set_model(model);
+  svrg.set_perm_block_size(block_size);
+  svrg.set_prefetch(true);
+
+  // Each epoch visits every sample once, block after block
+  TStoSolver<double, double> &sto_solver = svrg;
+  for (int epoch = 0; epoch < 3; ++epoch) {
+    ArrayULong n_visits(n_samples);
+    n_visits.init_to_zero();
+    ulong previous_block = n_samples;
+    for (ulong t = 0; t < n_samples; ++t) {
+      const ulong i = sto_solver.get_next_i();
+      const ulong block = i / block_size;
+      if (block != previous_block && previous_block != n_samples) {
+        // The previous block must have been entirely visited
+        const ulong block_end =
+            std::min((previous_block + 1) * block_size, n_samples);
+        for (ulong j = previous_block * block_size; j < block_end; ++j) {
+          EXPECT_EQ(n_visits[j], 1u);
+        }
+      }
+      previous_block = block;
+      n_visits[i] += 1;
+    }
+    for (ulong i = 0; i < n_samples; ++i) EXPECT_EQ(n_visits[i], 1u);
+  }
+
+  // Block permutation converges to the same minimizer as full permutation
+  auto get_objective = [&](RandType rand_type) {
+    TSVRG<double, double> solver(n_samples, 0, rand_type,
+                                 model->get_lip_max() / 100, 1, 1309);
+    solver.set_rand_max(n_samples);
+    solver.set_model(model);
+    solver.set_prox(prox);
+    solver.set_perm_block_size(block_size);
+    solver.set_prefetch(true);
+    solver.solve(60);
+    ArrayDouble iterate(model->get_n_coeffs());
+    solver.get_iterate(iterate);
+    return model->loss(iterate) + prox->value(iterate);
+  };
+  EXPECT_NEAR(get_objective(RandType::block_perm),
+              get_objective(RandType::perm), 1e-5);
+}
+
+TEST(SVRG, test_instrumentation) {
+  SArrayDoublePtr labels_ptr = get_labels();
+  SArrayDouble2dPtr features_ptr = get_features();
+
+  ulong n_samples = features_ptr->n_rows();
+  const ulong n_epochs = 4;
+
+  auto model =
+      std::make_shared<ModelLinReg>(features_ptr, labels_ptr, false, 1);
+  auto prox = std::make_shared<ProxL2Sq>(1e-3, false);
+  auto run = [&](bool instrumentation, ArrayDouble &iterate) {
+    auto svrg = std::make_shared<TSVRG<double, double>>(
+        n_samples, 0, RandType::unif, model->get_lip_max() / 100, 1, 1309);
+    svrg->set_rand_max(n_samples);
+    svrg->set_model(model);
+    svrg->set_prox(prox);
+    svrg->set_instrumentation(instrumentation);
+    svrg->solve(n_epochs);
+    svrg->get_iterate(iterate);
+    return svrg;
+  };
+
+  ArrayDouble iterate(model->get_n_coeffs());
+  auto svrg = run(false, iterate);
+  for (int c = 0; c < SolverInstrumentation::n_counters; ++c) {
+    EXPECT_EQ(svrg->get_counter(static_cast<SolverCounter>(c)), 0u);
+  }
+
+  // Instrumentation does not change the iterates
+  ArrayDouble instrumented_iterate(model->get_n_coeffs());
+  svrg = run(true, instrumented_iterate);
+  for (ulong j = 0; j < iterate.size(); ++j) {
+    EXPECT_DOUBLE_EQ(iterate[j], instrumented_iterate[j]);
+  }
+
+  EXPECT_EQ(svrg->get_counter(SolverCounter::n_samples),
+            n_epochs * n_samples);
+  EXPECT_EQ(svrg->get_counter(SolverCounter::n_full_gradients), n_epochs);
+  EXPECT_EQ(svrg->get_counter(SolverCounter::n_prox_calls),
+            n_epochs * n_samples);
+  EXPECT_EQ(svrg->get_counter(SolverCounter::n_nnz),
+            n_epochs * n_samples * model->get_n_coeffs());
+  for (SolverCounter phase :
+       {SolverCounter::sampling_cycles, SolverCounter::gradient_cycles,
+        SolverCounter::update_cycles, SolverCounter::prox_cycles,
+        SolverCounter::full_gradient_cycles,
+        SolverCounter::objective_cycles}) {
+    EXPECT_GT(svrg->get_counter(phase), 0u);
+  }
+  EXPECT_GT(svrg->get_cycles_per_second(), 0);
+
+  // Counters are stored along with history, after each recorded epoch
+  const auto n_samples_history =
+      svrg->get_counter_history(SolverCounter::n_samples);
+  ASSERT_EQ(n_samples_history.size(), n_epochs);
+  for (ulong epoch = 0; epoch < n_epochs; ++epoch) {
+    EXPECT_EQ(n_samples_history[epoch], (epoch + 1) * n_samples);
+  }
+}
+
+TEST(SVRG, test_memory_footprint) {
+  SArrayDoublePtr labels_ptr = get_labels();
+  SArrayDouble2dPtr features_ptr = get_features();
+
+  ulong n_samples = features_ptr->n_rows();
+  const ulong n_epochs = 6;
+
+  auto model =
+      std::make_shared<ModelLinReg>(features_ptr, labels_ptr, false, 1);
+  TSVRG<double, double> svrg(n_samples, 0, RandType::perm,
+                             model->get_lip_max() / 100, 4, 1309);
+  svrg.set_rand_max(n_samples);
+  svrg.set_model(model);
+  svrg.set_prox(std::make_shared<ProxL2Sq>(1e-3, false));
+
+  // The footprint is known before solving and matches what is then held
+  const ulong footprint = svrg.memory_footprint(n_epochs);
+  EXPECT_GT(footprint, svrg.memory_footprint());
+  svrg.solve(n_epochs);
+  EXPECT_EQ(svrg.get_iterate_history().size(), 2u);
+  EXPECT_EQ(svrg.memory_usage(), footprint);
+}
+
 #ifdef ADD_MAIN
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
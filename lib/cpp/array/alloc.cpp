@@ -2,8 +2,16 @@
 
 #include "tick/array/alloc.h"
 
-#if defined(DEBUG_C_ARRAY)
+namespace tick {
 
-DEBUGCAllocArrayCount_t DEBUGCAllocArrayCount;
+std::atomic<std::uint64_t> AllocationCounter::n_allocations{0};
+std::atomic<std::uint64_t> AllocationCounter::n_frees{0};
+std::atomic<std::uint64_t> AllocationCounter::n_bytes_allocated{0};
 
-#endif
+void AllocationCounter::reset() {
+  n_allocations.store(0);
+  n_frees.store(0);
+  n_bytes_allocated.store(0);
+}
+
+}  // namespace tick
@@ -7,6 +7,9 @@
 #include "tick/base/time_func.h"
 #include <float.h>
 
+#include <algorithm>
+#include <vector>
+
 const double floor_threshold = 1e-10;
 
 double threshold_floor(const double x) {
@@ -25,7 +28,11 @@ TimeFunction::TimeFunction(double y) {
 
 TimeFunction::TimeFunction(const ArrayDouble &Y, BorderType type,
                            InterMode mode, double dt, double border_value)
-    : inter_mode(mode), border_type(type), dt(dt), border_value(border_value) {
+    : inter_mode(mode),
+      border_type(type),
+      t0(0),
+      dt(dt),
+      border_value(border_value) {
   sampled_y = SArrayDouble::new_ptr(Y.size());
   std::copy(Y.data(), Y.data() + Y.size(), sampled_y->data());
 
@@ -309,6 +316,48 @@ double TimeFunction::get_norm() {
   return norm;
 }
 
+ArrayDouble TimeFunction::get_breakpoints(double start_time, double end_time) {
+  std::vector<double> breakpoints{start_time};
+  auto add_breakpoint = [&](double t) {
+    if (t > breakpoints.back() && t < end_time) breakpoints.push_back(t);
+  };
+
+  // Constant TimeFunctions have no breakpoint
+  if (last_value_before_border >= 0) {
+    const double period = last_value_before_border;
+    const bool cyclic = border_type == BorderType::Cyclic && period > 0;
+    ulong cycle = 0;
+    if (cyclic && start_time > 0) {
+      cycle = static_cast<ulong>(std::floor(start_time / period));
+    }
+
+    while (true) {
+      const double cycle_start = cycle * period;
+      if (cycle_start >= end_time) break;
+
+      add_breakpoint(cycle_start);
+      add_breakpoint(cycle_start + t0);
+      const double first_index =
+          std::max(0., std::floor((start_time - cycle_start - t0) / dt));
+      for (ulong i = static_cast<ulong>(first_index);; ++i) {
+        const double t = get_t_from_index_(i);
+        if (t > period || cycle_start + t >= end_time) break;
+        add_breakpoint(cycle_start + t);
+      }
+      add_breakpoint(cycle_start + period);
+
+      if (!cyclic) break;
+      cycle++;
+    }
+  }
+
+  if (end_time > breakpoints.back()) breakpoints.push_back(end_time);
+
+  ArrayDouble breakpoints_array(breakpoints.size());
+  std::copy(breakpoints.begin(), breakpoints.end(), breakpoints_array.data());
+  return breakpoints_array;
+}
+
 double TimeFunction::constant_left_interpolation(double t_left, double y_left,
                                                  double t_right, double y_right,
                                                  double t_value) {
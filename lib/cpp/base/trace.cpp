@@ -0,0 +1,84 @@
+// License: BSD 3 clause
+
+#include "tick/base/parallel/trace.h"
+
+#include "tick/base/debug.h"
+
+#include <fstream>
+#include <sstream>
+
+namespace tick {
+
+Tracer &Tracer::instance() {
+  static Tracer tracer;
+  return tracer;
+}
+
+void Tracer::enable(ulong capacity) {
+  if (capacity == 0) TICK_ERROR("Trace capacity must be positive");
+  // Round up to a power of two so that slots are found with a mask
+  ulong rounded_capacity = 1;
+  while (rounded_capacity < capacity) rounded_capacity <<= 1;
+
+  enabled.store(false);
+  events.assign(rounded_capacity, TraceEvent());
+  n_recorded.store(0);
+  origin = std::chrono::steady_clock::now();
+  enabled.store(true);
+}
+
+void Tracer::disable() { enabled.store(false); }
+
+std::uint32_t Tracer::thread_id() {
+  static std::atomic<std::uint32_t> n_threads{0};
+  thread_local const std::uint32_t id = n_threads.fetch_add(1);
+  return id;
+}
+
+void Tracer::record(const TraceEvent &event) {
+  if (!is_enabled() || events.empty()) return;
+  const ulong slot = n_recorded.fetch_add(1) & (events.size() - 1);
+  events[slot] = event;
+}
+
+std::vector<TraceEvent> Tracer::get_events() const {
+  const ulong n_events = n_recorded.load();
+  const ulong capacity = events.size();
+  std::vector<TraceEvent> ordered_events;
+  if (capacity == 0) return ordered_events;
+  const ulong first = n_events > capacity ? n_events - capacity : 0;
+  ordered_events.reserve(n_events - first);
+  for (ulong i = first; i < n_events; ++i) {
+    ordered_events.push_back(events[i & (capacity - 1)]);
+  }
+  return ordered_events;
+}
+
+std::string Tracer::to_chrome_trace() const {
+  std::ostringstream os;
+  os.precision(3);
+  os << std::fixed;
+  os << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [";
+  const std::vector<TraceEvent> recorded_events = get_events();
+  for (ulong i = 0; i < recorded_events.size(); ++i) {
+    const TraceEvent &event = recorded_events[i];
+    // Complete events, with timestamps and durations in microseconds
+    os << (i == 0 ? "" : ",") << "\n{\"name\": \"" << event.name
+       << "\", \"cat\": \"" << event.category << "\", \"ph\": \"X\""
+       << ", \"ts\": " << event.start_ns / 1e3
+       << ", \"dur\": " << (event.end_ns - event.start_ns) / 1e3
+       << ", \"pid\": 0, \"tid\": " << event.thread_id << ", \"args\": {"
+       << "\"first_index\": " << event.first_index
+       << ", \"last_index\": " << event.last_index << "}}";
+  }
+  os << "\n]}\n";
+  return os.str();
+}
+
+void Tracer::dump_chrome_trace(const std::string &path) const {
+  std::ofstream file(path);
+  if (!file) TICK_ERROR("Could not open trace file " << path);
+  file << to_chrome_trace();
+}
+
+}  // namespace tick
@@ -74,6 +74,7 @@ void TModelGeneralizedLinear<T, K>::inc_grad_i(const ulong i, Array<T> &out,
 template <class T, class K>
 void TModelGeneralizedLinear<T, K>::grad(const Array<K> &coeffs,
                                          Array<T> &out) {
+  TICK_TRACE_REGION("glm_grad");
   out.fill(0.0);
 
   parallel_map_array<Array<T>>(
@@ -88,6 +89,7 @@ void TModelGeneralizedLinear<T, K>::grad(const Array<K> &coeffs,
 
 template <class T, class K>
 T TModelGeneralizedLinear<T, K>::loss(const Array<K> &coeffs) {
+  TICK_TRACE_REGION("glm_loss");
   return parallel_map_additive_reduce(n_threads, n_samples,
                                       &TModelGeneralizedLinear<T, K>::loss_i,
                                       this, coeffs) /
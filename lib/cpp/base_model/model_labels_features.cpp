@@ -2,6 +2,8 @@
 
 #include "tick/base_model/model_labels_features.h"
 
+#include <algorithm>
+
 template <class T, class K>
 TModelLabelsFeatures<T, K>::TModelLabelsFeatures(
     const std::shared_ptr<BaseArray2d<T>> features,
@@ -41,6 +43,33 @@ void TModelLabelsFeatures<T, K>::compute_columns_sparsity() {
   }
 }
 
+// Only the beginning of a row is prefetched: once the first cache lines are
+// requested, hardware prefetchers follow the sequential read of the row
+static constexpr ulong N_PREFETCHED_CACHE_LINES = 8;
+static constexpr ulong CACHE_LINE_SIZE = 64;
+
+template <class T, class K>
+void TModelLabelsFeatures<T, K>::prefetch_features(ulong i) const {
+  const BaseArray<T> features_i = view_row(*features, i);
+  const ulong n_bytes =
+      std::min(features_i.size_data() * sizeof(T),
+               N_PREFETCHED_CACHE_LINES * CACHE_LINE_SIZE);
+  const char *data = reinterpret_cast<const char *>(features_i.data());
+  for (ulong offset = 0; offset < n_bytes; offset += CACHE_LINE_SIZE) {
+    TICK_PREFETCH(data + offset);
+  }
+  if (features_i.is_sparse()) {
+    const char *indices = reinterpret_cast<const char *>(features_i.indices());
+    const ulong n_index_bytes =
+        std::min(features_i.size_sparse() * sizeof(INDICE_TYPE),
+                 N_PREFETCHED_CACHE_LINES * CACHE_LINE_SIZE);
+    for (ulong offset = 0; offset < n_index_bytes;
+         offset += CACHE_LINE_SIZE) {
+      TICK_PREFETCH(indices + offset);
+    }
+  }
+}
+
 template class TModelLabelsFeatures<double, double>;
 template class TModelLabelsFeatures<float, float>;
 
@@ -0,0 +1,264 @@
+// License: BSD 3 clause
+
+#include "tick/hawkes/inference/hawkes_accelerated_em.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+double distance(const ArrayDouble &x, const ArrayDouble &y) {
+  double diff_sq = 0;
+  for (ulong k = 0; k < x.size(); ++k) {
+    const double diff = x[k] - y[k];
+    diff_sq += diff * diff;
+  }
+  return std::sqrt(diff_sq);
+}
+
+// Relative distance between two iterates, consistent with
+// tick.solver.base.utils.relative_distance
+double relative_distance(const ArrayDouble &new_x, const ArrayDouble &old_x) {
+  double norm_old = std::sqrt(old_x.norm_sq());
+  if (norm_old == 0) norm_old = 1.;
+  return distance(new_x, old_x) / norm_old;
+}
+
+bool all_finite(const ArrayDouble &x) {
+  for (ulong k = 0; k < x.size(); ++k) {
+    if (!std::isfinite(x[k])) return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+HawkesAcceleratedEM::HawkesAcceleratedEM(const ulong max_iter,
+                                         const double tol)
+    : step_factor(4.), n_iter(0), n_solve_calls(0), n_rejected(0),
+      rel_change(0) {
+  set_max_iter(max_iter);
+  set_tol(tol);
+}
+
+ulong HawkesAcceleratedEM::run(ArrayDouble &x, FixedPointStep step,
+                               Objective objective) {
+  const ulong n_params = x.size();
+  const bool use_objective = static_cast<bool>(objective);
+
+  ArrayDouble x_prev(n_params), x1(n_params), x2(n_params), r(n_params),
+      v(n_params), x_extrapolated(n_params), x_new(n_params);
+
+  // Maximum (absolute) step length, adapted along iterations
+  double step_max = 1.;
+
+  // Objective value of the current iterate, computed lazily
+  double objective_x = 0;
+  bool objective_x_computed = false;
+
+  n_iter = 0;
+  n_solve_calls = 0;
+  n_rejected = 0;
+  rel_change = 0;
+
+  for (ulong iter = 0; iter < max_iter; ++iter) {
+    x_prev.mult_fill(x, 1.);
+
+    // Two plain steps of the fixed point map
+    x1.mult_fill(x, 1.);
+    step(x1);
+    x2.mult_fill(x1, 1.);
+    step(x2);
+    n_solve_calls += 2;
+
+    // r = x1 - x and v = (x2 - x1) - r
+    r.mult_fill(x1, 1.);
+    r.mult_incr(x, -1.);
+    v.mult_fill(x2, 1.);
+    v.mult_incr(x1, -1.);
+    v.mult_incr(r, -1.);
+
+    const double r_norm_sq = r.norm_sq();
+    const double v_norm_sq = v.norm_sq();
+
+    // S3 step length, alpha = -1 corresponds to the plain two steps x2
+    double alpha = -1.;
+    if (v_norm_sq > 0) alpha = -std::sqrt(r_norm_sq / v_norm_sq);
+    alpha = std::min(-1., std::max(alpha, -step_max));
+
+    // x' = x - 2 alpha r + alpha^2 v must remain non negative. Since EM
+    // updates are multiplicative, parameters projected on zero would never
+    // move again, hence the step length is backtracked toward -1 instead
+    bool feasible = false;
+    while (alpha < -1. && !feasible) {
+      x_extrapolated.mult_fill(x, 1.);
+      x_extrapolated.mult_incr(r, -2. * alpha);
+      x_extrapolated.mult_incr(v, alpha * alpha);
+      feasible = x_extrapolated.min() >= 0;
+      if (!feasible) {
+        alpha = (alpha - 1.) / 2.;
+        if (alpha > -1. - 1e-2) alpha = -1.;
+      }
+    }
+
+    bool accepted = false;
+    if (alpha < -1.) {
+      // Stabilization step
+      x_new.mult_fill(x_extrapolated, 1.);
+      step(x_new);
+      ++n_solve_calls;
+
+      accepted = all_finite(x_new);
+      if (accepted && use_objective) {
+        // The extrapolated iterate is kept only if it does not decrease the
+        // objective
+        if (!objective_x_computed) {
+          objective_x = objective(x);
+          objective_x_computed = true;
+        }
+        const double objective_new = objective(x_new);
+        accepted = std::isfinite(objective_new) && objective_new >= objective_x;
+        if (accepted) objective_x = objective_new;
+      } else if (accepted) {
+        // Without objective, the fixed point residual of the extrapolated
+        // point must not be larger than the one of the current iterate
+        accepted = distance(x_new, x_extrapolated) <= std::sqrt(r_norm_sq);
+      }
+    }
+
+    if (accepted) {
+      x.mult_fill(x_new, 1.);
+    } else {
+      x.mult_fill(x2, 1.);
+      objective_x_computed = false;
+    }
+
+    // The maximum step length grows when it has been reached (including the
+    // plain step alpha = -1) and shrinks after a rejected extrapolation
+    if (alpha < -1. && !accepted) {
+      ++n_rejected;
+      step_max = std::max(1., step_max / step_factor);
+    } else if (alpha == -step_max) {
+      step_max *= step_factor;
+    }
+
+    n_iter = iter + 1;
+    rel_change = relative_distance(x, x_prev);
+    if (rel_change <= tol) break;
+  }
+
+  return n_iter;
+}
+
+ulong HawkesAcceleratedEM::solve(HawkesEM &learner, ArrayDouble &mu,
+                                 ArrayDouble2d &kernels) {
+  const ulong n_mu = mu.size();
+  const ulong n_kernels = kernels.size();
+
+  ArrayDouble x(n_mu + n_kernels);
+  ArrayDouble x_mu(n_mu, x.data());
+  ArrayDouble2d x_kernels(kernels.n_rows(), kernels.n_cols(),
+                          x.data() + n_mu);
+  x_mu.mult_fill(mu, 1.);
+  x_kernels.mult_fill(kernels, 1.);
+
+  auto step = [&learner, n_mu, &kernels](ArrayDouble &params) {
+    ArrayDouble params_mu(n_mu, params.data());
+    ArrayDouble2d params_kernels(kernels.n_rows(), kernels.n_cols(),
+                                 params.data() + n_mu);
+    learner.solve(params_mu, params_kernels);
+  };
+  auto objective = [&learner, n_mu, &kernels](ArrayDouble &params) {
+    ArrayDouble params_mu(n_mu, params.data());
+    ArrayDouble2d params_kernels(kernels.n_rows(), kernels.n_cols(),
+                                 params.data() + n_mu);
+    return learner.loglikelihood(params_mu, params_kernels);
+  };
+
+  run(x, step, objective);
+
+  mu.mult_fill(x_mu, 1.);
+  kernels.mult_fill(x_kernels, 1.);
+  return n_iter;
+}
+
+ulong HawkesAcceleratedEM::solve(HawkesBasisKernels &learner, ArrayDouble &mu,
+                                 ArrayDouble2d &gdm, ArrayDouble2d &auvd,
+                                 ulong max_iter_gdm, double max_tol_gdm) {
+  const ulong n_mu = mu.size();
+  const ulong n_gdm = gdm.size();
+  const ulong n_auvd = auvd.size();
+
+  ArrayDouble x(n_mu + n_gdm + n_auvd);
+  ArrayDouble x_mu(n_mu, x.data());
+  ArrayDouble2d x_gdm(gdm.n_rows(), gdm.n_cols(), x.data() + n_mu);
+  ArrayDouble2d x_auvd(auvd.n_rows(), auvd.n_cols(), x.data() + n_mu + n_gdm);
+  x_mu.mult_fill(mu, 1.);
+  x_gdm.mult_fill(gdm, 1.);
+  x_auvd.mult_fill(auvd, 1.);
+
+  auto step = [&learner, n_mu, n_gdm, &gdm, &auvd, max_iter_gdm,
+               max_tol_gdm](ArrayDouble &params) {
+    ArrayDouble params_mu(n_mu, params.data());
+    ArrayDouble2d params_gdm(gdm.n_rows(), gdm.n_cols(), params.data() + n_mu);
+    ArrayDouble2d params_auvd(auvd.n_rows(), auvd.n_cols(),
+                              params.data() + n_mu + n_gdm);
+    learner.solve(params_mu, params_gdm, params_auvd, max_iter_gdm,
+                  max_tol_gdm);
+  };
+
+  run(x, step);
+
+  mu.mult_fill(x_mu, 1.);
+  gdm.mult_fill(x_gdm, 1.);
+  auvd.mult_fill(x_auvd, 1.);
+  return n_iter;
+}
+
+ulong HawkesAcceleratedEM::solve(HawkesSumGaussians &learner, ArrayDouble &mu,
+                                 ArrayDouble2d &amplitudes) {
+  const ulong n_mu = mu.size();
+  const ulong n_amplitudes = amplitudes.size();
+
+  ArrayDouble x(n_mu + n_amplitudes);
+  ArrayDouble x_mu(n_mu, x.data());
+  ArrayDouble2d x_amplitudes(amplitudes.n_rows(), amplitudes.n_cols(),
+                             x.data() + n_mu);
+  x_mu.mult_fill(mu, 1.);
+  x_amplitudes.mult_fill(amplitudes, 1.);
+
+  auto step = [&learner, n_mu, &amplitudes](ArrayDouble &params) {
+    ArrayDouble params_mu(n_mu, params.data());
+    ArrayDouble2d params_amplitudes(amplitudes.n_rows(), amplitudes.n_cols(),
+                                    params.data() + n_mu);
+    learner.solve(params_mu, params_amplitudes);
+  };
+
+  run(x, step);
+
+  mu.mult_fill(x_mu, 1.);
+  amplitudes.mult_fill(x_amplitudes, 1.);
+  return n_iter;
+}
+
+void HawkesAcceleratedEM::set_max_iter(const ulong max_iter) {
+  if (max_iter == 0) {
+    TICK_ERROR("max_iter must be positive");
+  }
+  this->max_iter = max_iter;
+}
+
+void HawkesAcceleratedEM::set_tol(const double tol) {
+  if (tol < 0) {
+    TICK_ERROR("tol must be non negative and you have provided " << tol);
+  }
+  this->tol = tol;
+}
+
+void HawkesAcceleratedEM::set_step_factor(const double step_factor) {
+  if (step_factor <= 1) {
+    TICK_ERROR("step_factor must be greater than 1 and you have provided "
+               << step_factor);
+  }
+  this->step_factor = step_factor;
+}
@@ -6,7 +6,7 @@
 HawkesADM4::HawkesADM4(const double decay, const double rho,
                        const int max_n_threads,
                        const unsigned int optimization_level)
-    : ModelHawkesList(max_n_threads, optimization_level) {
+    : ModelHawkesList(max_n_threads, optimization_level), store_weights(true) {
   set_decay(decay);
   set_rho(rho);
 }
@@ -18,12 +18,17 @@ void HawkesADM4::compute_weights() {
   unnormalized_next_C = ArrayDouble2d(n_realizations * n_nodes, n_nodes);
 
   kernel_integral = ArrayDouble(n_nodes);
-  g = ArrayDouble2dList2D(n_realizations);
-  for (ulong r = 0; r < n_realizations; ++r) {
-    g[r] = ArrayDouble2dList1D(n_nodes);
-    for (ulong u = 0; u < n_nodes; ++u) {
-      g[r][u] = ArrayDouble2d(timestamps_list[r][u]->size(), n_nodes);
+  if (store_weights) {
+    g = ArrayDouble2dList2D(n_realizations);
+    for (ulong r = 0; r < n_realizations; ++r) {
+      g[r] = ArrayDouble2dList1D(n_nodes);
+      for (ulong u = 0; u < n_nodes; ++u) {
+        g[r][u] = ArrayDouble2d(timestamps_list[r][u]->size(), n_nodes);
+      }
     }
+  } else {
+    // Release weights that might have been computed previously
+    g = ArrayDouble2dList2D();
   }
 
   // Compute weights
@@ -51,11 +56,18 @@ void HawkesADM4::compute_weights_ru(const ulong r_u,
   // Obtain realization and node index from r_u
   const ulong r = static_cast<const ulong>(r_u / n_nodes);
   const ulong u = r_u % n_nodes;
-  ArrayDouble2d g_ru = view(g[r][u]);
   const ArrayDouble timestamps_ru = view(*timestamps_list[r][u]);
   const double end_time_r = (*end_times)[r];
   ArrayDouble map_kernel_integral_r = view_row(map_kernel_integral, r);
 
+  for (ulong k = 0; k < timestamps_ru.size(); k++) {
+    map_kernel_integral_r[u] +=
+        (1. - cexp(-decay * (end_time_r - timestamps_ru[k])));
+  }
+
+  if (!store_weights) return;
+
+  ArrayDouble2d g_ru = view(g[r][u]);
   for (ulong v = 0; v < n_nodes; v++) {
     const ArrayDouble timestamps_rv = view(*timestamps_list[r][v]);
     ulong ij = 0;
@@ -66,22 +78,34 @@ void HawkesADM4::compute_weights_ru(const ulong r_u,
         const double ebt = cexp(-decay * (t_ru_k - timestamps_ru[k - 1]));
         g_ru[k * n_nodes + v] = g_ru[(k - 1) * n_nodes + v] * ebt;
       } else {
-        if (k < timestamps_ru.size()) g_ru[k * n_nodes + v] = 0;
+        g_ru[k * n_nodes + v] = 0;
       }
       while ((ij < timestamps_rv.size()) && (timestamps_rv[ij] < t_ru_k)) {
         const double ebt = cexp(-decay * (t_ru_k - timestamps_rv[ij]));
         g_ru[k * n_nodes + v] += decay * ebt;
         ij++;
       }
-
-      if (u == v) {
-        // We use this pass over the data to fill kernel_integral
-        map_kernel_integral_r[u] += (1. - cexp(-decay * (end_time_r - t_ru_k)));
-      }
     }
   }
 }
 
+ulong HawkesADM4::memory_usage() const {
+  return tick::array_bytes(kernel_integral) + tick::array_bytes(g) +
+         tick::array_bytes(next_C) + tick::array_bytes(unnormalized_next_C) +
+         tick::array_bytes(next_mu);
+}
+
+ulong HawkesADM4::memory_footprint() const {
+  if (n_nodes == 0) return 0;
+  // next_mu, next_C, unnormalized_next_C, kernel_integral and the kernel
+  // integral of each realization, reduced after computing the weights
+  ulong n_doubles = 2 * n_realizations * n_nodes +
+                    2 * n_realizations * n_nodes * n_nodes + n_nodes;
+  // g has a row per jump
+  if (store_weights) n_doubles += get_n_total_jumps() * n_nodes;
+  return n_doubles * sizeof(double);
+}
+
 // The main method for performing one iteration
 void HawkesADM4::solve(ArrayDouble &mu, ArrayDouble2d &adjacency,
                        ArrayDouble2d &z1, ArrayDouble2d &z2, ArrayDouble2d &u1,
@@ -115,8 +139,13 @@ void HawkesADM4::solve(ArrayDouble &mu, ArrayDouble2d &adjacency,
   next_C.init_to_zero();
   next_mu.init_to_zero();
 
-  parallel_run(get_n_threads(), n_nodes * n_realizations,
-               &HawkesADM4::estimate_ru, this, mu, adjacency);
+  if (store_weights) {
+    parallel_run(get_n_threads(), n_nodes * n_realizations,
+                 &HawkesADM4::estimate_ru, this, mu, adjacency);
+  } else {
+    parallel_run(get_n_threads(), n_nodes * n_realizations,
+                 &HawkesADM4::estimate_ru_streaming, this, mu, adjacency);
+  }
   parallel_run(
       std::min(get_n_threads(), static_cast<const unsigned int>(n_nodes)),
       n_nodes, &HawkesADM4::update_u, this, mu, adjacency, z1, z2, u1, u2);
@@ -144,24 +173,81 @@ void HawkesADM4::estimate_ru(const ulong r_u, ArrayDouble &mu,
   // We loop in reverse order to benefit from last_indices
   for (ulong i = realization[node_u]->size() - 1; i != static_cast<ulong>(-1);
        i--) {
-    // this array will store temporary values
-    unnormalized_next_C_ru.init_to_zero();
-    ArrayDouble g_ru_i = view_row(g_ru, i);
+    const ArrayDouble g_ru_i = view_row(g_ru, i);
+    estimate_ru_i(mu_u, adjacency_u, g_ru_i, next_mu_ur, next_C_ru,
+                  unnormalized_next_C_ru);
+  }
+}
+
+// Procedure called by HawkesADM4::solve when weights are not stored
+void HawkesADM4::estimate_ru_streaming(const ulong r_u, ArrayDouble &mu,
+                                       ArrayDouble2d &adjacency) {
+  // Obtain realization and node index from r_u
+  const ulong r = static_cast<const ulong>(r_u / n_nodes);
+  const ulong node_u = r_u % n_nodes;
+
+  // Fetch corresponding data
+  SArrayDoublePtrList1D &realization = timestamps_list[r];
+  const ArrayDouble timestamps_ru = view(*realization[node_u]);
+  ArrayDouble adjacency_u = view_row(adjacency, node_u);
+  double mu_u = mu[node_u];
+
+  // initialize next data
+  double &next_mu_ur = next_mu(r, node_u);
+  ArrayDouble next_C_ru = view_row(next_C, r * n_nodes + node_u);
+  ArrayDouble unnormalized_next_C_ru =
+      view_row(unnormalized_next_C, r * n_nodes + node_u);
 
-    // norm will be equal to mu_u + \sum_v \sum_(t_j < t_i) a_uv g(t_i - t_j)
-    double norm = mu_u;
+  // g_ru_i[v] = \sum_{t_j^v < t_i^u} g(t_i^u - t_j^v), updated recursively
+  // from one event of node u to the next one
+  ArrayDouble g_ru_i(n_nodes);
+  g_ru_i.init_to_zero();
+  ArrayULong last_indices(n_nodes);
+  last_indices.init_to_zero();
+
+  for (ulong i = 0; i < timestamps_ru.size(); i++) {
+    const double t_ru_i = timestamps_ru[i];
+    if (i > 0) {
+      const double ebt = cexp(-decay * (t_ru_i - timestamps_ru[i - 1]));
+      g_ru_i.mult_fill(g_ru_i, ebt);
+    }
 
     for (ulong node_v = 0; node_v < n_nodes; node_v++) {
-      const double sum_unnormalized_p_ij = adjacency_u[node_v] * g_ru_i[node_v];
-      unnormalized_next_C_ru[node_v] += sum_unnormalized_p_ij;
-      norm += sum_unnormalized_p_ij;
+      const ArrayDouble timestamps_rv = view(*realization[node_v]);
+      ulong &ij = last_indices[node_v];
+      while ((ij < timestamps_rv.size()) && (timestamps_rv[ij] < t_ru_i)) {
+        const double ebt = cexp(-decay * (t_ru_i - timestamps_rv[ij]));
+        g_ru_i[node_v] += decay * ebt;
+        ij++;
+      }
     }
 
-    next_mu_ur += mu_u / norm;
-    next_C_ru.mult_incr(unnormalized_next_C_ru, 1. / norm);
+    estimate_ru_i(mu_u, adjacency_u, g_ru_i, next_mu_ur, next_C_ru,
+                  unnormalized_next_C_ru);
   }
 }
 
+void HawkesADM4::estimate_ru_i(const double mu_u,
+                               const ArrayDouble &adjacency_u,
+                               const ArrayDouble &g_ru_i, double &next_mu_ur,
+                               ArrayDouble &next_C_ru,
+                               ArrayDouble &unnormalized_next_C_ru) {
+  // this array will store temporary values
+  unnormalized_next_C_ru.init_to_zero();
+
+  // norm will be equal to mu_u + \sum_v \sum_(t_j < t_i) a_uv g(t_i - t_j)
+  double norm = mu_u;
+
+  for (ulong node_v = 0; node_v < n_nodes; node_v++) {
+    const double sum_unnormalized_p_ij = adjacency_u[node_v] * g_ru_i[node_v];
+    unnormalized_next_C_ru[node_v] += sum_unnormalized_p_ij;
+    norm += sum_unnormalized_p_ij;
+  }
+
+  next_mu_ur += mu_u / norm;
+  next_C_ru.mult_incr(unnormalized_next_C_ru, 1. / norm);
+}
+
 // A method called in parallel by the method 'solve' (see below)
 void HawkesADM4::update_u(const ulong u, ArrayDouble &mu,
                           ArrayDouble2d &adjacency, ArrayDouble2d &z1,
@@ -221,3 +307,10 @@ void HawkesADM4::set_rho(double rho) {
   }
   this->rho = rho;
 }
+
+bool HawkesADM4::get_store_weights() const { return store_weights; }
+
+void HawkesADM4::set_store_weights(const bool store_weights) {
+  if (this->store_weights != store_weights) weights_computed = false;
+  this->store_weights = store_weights;
+}
@@ -4,21 +4,26 @@
 
 // Procedure called by HawkesBasisKernels::solve
 // Not commented, see LaTeX notes
+// Basis functions and their primitives are stored bin by bin: gmd and Gmd have
+// shape (M, D)
 void compute_r(ArrayDouble &u_realization, double T, double kernel_dt,
-               ArrayDouble2d &gdm, ArrayDouble2d &Gdm, ArrayDouble &rd) {
-  ulong D = gdm.n_rows();
-  ulong M = gdm.n_cols();
+               ArrayDouble2d &gmd, ArrayDouble2d &Gmd, ArrayDouble &rd) {
+  ulong M = gmd.n_rows();
+  ulong D = gmd.n_cols();
   for (ulong j = 0; j < u_realization.size(); j++) {
     ulong m0 =
         static_cast<ulong>(std::floor((T - u_realization[j]) / kernel_dt));
-    for (ulong d = 0; d < D; d++) {
-      if (m0 >= M) {
-        rd[d] += Gdm[d * M + M - 1];
-      } else if (m0 > 0) {
-        rd[d] += Gdm[d * M + m0 - 1] +
-                 (T - u_realization[j] - m0 * kernel_dt) * gdm[d * M + m0];
+    if (m0 >= M) {
+      const double *G_last = Gmd.data() + (M - 1) * D;
+      for (ulong d = 0; d < D; d++) rd[d] += G_last[d];
+    } else {
+      const double dt = T - u_realization[j] - m0 * kernel_dt;
+      const double *g_m0 = gmd.data() + m0 * D;
+      if (m0 > 0) {
+        const double *G_prev = Gmd.data() + (m0 - 1) * D;
+        for (ulong d = 0; d < D; d++) rd[d] += G_prev[d] + dt * g_m0[d];
       } else {
-        rd[d] += (T - u_realization[j] - m0 * kernel_dt) * gdm[d * M + m0];
+        for (ulong d = 0; d < D; d++) rd[d] += dt * g_m0[d];
       }
     }
   }
@@ -26,36 +31,41 @@ void compute_r(ArrayDouble &u_realization, double T, double kernel_dt,
 
 // Procedure called by HawkesBasisKernels::solve
 // Not commented, see LaTeX notes
+// gmd and Cmd have shape (M, D)
 void compute_C(ArrayDouble &u_realization, double T, double kernel_dt,
-               ArrayDouble2d &gdm, ArrayDouble &a_sum, ArrayDouble2d &Cdm) {
-  ulong D = gdm.n_rows();
-  ulong M = gdm.n_cols();
+               ArrayDouble2d &gmd, ArrayDouble &a_sum, ArrayDouble2d &Cmd) {
+  ulong M = gmd.n_rows();
+  ulong D = gmd.n_cols();
 
   ulong i = u_realization.size() - 1;
   for (ulong m = 0; m < M; m++) {
     while (i != static_cast<ulong>(-1) && u_realization[i] > T - m * kernel_dt)
       i--;
     if (i == static_cast<ulong>(-1)) break;
+    const double *g_m = gmd.data() + m * D;
+    double *C_m = Cmd.data() + m * D;
     for (ulong d = 0; d < D; d++) {
-      Cdm[d * M + m] += a_sum[d] * (i + 1) / gdm[d * M + m];
+      C_m[d] += a_sum[d] * (i + 1) / g_m[d];
     }
   }
 }
 
 // Procedure called by HawkesBasisKernels::solve
 // Not commented, see LaTeX notes
+// gmd, Dmd and Dmd_temp have shape (M, D). qvd_temp and Dmd_temp must be zero
+// when called, they are reset to zero after each jump of u so that only the
+// bins that have been used need to be visited
 double compute_mu_q_D(ulong u_index, SArrayDoublePtrList1D &realization,
-                      double T, double kernel_dt, ArrayDouble2d &gdm,
-                      ArrayDouble2d &avd, double mu, ArrayDouble2d &qvd,
-                      ArrayDouble2d &qvd_temp, ArrayDouble2d &Ddm,
-                      ArrayDouble2d &Ddm_temp) {
+                      double kernel_dt, ArrayDouble2d &gmd, ArrayDouble2d &avd,
+                      double mu, ArrayDouble2d &qvd, ArrayDouble2d &qvd_temp,
+                      ArrayDouble2d &Dmd, ArrayDouble2d &Dmd_temp,
+                      ArrayULong &v_indices) {
   ulong dim = qvd.n_rows();
-  ulong M = gdm.n_cols();
-  ulong D = gdm.n_rows();
+  ulong M = gmd.n_rows();
+  ulong D = gmd.n_cols();
 
   ArrayDouble &u = *realization[u_index];
 
-  ArrayULong v_indices(dim);
   for (ulong n = 0; n < dim; n++) {
     v_indices[n] = realization[n]->size();
   }
@@ -64,13 +74,13 @@ double compute_mu_q_D(ulong u_index, SArrayDoublePtrList1D &realization,
 
   for (ulong i = u.size() - 1; i != static_cast<ulong>(-1); i--) {
     double norm = 0;
-    qvd_temp.init_to_zero();
-    Ddm_temp.init_to_zero();
+    ulong m_min = M, m_max = 0;
 
     double t_i = u[i];
 
     for (ulong v_index = 0; v_index < dim; v_index++) {
       ArrayDouble &v = *realization[v_index];
+      if (v.size() == 0) continue;
 
       while (true) {
         if (v_indices[v_index] == 0) break;
@@ -82,36 +92,46 @@ double compute_mu_q_D(ulong u_index, SArrayDoublePtrList1D &realization,
 
       ulong j0 = v_indices[v_index];
 
-      ArrayDouble ad = view_row(avd, v_index);
-      ArrayDouble qd_temp = view_row(qvd_temp, v_index);
+      const double *ad = avd.data() + v_index * D;
+      double *qd_temp = qvd_temp.data() + v_index * D;
 
       for (ulong j = j0; j != static_cast<ulong>(-1); j--) {
         double t_j = v[j];
         if (u_index == v_index && i == j) {
           norm += mu;
         } else {
-          ulong m = static_cast<ulong>(std::floor((t_i - t_j) / kernel_dt));
+          // t_i >= t_j, truncation is the floor
+          ulong m = static_cast<ulong>((t_i - t_j) / kernel_dt);
           if (m >= M) break;
+          m_min = std::min(m, m_min);
+          m_max = std::max(m, m_max);
+          const double *g_m = gmd.data() + m * D;
+          double *D_temp_m = Dmd_temp.data() + m * D;
           for (ulong d = 0; d < D; d++) {
-            double val = ad[d] * gdm[d * M + m];
+            double val = ad[d] * g_m[d];
             qd_temp[d] += val;
-            Ddm_temp[d * M + m] += val;
-            norm += val;
+            D_temp_m[d] += val;
           }
         }
       }
     }
 
+    // The sum of all contributions is recovered from qvd_temp
+    for (ulong k = 0; k < dim * D; k++) norm += qvd_temp[k];
+
     mu_out += mu / norm;
-    for (ulong d = 0; d < D; d++) {
-      for (ulong m = 0; m < M; m++) {
-        Ddm[d * M + m] += Ddm_temp[d * M + m] / (norm * kernel_dt);
-      }
-      for (ulong v_index = 0; v_index < dim; v_index++) {
-        qvd[v_index * D + d] +=
-            avd[v_index * D + d] * qvd_temp[v_index * D + d] / norm;
+    for (ulong m = m_min; m <= m_max && m < M; m++) {
+      double *D_m = Dmd.data() + m * D;
+      double *D_temp_m = Dmd_temp.data() + m * D;
+      for (ulong d = 0; d < D; d++) {
+        D_m[d] += D_temp_m[d] / (norm * kernel_dt);
+        D_temp_m[d] = 0;
       }
     }
+    for (ulong k = 0; k < dim * D; k++) {
+      qvd[k] += avd[k] * qvd_temp[k] / norm;
+      qvd_temp[k] = 0;
+    }
   }
 
   return mu_out;
@@ -119,12 +139,23 @@ double compute_mu_q_D(ulong u_index, SArrayDoublePtrList1D &realization,
 
 // Procedure called by HawkesBasisKernels::solve
 // Not commented, see LaTeX notes
+// Each bin depends on the values of its neighbours updated in the same sweep,
+// hence only the coefficients independent of gdm are computed beforehand
 double compute_gdm(double alpha, double kernel_dx, ArrayDouble &gdm,
                    ArrayDouble &Cdm, ArrayDouble &Ddm, double tol,
                    ulong max_iter) {
   gdm.init_to_zero();
   ulong M = gdm.size();
 
+  const double dx2 = kernel_dx * kernel_dx;
+
+  // a and c coefficients of the quadratic equations, stored in place of Cdm
+  // and Ddm
+  for (ulong m = 0; m < M; m++) {
+    Cdm[m] = 4 * alpha / dx2 + Cdm[m];
+    Ddm[m] = -Ddm[m];
+  }
+
   double max_rel_error = 0;
 
   for (ulong n_iter = 0; n_iter < max_iter; ++n_iter) {
@@ -132,11 +163,11 @@ double compute_gdm(double alpha, double kernel_dx, ArrayDouble &gdm,
 
     for (ulong m = 0; m < M; m++) {
       const double mm = m == 0 ? 0 : gdm[m - 1];
-      const double pm = (m == gdm.size() - 1) ? 0 : gdm[m + 1];
+      const double pm = (m == M - 1) ? 0 : gdm[m + 1];
 
-      double a = 4 * alpha / (kernel_dx * kernel_dx) + Cdm[m];
-      double b = -2 * alpha * (pm + mm) / (kernel_dx * kernel_dx);
-      double c = -Ddm[m];
+      double a = Cdm[m];
+      double b = -2 * alpha * (pm + mm) / dx2;
+      double c = Ddm[m];
 
       double sol = (-b + sqrt(b * b - 4 * a * c)) / (2 * a);
       if (n_iter != 0) {
@@ -166,52 +197,141 @@ HawkesBasisKernels::HawkesBasisKernels(const double kernel_support,
 
 void HawkesBasisKernels::allocate_weights() {
   const ulong n_basis = get_n_basis();
+  const ulong n_threads = get_n_threads();
   rud = ArrayDouble2d(n_nodes, n_basis);
-  Dudm = ArrayDouble2d(n_nodes, n_basis * kernel_size);
-  Gdm = ArrayDouble2d(n_basis, kernel_size);
-  Dudm_temp = ArrayDouble2d(n_nodes, n_basis * kernel_size);
-  Cudm = ArrayDouble2d(n_nodes, n_basis * kernel_size);
-  a_sum_vd = ArrayDouble2d(n_nodes, n_basis);
-  quvd_temp = ArrayDouble2d(n_nodes, n_nodes * n_basis);
   quvd = ArrayDouble2d(n_nodes, n_nodes * n_basis);
+  a_sum_vd = ArrayDouble2d(n_nodes, n_basis);
+
+  gmd = ArrayDouble2d(kernel_size, n_basis);
+  Gmd = ArrayDouble2d(kernel_size, n_basis);
+
+  Cumd = ArrayDouble2d(n_threads, kernel_size * n_basis);
+  Dumd = ArrayDouble2d(n_threads, kernel_size * n_basis);
+  Dumd_temp = ArrayDouble2d(n_threads, kernel_size * n_basis);
+  Dumd_temp.init_to_zero();
+  quvd_temp = ArrayDouble2d(n_threads, n_nodes * n_basis);
+  quvd_temp.init_to_zero();
+  v_indices = ArrayULong2d(n_threads, n_nodes);
+
+  Cdm = ArrayDouble2d(n_basis, kernel_size);
+  Ddm = ArrayDouble2d(n_basis, kernel_size);
+  gdm_rel_errors = ArrayDouble(n_basis);
 
   weights_computed = true;
 }
 
-// A method called in parallel by the method 'solve' (see below)
-void HawkesBasisKernels::solve_u(ulong u, ArrayDouble &mu, ArrayDouble2d &gdm,
+void HawkesBasisKernels::solve_thread(ulong thread_index, ArrayDouble &mu,
+                                      ArrayDouble2d &auvd) {
+  ulong min_u{}, max_u{};
+  std::tie(min_u, max_u) =
+      tick::get_thread_indices(thread_index, Cumd.n_rows(), n_nodes);
+
+  for (ulong u = min_u; u < max_u; ++u) {
+    solve_u(u, thread_index, mu, auvd);
+  }
+}
+
+void HawkesBasisKernels::solve_u(ulong u, ulong thread_index, ArrayDouble &mu,
                                  ArrayDouble2d &auvd) {
   const ulong n_basis = get_n_basis();
 
   ArrayDouble rd = view_row(rud, u);
   double mu_out = 0;
-  ArrayDouble2d Cdm(n_basis, kernel_size, view_row(Cudm, u).data());
-  ArrayDouble2d Ddm(n_basis, kernel_size, view_row(Dudm, u).data());
-  ArrayDouble2d Ddm_temp(n_basis, kernel_size, view_row(Dudm_temp, u).data());
   ArrayDouble2d avd(n_nodes, n_basis, view_row(auvd, u).data());
   ArrayDouble2d qvd(n_nodes, n_basis, view_row(quvd, u).data());
-  ArrayDouble2d qvd_temp(n_nodes, n_basis, view_row(quvd_temp, u).data());
   ArrayDouble a_sum_v = view_row(a_sum_vd, u);
 
+  // next data is accumulated in the buffers of the current thread
+  ArrayDouble2d Cmd(kernel_size, n_basis, view_row(Cumd, thread_index).data());
+  ArrayDouble2d Dmd(kernel_size, n_basis, view_row(Dumd, thread_index).data());
+  ArrayDouble2d Dmd_temp(kernel_size, n_basis,
+                         view_row(Dumd_temp, thread_index).data());
+  ArrayDouble2d qvd_temp(n_nodes, n_basis,
+                         view_row(quvd_temp, thread_index).data());
+  ArrayULong v_indices_thread = view_row(v_indices, thread_index);
+
   for (ulong r = 0; r < n_realizations; r++) {
-    compute_r(*(timestamps_list[r][u]), (*end_times)[r], get_kernel_dt(), gdm,
-              Gdm, rd);
-    compute_C(*timestamps_list[r][u], (*end_times)[r], get_kernel_dt(), gdm,
-              a_sum_v, Cdm);
-    mu_out +=
-        compute_mu_q_D(u, timestamps_list[r], (*end_times)[r], get_kernel_dt(),
-                       gdm, avd, mu[u], qvd, qvd_temp, Ddm, Ddm_temp);
+    compute_r(*(timestamps_list[r][u]), (*end_times)[r], get_kernel_dt(), gmd,
+              Gmd, rd);
+    compute_C(*timestamps_list[r][u], (*end_times)[r], get_kernel_dt(), gmd,
+              a_sum_v, Cmd);
+    mu_out += compute_mu_q_D(u, timestamps_list[r], get_kernel_dt(), gmd, avd,
+                             mu[u], qvd, qvd_temp, Dmd, Dmd_temp,
+                             v_indices_thread);
   }
 
   mu_out /= end_times->sum();
   mu[u] = mu_out;
 }
 
+void HawkesBasisKernels::reduce_thread_buffers(const ulong i,
+                                               const ulong stride) {
+  const ulong thread_dst = 2 * stride * i;
+  const ulong thread_src = thread_dst + stride;
+  if (thread_src >= Cumd.n_rows()) return;
+
+  ArrayDouble Cmd_dst = view_row(Cumd, thread_dst);
+  Cmd_dst.mult_incr(view_row(Cumd, thread_src), 1.);
+  ArrayDouble Dmd_dst = view_row(Dumd, thread_dst);
+  Dmd_dst.mult_incr(view_row(Dumd, thread_src), 1.);
+}
+
+void HawkesBasisKernels::update_amplitudes_u(ulong u, ArrayDouble2d &auvd) {
+  const ulong n_basis = get_n_basis();
+  double *avd = auvd.data() + u * n_nodes * n_basis;
+  const double *qvd = quvd.data() + u * n_nodes * n_basis;
+  for (ulong vd = 0; vd < n_nodes * n_basis; vd++) {
+    avd[vd] = sqrt(qvd[vd] / (rud[vd] + 2 * alpha));
+  }
+}
+
+void HawkesBasisKernels::update_basis_d(ulong d, ArrayDouble2d &gdm,
+                                        ulong max_iter_gdm,
+                                        double max_tol_gdm) {
+  const ulong n_basis = get_n_basis();
+
+  // Gather the reduced coefficients of basis function d, stored bin by bin
+  ArrayDouble Cm = view_row(Cdm, d);
+  ArrayDouble Dm = view_row(Ddm, d);
+  for (ulong m = 0; m < kernel_size; m++) {
+    Cm[m] = Cumd[m * n_basis + d];
+    Dm[m] = Dumd[m * n_basis + d];
+  }
+
+  ArrayDouble gm = view_row(gdm, d);
+  gdm_rel_errors[d] = compute_gdm(alpha, get_kernel_dt(), gm, Cm, Dm,
+                                  max_tol_gdm, max_iter_gdm);
+}
+
+ulong HawkesBasisKernels::memory_usage() const {
+  return tick::array_bytes(rud) + tick::array_bytes(quvd) +
+         tick::array_bytes(a_sum_vd) + tick::array_bytes(gmd) +
+         tick::array_bytes(Gmd) + tick::array_bytes(Cumd) +
+         tick::array_bytes(Dumd) + tick::array_bytes(Dumd_temp) +
+         tick::array_bytes(quvd_temp) + tick::array_bytes(v_indices) +
+         tick::array_bytes(Cdm) + tick::array_bytes(Ddm) +
+         tick::array_bytes(gdm_rel_errors);
+}
+
+ulong HawkesBasisKernels::memory_footprint() const {
+  const ulong n_basis = get_n_basis();
+  const ulong n_threads = get_n_threads();
+  // Buffers of allocate_weights: per node, per kernel discretization point
+  // and per thread
+  const ulong n_doubles = n_nodes * n_basis * (n_nodes + 2) +
+                          kernel_size * n_basis * 4 + n_basis +
+                          n_threads * (3 * kernel_size + n_nodes) * n_basis;
+  return n_doubles * sizeof(double) + n_threads * n_nodes * sizeof(ulong);
+}
+
 // The main method for performing one iteration
 double HawkesBasisKernels::solve(ArrayDouble &mu, ArrayDouble2d &gdm,
                                  ArrayDouble2d &auvd, ulong max_iter_gdm,
                                  double max_tol_gdm) {
-  if (!weights_computed) allocate_weights();
+  // Buffers are allocated per thread, hence the number of threads must not
+  // have changed since the last allocation
+  if (!weights_computed || Cumd.n_rows() != get_n_threads())
+    allocate_weights();
 
   if (mu.size() != n_nodes) {
     TICK_ERROR("baseline / mu argument must be an array of size " << n_nodes);
@@ -226,69 +346,56 @@ double HawkesBasisKernels::solve(ArrayDouble &mu, ArrayDouble2d &gdm,
   }
 
   const ulong n_basis = get_n_basis();
-
-  for (ulong d = 0; d < n_basis; d++) {
-    Gdm[d * kernel_size] = gdm[d * kernel_size] * get_kernel_dt();
-    for (ulong m = 1; m < kernel_size; m++)
-      Gdm[d * kernel_size + m] = Gdm[d * kernel_size + m - 1] +
-                                 gdm[d * kernel_size + m] * get_kernel_dt();
-  }
-
-  a_sum_vd.init_to_zero();
-  for (ulong v = 0; v < n_nodes; v++) {
+  const ulong n_threads = Cumd.n_rows();
+
+  // Basis functions and their primitives, stored bin by bin
+  for (ulong d = 0; d < n_basis; d++) gmd[d] = gdm[d * kernel_size];
+  for (ulong d = 0; d < n_basis; d++) Gmd[d] = gmd[d] * get_kernel_dt();
+  for (ulong m = 1; m < kernel_size; m++) {
+    double *g_m = gmd.data() + m * n_basis;
+    double *G_m = Gmd.data() + m * n_basis;
+    const double *G_prev = Gmd.data() + (m - 1) * n_basis;
     for (ulong d = 0; d < n_basis; d++) {
-      for (ulong u = 0; u < n_nodes; u++) {
-        a_sum_vd[v * n_basis + d] +=
-            auvd[u * n_nodes * n_basis + v * n_basis + d];
-      }
+      g_m[d] = gdm[d * kernel_size + m];
+      G_m[d] = G_prev[d] + g_m[d] * get_kernel_dt();
     }
   }
 
+  // a_sum_vd is the sum of the rows of auvd
+  ArrayDouble a_sum_vd_flat(n_nodes * n_basis, a_sum_vd.data());
+  a_sum_vd_flat.init_to_zero();
+  for (ulong u = 0; u < n_nodes; u++) {
+    a_sum_vd_flat.mult_incr(view_row(auvd, u), 1.);
+  }
+
   rud.init_to_zero();
   quvd.init_to_zero();
-  Dudm.init_to_zero();
-  Cudm.init_to_zero();
-
-  // Parallel loop on u to run compute_r, compute_C, Scompute_mu_q_D
-  parallel_run(get_n_threads(), n_nodes, &HawkesBasisKernels::solve_u, this, mu,
-               gdm, auvd);
-
-  // Then we reduce the computations of Cudm and Dudm
-  // We store in component u=0 the sum_u=0^n_nodes Cudm (same for Dudm)
-  for (ulong u = 1; u < n_nodes; u++) {
-    for (ulong d = 0; d < n_basis; d++) {
-      for (ulong m = 0; m < kernel_size; m++) {
-        Cudm[d * kernel_size + m] +=
-            Cudm[u * n_basis * kernel_size + d * kernel_size + m];
-        Dudm[d * kernel_size + m] +=
-            Dudm[u * n_basis * kernel_size + d * kernel_size + m];
-      }
-    }
+  Dumd.init_to_zero();
+  Cumd.init_to_zero();
+
+  // Map
+  // Each thread runs compute_r, compute_C, compute_mu_q_D on its nodes and
+  // fills its own rows of Cumd and Dumd
+  parallel_run(n_threads, n_threads, &HawkesBasisKernels::solve_thread, this,
+               mu, auvd);
+
+  // Reduce
+  // Thread buffers are summed two by two until they all have been added to the
+  // buffers of the first thread
+  for (ulong stride = 1; stride < n_threads; stride *= 2) {
+    const ulong n_pairs = (n_threads + 2 * stride - 1) / (2 * stride);
+    parallel_run(n_threads, n_pairs, &HawkesBasisKernels::reduce_thread_buffers,
+                 this, stride);
   }
 
-  for (ulong u = 0; u < n_nodes; u++) {
-    for (ulong v = 0; v < n_nodes; v++) {
-      for (ulong d = 0; d < n_basis; d++) {
-        auvd[u * n_nodes * n_basis + v * n_basis + d] =
-            sqrt(quvd[u * n_nodes * n_basis + v * n_basis + d] /
-                 (rud[v * n_basis + d] + 2 * alpha));
-      }
-    }
-  }
+  parallel_run(n_threads, n_nodes, &HawkesBasisKernels::update_amplitudes_u,
+               this, auvd);
 
-  double rerr_gdm = 0;
-  for (ulong d = 0; d < n_basis; d++) {
-    ArrayDouble gm = view_row(gdm, d);
-    ArrayDouble2d Cdm(n_basis, kernel_size, view_row(Cudm, 0).data());
-    ArrayDouble2d Ddm(n_basis, kernel_size, view_row(Dudm, 0).data());
-    ArrayDouble Cm = view_row(Cdm, d);
-    ArrayDouble Dm = view_row(Ddm, d);
-    double rerr = compute_gdm(alpha, get_kernel_dt(), gm, Cm, Dm, max_tol_gdm,
-                              max_iter_gdm);
-    rerr_gdm = std::max(rerr, rerr_gdm);
-  }
+  parallel_run(std::min(n_threads, n_basis), n_basis,
+               &HawkesBasisKernels::update_basis_d, this, gdm, max_iter_gdm,
+               max_tol_gdm);
 
-  return rerr_gdm;
+  return std::max(gdm_rel_errors.max(), 0.);
 }
 
 unsigned int HawkesBasisKernels::get_n_threads() const {
@@ -1,13 +1,10 @@
 // License: BSD 3 clause
 
-#ifdef PYTHON_LINK
-#include <Python.h>
-#else
-#define Py_BEGIN_ALLOW_THREADS
-#define Py_END_ALLOW_THREADS
-#endif
+#include <algorithm>
+#include <thread>
+#include <vector>
 
-#include "tick/array/array.h"
+#include "tick/hawkes/inference/hawkes_conditional_law.h"
 
 // The non parametric estimation is based on the following quantities :
 //
@@ -63,10 +60,8 @@ void PointProcessCondLaw(ArrayDouble &y_time, ArrayDouble &z_time,
 
   ulong n_terms = 0;
 
-  Py_BEGIN_ALLOW_THREADS
-
-      // Inititialization of the resulting array
-      res_Y.fill(0);
+  // Inititialization of the resulting array
+  res_Y.fill(0);
 
   double lagMax = lags[N];
 
@@ -136,8 +131,6 @@ void PointProcessCondLaw(ArrayDouble &y_time, ArrayDouble &z_time,
     res_Y[k] -= y_lambda;
     res_X[k] = (lags[k + 1] + lags[k]) / 2.0;
   }
-
-  Py_END_ALLOW_THREADS
 }
 
 //
@@ -151,10 +144,8 @@ double PointProcessCondLawSingle(ArrayDouble &y_time, ArrayDouble &y_mark,
                                  ArrayDouble &z_time, ArrayDouble &z_mark,
                                  double delta, double zmin, double zmax) {
   double res = 0;
-  Py_BEGIN_ALLOW_THREADS
-
-      const double lambda =
-          y_time.size() / (y_time[y_time.size() - 1] - y_time[0]);
+  const double lambda =
+      y_time.size() / (y_time[y_time.size() - 1] - y_time[0]);
 
   // The loop on the jumps of Z
   std::int64_t count = 0;
@@ -201,7 +192,587 @@ double PointProcessCondLawSingle(ArrayDouble &y_time, ArrayDouble &y_mark,
 
   res /= count;
 
-  Py_END_ALLOW_THREADS
+  return res;
+}
+
+namespace {
+
+unsigned int effective_n_threads(int n_threads, ulong n_tasks) {
+  const unsigned int max_n_threads =
+      n_threads >= 1 ? static_cast<unsigned int>(n_threads)
+                     : std::thread::hardware_concurrency();
+  return static_cast<unsigned int>(
+      std::min(static_cast<ulong>(max_n_threads), n_tasks));
+}
+
+// Computes the conditional laws of PointProcessCondLaw for all the (i, j, l)
+// triplets. The jumps of Z = times[j] are visited once for all the mark
+// intervals l of j, the per lag cursors on Y = times[i] being shared.
+class PointProcessCondLawComputer {
+  const SArrayDoublePtrList1D &times;
+  const SArrayDoublePtrList1D &marks;
+  const SArrayDoublePtrList1D &mark_intervals;
+  ArrayDouble &lags;
+  const double T;
+  ArrayDouble2d &res_Y;
+
+  ulong n_nodes, n_lags;
+
+  //! @brief Row of res_Y of (i, j, 0) is i * n_index_i + first_index_j[j]
+  ulong n_index_i;
+  std::vector<ulong> first_index_j;
+
+ public:
+  PointProcessCondLawComputer(const SArrayDoublePtrList1D &times,
+                              const SArrayDoublePtrList1D &marks,
+                              const SArrayDoublePtrList1D &mark_intervals,
+                              ArrayDouble &lags, double T,
+                              ArrayDouble2d &res_Y)
+      : times(times),
+        marks(marks),
+        mark_intervals(mark_intervals),
+        lags(lags),
+        T(T),
+        res_Y(res_Y) {
+    n_nodes = times.size();
+    n_lags = lags.size() - 1;
+    first_index_j.resize(n_nodes);
+    n_index_i = 0;
+    for (ulong j = 0; j < n_nodes; ++j) {
+      first_index_j[j] = n_index_i;
+      n_index_i += mark_intervals[j]->size() / 2;
+    }
+  }
+
+  ulong get_n_index() const { return n_nodes * n_index_i; }
+
+  void compute_ij(const ulong ij);
+};
+
+void PointProcessCondLawComputer::compute_ij(const ulong ij) {
+  const ulong i = ij / n_nodes;
+  const ulong j = ij % n_nodes;
+
+  ArrayDouble &y_time = *times[i];
+  ArrayDouble &z_time = *times[j];
+  ArrayDouble &z_mark = *marks[j];
+  ArrayDouble &intervals = *mark_intervals[j];
+  const ulong n_intervals = intervals.size() / 2;
+  const ulong first_row = i * n_index_i + first_index_j[j];
+
+  ArrayDouble2d res_ij(n_intervals, n_lags,
+                       res_Y.data() + first_row * n_lags);
+  res_ij.init_to_zero();
+
+  ArrayULong n_terms(n_intervals);
+  n_terms.init_to_zero();
+
+  // Eligible mark intervals of the current jump of Z and the increments of Y
+  // in each lag slice after this jump
+  std::vector<ulong> eligible_intervals;
+  eligible_intervals.reserve(n_intervals);
+  std::vector<double> increments(n_lags);
+
+  // Mark intervals for which PointProcessCondLaw would have left the loop on
+  // the jumps of Z. Each one stops on its own eligible jumps, the loop ends
+  // once they all have
+  std::vector<bool> done(n_intervals, false);
+  ulong n_done = 0;
+  const auto set_done = [&]() {
+    for (ulong l : eligible_intervals) done[l] = true;
+    n_done += eligible_intervals.size();
+  };
+
+  // To improve performance by remembering the last point of Y in each time
+  // slice
+  std::vector<ulong> tab_y_index(n_lags, 0);
+
+  // Raw accesses in the inner loops, so that sizes and data pointers are not
+  // reloaded after each store
+  const double *y = y_time.data();
+  const ulong y_size = y_time.size();
+  const double *lag = lags.data();
+  const double lagMax = lag[n_lags];
+
+  // The loop on the jumps of Z
+  ulong y_index = 0;
+  for (ulong z_index = 0; z_index < z_mark.size(); z_index++) {
+    // Is it an eligible jump, and for which mark intervals ?
+    eligible_intervals.clear();
+    for (ulong l = 0; l < n_intervals; ++l) {
+      if (done[l]) continue;
+      const double zmin = intervals[2 * l];
+      const double zmax = intervals[2 * l + 1];
+      if (zmin < zmax && z_index > 0 &&
+          (zmin > z_mark[z_index] - z_mark[z_index - 1] ||
+           z_mark[z_index] - z_mark[z_index - 1] > zmax))
+        continue;
+      eligible_intervals.push_back(l);
+    }
+    if (eligible_intervals.empty()) continue;
+
+    // Brings y_index after z_t
+    // After this block, one has
+    // time(Y[y_index]) >= z_t
+    double z_t = z_time[z_index];
+    if (z_t + lagMax >= T) {
+      set_done();
+      if (n_done == n_intervals) break;
+      continue;
+    }
+    for (ulong l : eligible_intervals) n_terms[l] += 1;
+    while (y_index < y_size && y[y_index] < z_t) y_index++;
+    if (y_index >= y_size) {
+      set_done();
+      if (n_done == n_intervals) break;
+      continue;
+    }
+
+    ulong y_index_lag_delta = y_index;
+
+    // Loop on the lag
+    for (ulong k = 0; k < n_lags; k++) {
+      increments[k] = 0;
+      ulong y_index_lag = y_index_lag_delta;
+
+      while (y[y_index_lag] <= z_t + lag[k]) {
+        y_index_lag++;
+        if (y_index_lag >= y_size) break;
+      }
+      if (y_index_lag >= y_size) {
+        y_index_lag_delta = y_size - 1;
+        tab_y_index[k] = y_index_lag_delta;
+        continue;
+      }
+      double ytlag = (y_index_lag == 0 ? 0 : y_index_lag - 1);
+
+      y_index_lag_delta = std::max(y_index_lag, tab_y_index[k]);
+      while (y[y_index_lag_delta] <= z_t + lag[k + 1]) {
+        y_index_lag_delta++;
+        if (y_index_lag_delta >= y_size) break;
+      }
+      if (y_index_lag_delta >= y_size) {
+        y_index_lag_delta = y_size - 1;
+        if (y_index_lag == y_size - 1) {
+          tab_y_index[k] = y_index_lag_delta;
+          continue;
+        }
+      }
+      tab_y_index[k] = y_index_lag_delta;
+      double ytlagdelta = (y_index_lag_delta == 0 ? 0 : y_index_lag_delta - 1);
+      increments[k] = ytlagdelta - ytlag;
+    }
+
+    for (ulong l : eligible_intervals) {
+      double *res_ijl = res_ij.data() + l * n_lags;
+      for (ulong k = 0; k < n_lags; k++) res_ijl[k] += increments[k];
+    }
+  }
+
+  const double y_lambda = y_time.size() / T;
+  for (ulong l = 0; l < n_intervals; ++l) {
+    for (ulong k = 0; k < n_lags; k++) {
+      if (n_terms[l] != 0) {
+        res_ij(l, k) /= n_terms[l];
+      }
+      res_ij(l, k) /= (lags[k + 1] - lags[k]);
+      res_ij(l, k) -= y_lambda;
+    }
+  }
+}
+
+}  // namespace
+
+void PointProcessCondLawBatch(const SArrayDoublePtrList1D &times,
+                              const SArrayDoublePtrList1D &marks,
+                              const SArrayDoublePtrList1D &mark_intervals,
+                              ArrayDouble &lags, double T, ArrayDouble &res_X,
+                              ArrayDouble2d &res_Y, int n_threads) {
+  const ulong n_nodes = times.size();
+  if (marks.size() != n_nodes || mark_intervals.size() != n_nodes) {
+    TICK_ERROR("times (size=" << n_nodes << "), marks (size=" << marks.size()
+                              << ") and mark_intervals (size="
+                              << mark_intervals.size()
+                              << ") should have the same size");
+  }
+  for (ulong j = 0; j < n_nodes; ++j) {
+    if (times[j]->size() != marks[j]->size()) {
+      TICK_ERROR("times[" << j << "] (size=" << times[j]->size()
+                          << ") and marks[" << j << "] (size="
+                          << marks[j]->size() << ") should have the same size");
+    }
+    if (mark_intervals[j]->size() == 0 || mark_intervals[j]->size() % 2 != 0) {
+      TICK_ERROR("mark_intervals[" << j << "] should contain pairs of bounds");
+    }
+  }
+
+  if (res_X.size() + 1 != lags.size()) {
+    TICK_ERROR("lags (size=" << lags.size()
+                             << ") should be of the size of res_X (size="
+                             << res_X.size() << " plus one");
+  }
+
+  PointProcessCondLawComputer computer(times, marks, mark_intervals, lags, T,
+                                       res_Y);
+  if (res_Y.n_rows() != computer.get_n_index() ||
+      res_Y.n_cols() != res_X.size()) {
+    TICK_ERROR("res_Y should be of shape (" << computer.get_n_index() << ", "
+                                            << res_X.size()
+                                            << ") but has shape ("
+                                            << res_Y.n_rows() << ", "
+                                            << res_Y.n_cols() << ")");
+  }
+
+  parallel_run(effective_n_threads(n_threads, n_nodes * n_nodes),
+               n_nodes * n_nodes, &PointProcessCondLawComputer::compute_ij,
+               &computer);
+
+  for (ulong k = 0; k < res_X.size(); k++) {
+    res_X[k] = (lags[k + 1] + lags[k]) / 2.0;
+  }
+}
+
+namespace {
+
+// Builds and solves, for each component i, the Fredholm system V = M PHI
+// approximated on the quadrature points
+class HawkesConditionalLawFredholmSolver {
+  ArrayULong &n_marks;
+  ArrayDouble &mark_probabilities;
+  ArrayDouble &mean_intensity;
+  ArrayDouble &quad_x;
+  ArrayDouble &quad_w;
+  const std::string &quad_method;
+  ArrayDouble2d &res_phi;
+
+  ulong n_nodes, n_quad;
+
+  //! @brief Index of (i, j, l) is i * n_index_i + first_index_j[j] + l
+  ulong n_index_i;
+  std::vector<ulong> first_index_j;
+
+  //! @brief Abscissa at which the claws are interpolated: quadrature
+  //! points, claw abscissa and non negative differences of quadrature
+  //! points
+  std::vector<double> xs;
+
+  //! @brief Claws linearly interpolated on xs (int_claw), their integrals
+  //! (IG) and the integrals of x times the claws (IG2) from 0 to xs
+  ArrayDouble2d int_claw, IG, IG2;
+
+ public:
+  HawkesConditionalLawFredholmSolver(
+      ArrayDouble &claw_X, ArrayDouble2d &claws, ArrayULong &n_marks,
+      ArrayDouble &mark_probabilities, ArrayDouble &mean_intensity,
+      ArrayDouble &quad_x, ArrayDouble &quad_w, const std::string &quad_method,
+      ArrayDouble2d &res_phi);
+
+  void solve_i(const ulong i);
+
+ private:
+  ulong index(ulong i, ulong j, ulong l) const {
+    return i * n_index_i + first_index_j[j] + l;
+  }
+
+  //! @brief Closest value of a signal sampled on xs, zero value border
+  double lin0(ArrayDouble2d &signal, ulong index, double t) const;
+
+  //! @brief Closest value of a signal sampled on xs, continuous border
+  double linc(ArrayDouble2d &signal, ulong index, double t) const;
+
+  //! @brief Value of the claw (i, j, l) at t
+  double G(ulong i, ulong j, ulong l, double t) {
+    return lin0(int_claw, index(i, j, l), t);
+  }
+
+  //! @brief Integral of the claw (i, j, l) between t1 and t2
+  double DIG(ulong i, ulong j, ulong l, double t1, double t2) {
+    const ulong index_ijl = index(i, j, l);
+    return linc(IG, index_ijl, t2) - linc(IG, index_ijl, t1);
+  }
+
+  //! @brief Integral of x times the claw (i, j, l) between t1 and t2
+  double DIG2(ulong i, ulong j, ulong l, double t1, double t2) {
+    const ulong index_ijl = index(i, j, l);
+    return linc(IG2, index_ijl, t2) - linc(IG2, index_ijl, t1);
+  }
+
+  double M_entry_gauss(ulong j, ulong l, ulong j1, ulong l1, double fact,
+                       ulong n, ulong n1);
+
+  double M_entry_log_lin(ulong j, ulong l, ulong j1, ulong l1, double fact,
+                         ulong n, ulong n1);
+};
+
+HawkesConditionalLawFredholmSolver::HawkesConditionalLawFredholmSolver(
+    ArrayDouble &claw_X, ArrayDouble2d &claws, ArrayULong &n_marks,
+    ArrayDouble &mark_probabilities, ArrayDouble &mean_intensity,
+    ArrayDouble &quad_x, ArrayDouble &quad_w, const std::string &quad_method,
+    ArrayDouble2d &res_phi)
+    : n_marks(n_marks),
+      mark_probabilities(mark_probabilities),
+      mean_intensity(mean_intensity),
+      quad_x(quad_x),
+      quad_w(quad_w),
+      quad_method(quad_method),
+      res_phi(res_phi) {
+  n_nodes = n_marks.size();
+  n_quad = quad_x.size();
+  first_index_j.resize(n_nodes);
+  n_index_i = 0;
+  for (ulong j = 0; j < n_nodes; ++j) {
+    first_index_j[j] = n_index_i;
+    n_index_i += n_marks[j];
+  }
+  const ulong n_index = n_nodes * n_index_i;
+
+  xs.reserve(n_quad + claw_X.size() + n_quad * n_quad);
+  for (ulong n = 0; n < n_quad; ++n) xs.push_back(quad_x[n]);
+  for (ulong k = 0; k < claw_X.size(); ++k) xs.push_back(claw_X[k]);
+  for (ulong n = 0; n < n_quad; ++n) {
+    for (ulong n1 = 0; n1 < n_quad; ++n1) {
+      xs.push_back(quad_x[n] - quad_x[n1]);
+    }
+  }
+  std::sort(xs.begin(), xs.end());
+  xs.erase(std::unique(xs.begin(), xs.end()), xs.end());
+  xs.erase(xs.begin(), std::lower_bound(xs.begin(), xs.end(), 0.));
+  const ulong n_xs = xs.size();
+
+  // Linear interpolation of the claws, points after the last claw abscissa
+  // being set to zero
+  int_claw = ArrayDouble2d(n_index, n_xs);
+  int_claw.init_to_zero();
+  for (ulong index = 0; index < n_index; ++index) {
+    ulong k = 0;
+    for (ulong m = 1; m < claw_X.size(); ++m) {
+      const double y_prev = claws(index, m - 1);
+      const double y_next = claws(index, m);
+      while (k < n_xs && xs[k] < claw_X[m]) {
+        int_claw(index, k) = y_prev + (y_next - y_prev) * (xs[k] - claw_X[m - 1]) /
+                                          (claw_X[m] - claw_X[m - 1]);
+        k++;
+      }
+    }
+  }
+
+  if (quad_method == "log" || quad_method == "lin") {
+    IG = ArrayDouble2d(n_index, n_xs);
+    IG2 = ArrayDouble2d(n_index, n_xs);
+    for (ulong index = 0; index < n_index; ++index) {
+      IG(index, 0) = 0;
+      IG2(index, 0) = 0;
+      for (ulong k = 1; k < n_xs; ++k) {
+        const double dx = xs[k] - xs[k - 1];
+        const double y_prev = int_claw(index, k - 1);
+        const double y_next = int_claw(index, k);
+        IG(index, k) = IG(index, k - 1) + dx * (y_prev + y_next) / 2.;
+        IG2(index, k) = IG2(index, k - 1) +
+                        ((y_prev + y_next) / 2. * dx * xs[k - 1] +
+                         dx * dx / 3. * (y_next - y_prev) +
+                         dx * dx / 2. * y_prev);
+      }
+    }
+  }
+}
+
+double HawkesConditionalLawFredholmSolver::lin0(ArrayDouble2d &signal,
+                                                ulong index, double t) const {
+  const ulong n_xs = xs.size();
+  if (t >= xs[n_xs - 1]) return 0;
+  const ulong k = std::lower_bound(xs.begin(), xs.end(), t) - xs.begin();
+  if (k == n_xs - 1) return signal(index, k);
+  if (std::abs(xs[k] - t) < std::abs(xs[k + 1] - t)) return signal(index, k);
+  return signal(index, k + 1);
+}
+
+double HawkesConditionalLawFredholmSolver::linc(ArrayDouble2d &signal,
+                                                ulong index, double t) const {
+  const ulong n_xs = xs.size();
+  if (t >= xs[n_xs - 1]) return signal(index, n_xs - 1);
+  const ulong k = std::lower_bound(xs.begin(), xs.end(), t) - xs.begin();
+  if (k == n_xs - 1) return signal(index, k);
+  if (std::abs(xs[k] - t) < std::abs(xs[k + 1] - t)) return signal(index, k);
+  return signal(index, k + 1);
+}
+
+double HawkesConditionalLawFredholmSolver::M_entry_gauss(
+    ulong j, ulong l, ulong j1, ulong l1, double fact, ulong n, ulong n1) {
+  const double p_w = mark_probabilities[first_index_j[j1] + l1] * quad_w[n1];
+  if (n > n1) {
+    return p_w * G(j1, j, l, quad_x[n] - quad_x[n1]);
+  } else if (n < n1) {
+    return fact * (p_w * G(j, j1, l1, quad_x[n1] - quad_x[n]));
+  } else if (quad_method == "gauss-") {
+    return 0;
+  } else {
+    const double x1 = p_w * G(j1, j, l, quad_x[n] - quad_x[n1]);
+    const double x2 = fact * (p_w * G(j, j1, l1, quad_x[n1] - quad_x[n]));
+    return (x1 + x2) / 2;
+  }
+}
+
+double HawkesConditionalLawFredholmSolver::M_entry_log_lin(
+    ulong j, ulong l, ulong j1, ulong l1, double fact, ulong n, ulong n1) {
+  const double p = mark_probabilities[first_index_j[j1] + l1];
+
+  auto ratio_dig = [this, n](ulong n_q) {
+    return (quad_x[n] - quad_x[n_q]) / quad_w[n_q];
+  };
+  auto ratio_dig2 = [this](ulong n_q) { return 1. / quad_w[n_q]; };
+
+  // Integrals of claw (j1, j, l) on [x_n - x_nq - w_nq, x_n - x_nq]
+  auto dig_greater = [this, j, l, j1, n](ulong n_q) {
+    return DIG(j1, j, l, quad_x[n] - quad_x[n_q] - quad_w[n_q],
+               quad_x[n] - quad_x[n_q]);
+  };
+  auto dig2_greater = [this, j, l, j1, n](ulong n_q) {
+    return DIG2(j1, j, l, quad_x[n] - quad_x[n_q] - quad_w[n_q],
+                quad_x[n] - quad_x[n_q]);
+  };
+  // Integrals of claw (j, j1, l1) on [x_nq - x_n, x_nq - x_n + w_nq]
+  auto dig_lower = [this, j, j1, l1, n](ulong n_q) {
+    return DIG(j, j1, l1, quad_x[n_q] - quad_x[n],
+               quad_x[n_q] - quad_x[n] + quad_w[n_q]);
+  };
+  auto dig2_lower = [this, j, j1, l1, n](ulong n_q) {
+    return DIG2(j, j1, l1, quad_x[n_q] - quad_x[n],
+                quad_x[n_q] - quad_x[n] + quad_w[n_q]);
+  };
+
+  double x = 0;
+  if (n > n1) {
+    x += p * dig_greater(n1);
+    if (n1 < n_quad - 1) {
+      x -= ratio_dig(n1) * p * dig_greater(n1);
+      x += ratio_dig2(n1) * p * dig2_greater(n1);
+    }
+    if (n1 > 0) {
+      x += ratio_dig(n1 - 1) * p * dig_greater(n1 - 1);
+      x -= ratio_dig2(n1 - 1) * p * dig2_greater(n1 - 1);
+    }
+  } else if (n < n1) {
+    x += fact * p * dig_lower(n1);
+    if (n1 < n_quad - 1) {
+      x -= fact * ratio_dig(n1) * p * dig_lower(n1);
+      x -= fact * ratio_dig2(n1) * p * dig2_lower(n1);
+    }
+    if (n1 > 0) {
+      x += fact * ratio_dig(n1 - 1) * p * dig_lower(n1 - 1);
+      x += fact * ratio_dig2(n1 - 1) * p * dig2_lower(n1 - 1);
+    }
+  } else {
+    x += fact * p * dig_lower(n1);
+    if (n1 < n_quad - 1) {
+      x -= fact * ratio_dig(n1) * p * dig_lower(n1);
+      x -= fact * ratio_dig2(n1) * p * dig2_lower(n1);
+    }
+    if (n1 > 0) {
+      x += ratio_dig(n1 - 1) * p * dig_greater(n1 - 1);
+      x -= ratio_dig2(n1 - 1) * p * dig2_greater(n1 - 1);
+    }
+  }
+  return x;
+}
+
+void HawkesConditionalLawFredholmSolver::solve_i(const ulong i) {
+  const ulong size = n_index_i * n_quad;
+  const bool gauss = quad_method == "gauss" || quad_method == "gauss-";
+
+  // M is stored column major as expected by solve_linear_system, its entry
+  // (row, col) being M_col_major(col, row)
+  ArrayDouble2d M_col_major(size, size);
+  M_col_major.init_to_zero();
+  ArrayDouble V(size);
+
+  for (ulong j = 0; j < n_nodes; ++j) {
+    for (ulong l = 0; l < n_marks[j]; ++l) {
+      const ulong block = first_index_j[j] + l;
+      for (ulong n = 0; n < n_quad; ++n) {
+        V[block * n_quad + n] = G(i, j, l, quad_x[n]);
+      }
+
+      for (ulong j1 = 0; j1 < n_nodes; ++j1) {
+        const double fact = mean_intensity[j1] / mean_intensity[j];
+        for (ulong l1 = 0; l1 < n_marks[j1]; ++l1) {
+          const ulong block1 = first_index_j[j1] + l1;
+          for (ulong n = 0; n < n_quad; ++n) {
+            const ulong row = block * n_quad + n;
+            for (ulong n1 = 0; n1 < n_quad; ++n1) {
+              const ulong col = block1 * n_quad + n1;
+              double x = gauss ? M_entry_gauss(j, l, j1, l1, fact, n, n1)
+                               : M_entry_log_lin(j, l, j1, l1, fact, n, n1);
+              if (quad_method == "gauss-") {
+                M_col_major(block1 * n_quad + n, row) -= x;
+              }
+              if (l == l1 && j == j1 && n == n1) x += 1;
+              M_col_major(col, row) += x;
+            }
+          }
+        }
+      }
+    }
+  }
+
+  tick::vector_operations<double>{}.solve_linear_system(
+      size, M_col_major.data(), V.data());
+
+  for (ulong block = 0; block < n_index_i; ++block) {
+    for (ulong n = 0; n < n_quad; ++n) {
+      res_phi(i * n_index_i + block, n) = V[block * n_quad + n];
+    }
+  }
+}
+
+}  // namespace
+
+void HawkesConditionalLawFredholm(ArrayDouble &claw_X, ArrayDouble2d &claws,
+                                  ArrayULong &n_marks,
+                                  ArrayDouble &mark_probabilities,
+                                  ArrayDouble &mean_intensity,
+                                  ArrayDouble &quad_x, ArrayDouble &quad_w,
+                                  const std::string &quad_method,
+                                  ArrayDouble2d &res_phi, int n_threads) {
+  if (quad_method != "gauss" && quad_method != "gauss-" &&
+      quad_method != "log" && quad_method != "lin") {
+    TICK_ERROR("Unknown quad_method " << quad_method);
+  }
+
+  const ulong n_nodes = n_marks.size();
+  const ulong n_index_i = n_marks.sum();
+  const ulong n_index = n_nodes * n_index_i;
+  if (mean_intensity.size() != n_nodes) {
+    TICK_ERROR("mean_intensity (size=" << mean_intensity.size()
+                                       << ") should be of size " << n_nodes);
+  }
+  if (mark_probabilities.size() != n_index_i) {
+    TICK_ERROR("mark_probabilities (size=" << mark_probabilities.size()
+                                           << ") should be of size "
+                                           << n_index_i);
+  }
+  if (claws.n_rows() != n_index || claws.n_cols() != claw_X.size()) {
+    TICK_ERROR("claws should be of shape (" << n_index << ", " << claw_X.size()
+                                            << ") but has shape ("
+                                            << claws.n_rows() << ", "
+                                            << claws.n_cols() << ")");
+  }
+  if (quad_w.size() != quad_x.size()) {
+    TICK_ERROR("quad_x (size=" << quad_x.size() << ") and quad_w (size="
+                               << quad_w.size()
+                               << ") should have the same size");
+  }
+  if (res_phi.n_rows() != n_index || res_phi.n_cols() != quad_x.size()) {
+    TICK_ERROR("res_phi should be of shape (" << n_index << ", "
+                                              << quad_x.size()
+                                              << ") but has shape ("
+                                              << res_phi.n_rows() << ", "
+                                              << res_phi.n_cols() << ")");
+  }
+
+  HawkesConditionalLawFredholmSolver solver(
+      claw_X, claws, n_marks, mark_probabilities, mean_intensity, quad_x,
+      quad_w, quad_method, res_phi);
 
-      return res;
+  parallel_run(effective_n_threads(n_threads, n_nodes), n_nodes,
+               &HawkesConditionalLawFredholmSolver::solve_i, &solver);
 }
@@ -1,17 +1,32 @@
+// License: BSD 3 clause
+
 #include "tick/hawkes/inference/hawkes_cumulant.h"
 
-HawkesCumulant::HawkesCumulant(double integration_support)
-    : integration_support(integration_support), are_cumulants_ready(false) {}
+HawkesCumulant::HawkesCumulant(double integration_support,
+                               const int max_n_threads)
+    : ModelHawkesList(max_n_threads, 0),
+      integration_support(integration_support),
+      are_cumulants_ready(false) {}
 
 SArrayDoublePtr HawkesCumulant::compute_A_and_I_ij(ulong r, ulong i, ulong j,
                                                    double mean_intensity_j) {
+  double res_C, res_J;
+  compute_A_and_I_ij(r, i, j, mean_intensity_j, res_C, res_J);
+
+  ArrayDouble return_array{res_C, res_J};
+  return return_array.as_sarray_ptr();
+}
+
+void HawkesCumulant::compute_A_and_I_ij(ulong r, ulong i, ulong j,
+                                        double mean_intensity_j, double &res_C,
+                                        double &res_J) {
   auto timestamps_i = timestamps_list[r][i];
   auto timestamps_j = timestamps_list[r][j];
 
   ulong n_i = timestamps_i->size();
   ulong n_j = timestamps_j->size();
-  double res_C = 0;
-  double res_J = 0;
+  res_C = 0;
+  res_J = 0;
   double width = 2 * integration_support;
   double trend_C_j = mean_intensity_j * width;
   double trend_J_j = mean_intensity_j * width * width;
@@ -59,9 +74,6 @@ SArrayDoublePtr HawkesCumulant::compute_A_and_I_ij(ulong r, ulong i, ulong j,
 
   res_C /= (*end_times)[r];
   res_J /= (*end_times)[r];
-
-  ArrayDouble return_array{res_C, res_J};
-  return return_array.as_sarray_ptr();
 }
 
 double HawkesCumulant::compute_E_ijk(ulong r, ulong i, ulong j, ulong k,
@@ -126,3 +138,164 @@ double HawkesCumulant::compute_E_ijk(ulong r, ulong i, ulong j, ulong k,
   res /= (*end_times)[r];
   return res;
 }
+
+ulong HawkesCumulant::memory_usage() const {
+  return tick::array_bytes(mean_intensity_per_realization) +
+         tick::array_bytes(covariance_per_realization) +
+         tick::array_bytes(J_per_realization) +
+         tick::array_bytes(E_c_per_realization) +
+         tick::array_bytes(mean_intensity) + tick::array_bytes(covariance) +
+         tick::array_bytes(skewness);
+}
+
+ulong HawkesCumulant::memory_footprint() const {
+  // Cumulants per realization, their averages and two buffers used to
+  // average the skewness
+  const ulong n_doubles = n_realizations * n_nodes * (1 + 4 * n_nodes) +
+                          n_nodes * (1 + 4 * n_nodes);
+  return n_doubles * sizeof(double);
+}
+
+void HawkesCumulant::compute_cumulants() {
+  if (n_realizations == 0) {
+    TICK_ERROR("Cannot compute cumulants if no realization has been provided");
+  }
+
+  mean_intensity_per_realization = ArrayDouble2d(n_realizations, n_nodes);
+  for (ulong r = 0; r < n_realizations; ++r) {
+    for (ulong i = 0; i < n_nodes; ++i) {
+      mean_intensity_per_realization(r, i) =
+          timestamps_list[r][i]->size() / (*end_times)[r];
+    }
+  }
+
+  covariance_per_realization =
+      ArrayDouble2d(n_realizations, n_nodes * n_nodes);
+  J_per_realization = ArrayDouble2d(n_realizations, n_nodes * n_nodes);
+  E_c_per_realization = ArrayDouble2d(n_realizations * n_nodes, 2 * n_nodes);
+
+  parallel_run(get_n_threads(), n_realizations * n_nodes,
+               &HawkesCumulant::compute_C_and_J_ri, this);
+
+  // we keep the symmetric part to remove edge effects
+  for (ulong r = 0; r < n_realizations; ++r) {
+    ArrayDouble C_r = view_row(covariance_per_realization, r);
+    ArrayDouble J_r = view_row(J_per_realization, r);
+    for (ulong i = 0; i < n_nodes; ++i) {
+      for (ulong j = i + 1; j < n_nodes; ++j) {
+        C_r[i * n_nodes + j] = C_r[j * n_nodes + i] =
+            0.5 * (C_r[i * n_nodes + j] + C_r[j * n_nodes + i]);
+        J_r[i * n_nodes + j] = J_r[j * n_nodes + i] =
+            0.5 * (J_r[i * n_nodes + j] + J_r[j * n_nodes + i]);
+      }
+    }
+  }
+
+  parallel_run(get_n_threads(), n_realizations * n_nodes,
+               &HawkesCumulant::compute_E_c_rk, this);
+
+  // Average over realizations
+  mean_intensity = SArrayDouble::new_ptr(n_nodes);
+  covariance = SArrayDouble2d::new_ptr(n_nodes, n_nodes);
+  skewness = SArrayDouble2d::new_ptr(n_nodes, n_nodes);
+  mean_intensity->init_to_zero();
+  covariance->init_to_zero();
+
+  ArrayDouble2d E_c_0(n_nodes, n_nodes), E_c_1(n_nodes, n_nodes);
+  E_c_0.init_to_zero();
+  E_c_1.init_to_zero();
+
+  for (ulong r = 0; r < n_realizations; ++r) {
+    mean_intensity->mult_incr(view_row(mean_intensity_per_realization, r), 1.);
+    const ArrayDouble C_r = view_row(covariance_per_realization, r);
+    for (ulong ij = 0; ij < n_nodes * n_nodes; ++ij) {
+      (*covariance)[ij] += C_r[ij] / n_realizations;
+    }
+    for (ulong i = 0; i < n_nodes; ++i) {
+      for (ulong j = 0; j < n_nodes; ++j) {
+        E_c_0(i, j) += E_c_per_realization(r * n_nodes + j, i);
+        E_c_1(i, j) += E_c_per_realization(r * n_nodes + i, n_nodes + j);
+      }
+    }
+  }
+  (*mean_intensity) /= n_realizations;
+
+  // K_c = (2 E_c[:, :, 0] + E_c[:, :, 1]) / 3
+  for (ulong ij = 0; ij < n_nodes * n_nodes; ++ij) {
+    (*skewness)[ij] = (2 * (E_c_0[ij] / n_realizations) +
+                       E_c_1[ij] / n_realizations) /
+                      3.;
+  }
+
+  are_cumulants_ready = true;
+}
+
+void HawkesCumulant::compute_C_and_J_ri(const ulong r_i) {
+  const ulong r = r_i / n_nodes;
+  const ulong i = r_i % n_nodes;
+
+  ArrayDouble C_r = view_row(covariance_per_realization, r);
+  ArrayDouble J_r = view_row(J_per_realization, r);
+  for (ulong j = 0; j < n_nodes; ++j) {
+    compute_A_and_I_ij(r, i, j, mean_intensity_per_realization(r, j),
+                       C_r[i * n_nodes + j], J_r[i * n_nodes + j]);
+  }
+}
+
+// This is compute_E_ijk computed at once for all triples (i, k, k) and (j, j,
+// k) as these are the only ones needed in K_c
+void HawkesCumulant::compute_E_c_rk(const ulong r_k) {
+  const ulong r = r_k / n_nodes;
+  const ulong k = r_k % n_nodes;
+
+  const ArrayDouble timestamps_k = view(*timestamps_list[r][k]);
+  const ArrayDouble L_r = view_row(mean_intensity_per_realization, r);
+  const ArrayDouble J_r = view_row(J_per_realization, r);
+
+  // E_c_rk[i] = E_ikk and E_c_rk[n_nodes + j] = E_jjk
+  ArrayDouble E_c_rk = view_row(E_c_per_realization, r_k);
+  E_c_rk.init_to_zero();
+
+  // Events of node i in ]tau - integration_support, tau + integration_support[
+  // are the ones in [first_indices[i], last_indices[i])
+  ArrayULong first_indices(n_nodes), last_indices(n_nodes);
+  first_indices.init_to_zero();
+  last_indices.init_to_zero();
+
+  // Centered window counts, and whether the window ends before the last event
+  ArrayDouble counts(n_nodes);
+  std::vector<bool> in_range(n_nodes);
+
+  for (ulong t = 0; t < timestamps_k.size(); ++t) {
+    const double tau = timestamps_k[t];
+
+    if (tau - integration_support < 0) continue;
+
+    for (ulong i = 0; i < n_nodes; ++i) {
+      const ArrayDouble timestamps_i = view(*timestamps_list[r][i]);
+      const ulong n_i = timestamps_i.size();
+      ulong &first_l = first_indices[i];
+      ulong &last_l = last_indices[i];
+
+      while (first_l < n_i && timestamps_i[first_l] <= tau - integration_support)
+        first_l += 1;
+      if (last_l < first_l) last_l = first_l;
+      while (last_l < n_i && timestamps_i[last_l] < tau + integration_support)
+        last_l += 1;
+
+      const double trend_i = L_r[i] * 2 * integration_support;
+      counts[i] = last_l - first_l - trend_i;
+      in_range[i] = last_l < n_i;
+    }
+
+    for (ulong i = 0; i < n_nodes; ++i) {
+      if (!in_range[i]) continue;
+      if (in_range[k]) {
+        E_c_rk[i] += counts[i] * counts[k] - J_r[i * n_nodes + k];
+      }
+      E_c_rk[n_nodes + i] += counts[i] * counts[i] - J_r[i * n_nodes + i];
+    }
+  }
+
+  for (ulong i = 0; i < 2 * n_nodes; ++i) E_c_rk[i] /= (*end_times)[r];
+}
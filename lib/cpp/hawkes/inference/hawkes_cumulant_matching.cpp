@@ -0,0 +1,489 @@
+// License: BSD 3 clause
+
+#include "tick/hawkes/inference/hawkes_cumulant_matching.h"
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace {
+
+// Hyper parameters of the first order solvers, set to the default values of
+// the Tensorflow optimizers previously used by the Python learner
+const double ADAGRAD_INITIAL_ACCUMULATOR = 0.1;
+const double RMSPROP_DECAY = 0.9;
+const double RMSPROP_EPSILON = 1e-10;
+const double ADADELTA_RHO = 0.95;
+const double ADADELTA_EPSILON = 1e-8;
+const double ADAM_BETA_1 = 0.9;
+const double ADAM_BETA_2 = 0.999;
+const double ADAM_EPSILON = 1e-8;
+
+// Armijo backtracking line search parameters of LBFGS solver
+const double LBFGS_ARMIJO_COEFF = 1e-4;
+const ulong LBFGS_MAX_BACKTRACKS = 50;
+
+// out = A B^T, every entry being the dot product of two rows (BLAS backed
+// when tick is compiled with it)
+void multiply_transposed(ArrayDouble2d &A, ArrayDouble2d &B,
+                         ArrayDouble2d &out) {
+  for (ulong i = 0; i < A.n_rows(); ++i) {
+    ArrayDouble A_i = view_row(A, i);
+    for (ulong j = 0; j < B.n_rows(); ++j) {
+      out(i, j) = A_i.dot(view_row(B, j));
+    }
+  }
+}
+
+// Scalar product of two 2d arrays seen as flat arrays
+double dot(ArrayDouble2d &A, ArrayDouble2d &B) {
+  return ArrayDouble(A.size(), A.data()).dot(ArrayDouble(B.size(), B.data()));
+}
+
+void transpose(const ArrayDouble2d &A, ArrayDouble2d &out) {
+  for (ulong i = 0; i < A.n_rows(); ++i) {
+    for (ulong j = 0; j < A.n_cols(); ++j) {
+      out(j, i) = A(i, j);
+    }
+  }
+}
+
+// Gauss-Jordan inversion with partial pivoting
+void inverse(const ArrayDouble2d &A, ArrayDouble2d &out) {
+  const ulong d = A.n_rows();
+  ArrayDouble2d M(A);
+  out.init_to_zero();
+  for (ulong i = 0; i < d; ++i) out(i, i) = 1.;
+
+  for (ulong k = 0; k < d; ++k) {
+    ulong pivot = k;
+    for (ulong i = k + 1; i < d; ++i) {
+      if (std::abs(M(i, k)) > std::abs(M(pivot, k))) pivot = i;
+    }
+    if (M(pivot, k) == 0) TICK_ERROR("R is a singular matrix");
+
+    if (pivot != k) {
+      for (ulong j = 0; j < d; ++j) {
+        std::swap(M(k, j), M(pivot, j));
+        std::swap(out(k, j), out(pivot, j));
+      }
+    }
+
+    const double inv_pivot = 1. / M(k, k);
+    for (ulong j = 0; j < d; ++j) {
+      M(k, j) *= inv_pivot;
+      out(k, j) *= inv_pivot;
+    }
+
+    for (ulong i = 0; i < d; ++i) {
+      const double factor = M(i, k);
+      if (i == k || factor == 0) continue;
+      for (ulong j = 0; j < d; ++j) {
+        M(i, j) -= factor * M(k, j);
+        out(i, j) -= factor * out(k, j);
+      }
+    }
+  }
+}
+
+}  // namespace
+
+HawkesCumulantMatching::HawkesCumulantMatching(
+    const double cs_ratio, const double strength_lasso,
+    const double strength_ridge, const HawkesCumulantMatching_Solver solver,
+    const double step)
+    : n_nodes(0), solver(solver), momentum(0.9), history_size(10), t(0) {
+  set_cs_ratio(cs_ratio);
+  set_strength_lasso(strength_lasso);
+  set_strength_ridge(strength_ridge);
+  set_step(step);
+}
+
+void HawkesCumulantMatching::set_cumulants(const ArrayDouble &mean_intensity,
+                                           const ArrayDouble2d &covariance,
+                                           const ArrayDouble2d &skewness) {
+  const ulong d = mean_intensity.size();
+  if (covariance.n_rows() != d || covariance.n_cols() != d) {
+    TICK_ERROR("covariance should be of shape (" << d << ", " << d
+                                                 << ") but has shape ("
+                                                 << covariance.n_rows() << ", "
+                                                 << covariance.n_cols() << ")");
+  }
+  if (skewness.n_rows() != d || skewness.n_cols() != d) {
+    TICK_ERROR("skewness should be of shape (" << d << ", " << d
+                                               << ") but has shape ("
+                                               << skewness.n_rows() << ", "
+                                               << skewness.n_cols() << ")");
+  }
+
+  n_nodes = d;
+  this->mean_intensity = mean_intensity;
+  this->covariance = covariance;
+  this->skewness = skewness;
+
+  for (ArrayDouble2d *buffer :
+       {&R_L, &R_sq, &R_C, &diff_covariance, &diff_skewness, &buffer_1,
+        &buffer_2, &buffer_3, &grad, &accumulator_1, &accumulator_2}) {
+    *buffer = ArrayDouble2d(d, d);
+  }
+  reset();
+}
+
+void HawkesCumulantMatching::check_R(const ArrayDouble2d &R) const {
+  if (n_nodes == 0) TICK_ERROR("You must provide cumulants first");
+  if (R.n_rows() != n_nodes || R.n_cols() != n_nodes) {
+    TICK_ERROR("R should be of shape (" << n_nodes << ", " << n_nodes
+                                        << ") but has shape (" << R.n_rows()
+                                        << ", " << R.n_cols() << ")");
+  }
+}
+
+double HawkesCumulantMatching::compute_differences(ArrayDouble2d &R) {
+  const ulong d = n_nodes;
+
+  for (ulong i = 0; i < d; ++i) {
+    for (ulong k = 0; k < d; ++k) {
+      const double R_ik = R(i, k);
+      R_L(i, k) = R_ik * mean_intensity[k];
+      R_sq(i, k) = R_ik * R_ik;
+      R_C(i, k) = R_ik * covariance(i, k);
+      buffer_1(i, k) = covariance(i, k) - 2 * R_L(i, k);
+    }
+  }
+
+  // C(R) - C with C(R) = R diag(L) R^T
+  multiply_transposed(R_L, R, diff_covariance);
+  diff_covariance.mult_incr(covariance, -1.);
+
+  // K(R) - K_c with
+  // K(R) = (C - 2 R diag(L)) (R * R)^T + 2 R (R * C)^T
+  multiply_transposed(buffer_1, R_sq, diff_skewness);
+  multiply_transposed(R, R_C, buffer_2);
+  diff_skewness.mult_incr(buffer_2, 2.);
+  diff_skewness.mult_incr(skewness, -1.);
+
+  const double n_entries = d * d;
+  return (1 - cs_ratio) * diff_skewness.norm_sq() / n_entries +
+         cs_ratio * diff_covariance.norm_sq() / n_entries;
+}
+
+double HawkesCumulantMatching::regularization(ArrayDouble2d &R,
+                                              ArrayDouble2d *out) {
+  if (strength_lasso == 0 && strength_ridge == 0) return 0.;
+
+  const ulong d = n_nodes;
+  ArrayDouble2d R_inv(d, d), F(d, d);
+  inverse(R, R_inv);
+
+  // W = I - R^{-1} is the adjacency matrix and F the gradient of the
+  // penalization with respect to W
+  double value = 0;
+  for (ulong i = 0; i < d; ++i) {
+    for (ulong j = 0; j < d; ++j) {
+      const double W_ij = (i == j ? 1. : 0.) - R_inv(i, j);
+      value += strength_lasso * std::abs(W_ij) +
+               strength_ridge * W_ij * W_ij / 2;
+      const double sign_W_ij = W_ij > 0 ? 1. : (W_ij < 0 ? -1. : 0.);
+      F(i, j) = strength_lasso * sign_W_ij + strength_ridge * W_ij;
+    }
+  }
+
+  if (out != nullptr) {
+    // As dW = R^{-1} dR R^{-1}, the gradient with respect to R is
+    // R^{-T} F R^{-T}
+    ArrayDouble2d R_inv_T(d, d), F_R_inv_T(d, d), F_R_inv_T_T(d, d),
+        grad_reg(d, d);
+    transpose(R_inv, R_inv_T);
+    multiply_transposed(F, R_inv, F_R_inv_T);
+    transpose(F_R_inv_T, F_R_inv_T_T);
+    multiply_transposed(R_inv_T, F_R_inv_T_T, grad_reg);
+    out->mult_incr(grad_reg, 1.);
+  }
+
+  return value;
+}
+
+double HawkesCumulantMatching::loss(ArrayDouble2d &R) {
+  check_R(R);
+  return compute_differences(R) + regularization(R, nullptr);
+}
+
+double HawkesCumulantMatching::grad_loss(ArrayDouble2d &R, ArrayDouble2d &out) {
+  check_R(R);
+  if (out.n_rows() != n_nodes || out.n_cols() != n_nodes) {
+    TICK_ERROR("out should be of shape (" << n_nodes << ", " << n_nodes
+                                          << ") but has shape ("
+                                          << out.n_rows() << ", "
+                                          << out.n_cols() << ")");
+  }
+
+  const ulong d = n_nodes;
+  const double objective = compute_differences(R);
+  const double n_entries = d * d;
+
+  // Gradients of the objective with respect to C(R) and K(R)
+  const double coeff_covariance = 2 * cs_ratio / n_entries;
+  const double coeff_skewness = 2 * (1 - cs_ratio) / n_entries;
+  diff_skewness.mult_fill(diff_skewness, coeff_skewness);
+  for (ulong i = 0; i < d; ++i) {
+    for (ulong j = 0; j < d; ++j) {
+      buffer_1(i, j) =
+          coeff_covariance * (diff_covariance(i, j) + diff_covariance(j, i));
+    }
+  }
+
+  // Covariance part, (G_c + G_c^T) R diag(L)
+  transpose(R, buffer_3);
+  multiply_transposed(buffer_1, buffer_3, out);
+  for (ulong i = 0; i < d; ++i) {
+    for (ulong k = 0; k < d; ++k) out(i, k) *= mean_intensity[k];
+  }
+
+  // Skewness part, with G_k the gradient with respect to K(R)
+  // 2 G_k (R * C - (R * R) diag(L)) + 2 R * (G_k^T C)
+  //   + (2 C - 4 R diag(L)) * (G_k^T R)
+  transpose(diff_skewness, buffer_1);
+  multiply_transposed(buffer_1, buffer_3, buffer_2);
+  for (ulong i = 0; i < d; ++i) {
+    for (ulong k = 0; k < d; ++k) {
+      out(i, k) += (2 * covariance(i, k) - 4 * R_L(i, k)) * buffer_2(i, k);
+    }
+  }
+
+  transpose(covariance, buffer_3);
+  multiply_transposed(buffer_1, buffer_3, buffer_2);
+  for (ulong i = 0; i < d; ++i) {
+    for (ulong k = 0; k < d; ++k) {
+      out(i, k) += 2 * R(i, k) * buffer_2(i, k);
+      buffer_3(k, i) = R_C(i, k) - R_sq(i, k) * mean_intensity[k];
+    }
+  }
+  multiply_transposed(diff_skewness, buffer_3, buffer_2);
+  out.mult_incr(buffer_2, 2.);
+
+  return objective + regularization(R, &out);
+}
+
+void HawkesCumulantMatching::reset() {
+  t = 0;
+  history_s.clear();
+  history_y.clear();
+  previous_R = ArrayDouble2d();
+  previous_grad = ArrayDouble2d();
+
+  if (n_nodes == 0) return;
+
+  accumulator_1.init_to_zero();
+  accumulator_2.init_to_zero();
+  if (solver == HawkesCumulantMatching_Solver::AdaGrad) {
+    accumulator_1.fill(ADAGRAD_INITIAL_ACCUMULATOR);
+  } else if (solver == HawkesCumulantMatching_Solver::RMSProp) {
+    accumulator_1.fill(1.);
+  }
+}
+
+void HawkesCumulantMatching::solve(ArrayDouble2d &R, const ulong n_iter) {
+  check_R(R);
+  for (ulong iter = 0; iter < n_iter; ++iter) {
+    if (solver == HawkesCumulantMatching_Solver::LBFGS) {
+      step_lbfgs(R);
+    } else {
+      step_first_order(R);
+    }
+  }
+}
+
+void HawkesCumulantMatching::step_first_order(ArrayDouble2d &R) {
+  grad_loss(R, grad);
+  ++t;
+
+  const ulong n_coeffs = R.size();
+  double *R_data = R.data();
+  const double *g = grad.data();
+  double *acc_1 = accumulator_1.data();
+  double *acc_2 = accumulator_2.data();
+
+  switch (solver) {
+    case HawkesCumulantMatching_Solver::GD: {
+      R.mult_incr(grad, -step);
+      break;
+    }
+    case HawkesCumulantMatching_Solver::Momentum: {
+      for (ulong k = 0; k < n_coeffs; ++k) {
+        acc_1[k] = momentum * acc_1[k] + g[k];
+        R_data[k] -= step * acc_1[k];
+      }
+      break;
+    }
+    case HawkesCumulantMatching_Solver::AdaGrad: {
+      for (ulong k = 0; k < n_coeffs; ++k) {
+        acc_1[k] += g[k] * g[k];
+        R_data[k] -= step * g[k] / std::sqrt(acc_1[k]);
+      }
+      break;
+    }
+    case HawkesCumulantMatching_Solver::RMSProp: {
+      for (ulong k = 0; k < n_coeffs; ++k) {
+        acc_1[k] = RMSPROP_DECAY * acc_1[k] + (1 - RMSPROP_DECAY) * g[k] * g[k];
+        R_data[k] -= step * g[k] / std::sqrt(acc_1[k] + RMSPROP_EPSILON);
+      }
+      break;
+    }
+    case HawkesCumulantMatching_Solver::AdaDelta: {
+      for (ulong k = 0; k < n_coeffs; ++k) {
+        acc_1[k] = ADADELTA_RHO * acc_1[k] + (1 - ADADELTA_RHO) * g[k] * g[k];
+        const double update = std::sqrt(acc_2[k] + ADADELTA_EPSILON) /
+                              std::sqrt(acc_1[k] + ADADELTA_EPSILON) * g[k];
+        acc_2[k] =
+            ADADELTA_RHO * acc_2[k] + (1 - ADADELTA_RHO) * update * update;
+        R_data[k] -= step * update;
+      }
+      break;
+    }
+    case HawkesCumulantMatching_Solver::Adam: {
+      const double step_t =
+          step * std::sqrt(1 - std::pow(ADAM_BETA_2, static_cast<double>(t))) /
+          (1 - std::pow(ADAM_BETA_1, static_cast<double>(t)));
+      for (ulong k = 0; k < n_coeffs; ++k) {
+        acc_1[k] = ADAM_BETA_1 * acc_1[k] + (1 - ADAM_BETA_1) * g[k];
+        acc_2[k] = ADAM_BETA_2 * acc_2[k] + (1 - ADAM_BETA_2) * g[k] * g[k];
+        R_data[k] -= step_t * acc_1[k] / (std::sqrt(acc_2[k]) + ADAM_EPSILON);
+      }
+      break;
+    }
+    default:
+      TICK_ERROR("Unknown first order solver");
+  }
+}
+
+void HawkesCumulantMatching::step_lbfgs(ArrayDouble2d &R) {
+  const double objective = grad_loss(R, grad);
+  ++t;
+
+  // Store the last correction pair if it satisfies the curvature condition
+  if (previous_R.size() > 0) {
+    ArrayDouble2d s(R), y(grad);
+    s.mult_incr(previous_R, -1.);
+    y.mult_incr(previous_grad, -1.);
+    if (dot(s, y) > std::numeric_limits<double>::epsilon() * y.norm_sq()) {
+      if (history_s.size() == history_size) {
+        history_s.pop_front();
+        history_y.pop_front();
+      }
+      history_s.push_back(s);
+      history_y.push_back(y);
+    }
+  }
+  previous_R = R;
+  previous_grad = grad;
+
+  // Two loop recursion, the direction is stored in accumulator_1
+  ArrayDouble2d &direction = accumulator_1;
+  direction.mult_fill(grad, 1.);
+  const ulong n_pairs = history_s.size();
+  std::vector<double> alphas(n_pairs), rhos(n_pairs);
+  for (ulong l = n_pairs; l-- > 0;) {
+    rhos[l] = 1. / dot(history_s[l], history_y[l]);
+    alphas[l] = rhos[l] * dot(history_s[l], direction);
+    direction.mult_incr(history_y[l], -alphas[l]);
+  }
+  // Without any correction pair, the first trial step is a gradient step of
+  // length `step`
+  const double gamma =
+      n_pairs > 0 ? dot(history_s[n_pairs - 1], history_y[n_pairs - 1]) /
+                        history_y[n_pairs - 1].norm_sq()
+                  : step;
+  direction.mult_fill(direction, gamma);
+  for (ulong l = 0; l < n_pairs; ++l) {
+    const double beta = rhos[l] * dot(history_y[l], direction);
+    direction.mult_incr(history_s[l], alphas[l] - beta);
+  }
+  direction.mult_fill(direction, -1.);
+
+  double slope = dot(grad, direction);
+  if (!(slope < 0)) {
+    // Not a descent direction, the curvature information is dropped
+    history_s.clear();
+    history_y.clear();
+    direction.mult_fill(grad, -step);
+    slope = dot(grad, direction);
+  }
+
+  // Armijo backtracking line search, the candidate is stored in accumulator_2
+  ArrayDouble2d &candidate = accumulator_2;
+  double step_length = 1.;
+  for (ulong n_backtracks = 0; n_backtracks < LBFGS_MAX_BACKTRACKS;
+       ++n_backtracks) {
+    candidate.mult_fill(R, 1.);
+    candidate.mult_incr(direction, step_length);
+    const double candidate_objective =
+        compute_differences(candidate) + regularization(candidate, nullptr);
+    if (std::isfinite(candidate_objective) &&
+        candidate_objective <=
+            objective + LBFGS_ARMIJO_COEFF * step_length * slope) {
+      R.mult_fill(candidate, 1.);
+      return;
+    }
+    step_length /= 2;
+  }
+
+  // No sufficient decrease was found, R is left unchanged
+  history_s.clear();
+  history_y.clear();
+}
+
+void HawkesCumulantMatching::set_cs_ratio(const double cs_ratio) {
+  if (cs_ratio < 0 || cs_ratio > 1) {
+    TICK_ERROR("cs_ratio must be between 0 and 1 and you have provided "
+               << cs_ratio);
+  }
+  this->cs_ratio = cs_ratio;
+}
+
+void HawkesCumulantMatching::set_strength_lasso(const double strength_lasso) {
+  if (strength_lasso < 0) {
+    TICK_ERROR("strength_lasso must be non negative and you have provided "
+               << strength_lasso);
+  }
+  this->strength_lasso = strength_lasso;
+}
+
+void HawkesCumulantMatching::set_strength_ridge(const double strength_ridge) {
+  if (strength_ridge < 0) {
+    TICK_ERROR("strength_ridge must be non negative and you have provided "
+               << strength_ridge);
+  }
+  this->strength_ridge = strength_ridge;
+}
+
+void HawkesCumulantMatching::set_solver(
+    const HawkesCumulantMatching_Solver solver) {
+  if (solver != this->solver) {
+    this->solver = solver;
+    reset();
+  }
+}
+
+void HawkesCumulantMatching::set_step(const double step) {
+  if (step <= 0) {
+    TICK_ERROR("step must be positive and you have provided " << step);
+  }
+  this->step = step;
+}
+
+void HawkesCumulantMatching::set_momentum(const double momentum) {
+  if (momentum < 0) {
+    TICK_ERROR("momentum must be non negative and you have provided "
+               << momentum);
+  }
+  this->momentum = momentum;
+}
+
+void HawkesCumulantMatching::set_history_size(const ulong history_size) {
+  if (history_size == 0) TICK_ERROR("history_size must be positive");
+  this->history_size = history_size;
+  while (history_s.size() > history_size) {
+    history_s.pop_front();
+    history_y.pop_front();
+  }
+}
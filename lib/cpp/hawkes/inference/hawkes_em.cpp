@@ -2,6 +2,8 @@
 
 #include "tick/hawkes/inference/hawkes_em.h"
 
+#include <algorithm>
+
 HawkesEM::HawkesEM(const double kernel_support, const ulong kernel_size,
                    const int max_n_threads)
     : ModelHawkesList(max_n_threads, 0), kernel_discretization(nullptr) {
@@ -16,109 +18,163 @@ HawkesEM::HawkesEM(const SArrayDoublePtr kernel_discretization,
 }
 
 void HawkesEM::allocate_weights() {
-  next_mu = ArrayDouble2d(n_realizations, n_nodes);
-  next_kernels = ArrayDouble2d(n_realizations * n_nodes, n_nodes * kernel_size);
-  unnormalized_kernels =
-      ArrayDouble2d(n_realizations * n_nodes, n_nodes * kernel_size);
+  const ulong n_threads = get_n_threads();
+  next_mu = ArrayDouble2d(n_threads, n_nodes);
+  next_kernels = ArrayDouble2d(n_threads * n_nodes, n_nodes * kernel_size);
+  unnormalized_kernels = ArrayDouble2d(n_threads, n_nodes * kernel_size);
   weights_computed = true;
 }
 
 double HawkesEM::loglikelihood(const ArrayDouble &mu, ArrayDouble2d &kernels) {
   check_baseline_and_kernels(mu, kernels);
 
+  // Kernel norms and discretization do not depend on the realization nor on
+  // the node, we compute them once for all tasks
+  const ArrayDouble2d kernel_norms = *get_kernel_norms(kernels);
+  const ArrayDouble discretization = *get_kernel_discretization();
+
   double llh = parallel_map_additive_reduce(
       get_n_threads(), n_nodes * n_realizations, &HawkesEM::loglikelihood_ur,
-      this, mu, kernels);
+      this, mu, kernels, kernel_norms, discretization);
   return llh /= get_n_total_jumps();
 }
 
+ulong HawkesEM::memory_usage() const {
+  return tick::array_bytes(next_mu) + tick::array_bytes(next_kernels) +
+         tick::array_bytes(unnormalized_kernels);
+}
+
+ulong HawkesEM::memory_footprint() const {
+  // Buffers of allocate_weights, one set per thread
+  const ulong n_threads = get_n_threads();
+  return n_threads * n_nodes * (1 + (n_nodes + 1) * kernel_size) *
+         sizeof(double);
+}
+
 void HawkesEM::solve(ArrayDouble &mu, ArrayDouble2d &kernels) {
-  if (!weights_computed) allocate_weights();
+  // Buffers are allocated per thread, hence the number of threads must not
+  // have changed since the last allocation
+  if (!weights_computed || next_mu.n_rows() != get_n_threads())
+    allocate_weights();
   check_baseline_and_kernels(mu, kernels);
 
+  const ulong n_threads = next_mu.n_rows();
+
   // Map
-  // Fill next_mu and next_kernels
+  // Each thread fills its own rows of next_mu and next_kernels
   next_mu.init_to_zero();
   next_kernels.init_to_zero();
-  parallel_run(get_n_threads(), n_nodes * n_realizations, &HawkesEM::solve_ur,
-               this, mu, kernels);
+  parallel_run(n_threads, n_threads, &HawkesEM::solve_thread, this, mu,
+               kernels);
 
   // Reduce
-  // Fill mu and kernels with next_mu and next_kernels
-  mu.init_to_zero();
-  kernels.init_to_zero();
-  for (ulong r = 0; r < n_realizations; r++) {
-    for (ulong node_u = 0; node_u < n_nodes; ++node_u) {
-      mu[node_u] += next_mu(r, node_u);
-
-      ArrayDouble2d next_kernel_u_r(
-          n_nodes, kernel_size,
-          view_row(next_kernels, r * n_nodes + node_u).data());
-      ArrayDouble2d kernel_u(n_nodes, kernel_size,
-                             view_row(kernels, node_u).data());
-      kernel_u.mult_incr(next_kernel_u_r, 1.);
-    }
+  // Thread buffers are summed two by two until they all have been added to the
+  // buffers of the first thread
+  for (ulong stride = 1; stride < n_threads; stride *= 2) {
+    const ulong n_pairs = (n_threads + 2 * stride - 1) / (2 * stride);
+    parallel_run(n_threads, n_pairs, &HawkesEM::reduce_thread_buffers, this,
+                 stride);
+  }
+
+  // Fill mu and kernels with the buffers of the first thread
+  mu.mult_fill(view_row(next_mu, 0), 1.);
+  kernels.mult_fill(
+      ArrayDouble2d(n_nodes, n_nodes * kernel_size, next_kernels.data()), 1.);
+}
+
+void HawkesEM::solve_thread(const ulong thread_index, const ArrayDouble &mu,
+                            ArrayDouble2d &kernels) {
+  ulong min_r_u{}, max_r_u{};
+  std::tie(min_r_u, max_r_u) = tick::get_thread_indices(
+      thread_index, next_mu.n_rows(), n_nodes * n_realizations);
+
+  // Discretization intervals are shared by all the tasks of this thread
+  ArrayDouble kernel_dts(kernel_size);
+  for (ulong m = 0; m < kernel_size; ++m) kernel_dts[m] = get_kernel_dt(m);
+
+  for (ulong r_u = min_r_u; r_u < max_r_u; ++r_u) {
+    solve_ur(r_u, thread_index, mu, kernels, kernel_dts);
   }
 }
 
+void HawkesEM::reduce_thread_buffers(const ulong i, const ulong stride) {
+  const ulong thread_dst = 2 * stride * i;
+  const ulong thread_src = thread_dst + stride;
+  if (thread_src >= next_mu.n_rows()) return;
+
+  ArrayDouble next_mu_dst = view_row(next_mu, thread_dst);
+  next_mu_dst.mult_incr(view_row(next_mu, thread_src), 1.);
+
+  const ulong block_size = n_nodes * n_nodes * kernel_size;
+  ArrayDouble next_kernels_dst(block_size,
+                               next_kernels.data() + thread_dst * block_size);
+  ArrayDouble next_kernels_src(block_size,
+                               next_kernels.data() + thread_src * block_size);
+  next_kernels_dst.mult_incr(next_kernels_src, 1.);
+}
+
 double HawkesEM::loglikelihood_ur(const ulong r_u, const ArrayDouble &mu,
-                                  ArrayDouble2d &kernels) {
+                                  ArrayDouble2d &kernels,
+                                  const ArrayDouble2d &kernel_norms,
+                                  const ArrayDouble &discretization) {
   const ulong r = static_cast<const ulong>(r_u / n_nodes);
   double llh = (*end_times)[r];
-  std::function<void(double)> add_to_llh = [&llh](double intensity_t_i) {
+  auto add_to_llh = [&llh](double intensity_t_i) {
     if (intensity_t_i <= 0)
       llh = std::numeric_limits<double>::infinity();
     else
       llh += log(intensity_t_i);
   };
 
-  compute_intensities_ur(r_u, mu, kernels, add_to_llh, false);
+  compute_intensities_ur(r_u, mu, kernels, add_to_llh, nullptr);
 
-  llh -= compute_compensator_ur(r_u, mu, kernels);
+  llh -= compute_compensator_ur(r_u, mu, kernels, kernel_norms,
+                                discretization);
   return llh;
 }
 
-void HawkesEM::solve_ur(const ulong r_u, const ArrayDouble &mu,
-                        ArrayDouble2d &kernels) {
-  // Obtain realization and node index from r_u
-  const ulong r = static_cast<const ulong>(r_u / n_nodes);
+void HawkesEM::solve_ur(const ulong r_u, const ulong thread_index,
+                        const ArrayDouble &mu, ArrayDouble2d &kernels,
+                        const ArrayDouble &kernel_dts) {
+  // Obtain node index from r_u
   const ulong node_u = r_u % n_nodes;
 
   // Fetch corresponding data
   const double mu_u = mu[node_u];
+  const double end_times_sum = end_times->sum();
 
-  // initialize next data
+  // next data is accumulated in the buffers of the current thread
   ArrayDouble2d next_kernel_ru(
       n_nodes, kernel_size,
-      view_row(next_kernels, r * n_nodes + node_u).data());
+      view_row(next_kernels, thread_index * n_nodes + node_u).data());
   ArrayDouble2d unnormalized_kernel_ru(
-      n_nodes, kernel_size,
-      view_row(unnormalized_kernels, r * n_nodes + node_u).data());
-  double &next_mu_ru = next_mu(r, node_u);
-
-  std::function<void(double)> add_to_next_kernel =
-      [this, &unnormalized_kernel_ru, &next_kernel_ru, &next_mu_ru,
-       &mu_u](double intensity_t_i) {
-        // If norm is zero then nothing to do (no contribution)
-        if (intensity_t_i == 0) return;
-
-        // Otherwise, we need to norm the kernel_temp's and the mu_temp
-        // and add their contributions to the estimation
-        next_mu_ru += mu_u / (intensity_t_i * this->end_times->sum());
-        for (ulong node_v = 0; node_v < this->n_nodes; node_v++) {
-          ArrayDouble unnormalized_kernel_ruv =
-              view_row(unnormalized_kernel_ru, node_v);
-          ArrayDouble next_kernel_ruv = view_row(next_kernel_ru, node_v);
-          for (ulong m = 0; m < this->kernel_size; m++) {
-            const double normalization_term =
-                intensity_t_i * (*this->n_jumps_per_node)[node_v] *
-                get_kernel_dt(m);
-            next_kernel_ruv[m] +=
-                unnormalized_kernel_ruv[m] / normalization_term;
-          }
-        }
-      };
-  compute_intensities_ur(r_u, mu, kernels, add_to_next_kernel, true);
+      n_nodes, kernel_size, view_row(unnormalized_kernels, thread_index).data());
+  double &next_mu_ru = next_mu(thread_index, node_u);
+
+  auto add_to_next_kernel = [this, &unnormalized_kernel_ru, &next_kernel_ru,
+                             &next_mu_ru, &kernel_dts, mu_u,
+                             end_times_sum](double intensity_t_i) {
+    // If norm is zero then nothing to do (no contribution)
+    if (intensity_t_i == 0) return;
+
+    // Otherwise, we need to norm the kernel_temp's and the mu_temp
+    // and add their contributions to the estimation
+    next_mu_ru += mu_u / (intensity_t_i * end_times_sum);
+    for (ulong node_v = 0; node_v < this->n_nodes; node_v++) {
+      const double *unnormalized_kernel_ruv =
+          unnormalized_kernel_ru.data() + node_v * this->kernel_size;
+      double *next_kernel_ruv =
+          next_kernel_ru.data() + node_v * this->kernel_size;
+      const double intensity_n_jumps_v =
+          intensity_t_i * (*this->n_jumps_per_node)[node_v];
+      for (ulong m = 0; m < this->kernel_size; m++) {
+        const double normalization_term = intensity_n_jumps_v * kernel_dts[m];
+        next_kernel_ruv[m] += unnormalized_kernel_ruv[m] / normalization_term;
+      }
+    }
+  };
+  compute_intensities_ur(r_u, mu, kernels, add_to_next_kernel,
+                         &unnormalized_kernel_ru);
 }
 
 SArrayDouble2dPtr HawkesEM::get_kernel_norms(ArrayDouble2d &kernels) const {
@@ -142,32 +198,31 @@ SArrayDouble2dPtr HawkesEM::get_kernel_norms(ArrayDouble2d &kernels) const {
   return kernel_norms.as_sarray2d_ptr();
 }
 
-void HawkesEM::compute_intensities_ur(
-    const ulong r_u, const ArrayDouble &mu, ArrayDouble2d &kernels,
-    std::function<void(double)> intensity_func,
-    bool store_unnormalized_kernel) {
+template <class IntensityFunc>
+void HawkesEM::compute_intensities_ur(const ulong r_u, const ArrayDouble &mu,
+                                      ArrayDouble2d &kernels,
+                                      IntensityFunc intensity_func,
+                                      ArrayDouble2d *unnormalized_kernel_ru) {
   // Obtain realization and node index from r_u
   const ulong r = static_cast<const ulong>(r_u / n_nodes);
   const ulong node_u = r_u % n_nodes;
 
-  ArrayDouble2d kernel_norms = *get_kernel_norms(kernels);
-  double marginal_int_intensity = 0;
-  for (ulong node_v = 0; node_v < n_nodes; ++node_v) {
-    marginal_int_intensity += kernel_norms(node_v, node_u);
-  }
-
   // Fetch corresponding data
   SArrayDoublePtrList1D &realization = timestamps_list[r];
   ArrayDouble2d kernel_u(n_nodes, kernel_size,
                          view_row(kernels, node_u).data());
   const double mu_u = mu[node_u];
 
-  ArrayDouble2d unnormalized_kernel_ru;
-  if (store_unnormalized_kernel) {
-    unnormalized_kernel_ru = ArrayDouble2d(
-        n_nodes, kernel_size,
-        view_row(unnormalized_kernels, r * n_nodes + node_u).data());
-  }
+  const bool store_unnormalized_kernel = unnormalized_kernel_ru != nullptr;
+
+  // With a regular discretization, the kernel bucket of a time difference is
+  // obtained directly, otherwise it is searched in the discretization
+  const double kernel_dt = get_kernel_dt();
+  const double *discretization_begin =
+      kernel_discretization == nullptr ? nullptr : kernel_discretization->data();
+  const double *discretization_end = discretization_begin == nullptr
+                                         ? nullptr
+                                         : discretization_begin + kernel_size + 1;
 
   ArrayDouble timestamps_u = view(*realization[node_u]);
 
@@ -180,7 +235,7 @@ void HawkesEM::compute_intensities_ur(
 
   for (ulong i = timestamps_u.size() - 1; i != static_cast<ulong>(-1); i--) {
     const double t_i = timestamps_u[i];
-    unnormalized_kernel_ru.init_to_zero();
+    if (store_unnormalized_kernel) unnormalized_kernel_ru->init_to_zero();
 
     // intensity_t_i will be equal to the intensity value of node i at time t_i
     // ie. mu_u + \sum_v \sum_(t_j < t_i) g_uv(t_i - t_j)
@@ -188,9 +243,10 @@ void HawkesEM::compute_intensities_ur(
     for (ulong node_v = 0; node_v < n_nodes; node_v++) {
       ArrayDouble timestamps_v = view(*realization[node_v]);
 
-      ArrayDouble unnormalized_kernel_ruv;
+      double *unnormalized_kernel_ruv = nullptr;
       if (store_unnormalized_kernel)
-        unnormalized_kernel_ruv = view_row(unnormalized_kernel_ru, node_v);
+        unnormalized_kernel_ruv =
+            unnormalized_kernel_ru->data() + node_v * kernel_size;
 
       // Update the corresponding index such that it is the largest index which
       // satisfies v[index] <= t_i
@@ -205,7 +261,7 @@ void HawkesEM::compute_intensities_ur(
       if ( (timestamps_v.size() == 0) || (t_i < timestamps_v[last_indices[node_v]]) ) continue;
 
       // Get the corresponding kernels and their size
-      ArrayDouble kernel_ruv = view_row(kernel_u, node_v);
+      const double *kernel_ruv = kernel_u.data() + node_v * kernel_size;
 
       ulong j0 = last_indices[node_v];
       ulong last_m = 0;
@@ -224,12 +280,15 @@ void HawkesEM::compute_intensities_ur(
           if (t_diff < kernel_support) {
             // We get the index in the kernel array
             ulong m;
-            if (kernel_discretization == nullptr) {
-              m = static_cast<ulong>(floor(t_diff / get_kernel_dt()));
+            if (discretization_begin == nullptr) {
+              m = static_cast<ulong>(floor(t_diff / kernel_dt));
             } else {
-              // last_m allows us to find m value quicker as m >= last_m
-              m = last_m;
-              while ((*kernel_discretization)[m + 1] < t_diff) m++;
+              // m is the index such that
+              // discretization[m] < t_diff <= discretization[m + 1]
+              // last_m allows us to restrict the search as m >= last_m
+              m = std::lower_bound(discretization_begin + last_m + 1,
+                                   discretization_end, t_diff) -
+                  discretization_begin - 1;
             }
             last_m = m;
 
@@ -254,13 +313,14 @@ void HawkesEM::compute_intensities_ur(
 }
 
 double HawkesEM::compute_compensator_ur(const ulong r_u, const ArrayDouble &mu,
-                                        ArrayDouble2d &kernels) {
+                                        ArrayDouble2d &kernels,
+                                        const ArrayDouble2d &kernel_norms,
+                                        const ArrayDouble &discretization) {
   // Obtain realization and node index from r_u
   const ulong r = static_cast<const ulong>(r_u / n_nodes);
   const ulong node_u = r_u % n_nodes;
 
   double compensator = 0;
-  ArrayDouble2d kernel_norms = *get_kernel_norms(kernels);
 
   // Marginal value added to compensator by an event of node u
   double marginal_compensator = 0;
@@ -277,7 +337,6 @@ double HawkesEM::compute_compensator_ur(const ulong r_u, const ArrayDouble &mu,
   // Marginal compensator of the kernel u for timestamps are close to end_time
   double current_marginal_compensator = 0;
   ulong last_m = 0;
-  ArrayDouble kernel_discretization = *get_kernel_discretization();
   for (ulong i = timestamps_u.size() - 1; i != static_cast<ulong>(-1); i--) {
     const double t_i = timestamps_u[i];
     double t_diff = (*end_times)[r] - t_i;
@@ -288,9 +347,9 @@ double HawkesEM::compute_compensator_ur(const ulong r_u, const ArrayDouble &mu,
       // We get the index in the kernel array
       // last_m allows us to find m value quicker as m >= last_m
       ulong m = last_m;
-      while (kernel_discretization[m + 1] < t_diff) {
+      while (discretization[m + 1] < t_diff) {
         double interval =
-            kernel_discretization[m + 1] - kernel_discretization[m];
+            discretization[m + 1] - discretization[m];
         // We add the compensator value added by bucket m
         for (ulong node_v = 0; node_v < n_nodes; ++node_v) {
           current_marginal_compensator +=
@@ -299,7 +358,7 @@ double HawkesEM::compute_compensator_ur(const ulong r_u, const ArrayDouble &mu,
         m++;
       }
       compensator += current_marginal_compensator;
-      double interval_part = t_diff - kernel_discretization[m];
+      double interval_part = t_diff - discretization[m];
       // We add compensator value of part of the bucket
       for (ulong node_v = 0; node_v < n_nodes; ++node_v) {
         compensator +=
@@ -3,6 +3,10 @@
 #include "tick/hawkes/inference/hawkes_sumgaussians.h"
 #include "tick/base/base.h"
 
+// In streaming mode, gaussian values lower than exp(-36) (about 2e-16 times
+// their maximum) are neglected
+const double GAUSSIAN_TRUNCATION = std::sqrt(72.);
+
 // soft-thresholding operator
 double soft_thres(double z, double alpha) {
   return (z > 0 ? std::max(std::abs(z) - alpha, 0.)
@@ -14,7 +18,7 @@ HawkesSumGaussians::HawkesSumGaussians(
     const double step_size, const double strength_lasso,
     const double strength_grouplasso, const ulong em_max_iter,
     const int max_n_threads, const unsigned int optimization_level)
-    : ModelHawkesList(max_n_threads, optimization_level) {
+    : ModelHawkesList(max_n_threads, optimization_level), store_weights(true) {
   set_n_gaussians(n_gaussians);
   set_em_max_iter(em_max_iter);
   set_max_mean_gaussian(max_mean_gaussian);
@@ -31,13 +35,18 @@ void HawkesSumGaussians::compute_weights() {
       ArrayDouble2d(n_realizations * n_nodes, n_nodes * n_gaussians);
 
   kernel_integral = ArrayDouble(n_nodes * n_gaussians);
-  g = ArrayDouble2dList2D(n_realizations);
-  for (ulong r = 0; r < n_realizations; r++) {
-    g[r] = ArrayDouble2dList1D(n_nodes);
-    for (ulong u = 0; u < n_nodes; u++) {
-      g[r][u] =
-          ArrayDouble2d(timestamps_list[r][u]->size(), n_nodes * n_gaussians);
+  if (store_weights) {
+    g = ArrayDouble2dList2D(n_realizations);
+    for (ulong r = 0; r < n_realizations; r++) {
+      g[r] = ArrayDouble2dList1D(n_nodes);
+      for (ulong u = 0; u < n_nodes; u++) {
+        g[r][u] =
+            ArrayDouble2d(timestamps_list[r][u]->size(), n_nodes * n_gaussians);
+      }
     }
+  } else {
+    // Release weights that might have been computed previously
+    g = ArrayDouble2dList2D();
   }
 
   // Compute means_gaussians, std_gaussian and useful constants
@@ -79,12 +88,24 @@ void HawkesSumGaussians::compute_weights_ru(
   // Obtain realization and node index from r_u
   const ulong r = static_cast<const ulong>(r_u / n_nodes);
   const ulong u = r_u % n_nodes;
-  ArrayDouble2d g_ru = view(g[r][u]);
-  g_ru.init_to_zero();
   const ArrayDouble timestamps_ru = view(*timestamps_list[r][u]);
   const double end_time_r = (*end_times)[r];
   ArrayDouble map_kernel_integral_r = view_row(map_kernel_integral, r);
 
+  for (ulong k = 0; k < timestamps_ru.size(); k++) {
+    const double t_ru_k = timestamps_ru[k];
+    for (ulong m = 0; m < n_gaussians; m++) {
+      map_kernel_integral_r[u * n_gaussians + m] +=
+          0.5 * std::erf((end_time_r - t_ru_k - means_gaussians[m]) /
+                         norm_constant_erf) +
+          0.5 * std::erf(means_gaussians[m] / norm_constant_erf);
+    }
+  }
+
+  if (!store_weights) return;
+
+  ArrayDouble2d g_ru = view(g[r][u]);
+  g_ru.init_to_zero();
   for (ulong v = 0; v < n_nodes; v++) {
     const ArrayDouble timestamps_rv = view(*timestamps_list[r][v]);
     for (ulong k = 0; k < timestamps_ru.size(); k++) {
@@ -101,19 +122,30 @@ void HawkesSumGaussians::compute_weights_ru(
           ij++;
         }
       }
-      if (u == v) {
-        // We use this pass over the data to fill kernel_integral
-        for (ulong m = 0; m < n_gaussians; m++) {
-          map_kernel_integral_r[u * n_gaussians + m] +=
-              0.5 * std::erf((end_time_r - t_ru_k - means_gaussians[m]) /
-                             norm_constant_erf) +
-              0.5 * std::erf(means_gaussians[m] / norm_constant_erf);
-        }
-      }
     }
   }
 }
 
+ulong HawkesSumGaussians::memory_usage() const {
+  return tick::array_bytes(means_gaussians) +
+         tick::array_bytes(kernel_integral) + tick::array_bytes(g) +
+         tick::array_bytes(next_C) + tick::array_bytes(unnormalized_next_C) +
+         tick::array_bytes(next_mu);
+}
+
+ulong HawkesSumGaussians::memory_footprint() const {
+  if (n_nodes == 0) return 0;
+  // next_mu, next_C, unnormalized_next_C, kernel_integral, means_gaussians
+  // and the kernel integral of each realization
+  ulong n_doubles = n_realizations * n_nodes +
+                    2 * n_realizations * n_nodes * n_nodes * n_gaussians +
+                    n_nodes * n_gaussians + n_gaussians +
+                    n_realizations * n_nodes * n_gaussians;
+  // g has a row per jump
+  if (store_weights) n_doubles += get_n_total_jumps() * n_nodes * n_gaussians;
+  return n_doubles * sizeof(double);
+}
+
 // The main method for performing one iteration
 void HawkesSumGaussians::solve(ArrayDouble &mu, ArrayDouble2d &amplitudes) {
   if (!weights_computed) compute_weights();
@@ -133,8 +165,14 @@ void HawkesSumGaussians::solve(ArrayDouble &mu, ArrayDouble2d &amplitudes) {
     next_C.init_to_zero();
     next_mu.init_to_zero();
 
-    parallel_run(get_n_threads(), n_nodes * n_realizations,
-                 &HawkesSumGaussians::estimate_ru, this, mu, amplitudes);
+    if (store_weights) {
+      parallel_run(get_n_threads(), n_nodes * n_realizations,
+                   &HawkesSumGaussians::estimate_ru, this, mu, amplitudes);
+    } else {
+      parallel_run(get_n_threads(), n_nodes * n_realizations,
+                   &HawkesSumGaussians::estimate_ru_streaming, this, mu,
+                   amplitudes);
+    }
     parallel_run(
         std::min(get_n_threads(), static_cast<const unsigned int>(n_nodes)),
         n_nodes, &HawkesSumGaussians::update_u, this, mu, amplitudes);
@@ -168,27 +206,100 @@ void HawkesSumGaussians::estimate_ru(const ulong r_u, ArrayDouble &mu,
   // We loop in reverse order to benefit from last_indices
   for (ulong i = realization[node_u]->size() - 1; i != static_cast<ulong>(-1);
        i--) {
-    // this array will store temporary values
-    unnormalized_next_C_ru.init_to_zero();
-    ArrayDouble g_ru_i = view_row(g_ru, i);
+    const ArrayDouble g_ru_i = view_row(g_ru, i);
+    estimate_ru_i(mu_u, amplitudes_u, g_ru_i, next_mu_ur, next_C_ru,
+                  unnormalized_next_C_ru);
+  }
+}
 
-    // norm will be equal to mu_u + \sum_v \sum_m a_uv^m \sum_(t_j < t_i)
-    // g_m(t_i - t_j)
-    double norm = mu_u;
+// Procedure called by HawkesSumGaussians::solve when weights are not stored
+void HawkesSumGaussians::estimate_ru_streaming(const ulong r_u,
+                                               ArrayDouble &mu,
+                                               ArrayDouble2d &amplitudes) {
+  // Obtain realization and node index from r_u
+  const ulong r = static_cast<const ulong>(r_u / n_nodes);
+  const ulong node_u = r_u % n_nodes;
+
+  // Fetch corresponding data
+  SArrayDoublePtrList1D &realization = timestamps_list[r];
+  const ArrayDouble timestamps_ru = view(*realization[node_u]);
+  ArrayDouble amplitudes_u = view_row(amplitudes, node_u);
+  double mu_u = mu[node_u];
+
+  // initialize next data
+  double &next_mu_ur = next_mu(r, node_u);
+  ArrayDouble next_C_ru = view_row(next_C, r * n_nodes + node_u);
+  ArrayDouble unnormalized_next_C_ru =
+      view_row(unnormalized_next_C, r * n_nodes + node_u);
+
+  // Events of node v older than max_lag do not contribute to g_ru_i
+  const double max_lag =
+      means_gaussians[n_gaussians - 1] + GAUSSIAN_TRUNCATION * std_gaussian;
+
+  // For each node v, events in [first_indices[v], last_indices[v]) are the
+  // ones in the window [t_i^u - max_lag, t_i^u)
+  ArrayDouble g_ru_i(n_nodes * n_gaussians);
+  ArrayULong first_indices(n_nodes), last_indices(n_nodes);
+  first_indices.init_to_zero();
+  last_indices.init_to_zero();
+
+  for (ulong i = 0; i < timestamps_ru.size(); i++) {
+    const double t_ru_i = timestamps_ru[i];
+    g_ru_i.init_to_zero();
 
     for (ulong node_v = 0; node_v < n_nodes; node_v++) {
-      for (ulong m = 0; m < n_gaussians; m++) {
-        const double sum_unnormalized_p_ij =
-            amplitudes_u[node_v * n_gaussians + m] *
-            g_ru_i[node_v * n_gaussians + m];
-        unnormalized_next_C_ru[node_v * n_gaussians + m] +=
-            sum_unnormalized_p_ij;
-        norm += sum_unnormalized_p_ij;
+      const ArrayDouble timestamps_rv = view(*realization[node_v]);
+      ulong &first_ij = first_indices[node_v];
+      ulong &last_ij = last_indices[node_v];
+      while ((last_ij < timestamps_rv.size()) &&
+             (timestamps_rv[last_ij] < t_ru_i)) {
+        last_ij++;
       }
+      while ((first_ij < last_ij) &&
+             (t_ru_i - timestamps_rv[first_ij] > max_lag)) {
+        first_ij++;
+      }
+
+      for (ulong ij = first_ij; ij < last_ij; ij++) {
+        const double t_diff = t_ru_i - timestamps_rv[ij];
+        for (ulong m = 0; m < n_gaussians; m++) {
+          g_ru_i[node_v * n_gaussians + m] +=
+              cexp(-(t_diff - means_gaussians[m]) *
+                   (t_diff - means_gaussians[m]) / (2. * std_gaussian_sq)) /
+              norm_constant_gauss;
+        }
+      }
+    }
+
+    estimate_ru_i(mu_u, amplitudes_u, g_ru_i, next_mu_ur, next_C_ru,
+                  unnormalized_next_C_ru);
+  }
+}
+
+void HawkesSumGaussians::estimate_ru_i(const double mu_u,
+                                       const ArrayDouble &amplitudes_u,
+                                       const ArrayDouble &g_ru_i,
+                                       double &next_mu_ur,
+                                       ArrayDouble &next_C_ru,
+                                       ArrayDouble &unnormalized_next_C_ru) {
+  // this array will store temporary values
+  unnormalized_next_C_ru.init_to_zero();
+
+  // norm will be equal to mu_u + \sum_v \sum_m a_uv^m \sum_(t_j < t_i)
+  // g_m(t_i - t_j)
+  double norm = mu_u;
+
+  for (ulong node_v = 0; node_v < n_nodes; node_v++) {
+    for (ulong m = 0; m < n_gaussians; m++) {
+      const double sum_unnormalized_p_ij =
+          amplitudes_u[node_v * n_gaussians + m] *
+          g_ru_i[node_v * n_gaussians + m];
+      unnormalized_next_C_ru[node_v * n_gaussians + m] += sum_unnormalized_p_ij;
+      norm += sum_unnormalized_p_ij;
     }
-    next_mu_ur += mu_u / norm;
-    next_C_ru.mult_incr(unnormalized_next_C_ru, 1. / norm);
   }
+  next_mu_ur += mu_u / norm;
+  next_C_ru.mult_incr(unnormalized_next_C_ru, 1. / norm);
 }
 
 // A method called in parallel by the method 'solve' (see below)
@@ -352,3 +463,10 @@ void HawkesSumGaussians::set_strength_grouplasso(
   }
   this->strength_grouplasso = strength_grouplasso;
 }
+
+bool HawkesSumGaussians::get_store_weights() const { return store_weights; }
+
+void HawkesSumGaussians::set_store_weights(const bool store_weights) {
+  if (this->store_weights != store_weights) weights_computed = false;
+  this->store_weights = store_weights;
+}
@@ -31,6 +31,7 @@ double ModelHawkesLeastSq::loss(const ArrayDouble &coeffs) {
 // Full initialization of the arrays H, Dg, Dg2 and C
 // Must be performed just once
 void ModelHawkesLeastSq::compute_weights() {
+  TICK_TRACE_REGION("hawkes_leastsq_compute_weights");
   allocate_weights();
 
   compute_weights_timestamps_list();
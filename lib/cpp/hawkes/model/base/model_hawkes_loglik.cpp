@@ -42,6 +42,7 @@ void ModelHawkesLogLik::incremental_set_data(
 }
 
 void ModelHawkesLogLik::compute_weights() {
+  TICK_TRACE_REGION("hawkes_loglik_compute_weights");
   if (!model_list.empty() && timestamps_list.size() != model_list.size()) {
     TICK_ERROR(
         "Cannot compute weights as timestamps have not been stored. "
@@ -168,6 +169,37 @@ void ModelHawkesLogLik::hessian(const ArrayDouble &coeffs, ArrayDouble &out) {
   out /= get_n_total_jumps();
 }
 
+void ModelHawkesLogLik::compensator_increments_i_r(
+    const ulong i_r, const ArrayDouble &coeffs, SArrayDoublePtrList2D &out) {
+  ulong r, i;
+  std::tie(r, i) = get_realization_node(i_r);
+
+  model_list[r]->compensator_increments_dim_i(i, coeffs, out[r]);
+}
+
+SArrayDoublePtrList2D ModelHawkesLogLik::get_compensator_increments(
+    const ArrayDouble &coeffs) {
+  if (coeffs.size() != get_n_coeffs()) {
+    TICK_ERROR("coeffs has size " << coeffs.size() << " while the model expects "
+                                  << get_n_coeffs() << " coefficients");
+  }
+  if (!weights_computed) compute_weights();
+
+  SArrayDoublePtrList2D out(n_realizations);
+  for (ulong r = 0; r < n_realizations; ++r) {
+    out[r] = SArrayDoublePtrList1D(n_nodes);
+    for (ulong i = 0; i < n_nodes; ++i) {
+      out[r][i] =
+          SArrayDouble::new_ptr(model_list[r]->timestamps[i]->size());
+    }
+  }
+
+  parallel_run(get_n_threads(), n_realizations * n_nodes,
+               &ModelHawkesLogLik::compensator_increments_i_r, this, coeffs,
+               out);
+  return out;
+}
+
 std::pair<ulong, ulong> ModelHawkesLogLik::sampled_i_to_realization(
     const ulong sampled_i) {
   ulong cum_n_jumps = 0;
@@ -182,6 +214,25 @@ std::pair<ulong, ulong> ModelHawkesLogLik::sampled_i_to_realization(
   TICK_ERROR("sampled_i out of range");
 }
 
+ulong ModelHawkesLogLik::memory_usage() const {
+  ulong n_bytes = 0;
+  for (const auto &model : model_list) {
+    if (model) n_bytes += model->memory_usage();
+  }
+  return n_bytes;
+}
+
+ulong ModelHawkesLogLik::memory_footprint() const {
+  if (n_nodes == 0) return 0;
+  // All coefficients but the baselines are kernel coefficients
+  const ulong n_kernel_coeffs = (get_n_coeffs() - n_nodes) / n_nodes;
+  // Each realization has its own weights
+  return ModelHawkesLogLikSingle::n_weights(n_nodes * n_realizations,
+                                            get_n_total_jumps(),
+                                            n_kernel_coeffs) *
+         sizeof(double);
+}
+
 ulong ModelHawkesLogLik::get_n_coeffs() const {
   return n_nodes + n_nodes * n_nodes;
 }
@@ -16,6 +16,25 @@ void ModelHawkesLogLikSingle::allocate_weights() {
   TICK_CLASS_DOES_NOT_IMPLEMENT("");
 }
 
+ulong ModelHawkesLogLikSingle::n_weights(ulong n_nodes, ulong n_jumps,
+                                         ulong n_kernel_coeffs) {
+  // g has a row per jump, G a row per jump and per node and sum_G a row per
+  // node
+  return n_kernel_coeffs * (2 * n_jumps + 2 * n_nodes);
+}
+
+ulong ModelHawkesLogLikSingle::memory_usage() const {
+  return tick::array_bytes(g) + tick::array_bytes(G) +
+         tick::array_bytes(sum_G);
+}
+
+ulong ModelHawkesLogLikSingle::memory_footprint() const {
+  if (n_nodes == 0) return 0;
+  // All coefficients but the baselines are kernel coefficients
+  const ulong n_kernel_coeffs = (get_n_coeffs() - n_nodes) / n_nodes;
+  return n_weights(n_nodes, n_total_jumps, n_kernel_coeffs) * sizeof(double);
+}
+
 void ModelHawkesLogLikSingle::compute_weights_dim_i(const ulong i) {
   TICK_CLASS_DOES_NOT_IMPLEMENT("");
 }
@@ -100,6 +119,24 @@ void ModelHawkesLogLikSingle::hessian(const ArrayDouble &coeffs,
   out /= n_total_jumps;
 }
 
+SArrayDoublePtrList1D ModelHawkesLogLikSingle::get_compensator_increments(
+    const ArrayDouble &coeffs) {
+  if (coeffs.size() != get_n_coeffs()) {
+    TICK_ERROR("coeffs has size " << coeffs.size() << " while the model expects "
+                                  << get_n_coeffs() << " coefficients");
+  }
+  if (!weights_computed) compute_weights();
+
+  SArrayDoublePtrList1D out(n_nodes);
+  for (ulong i = 0; i < n_nodes; ++i)
+    out[i] = SArrayDouble::new_ptr((*n_jumps_per_node)[i]);
+
+  parallel_run(get_n_threads(), n_nodes,
+               &ModelHawkesLogLikSingle::compensator_increments_dim_i, this,
+               coeffs, out);
+  return out;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 //                                    PRIVATE METHODS
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -179,6 +216,24 @@ double ModelHawkesLogLikSingle::loss_i_k(const ulong i, const ulong k,
   return loss;
 }
 
+void ModelHawkesLogLikSingle::compensator_increments_dim_i(
+    const ulong i, const ArrayDouble &coeffs, SArrayDoublePtrList1D &out) {
+  const double mu_i = coeffs[i];
+  const ArrayDouble alpha_i =
+      view(coeffs, get_alpha_i_first_index(i), get_alpha_i_last_index(i));
+  const ArrayDouble t_i = view(*timestamps[i]);
+  ArrayDouble out_i = view(*out[i]);
+
+  // Row k of G[i] already holds the compensator of each unit kernel between
+  // t_i_(k-1) and t_i_k
+  double t_i_k_minus_one = 0;
+  for (ulong k = 0; k < (*n_jumps_per_node)[i]; ++k) {
+    out_i[k] = mu_i * (t_i[k] - t_i_k_minus_one) +
+               alpha_i.dot(view_row(G[i], k));
+    t_i_k_minus_one = t_i[k];
+  }
+}
+
 void ModelHawkesLogLikSingle::grad_dim_i(const ulong i,
                                          const ArrayDouble &coeffs,
                                          ArrayDouble &out) {
@@ -96,6 +96,16 @@ void ModelHawkesExpKernLeastSq::synchronize_aggregated_model() {
   casted_model->weights_computed = weights_computed;
 }
 
+ulong ModelHawkesExpKernLeastSq::memory_usage() const {
+  return tick::array_bytes(E) + tick::array_bytes(Dg) +
+         tick::array_bytes(Dg2) + tick::array_bytes(C);
+}
+
+ulong ModelHawkesExpKernLeastSq::memory_footprint() const {
+  return (n_realizations + 1) *
+         ModelHawkesExpKernLeastSqSingle::n_weights(n_nodes) * sizeof(double);
+}
+
 ulong ModelHawkesExpKernLeastSq::get_n_coeffs() const {
   return n_nodes + n_nodes * n_nodes;
 }
@@ -127,6 +127,19 @@ void ModelHawkesSumExpKernLeastSq::synchronize_aggregated_model() {
   casted_model->weights_computed = weights_computed;
 }
 
+ulong ModelHawkesSumExpKernLeastSq::memory_usage() const {
+  return tick::array_bytes(L) + tick::array_bytes(C) +
+         tick::array_bytes(Dg) + tick::array_bytes(Dgg) +
+         tick::array_bytes(E) + tick::array_bytes(K);
+}
+
+ulong ModelHawkesSumExpKernLeastSq::memory_footprint() const {
+  return (n_realizations + 1) *
+         ModelHawkesSumExpKernLeastSqSingle::n_weights(n_nodes, n_decays,
+                                                       n_baselines) *
+         sizeof(double);
+}
+
 ulong ModelHawkesSumExpKernLeastSq::get_n_coeffs() const {
   return n_nodes * n_baselines + n_nodes * n_nodes * n_decays;
 }
@@ -247,6 +247,20 @@ void ModelHawkesExpKernLeastSqSingle::compute_weights_i(const ulong i) {
   }
 }
 
+ulong ModelHawkesExpKernLeastSqSingle::n_weights(ulong n_nodes) {
+  // E, Dg, Dg2 and C
+  return n_nodes * n_nodes * n_nodes + 3 * n_nodes * n_nodes;
+}
+
+ulong ModelHawkesExpKernLeastSqSingle::memory_usage() const {
+  return tick::array_bytes(E) + tick::array_bytes(Dg) +
+         tick::array_bytes(Dg2) + tick::array_bytes(C);
+}
+
+ulong ModelHawkesExpKernLeastSqSingle::memory_footprint() const {
+  return n_weights(n_nodes) * sizeof(double);
+}
+
 ulong ModelHawkesExpKernLeastSqSingle::get_n_coeffs() const {
   return n_nodes + n_nodes * n_nodes;
 }
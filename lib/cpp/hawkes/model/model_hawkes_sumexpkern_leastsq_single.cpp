@@ -313,6 +313,26 @@ void ModelHawkesSumExpKernLeastSqSingle::compute_weights() {
   weights_computed = true;
 }
 
+ulong ModelHawkesSumExpKernLeastSqSingle::n_weights(ulong n_nodes,
+                                                    ulong n_decays,
+                                                    ulong n_baselines) {
+  // L, then C, Dg, Dgg, E and K for each node
+  return n_baselines +
+         n_nodes * (n_nodes * n_decays + n_decays * n_baselines +
+                    n_decays * n_decays + n_nodes * n_decays * n_decays +
+                    n_baselines);
+}
+
+ulong ModelHawkesSumExpKernLeastSqSingle::memory_usage() const {
+  return tick::array_bytes(L) + tick::array_bytes(C) +
+         tick::array_bytes(Dg) + tick::array_bytes(Dgg) +
+         tick::array_bytes(E) + tick::array_bytes(K);
+}
+
+ulong ModelHawkesSumExpKernLeastSqSingle::memory_footprint() const {
+  return n_weights(n_nodes, n_decays, n_baselines) * sizeof(double);
+}
+
 ulong ModelHawkesSumExpKernLeastSqSingle::get_n_coeffs() const {
   return n_nodes * n_baselines + n_nodes * n_nodes * n_decays;
 }
@@ -31,3 +31,82 @@ double HawkesKernelPowerLaw::get_norm(int nsteps) {
                 multiplier / (1 - exponent);
   return norm;
 }
+
+std::shared_ptr<HawkesKernelSumExp>
+HawkesKernelPowerLaw::get_sum_exp_approximation(double relative_error,
+                                                ulong max_n_decays) {
+  if (exponent <= 0 || cutoff <= 0) {
+    TICK_ERROR(
+        "Sum of exponential approximation requires positive exponent and "
+        "cutoff");
+  }
+  if (relative_error <= 0) TICK_ERROR("relative_error must be positive");
+
+  const double gamma_exponent = std::tgamma(exponent);
+
+  // Relative error is checked on a logarithmic grid of [0, support]
+  const ulong n_checks = 500;
+  ArrayDouble check_times(n_checks), check_values(n_checks);
+  for (ulong p = 0; p < n_checks; ++p) {
+    check_times[p] =
+        p == 0 ? 0
+               : cutoff * std::pow((support + cutoff) / cutoff,
+                                   static_cast<double>(p) / (n_checks - 1)) -
+                     cutoff;
+    check_values[p] = std::pow(check_times[p] + cutoff, -exponent);
+  }
+
+  // With u = log(s), the integrand is exp(exponent u - (cutoff + t) e^u). Small
+  // decays are truncated such that the neglected mass is below a third of the
+  // error at support, and large ones once the integrand vanishes at t = 0
+  const double log_error = std::log(relative_error / 3);
+  const double u_min =
+      (log_error + std::log(exponent * gamma_exponent)) / exponent -
+      std::log(support + cutoff);
+  double u_max = std::log((exponent - log_error) / cutoff);
+  double step = 1.;
+
+  ArrayDouble intensities, decays;
+  while (true) {
+    const ulong n_decays =
+        static_cast<ulong>(std::ceil((u_max - u_min) / step)) + 1;
+    if (n_decays > max_n_decays) {
+      TICK_ERROR("Relative error " << relative_error << " cannot be reached "
+                                   << "with " << max_n_decays
+                                   << " exponentials");
+    }
+
+    ArrayDouble weights(n_decays);
+    decays = ArrayDouble(n_decays);
+    for (ulong k = 0; k < n_decays; ++k) {
+      const double u = u_min + k * step;
+      decays[k] = std::exp(u);
+      weights[k] =
+          step * std::exp(exponent * u - cutoff * decays[k]) / gamma_exponent;
+    }
+
+    double max_error = 0;
+    for (ulong p = 0; p < n_checks; ++p) {
+      double approximation = 0;
+      for (ulong k = 0; k < n_decays; ++k) {
+        approximation += weights[k] * std::exp(-decays[k] * check_times[p]);
+      }
+      max_error = std::max(max_error,
+                           std::abs(approximation / check_values[p] - 1));
+    }
+
+    if (max_error <= relative_error) {
+      // Sum of exponential kernel is sum_k intensities[k] decays[k]
+      // exp(-decays[k] t)
+      intensities = ArrayDouble(n_decays);
+      for (ulong k = 0; k < n_decays; ++k) {
+        intensities[k] = multiplier * weights[k] / decays[k];
+      }
+      break;
+    }
+    step *= 0.75;
+    u_max += 0.5;
+  }
+
+  return std::make_shared<HawkesKernelSumExp>(intensities, decays);
+}
@@ -0,0 +1,87 @@
+// License: BSD 3 clause
+
+#include "tick/hawkes/simulation/simu_event_sink.h"
+
+#include <cstdint>
+#include <vector>
+
+PPBatchEventSink::PPBatchEventSink(ulong batch_size)
+    : times(batch_size), nodes(batch_size), n_buffered(0) {
+  if (batch_size == 0) TICK_ERROR("batch_size must be positive");
+}
+
+void PPBatchEventSink::flush() {
+  if (n_buffered == 0) return;
+  // Views on the buffered part of the buffers
+  const ArrayDouble batch_times(n_buffered, times.data());
+  const ArrayULong batch_nodes(n_buffered, nodes.data());
+  n_buffered = 0;
+  write_batch_(batch_times, batch_nodes);
+}
+
+PPFileEventSink::PPFileEventSink(const std::string &path, ulong batch_size)
+    : PPBatchEventSink(batch_size),
+      path(path),
+      stream(path, std::ios::binary | std::ios::trunc) {
+  if (!stream) TICK_ERROR("Cannot open " << path << " for writing");
+}
+
+PPFileEventSink::~PPFileEventSink() {
+  try {
+    flush();
+  } catch (...) {
+  }
+}
+
+void PPFileEventSink::flush() {
+  PPBatchEventSink::flush();
+  stream.flush();
+}
+
+void PPFileEventSink::write_batch_(const ArrayDouble &times,
+                                   const ArrayULong &nodes) {
+  const std::uint64_t n_events = times.size();
+  std::vector<std::uint64_t> nodes_64(nodes.data(),
+                                      nodes.data() + nodes.size());
+  stream.write(reinterpret_cast<const char *>(&n_events), sizeof(n_events));
+  stream.write(reinterpret_cast<const char *>(times.data()),
+               sizeof(double) * n_events);
+  stream.write(reinterpret_cast<const char *>(nodes_64.data()),
+               sizeof(std::uint64_t) * n_events);
+  if (!stream) TICK_ERROR("Cannot write events to " << path);
+}
+
+SArrayDoublePtrList1D PPFileEventSink::read(const std::string &path,
+                                            ulong n_nodes) {
+  std::ifstream stream(path, std::ios::binary);
+  if (!stream) TICK_ERROR("Cannot open " << path << " for reading");
+
+  std::vector<std::vector<double>> node_times(n_nodes);
+  std::vector<double> times;
+  std::vector<std::uint64_t> nodes;
+  std::uint64_t n_events;
+  while (stream.read(reinterpret_cast<char *>(&n_events), sizeof(n_events))) {
+    times.resize(n_events);
+    nodes.resize(n_events);
+    stream.read(reinterpret_cast<char *>(times.data()),
+                sizeof(double) * n_events);
+    stream.read(reinterpret_cast<char *>(nodes.data()),
+                sizeof(std::uint64_t) * n_events);
+    if (!stream) TICK_ERROR("Truncated events file " << path);
+    for (ulong k = 0; k < n_events; ++k) {
+      if (nodes[k] >= n_nodes) TICK_BAD_INDEX(0, n_nodes, nodes[k]);
+      node_times[nodes[k]].push_back(times[k]);
+    }
+  }
+
+  SArrayDoublePtrList1D timestamps(n_nodes);
+  for (ulong i = 0; i < n_nodes; ++i) {
+    timestamps[i] = SArrayDouble::new_ptr(node_times[i].size());
+    std::copy(node_times[i].begin(), node_times[i].end(),
+              timestamps[i]->data());
+  }
+  return timestamps;
+}
+
+PPCallbackEventSink::PPCallbackEventSink(Callback callback, ulong batch_size)
+    : PPBatchEventSink(batch_size), callback(std::move(callback)) {}
@@ -2,6 +2,31 @@
 
 #include "tick/hawkes/simulation/simu_hawkes.h"
 
+#include <algorithm>
+#include <tuple>
+
+namespace {
+
+// Fills intensities and decays if the kernel can be written as
+// sum_u intensities[u] decays[u] e^{-decays[u] t}, returns false otherwise
+bool get_exponential_parameters(const HawkesKernelPtr &kernel,
+                                ArrayDouble &intensities, ArrayDouble &decays) {
+  if (auto kernel_exp = std::dynamic_pointer_cast<HawkesKernelExp>(kernel)) {
+    intensities = ArrayDouble{kernel_exp->get_intensity()};
+    decays = ArrayDouble{kernel_exp->get_decay()};
+    return true;
+  }
+  if (auto kernel_sum_exp =
+          std::dynamic_pointer_cast<HawkesKernelSumExp>(kernel)) {
+    intensities = *kernel_sum_exp->get_intensities();
+    decays = *kernel_sum_exp->get_decays();
+    return true;
+  }
+  return false;
+}
+
+}  // namespace
+
 Hawkes::Hawkes(unsigned int n_nodes, int seed)
     : PP(n_nodes, seed), kernels(n_nodes * n_nodes), baselines(n_nodes) {
   for (unsigned int i = 0; i < n_nodes; i++) {
@@ -54,6 +79,7 @@ bool Hawkes::update_time_shift_(double delay, ArrayDouble &intensity,
 }
 
 void Hawkes::reset() {
+  event_driven_ready = false;
   for (unsigned int i = 0; i < n_nodes; i++) {
     for (unsigned int j = 0; j < n_nodes; j++) {
       if (kernels[i * n_nodes + j] != nullptr)
@@ -69,6 +95,7 @@ void Hawkes::set_kernel(unsigned int i, unsigned int j,
   if (j >= n_nodes) TICK_BAD_INDEX(0, n_nodes, j);
 
   kernels[i * n_nodes + j].reset();
+  event_driven_ready = false;
 
   if (kernel == nullptr)
     kernel = std::make_shared<HawkesKernel>();
@@ -89,6 +116,7 @@ void Hawkes::set_baseline(unsigned int i, const HawkesBaselinePtr &baseline) {
 
   if (baseline) {
     baselines[i] = baseline;
+    event_driven_ready = false;
   }
 }
 
@@ -122,3 +150,315 @@ double Hawkes::get_baseline_bound(unsigned int i, double t) {
 
   return baselines[i]->get_future_bound(t);
 }
+
+bool Hawkes::init_event_driven_() {
+  if (event_driven_ready && event_driven_n_total_jumps == get_n_total_jumps()) {
+    for (ulong i = 0; i < n_nodes; i++) update_event_driven_bound_(i);
+    return true;
+  }
+  event_driven_ready = false;
+
+  for (ulong i = 0; i < n_nodes; i++) {
+    auto baseline = std::dynamic_pointer_cast<HawkesConstantBaseline>(
+        baselines[i]);
+    if (baseline && baseline->get_value(0.) < 0) return false;
+  }
+
+  // Node i excitations decays, and for each node j the
+  // (node, local excitation index, weight) it excites
+  std::vector<std::vector<double>> node_decays(n_nodes);
+  std::vector<std::vector<std::tuple<ulong, ulong, double>>> out_adjacency(
+      n_nodes);
+  ulong n_out_adjacency = 0;
+  for (ulong i = 0; i < n_nodes; i++) {
+    for (ulong j = 0; j < n_nodes; j++) {
+      const HawkesKernelPtr &kernel = kernels[i * n_nodes + j];
+      if (kernel->is_zero()) continue;
+
+      ArrayDouble intensities, decays;
+      if (!get_exponential_parameters(kernel, intensities, decays)) {
+        return false;
+      }
+      for (ulong u = 0; u < decays.size(); u++) {
+        if (intensities[u] < 0) return false;
+        if (intensities[u] == 0) continue;
+
+        std::vector<double> &decays_i = node_decays[i];
+        const ulong e = std::find(decays_i.begin(), decays_i.end(), decays[u]) -
+                        decays_i.begin();
+        if (e == decays_i.size()) decays_i.push_back(decays[u]);
+        out_adjacency[j].emplace_back(i, e, intensities[u] * decays[u]);
+        n_out_adjacency++;
+      }
+    }
+  }
+
+  // The excitation is rebuilt from the stored jumps, jumps streamed to an
+  // event sink are lost
+  ulong n_stored_jumps = 0;
+  for (ulong j = 0; j < n_nodes; j++) n_stored_jumps += timestamps[j]->size();
+  if (n_stored_jumps != get_n_total_jumps()) {
+    TICK_ERROR(
+        "Kernels or baselines cannot be changed once jumps have been "
+        "streamed to an event sink, call reset first");
+  }
+
+  excitation_ptr = ArrayULong(n_nodes + 1);
+  excitation_ptr[0] = 0;
+  for (ulong i = 0; i < n_nodes; i++) {
+    excitation_ptr[i + 1] = excitation_ptr[i] + node_decays[i].size();
+  }
+  excitation_decays = ArrayDouble(excitation_ptr[n_nodes]);
+  excitation_values = ArrayDouble(excitation_ptr[n_nodes]);
+  excitation_values.init_to_zero();
+  excitation_times = ArrayDouble(n_nodes);
+  excitation_times.fill(get_time());
+  for (ulong i = 0; i < n_nodes; i++) {
+    std::copy(node_decays[i].begin(), node_decays[i].end(),
+              excitation_decays.data() + excitation_ptr[i]);
+  }
+
+  out_adjacency_ptr = ArrayULong(n_nodes + 1);
+  out_adjacency_nodes = ArrayULong(n_out_adjacency);
+  out_adjacency_excitations = ArrayULong(n_out_adjacency);
+  out_adjacency_weights = ArrayDouble(n_out_adjacency);
+  out_adjacency_ptr[0] = 0;
+  for (ulong j = 0; j < n_nodes; j++) {
+    ulong k = out_adjacency_ptr[j];
+    for (const auto &entry : out_adjacency[j]) {
+      out_adjacency_nodes[k] = std::get<0>(entry);
+      out_adjacency_excitations[k] =
+          excitation_ptr[std::get<0>(entry)] + std::get<1>(entry);
+      out_adjacency_weights[k] = std::get<2>(entry);
+      k++;
+    }
+    out_adjacency_ptr[j + 1] = k;
+  }
+
+  // Excitation of the jumps that have already occurred
+  for (ulong j = 0; j < n_nodes; j++) {
+    const ArrayDouble t_j = view(*timestamps[j]);
+    for (ulong k = out_adjacency_ptr[j]; k < out_adjacency_ptr[j + 1]; k++) {
+      const ulong e = out_adjacency_excitations[k];
+      for (ulong l = 0; l < t_j.size(); l++) {
+        excitation_values[e] += out_adjacency_weights[k] *
+                                std::exp(-excitation_decays[e] *
+                                         (get_time() - t_j[l]));
+      }
+    }
+  }
+
+  for (ulong i = 0; i < n_nodes; i++) update_event_driven_bound_(i);
+
+  event_driven_ready = true;
+  event_driven_n_total_jumps = get_n_total_jumps();
+  return true;
+}
+
+double Hawkes::update_excitation(ulong i) {
+  const double delay = get_time() - excitation_times[i];
+  excitation_times[i] = get_time();
+
+  double excitation = 0;
+  for (ulong e = excitation_ptr[i]; e < excitation_ptr[i + 1]; e++) {
+    double &value = excitation_values[e];
+    if (delay > 0) value *= std::exp(-excitation_decays[e] * delay);
+    excitation += value;
+  }
+  return excitation;
+}
+
+double Hawkes::get_event_driven_intensity_(ulong i) {
+  return get_baseline(i, get_time()) + update_excitation(i);
+}
+
+void Hawkes::update_event_driven_bound_(ulong i) {
+  set_node_intensity_bound(
+      i, get_baseline_bound(i, get_time()) + update_excitation(i));
+}
+
+void Hawkes::update_event_driven_jump_(ulong j) {
+  const ulong start = out_adjacency_ptr[j], end = out_adjacency_ptr[j + 1];
+  for (ulong k = start; k < end; k++) {
+    const ulong i = out_adjacency_nodes[k];
+    // Entries of a given node are contiguous
+    if (k == start || out_adjacency_nodes[k - 1] != i) update_excitation(i);
+    excitation_values[out_adjacency_excitations[k]] += out_adjacency_weights[k];
+    if (k + 1 == end || out_adjacency_nodes[k + 1] != i) {
+      update_event_driven_bound_(i);
+    }
+  }
+  event_driven_n_total_jumps = get_n_total_jumps();
+}
+
+SArrayDoublePtrList1D Hawkes::get_compensator_increments(int n_threads) {
+  for (unsigned int i = 0; i < n_nodes; i++) {
+    if (!std::dynamic_pointer_cast<HawkesConstantBaseline>(baselines[i])) {
+      TICK_ERROR(
+          "Compensator increments can only be computed with constant "
+          "baselines");
+    }
+    for (unsigned int j = 0; j < n_nodes; j++) {
+      const HawkesKernelPtr &kernel = kernels[i * n_nodes + j];
+      if (kernel->is_zero()) continue;
+      ArrayDouble intensities, decays;
+      if (!get_exponential_parameters(kernel, intensities, decays)) {
+        TICK_ERROR(
+            "Compensator increments can only be computed with exponential "
+            "or sum of exponential kernels");
+      }
+    }
+  }
+
+  SArrayDoublePtrList1D out(n_nodes);
+  for (unsigned int i = 0; i < n_nodes; i++) {
+    out[i] = SArrayDouble::new_ptr(timestamps[i]->size());
+  }
+
+  if (n_threads <= 0) n_threads = std::thread::hardware_concurrency();
+  parallel_run(n_threads, n_nodes, &Hawkes::compensator_increments_dim_i, this,
+               out);
+  return out;
+}
+
+void Hawkes::compensator_increments_dim_i(const ulong i,
+                                          SArrayDoublePtrList1D &out) {
+  const ArrayDouble t_i = view(*timestamps[i]);
+  ArrayDouble out_i = view(*out[i]);
+  const ulong n_jumps_i = t_i.size();
+
+  const double mu_i = baselines[i]->get_value(0.);
+  double t_i_k_minus_one = 0;
+  for (ulong k = 0; k < n_jumps_i; k++) {
+    out_i[k] = mu_i * (t_i[k] - t_i_k_minus_one);
+    t_i_k_minus_one = t_i[k];
+  }
+
+  for (ulong j = 0; j < n_nodes; j++) {
+    const HawkesKernelPtr &kernel = kernels[i * n_nodes + j];
+    if (kernel->is_zero()) continue;
+
+    ArrayDouble intensities, decays;
+    get_exponential_parameters(kernel, intensities, decays);
+    const ulong n_decays = decays.size();
+
+    // g[u] is sum_{t_j < t_i_(k-1)} e^{-decays[u] (t_i_(k-1) - t_j)}
+    ArrayDouble g(n_decays);
+    g.init_to_zero();
+
+    const ArrayDouble t_j = view(*timestamps[j]);
+    const ulong n_jumps_j = t_j.size();
+    ulong ij = 0;
+    t_i_k_minus_one = 0;
+    for (ulong k = 0; k < n_jumps_i; k++) {
+      const double t_i_k = t_i[k];
+      double increment = 0;
+      for (ulong u = 0; u < n_decays; u++) {
+        const double ebt = std::exp(-decays[u] * (t_i_k - t_i_k_minus_one));
+        increment += intensities[u] * g[u] * (1 - ebt);
+        g[u] *= ebt;
+      }
+      while (ij < n_jumps_j && t_j[ij] < t_i_k) {
+        for (ulong u = 0; u < n_decays; u++) {
+          const double ebt = std::exp(-decays[u] * (t_i_k - t_j[ij]));
+          increment += intensities[u] * (1 - ebt);
+          g[u] += ebt;
+        }
+        ij++;
+      }
+      out_i[k] += increment;
+      t_i_k_minus_one = t_i_k;
+    }
+  }
+}
+
+SArrayDoublePtrList1D Hawkes::get_intensity(
+    const SArrayDoublePtrList1D &timestamps, const ArrayDouble &times,
+    int n_threads) {
+  if (timestamps.size() != n_nodes) {
+    TICK_ERROR("Should provide n_nodes (" << n_nodes
+                                          << ") arrays for timestamps but was "
+                                          << timestamps.size());
+  }
+  for (ulong p = 1; p < times.size(); p++) {
+    if (times[p] < times[p - 1]) {
+      TICK_ERROR("Times at which intensity is computed must be sorted");
+    }
+  }
+
+  SArrayDoublePtrList1D out(n_nodes);
+  for (unsigned int i = 0; i < n_nodes; i++) {
+    out[i] = SArrayDouble::new_ptr(times.size());
+  }
+
+  if (n_threads <= 0) n_threads = std::thread::hardware_concurrency();
+  parallel_run(n_threads, n_nodes, &Hawkes::intensity_dim_i, this, timestamps,
+               times, out);
+  return out;
+}
+
+void Hawkes::intensity_dim_i(const ulong i,
+                             const SArrayDoublePtrList1D &timestamps,
+                             const ArrayDouble &times,
+                             SArrayDoublePtrList1D &out) {
+  ArrayDouble out_i = view(*out[i]);
+  const ulong n_times = times.size();
+
+  for (ulong p = 0; p < n_times; p++) {
+    out_i[p] = baselines[i]->get_value(times[p]);
+  }
+
+  for (ulong j = 0; j < n_nodes; j++) {
+    const HawkesKernelPtr &kernel = kernels[i * n_nodes + j];
+    if (kernel->is_zero()) continue;
+
+    const ArrayDouble t_j = view(*timestamps[j]);
+    const ulong n_jumps_j = t_j.size();
+
+    ArrayDouble intensities, decays;
+    if (get_exponential_parameters(kernel, intensities, decays)) {
+      // Single merged sweep over events and times where
+      // g[u] = sum_{t_j < t} e^{-decays[u] (t - t_j)} at the last time t
+      const ulong n_decays = decays.size();
+      ArrayDouble g(n_decays);
+      g.init_to_zero();
+
+      ulong ij = 0;
+      double last_time = n_times > 0 ? times[0] : 0;
+      for (ulong p = 0; p < n_times; p++) {
+        const double t = times[p];
+        double value = 0;
+        for (ulong u = 0; u < n_decays; u++) {
+          g[u] *= std::exp(-decays[u] * (t - last_time));
+        }
+        while (ij < n_jumps_j && t_j[ij] < t) {
+          for (ulong u = 0; u < n_decays; u++) {
+            g[u] += std::exp(-decays[u] * (t - t_j[ij]));
+          }
+          ij++;
+        }
+        for (ulong u = 0; u < n_decays; u++) {
+          value += intensities[u] * decays[u] * g[u];
+        }
+        out_i[p] += value;
+        last_time = t;
+      }
+    } else {
+      // Events contributing at time t lie in the window
+      // [t - support, t), whose bounds only move forward
+      const double support = kernel->get_support();
+      ulong first = 0, last = 0;
+      for (ulong p = 0; p < n_times; p++) {
+        const double t = times[p];
+        while (last < n_jumps_j && t_j[last] < t) last++;
+        while (first < last && t - t_j[first] >= support) first++;
+
+        double value = 0;
+        for (ulong ij = first; ij < last; ij++) {
+          value += kernel->get_value(t - t_j[ij]);
+        }
+        out_i[p] += value;
+      }
+    }
+  }
+}
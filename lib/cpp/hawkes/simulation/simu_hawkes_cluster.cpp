@@ -0,0 +1,298 @@
+// License: BSD 3 clause
+
+#include "tick/hawkes/simulation/simu_hawkes.h"
+#include "tick/hawkes/simulation/simu_inhomogeneous_poisson.h"
+#include "tick/random/alias_table.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+// Number of parent events whose offspring is drawn with the same random
+// generator. Results only depend on the seed, not on the number of threads
+constexpr ulong CLUSTER_CHUNK_SIZE = 4096;
+
+/**
+ * Offspring law of a node on a child node: its number of children is Poisson
+ * distributed with mean the norm of the kernel, and their delays are drawn
+ * from the kernel normalized by its norm
+ */
+struct ClusterKernel {
+  ulong child_node;
+  double norm;
+
+  // Sum of exponentials: components are chosen proportionally to their
+  // intensities
+  AliasTable components;
+  std::vector<double> decays;
+
+  // Power law alpha (x + cutoff)^(-exponent) on [0, support]
+  bool power_law = false;
+  double cutoff = 0, exponent = 0, support = 0;
+
+  double sample_delay(Rand &rand) const {
+    if (power_law) {
+      const double u = rand.uniform();
+      const double p = 1 - exponent;
+      if (std::abs(p) < 1e-12) {
+        return cutoff * std::pow((support + cutoff) / cutoff, u) - cutoff;
+      }
+      const double a = std::pow(cutoff, p);
+      const double b = std::pow(support + cutoff, p);
+      return std::pow(a + u * (b - a), 1 / p) - cutoff;
+    }
+    const ulong u = decays.size() > 1 ? components.sample(rand) : 0;
+    return rand.exponential(decays[u]);
+  }
+};
+
+/**
+ * Simulates a Hawkes process generation by generation from its immigrant -
+ * offspring representation: immigrants are Poisson processes of intensity
+ * the baselines and each event of node j independently gives birth to
+ * events on node i according to kernel (i, j)
+ */
+class ClusterSimulator {
+  ulong n_nodes;
+  double end_time;
+  ArrayDouble baselines;
+
+  //! @brief Time varying baselines, nullptr for constant baselines
+  std::vector<std::shared_ptr<TimeFunction>> baseline_functions;
+
+  //! @brief Offspring laws of each parent node
+  std::vector<std::vector<ClusterKernel>> offspring_kernels;
+
+  //! @brief Generator of the simulation, whose substreams indexed by
+  //! generation and chunk sample each chunk
+  Rand simulation_rand;
+  ulong generation;
+
+  //! @brief Events of the current generation
+  std::vector<double> parent_times;
+  std::vector<ulong> parent_nodes;
+
+  //! @brief Events generated from each chunk of parents (or from each node
+  //! for immigrants)
+  std::vector<std::vector<double>> chunk_times;
+  std::vector<std::vector<ulong>> chunk_nodes;
+
+  //! @brief All simulated events, generation by generation
+  std::vector<double> all_times;
+  std::vector<ulong> all_nodes;
+
+  VArrayDoublePtrList1D timestamps;
+
+ public:
+  ClusterSimulator(
+      const ArrayDouble &baselines,
+      std::vector<std::shared_ptr<TimeFunction>> baseline_functions,
+      std::vector<std::vector<ClusterKernel>> offspring_kernels,
+      double end_time, Rand simulation_rand)
+      : n_nodes(baselines.size()),
+        end_time(end_time),
+        baselines(baselines),
+        baseline_functions(std::move(baseline_functions)),
+        offspring_kernels(std::move(offspring_kernels)),
+        simulation_rand(std::move(simulation_rand)),
+        generation(0) {}
+
+  VArrayDoublePtrList1D simulate(unsigned int n_threads) {
+    chunk_times = std::vector<std::vector<double>>(n_nodes);
+    chunk_nodes = std::vector<std::vector<ulong>>(n_nodes);
+    parallel_run(n_threads, n_nodes, &ClusterSimulator::simulate_immigrants,
+                 this);
+    gather_generation();
+
+    while (!parent_times.empty()) {
+      generation++;
+      const ulong n_chunks =
+          (parent_times.size() + CLUSTER_CHUNK_SIZE - 1) / CLUSTER_CHUNK_SIZE;
+      chunk_times = std::vector<std::vector<double>>(n_chunks);
+      chunk_nodes = std::vector<std::vector<ulong>>(n_chunks);
+      parallel_run(n_threads, n_chunks, &ClusterSimulator::simulate_offspring,
+                   this);
+      gather_generation();
+    }
+
+    // Events are bucketed by node and each node is sorted independently
+    ArrayULong n_jumps_per_node(n_nodes);
+    n_jumps_per_node.init_to_zero();
+    for (const ulong node : all_nodes) n_jumps_per_node[node]++;
+
+    timestamps = VArrayDoublePtrList1D(n_nodes);
+    for (ulong i = 0; i < n_nodes; i++) {
+      timestamps[i] = VArrayDouble::new_ptr(n_jumps_per_node[i]);
+    }
+    n_jumps_per_node.init_to_zero();
+    for (ulong k = 0; k < all_times.size(); k++) {
+      const ulong node = all_nodes[k];
+      (*timestamps[node])[n_jumps_per_node[node]++] = all_times[k];
+    }
+    parallel_run(n_threads, n_nodes, &ClusterSimulator::sort_node, this);
+    return timestamps;
+  }
+
+ private:
+  Rand chunk_rand(ulong chunk) const {
+    return simulation_rand.substream(generation).substream(chunk);
+  }
+
+  void simulate_immigrants(ulong i) {
+    Rand rand = chunk_rand(i);
+    if (baseline_functions[i]) {
+      VArrayDouble immigrants;
+      if (!sample_inhomogeneous_poisson(*baseline_functions[i], 0., end_time,
+                                        rand, immigrants)) {
+        TICK_ERROR("Cluster simulation requires non-negative baselines");
+      }
+      chunk_times[i].assign(immigrants.data(),
+                            immigrants.data() + immigrants.size());
+      chunk_nodes[i].assign(immigrants.size(), i);
+      return;
+    }
+
+    if (baselines[i] <= 0) return;
+    ArrayDouble immigrants(rand.poisson(baselines[i] * end_time));
+    rand.uniform(immigrants);
+    immigrants.mult_fill(immigrants, end_time);
+    chunk_times[i].assign(immigrants.data(),
+                          immigrants.data() + immigrants.size());
+    chunk_nodes[i].assign(immigrants.size(), i);
+  }
+
+  void simulate_offspring(ulong chunk) {
+    Rand rand = chunk_rand(chunk);
+    const ulong start = chunk * CLUSTER_CHUNK_SIZE;
+    const ulong end = std::min(start + CLUSTER_CHUNK_SIZE, parent_times.size());
+    std::vector<double> &times = chunk_times[chunk];
+    std::vector<ulong> &nodes = chunk_nodes[chunk];
+
+    for (ulong k = start; k < end; k++) {
+      const double parent_time = parent_times[k];
+      for (const ClusterKernel &kernel : offspring_kernels[parent_nodes[k]]) {
+        const int n_children = rand.poisson(kernel.norm);
+        for (int c = 0; c < n_children; c++) {
+          const double t = parent_time + kernel.sample_delay(rand);
+          if (t < end_time) {
+            times.push_back(t);
+            nodes.push_back(kernel.child_node);
+          }
+        }
+      }
+    }
+  }
+
+  void gather_generation() {
+    parent_times.clear();
+    parent_nodes.clear();
+    for (ulong c = 0; c < chunk_times.size(); c++) {
+      parent_times.insert(parent_times.end(), chunk_times[c].begin(),
+                          chunk_times[c].end());
+      parent_nodes.insert(parent_nodes.end(), chunk_nodes[c].begin(),
+                          chunk_nodes[c].end());
+    }
+    all_times.insert(all_times.end(), parent_times.begin(),
+                     parent_times.end());
+    all_nodes.insert(all_nodes.end(), parent_nodes.begin(),
+                     parent_nodes.end());
+  }
+
+  void sort_node(ulong i) {
+    std::sort(timestamps[i]->data(),
+              timestamps[i]->data() + timestamps[i]->size());
+  }
+};
+
+}  // namespace
+
+void Hawkes::simulate_cluster(double end_time, int n_threads) {
+  if (get_time() > 0 || get_n_total_jumps() > 0) {
+    TICK_ERROR(
+        "Cluster simulation must start from an empty realization, "
+        "call reset() first");
+  }
+  if (itr_on()) {
+    TICK_ERROR("Intensity cannot be track recorded in cluster simulation");
+  }
+
+  ArrayDouble constant_baselines(n_nodes);
+  constant_baselines.init_to_zero();
+  std::vector<std::shared_ptr<TimeFunction>> baseline_functions(n_nodes);
+  for (ulong i = 0; i < n_nodes; i++) {
+    if (auto time_function_baseline =
+            std::dynamic_pointer_cast<HawkesTimeFunctionBaseline>(
+                baselines[i])) {
+      baseline_functions[i] = std::make_shared<TimeFunction>(
+          time_function_baseline->get_time_function());
+      continue;
+    }
+    if (!std::dynamic_pointer_cast<HawkesConstantBaseline>(baselines[i])) {
+      TICK_ERROR(
+          "Cluster simulation can only be used with constant or time "
+          "function baselines");
+    }
+    constant_baselines[i] = get_baseline(i, 0.);
+    if (constant_baselines[i] < 0) {
+      TICK_ERROR("Cluster simulation requires non-negative baselines");
+    }
+  }
+
+  std::vector<std::vector<ClusterKernel>> offspring_kernels(n_nodes);
+  for (ulong i = 0; i < n_nodes; i++) {
+    for (ulong j = 0; j < n_nodes; j++) {
+      const HawkesKernelPtr &kernel = kernels[i * n_nodes + j];
+      if (kernel->is_zero()) continue;
+
+      ClusterKernel cluster_kernel;
+      cluster_kernel.child_node = i;
+      if (auto kernel_power_law =
+              std::dynamic_pointer_cast<HawkesKernelPowerLaw>(kernel)) {
+        if (kernel_power_law->get_multiplier() < 0) {
+          TICK_ERROR("Cluster simulation requires non-negative kernels");
+        }
+        cluster_kernel.power_law = true;
+        cluster_kernel.cutoff = kernel_power_law->get_cutoff();
+        cluster_kernel.exponent = kernel_power_law->get_exponent();
+        cluster_kernel.support = kernel_power_law->get_support();
+      } else {
+        ArrayDouble intensities, decays;
+        if (auto kernel_exp =
+                std::dynamic_pointer_cast<HawkesKernelExp>(kernel)) {
+          intensities = ArrayDouble{kernel_exp->get_intensity()};
+          decays = ArrayDouble{kernel_exp->get_decay()};
+        } else if (auto kernel_sum_exp =
+                       std::dynamic_pointer_cast<HawkesKernelSumExp>(kernel)) {
+          intensities = *kernel_sum_exp->get_intensities();
+          decays = *kernel_sum_exp->get_decays();
+        } else {
+          TICK_ERROR(
+              "Cluster simulation can only be used with exponential, sum of "
+              "exponential and power law kernels");
+        }
+        if (intensities.min() < 0) {
+          TICK_ERROR("Cluster simulation requires non-negative kernels");
+        }
+        if (intensities.sum() > 0) {
+          cluster_kernel.components = AliasTable(intensities);
+        }
+        cluster_kernel.decays.assign(decays.data(),
+                                     decays.data() + decays.size());
+      }
+
+      cluster_kernel.norm = kernel->get_norm();
+      if (cluster_kernel.norm > 0) {
+        offspring_kernels[j].push_back(std::move(cluster_kernel));
+      }
+    }
+  }
+
+  if (n_threads <= 0) n_threads = std::thread::hardware_concurrency();
+  Rand simulation_rand = get_rand().substream(
+      get_rand().uniform_int(0ul, std::numeric_limits<ulong>::max()));
+  ClusterSimulator simulator(constant_baselines, std::move(baseline_functions),
+                             std::move(offspring_kernels), end_time,
+                             std::move(simulation_rand));
+  set_realization(simulator.simulate(n_threads), end_time);
+}
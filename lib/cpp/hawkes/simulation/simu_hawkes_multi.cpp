@@ -0,0 +1,118 @@
+// License: BSD 3 clause
+
+#include "tick/hawkes/simulation/simu_hawkes_multi.h"
+
+#include <limits>
+
+HawkesMulti::HawkesMulti(Hawkes &model, ulong n_realizations, int seed) {
+  if (n_realizations == 0) {
+    TICK_ERROR("n_realizations must be greater or equal to 1");
+  }
+
+  const unsigned int n_nodes = model.get_n_nodes();
+  realizations.reserve(n_realizations);
+  for (ulong r = 0; r < n_realizations; ++r) {
+    std::unique_ptr<Hawkes> realization(new Hawkes(n_nodes, 0));
+    for (unsigned int i = 0; i < n_nodes; ++i) {
+      realization->baselines[i] = model.baselines[i];
+      for (unsigned int j = 0; j < n_nodes; ++j) {
+        HawkesKernelPtr kernel = model.get_kernel(i, j);
+        realization->set_kernel(i, j, kernel);
+      }
+    }
+    realization->set_threshold_negative_intensity(
+        model.get_threshold_negative_intensity());
+    if (model.itr_on()) {
+      realization->activate_itr(model.get_itr_base_step(),
+                                model.get_itr_max_size());
+    }
+    realizations.push_back(std::move(realization));
+  }
+  reseed(seed);
+}
+
+void HawkesMulti::reseed(int seed) {
+  seeds = std::vector<int>(realizations.size(), -1);
+  if (seed >= 0) {
+    // The seed of a realization only depends on its index
+    const Rand rand(seed);
+    for (ulong r = 0; r < seeds.size(); ++r) {
+      seeds[r] =
+          rand.substream(r).uniform_int(0, std::numeric_limits<int>::max());
+    }
+  }
+  for (ulong r = 0; r < realizations.size(); ++r) {
+    realizations[r]->reseed_random_generator(seeds[r]);
+  }
+}
+
+void HawkesMulti::simulate(double end_time, int n_threads) {
+  ArrayDouble end_times(realizations.size());
+  end_times.fill(end_time);
+  simulate(end_times, std::numeric_limits<ulong>::max(), n_threads);
+}
+
+void HawkesMulti::simulate(const ArrayDouble &end_times, ulong n_points,
+                           int n_threads) {
+  if (end_times.size() != realizations.size()) {
+    TICK_ERROR("end_times must have size " << realizations.size()
+                                           << " but has size "
+                                           << end_times.size());
+  }
+  if (n_threads <= 0) n_threads = std::thread::hardware_concurrency();
+  parallel_run(n_threads, realizations.size(),
+               &HawkesMulti::simulate_realization, this, end_times, n_points);
+}
+
+void HawkesMulti::simulate_realization(ulong r, const ArrayDouble &end_times,
+                                       ulong n_points) {
+  realizations[r]->simulate(end_times[r], n_points);
+}
+
+void HawkesMulti::reset() {
+  for (auto &realization : realizations) realization->reset();
+}
+
+SArrayDoublePtrList2D HawkesMulti::get_timestamps() {
+  SArrayDoublePtrList2D timestamps;
+  timestamps.reserve(realizations.size());
+  for (auto &realization : realizations) {
+    timestamps.push_back(realization->get_timestamps());
+  }
+  return timestamps;
+}
+
+SArrayULongPtr HawkesMulti::get_n_total_jumps() {
+  SArrayULongPtr n_total_jumps = SArrayULong::new_ptr(realizations.size());
+  for (ulong r = 0; r < realizations.size(); ++r) {
+    (*n_total_jumps)[r] = realizations[r]->get_n_total_jumps();
+  }
+  return n_total_jumps;
+}
+
+SArrayDoublePtr HawkesMulti::get_simulation_times() {
+  SArrayDoublePtr simulation_times = SArrayDouble::new_ptr(realizations.size());
+  for (ulong r = 0; r < realizations.size(); ++r) {
+    (*simulation_times)[r] = realizations[r]->get_time();
+  }
+  return simulation_times;
+}
+
+SArrayIntPtr HawkesMulti::get_seeds() {
+  SArrayIntPtr realization_seeds = SArrayInt::new_ptr(seeds.size());
+  for (ulong r = 0; r < seeds.size(); ++r) (*realization_seeds)[r] = seeds[r];
+  return realization_seeds;
+}
+
+VArrayDoublePtrList1D HawkesMulti::get_itr(ulong r) {
+  return get_realization(r).get_itr();
+}
+
+VArrayDoublePtr HawkesMulti::get_itr_times(ulong r) {
+  return get_realization(r).get_itr_times();
+}
+
+Hawkes &HawkesMulti::get_realization(ulong r) {
+  if (r >= realizations.size()) TICK_BAD_INDEX(0, realizations.size(), r);
+  return *realizations[r];
+}
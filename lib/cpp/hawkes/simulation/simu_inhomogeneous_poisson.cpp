@@ -6,6 +6,11 @@
 
 #include "tick/hawkes/simulation/simu_inhomogeneous_poisson.h"
 
+#include "tick/base/base.h"
+
+#include <algorithm>
+#include <limits>
+
 InhomogeneousPoisson::InhomogeneousPoisson(
     const TimeFunction &intensities_function, int seed)
     : PP(1, seed), intensities_functions(1) {
@@ -46,3 +51,75 @@ bool InhomogeneousPoisson::update_time_shift_(double delay,
 
   return flag_negative_intensity1;
 }
+
+bool InhomogeneousPoisson::simulate_exact_(
+    double end_time, VArrayDoublePtrList1D &new_timestamps) {
+  simulation_rand = get_rand().substream(
+      get_rand().uniform_int(0ul, std::numeric_limits<ulong>::max()));
+
+  std::vector<char> sampled(get_n_nodes(), 0);
+  const unsigned int n_threads_used =
+      n_threads > 0 ? n_threads : std::thread::hardware_concurrency();
+  parallel_run(n_threads_used, get_n_nodes(),
+               &InhomogeneousPoisson::sample_component, this, end_time,
+               new_timestamps, sampled);
+
+  for (const char component_sampled : sampled) {
+    if (!component_sampled) return false;
+  }
+  return true;
+}
+
+void InhomogeneousPoisson::sample_component(
+    ulong i, double end_time, VArrayDoublePtrList1D &new_timestamps,
+    std::vector<char> &sampled) {
+  Rand rand = simulation_rand.substream(i);
+  sampled[i] = sample_inhomogeneous_poisson(
+      intensities_functions[i], get_time(), end_time, rand, *new_timestamps[i]);
+}
+
+bool sample_inhomogeneous_poisson(TimeFunction &intensity_function,
+                                  double start_time, double end_time,
+                                  Rand &rand, VArrayDouble &out) {
+  const ArrayDouble breakpoints =
+      intensity_function.get_breakpoints(start_time, end_time);
+  std::vector<double> jumps;
+
+  // Cumulative intensity left before next jump
+  double target = rand.exponential(1.);
+  for (ulong k = 0; k + 1 < breakpoints.size(); ++k) {
+    const double segment_start = breakpoints[k];
+    const double width = breakpoints[k + 1] - segment_start;
+
+    // Values at the bounds of the segment are extrapolated from inner points,
+    // where the TimeFunction is not ambiguous
+    const double value_1 = intensity_function.value(segment_start + width / 4);
+    const double value_3 =
+        intensity_function.value(segment_start + 3 * width / 4);
+    double left_value = 1.5 * value_1 - 0.5 * value_3;
+    double right_value = 1.5 * value_3 - 0.5 * value_1;
+    const double tolerance = 1e-10 * (std::abs(value_1) + std::abs(value_3));
+    if (left_value < -tolerance || right_value < -tolerance) return false;
+    left_value = std::max(left_value, 0.);
+    right_value = std::max(right_value, 0.);
+    const double slope = (right_value - left_value) / width;
+
+    // Invert a(x - x0) + slope (x - x0)^2 / 2 = target from the last jump x0
+    double position = 0;
+    double value = left_value;
+    while (target <= (value + right_value) / 2 * (width - position)) {
+      const double discriminant =
+          std::max(value * value + 2 * slope * target, 0.);
+      position = std::min(
+          position + 2 * target / (value + std::sqrt(discriminant)), width);
+      if (segment_start + position >= end_time) break;
+      jumps.push_back(segment_start + position);
+      value = left_value + slope * position;
+      target = rand.exponential(1.);
+    }
+    target -= (value + right_value) / 2 * (width - position);
+  }
+
+  for (const double jump : jumps) out.append1(jump);
+  return true;
+}
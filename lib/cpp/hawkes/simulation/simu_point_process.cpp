@@ -3,6 +3,10 @@
 #include "tick/hawkes/simulation/simu_point_process.h"
 #include <float.h>
 
+#include <functional>
+#include <queue>
+#include <tuple>
+
 // Constructor
 PP::PP(unsigned int n_nodes, int seed) : rand(seed), n_nodes(n_nodes) {
   // Setting the process
@@ -29,6 +33,8 @@ PP::PP(unsigned int n_nodes, int seed) : rand(seed), n_nodes(n_nodes) {
 
   // By default : no track record of intensity
   itr_time_step = -1;
+  itr_base_time_step = -1;
+  itr_max_size = 0;
 }
 
 // Destructor
@@ -56,17 +62,21 @@ void PP::reset() {
 
   for (unsigned int i = 0; i < n_nodes; ++i)
     timestamps[i] = VArrayDouble::new_ptr();
-  activate_itr(itr_time_step);
+  activate_itr(itr_base_time_step, itr_max_size);
 }
 
-void PP::activate_itr(double dt) {
+void PP::activate_itr(double dt, ulong max_size) {
   if (dt <= 0) {
     itr_time_step = -1;
+    itr_base_time_step = -1;
     return;
   }
+  if (max_size == 1) TICK_ERROR("max_size must be 0 or greater than 1");
   if (itr.size() != 0) itr.resize(0);
 
   itr_time_step = dt;
+  itr_base_time_step = dt;
+  itr_max_size = max_size;
   itr.resize(n_nodes);
   for (unsigned int i = 0; i < n_nodes; i++) itr[i] = VArrayDouble::new_ptr();
   itr_times = VArrayDouble::new_ptr();
@@ -74,11 +84,71 @@ void PP::activate_itr(double dt) {
 
 void PP::reseed_random_generator(int seed) { rand.reseed(seed); }
 
+void PP::set_event_sink(PPEventSinkPtr event_sink) {
+  this->event_sink = std::move(event_sink);
+}
+
+void PP::push_to_event_sink(const VArrayDoublePtrList1D &new_timestamps) {
+  // Jumps of all nodes are merged in chronological order
+  typedef std::tuple<double, ulong, ulong> NextJump;
+  std::priority_queue<NextJump, std::vector<NextJump>, std::greater<NextJump>>
+      next_jumps;
+  for (ulong i = 0; i < new_timestamps.size(); ++i) {
+    if (new_timestamps[i]->size() > 0) {
+      next_jumps.emplace((*new_timestamps[i])[0], i, 0);
+    }
+  }
+  while (!next_jumps.empty()) {
+    double jump_time;
+    ulong i, k;
+    std::tie(jump_time, i, k) = next_jumps.top();
+    next_jumps.pop();
+    event_sink->push(i, jump_time);
+    if (k + 1 < new_timestamps[i]->size()) {
+      next_jumps.emplace((*new_timestamps[i])[k + 1], i, k + 1);
+    }
+  }
+}
+
+void PP::set_realization(VArrayDoublePtrList1D timestamps, double end_time) {
+  if (n_nodes != timestamps.size()) {
+    TICK_ERROR("Should provide n_nodes (" << n_nodes
+                                          << ") arrays for timestamps but"
+                                             " was "
+                                          << timestamps.size());
+  }
+  n_total_jumps = 0;
+  for (ulong i = 0; i < n_nodes; ++i) n_total_jumps += timestamps[i]->size();
+  if (event_sink) {
+    push_to_event_sink(timestamps);
+    event_sink->flush();
+  } else {
+    this->timestamps = std::move(timestamps);
+  }
+  time = end_time;
+}
+
 void PP::itr_process() {
   if (!itr_on()) return;
 
   for (unsigned int i = 0; i < n_nodes; i++) itr[i]->append1(intensity[i]);
   itr_times->append1(time);
+
+  if (itr_max_size > 0 && itr_times->size() >= itr_max_size) decimate_itr();
+}
+
+void PP::decimate_itr() {
+  // One record out of two is kept, the last one always being kept, and the
+  // recording step is doubled so that records remain evenly spaced
+  const ulong size = itr_times->size();
+  const ulong new_size = (size + 1) / 2;
+  for (ulong k = 0, l = (size - 1) % 2; k < new_size; ++k, l += 2) {
+    (*itr_times)[k] = (*itr_times)[l];
+    for (unsigned int i = 0; i < n_nodes; i++) (*itr[i])[k] = (*itr[i])[l];
+  }
+  itr_times->set_size(new_size);
+  for (unsigned int i = 0; i < n_nodes; i++) itr[i]->set_size(new_size);
+  itr_time_step *= 2;
 }
 
 void PP::update_time_shift(double delay, bool flag_compute_intensity_bound,
@@ -105,10 +175,53 @@ void PP::simulate(double run_time) {
 }
 
 void PP::simulate(double end_time, ulong n_points) {
-  // This causes deadlock, see MLPP-334 - Investigate deadlock in PP
-  // #ifdef PYTHON_LINK
-  //    Py_BEGIN_ALLOW_THREADS;
-  // #endif
+  // The GIL is released by the bindings, not here: simulations are also run
+  // from worker threads which do not hold it (see SimuHawkesMulti)
+
+  // Processes whose jumps can be directly sampled skip the thinning loop
+  if (!itr_on() && n_points == std::numeric_limits<ulong>::max() &&
+      time < end_time) {
+    VArrayDoublePtrList1D new_timestamps(n_nodes);
+    for (ulong i = 0; i < n_nodes; ++i) {
+      new_timestamps[i] = VArrayDouble::new_ptr();
+    }
+    if (simulate_exact_(end_time, new_timestamps)) {
+      for (ulong i = 0; i < n_nodes; ++i) {
+        if (!event_sink) timestamps[i]->append(new_timestamps[i]);
+        n_total_jumps += new_timestamps[i]->size();
+      }
+      if (event_sink) {
+        push_to_event_sink(new_timestamps);
+        event_sink->flush();
+      }
+      time = end_time;
+      init_intensity();
+      return;
+    }
+  }
+
+  // Processes that can be simulated event by event do not need to update the
+  // intensity of every component at each step, unless it is track recorded
+  if (!itr_on()) {
+    node_intensity_bounds = ArrayDouble(n_nodes);
+    node_intensity_bounds.init_to_zero();
+    node_intensity_bound_tree.init(n_nodes);
+    total_intensity_bound = 0;
+    n_node_intensity_bound_updates = 0;
+    if (init_event_driven_()) {
+      if (max_total_intensity_bound < total_intensity_bound)
+        max_total_intensity_bound = total_intensity_bound;
+      simulate_event_driven(end_time, n_points);
+      if (event_sink) event_sink->flush();
+      return;
+    }
+  }
+
+  if (event_sink && requires_timestamps_()) {
+    TICK_ERROR(
+        "This process needs its past jumps to be simulated, it cannot be "
+        "simulated with an event sink");
+  }
 
   // At start we need to init the intensity and eventually track record it
   if (get_time() == 0) {
@@ -171,10 +284,43 @@ void PP::simulate(double end_time, ulong n_points) {
     if (flag_negative_intensity && !threshold_negative_intensity) break;
   }
 
-  // This causes deadlock, see MLPP-334 - Investigate deadlock in PP
-  // #ifdef PYTHON_LINK
-  //    Py_END_ALLOW_THREADS;
-  // #endif
+  if (event_sink) event_sink->flush();
+
+  if (flag_negative_intensity && !threshold_negative_intensity)
+    TICK_ERROR(
+        "Simulation stopped because intensity went negative (you could call "
+        "``threshold_negative_intensity`` to allow it)");
+}
+
+void PP::simulate_event_driven(double end_time, ulong n_points) {
+  while (time < end_time && n_total_jumps < n_points &&
+         (!flag_negative_intensity || threshold_negative_intensity)) {
+    const double time_of_next_jump =
+        time + rand.exponential(total_intensity_bound);
+
+    if (time_of_next_jump >= end_time) {
+      time = end_time;
+      break;
+    }
+    time = time_of_next_jump;
+
+    // The candidate is attributed to a component proportionally to its
+    // bound, and accepted if it falls under its current intensity
+    double temp = rand.uniform() * total_intensity_bound;
+    const ulong i = node_intensity_bound_tree.find(temp);
+
+    const double intensity_i = get_event_driven_intensity_(i);
+    if (intensity_i < 0) flag_negative_intensity = true;
+
+    if (temp < intensity_i) {
+      update_jump(i);
+      update_event_driven_jump_(i);
+      if (max_total_intensity_bound < total_intensity_bound)
+        max_total_intensity_bound = total_intensity_bound;
+    } else {
+      update_event_driven_bound_(i);
+    }
+  }
 
   if (flag_negative_intensity && !threshold_negative_intensity)
     TICK_ERROR(
@@ -182,10 +328,28 @@ void PP::simulate(double end_time, ulong n_points) {
         "``threshold_negative_intensity`` to allow it)");
 }
 
+void PP::set_node_intensity_bound(ulong i, double bound) {
+  const double delta = bound - node_intensity_bounds[i];
+  node_intensity_bounds[i] = bound;
+  node_intensity_bound_tree.add(i, delta);
+  total_intensity_bound += delta;
+
+  // Incremental updates accumulate rounding errors, rebuilding every n_nodes
+  // updates keeps them in O(1) amortized time
+  if (++n_node_intensity_bound_updates >= n_nodes) {
+    node_intensity_bound_tree.build(node_intensity_bounds);
+    total_intensity_bound = node_intensity_bounds.sum();
+    n_node_intensity_bound_updates = 0;
+  }
+}
+
 // Update the process component 'index' with current time
 void PP::update_jump(int index) {
   // We make the jump on the corresponding signal
-  timestamps[index]->append1(time);
+  if (event_sink)
+    event_sink->push(index, time);
+  else
+    timestamps[index]->append1(time);
   n_total_jumps += 1;
 }
 
@@ -0,0 +1,51 @@
+// License: BSD 3 clause
+
+#include "tick/random/alias_table.h"
+
+#include <vector>
+
+AliasTable::AliasTable(const ArrayDouble &weights)
+    : thresholds(weights.size()), aliases(weights.size()) {
+  const ulong n = weights.size();
+  if (n == 0) TICK_ERROR("Cannot build an alias table without any event");
+  double total_weight = 0;
+  for (ulong k = 0; k < n; ++k) {
+    if (!(weights[k] >= 0)) {
+      TICK_ERROR("Weights must be non-negative but weight " << k << " is "
+                                                            << weights[k]);
+    }
+    total_weight += weights[k];
+  }
+  if (total_weight <= 0) TICK_ERROR("Weights must have a positive sum");
+
+  // Vose's algorithm: buckets under the mean are filled with the excess of
+  // buckets over it
+  std::vector<ulong> small, large;
+  for (ulong k = 0; k < n; ++k) {
+    thresholds[k] = weights[k] * n / total_weight;
+    aliases[k] = k;
+    (thresholds[k] < 1 ? small : large).push_back(k);
+  }
+  while (!small.empty() && !large.empty()) {
+    const ulong s = small.back();
+    const ulong l = large.back();
+    small.pop_back();
+    aliases[s] = l;
+    thresholds[l] -= 1 - thresholds[s];
+    if (thresholds[l] < 1) {
+      large.pop_back();
+      small.push_back(l);
+    }
+  }
+  // Remaining buckets are full, up to rounding errors
+  for (const ulong k : small) thresholds[k] = 1;
+  for (const ulong k : large) thresholds[k] = 1;
+}
+
+void AliasTable::sample(Rand &rand, ArrayULong &out) const {
+  ArrayDouble uniforms(out.size());
+  rand.uniform(uniforms);
+  for (ulong k = 0; k < out.size(); ++k) {
+    out[k] = sample_from_uniform(uniforms[k]);
+  }
+}
@@ -17,9 +17,20 @@
 
 #include "tick/random/rand.h"
 
+#include <algorithm>
 #include <iostream>
 #include <random>
 
+namespace {
+
+// Number of raw random words drawn before being transformed in array fills
+constexpr ulong RAND_BLOCK_SIZE = 256;
+
+// Below this rate, Poisson arrays are filled by inversion
+constexpr double RAND_POISSON_INVERSION_MAX_RATE = 10.;
+
+}  // namespace
+
 Rand::Rand(int seed) : seed(seed) {
   reseed(seed);
 
@@ -27,6 +38,12 @@ Rand::Rand(int seed) : seed(seed) {
 }
 
 Rand::Rand(const std::mt19937_64 &generator) : seed(0), generator(generator) {
+  // The key is taken from a copy so that the sequence of this generator is
+  // not shifted
+  std::mt19937_64 generator_copy(generator);
+  const std::uint64_t word = generator_copy();
+  stream_key = {{static_cast<std::uint32_t>(word),
+                 static_cast<std::uint32_t>(word >> 32)}};
   init_reusable_distributions();
 }
 
@@ -87,6 +104,77 @@ ulong Rand::discrete(ArrayDouble probabilities) {
   return discrete_dist(generator, p);
 }
 
+void Rand::fill_uniform(double *out, ulong size) {
+  const double scale = 1. / static_cast<double>(std::uint64_t{1} << 53);
+  std::uint64_t words[RAND_BLOCK_SIZE];
+  for (ulong start = 0; start < size; start += RAND_BLOCK_SIZE) {
+    const ulong n = std::min(RAND_BLOCK_SIZE, size - start);
+    for (ulong k = 0; k < n; ++k) words[k] = generator();
+    for (ulong k = 0; k < n; ++k) out[start + k] = (words[k] >> 11) * scale;
+  }
+}
+
+void Rand::uniform_int(ulong a, ulong b, ArrayULong &out) {
+  std::uniform_int_distribution<ulong>::param_type p(a, b);
+  for (ulong k = 0; k < out.size(); ++k) {
+    out[k] = uniform_ulong_dist(generator, p);
+  }
+}
+
+void Rand::uniform(ArrayDouble &out) { fill_uniform(out.data(), out.size()); }
+
+void Rand::gaussian(ArrayDouble &out) {
+  const ulong size = out.size();
+  fill_uniform(out.data(), size);
+  for (ulong k = 0; k + 1 < size; k += 2) {
+    const double radius = std::sqrt(-2 * std::log1p(-out[k]));
+    const double angle = 2 * M_PI * out[k + 1];
+    out[k] = radius * std::cos(angle);
+    out[k + 1] = radius * std::sin(angle);
+  }
+  if (size % 2 == 1) out[size - 1] = gaussian();
+}
+
+void Rand::exponential(double intensity, ArrayDouble &out) {
+  fill_uniform(out.data(), out.size());
+  for (ulong k = 0; k < out.size(); ++k) {
+    out[k] = -std::log1p(-out[k]) / intensity;
+  }
+}
+
+void Rand::poisson(double rate, ArrayInt &out) {
+  if (rate > RAND_POISSON_INVERSION_MAX_RATE) {
+    for (ulong k = 0; k < out.size(); ++k) out[k] = poisson(rate);
+    return;
+  }
+
+  ArrayDouble uniforms(out.size());
+  fill_uniform(uniforms.data(), uniforms.size());
+  const double p_zero = std::exp(-rate);
+  for (ulong k = 0; k < out.size(); ++k) {
+    // Smallest n such that P(X <= n) >= u
+    int n = 0;
+    double p = p_zero, cdf = p_zero;
+    while (uniforms[k] > cdf && p > 0) {
+      ++n;
+      p *= rate / n;
+      cdf += p;
+    }
+    out[k] = n;
+  }
+}
+
+Rand Rand::substream(ulong index) const {
+  std::seed_seq seed_sequence{stream_key[0], stream_key[1],
+                              static_cast<std::uint32_t>(index),
+                              static_cast<std::uint32_t>(index >> 32)};
+  Rand rand{std::mt19937_64(seed_sequence)};
+  std::uint32_t words[4];
+  seed_sequence.generate(words, words + 4);
+  rand.stream_key = {{words[2], words[3]}};
+  return rand;
+}
+
 int Rand::get_seed() const { return seed; }
 
 void Rand::reseed(const int seed) {
@@ -99,9 +187,11 @@ void Rand::reseed(const int seed) {
     // seed
     std::seed_seq seed_seq{r(), r(), r(), r(), r(), r(), r(), r()};
     generator = std::mt19937_64(seed_seq);
+    stream_key = {{r(), r()}};
   } else {
     unsigned int useed = seed < 0 ? 0 : static_cast<unsigned int>(seed);
     generator = std::mt19937_64(useed);
+    stream_key = {{useed, 0}};
   }
 
   Rand::seed = seed;
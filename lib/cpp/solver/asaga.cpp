@@ -2,6 +2,12 @@
 
 #include "tick/solver/asaga.h"
 
+#include <algorithm>
+#include <limits>
+
+// Number of indices each thread draws at once with uniform sampling
+constexpr ulong ASAGA_INDICES_BATCH_SIZE = 1024;
+
 template <class T>
 AtomicSAGA<T>::AtomicSAGA(ulong epoch_size, T tol,
                           RandType rand_type, T step, int record_every, int seed, int n_threads)
@@ -10,6 +16,21 @@ AtomicSAGA<T>::AtomicSAGA(ulong epoch_size, T tol,
   un_threads = (size_t)n_threads;
 }
 
+template <class T>
+ulong AtomicSAGA<T>::buffers_footprint() const {
+  const ulong n_coeffs = model ? model->get_n_coeffs() : 0;
+  // Gradient memory and its average
+  return TBaseSAGA<T, T>::buffers_footprint() +
+         (rand_max + n_coeffs) * sizeof(std::atomic<T>);
+}
+
+template <class T>
+ulong AtomicSAGA<T>::memory_usage() const {
+  return TBaseSAGA<T, T>::memory_usage() +
+         tick::array_bytes(gradients_memory) +
+         tick::array_bytes(gradients_average);
+}
+
 template <class T>
 void AtomicSAGA<T>::initialize_solver() {
   ulong n_samples = model->get_n_samples();
@@ -37,12 +58,26 @@ void AtomicSAGA<T>::threaded_solve(int n_epochs, size_t n_thread) {
   ulong thread_epoch_size = epoch_size / n_threads;
   thread_epoch_size += n_thread < (epoch_size % n_threads);
 
+  // Threads do not share a random generator for uniform sampling
+  Rand thread_rand = threads_rand.substream(n_thread);
+  ArrayULong indices(std::min(thread_epoch_size, ASAGA_INDICES_BATCH_SIZE));
+  ulong i_index = indices.size();
+
   auto start = std::chrono::steady_clock::now();
 
   for (int epoch = 1; epoch < (n_epochs + 1); ++epoch) {
     for (ulong t = 0; t < thread_epoch_size; ++t) {
       // Get next sample index
-      ulong i = get_next_i();
+      ulong i;
+      if (rand_type == RandType::unif) {
+        if (i_index == indices.size()) {
+          thread_rand.uniform_int(ulong{0}, rand_max - 1, indices);
+          i_index = 0;
+        }
+        i = indices[i_index++];
+      } else {
+        i = get_next_i();
+      }
       // Sparse features vector
       BaseArray<T> x_i = model->get_features(i);
       grad_i_factor = model->grad_i_factor(i, iterate);
@@ -128,7 +163,12 @@ void AtomicSAGA<T>::solve(size_t n_epochs) {
   if (!model->is_sparse()) {
     TICK_ERROR("AtomicSAGA can be used with sparse features only")
   }
+  if (rand_type == RandType::importance) {
+    TICK_ERROR("AtomicSAGA does not support importance sampling")
+  }
 
+  threads_rand = rand.substream(
+      rand.uniform_int(ulong{0}, std::numeric_limits<ulong>::max()));
   std::vector<std::thread> threads;
   for (size_t i = 0; i < un_threads; i++) {
     threads.emplace_back(&AtomicSAGA<T>::threaded_solve, this, n_epochs, i);
@@ -35,16 +35,37 @@ void TBaseSAGA<T, K>::prepare_solve() {
     initialize_solver();
   }
   if (model->is_sparse() && prox->is_separable()) {
-    if (!ready_step_corrections) {
+    if (!ready_step_corrections ||
+        this->step_corrections_outdated(importance_step_corrections)) {
       compute_step_corrections();
     }
   }
 }
 
+template <class T, class K>
+ulong TBaseSAGA<T, K>::buffers_footprint() const {
+  ulong n_bytes = TStoSolver<T, K>::buffers_footprint();
+  if (model && model->is_sparse()) {
+    n_bytes += model->get_n_features() * sizeof(T);
+  }
+  return n_bytes;
+}
+
+template <class T, class K>
+ulong TBaseSAGA<T, K>::memory_usage() const {
+  return TStoSolver<T, K>::memory_usage() +
+         tick::array_bytes(steps_correction);
+}
+
 template <class T, class K>
 void TBaseSAGA<T, K>::compute_step_corrections() {
   ulong n_features = model->get_n_features();
-  Array<T> columns_sparsity = casted_model->get_column_sparsity_view();
+  // Inverse of the probability that a sampled row hits each column
+  importance_step_corrections = rand_type == RandType::importance;
+  Array<T> columns_sparsity =
+      importance_step_corrections
+          ? this->get_importance_columns_probability(n_features)
+          : casted_model->get_column_sparsity_view();
   steps_correction = Array<T>(n_features);
   for (ulong j = 0; j < n_features; ++j) {
     steps_correction[j] = 1. / columns_sparsity[j];
@@ -52,6 +73,21 @@ void TBaseSAGA<T, K>::compute_step_corrections() {
   ready_step_corrections = true;
 }
 
+template <class T>
+ulong TSAGA<T>::buffers_footprint() const {
+  const ulong n_coeffs = model ? model->get_n_coeffs() : 0;
+  // Gradient memory and its average
+  return TBaseSAGA<T, T>::buffers_footprint() +
+         (this->rand_max + n_coeffs) * sizeof(T);
+}
+
+template <class T>
+ulong TSAGA<T>::memory_usage() const {
+  return TBaseSAGA<T, T>::memory_usage() +
+         tick::array_bytes(gradients_memory) +
+         tick::array_bytes(gradients_average);
+}
+
 template <class T>
 void TSAGA<T>::initialize_solver() {
   ulong n_samples = model->get_n_samples();
@@ -85,31 +121,42 @@ void TSAGA<T>::solve_one_epoch() {
 template <class T>
 void TSAGA<T>::solve_dense(bool use_intercept, ulong n_features) {
   ulong n_samples = model->get_n_samples();
+  SolverInstrumentation::Lap lap(instrumentation);
   for (ulong t = 0; t < epoch_size; ++t) {
     // Get next sample index
     ulong i = get_next_i();
+    lap.mark(SolverCounter::sampling_cycles);
+    lap.count(SolverCounter::n_samples);
     // Get the features matrix. We know that it's dense
     BaseArray<T> x_i = model->get_features(i);
     T grad_i_factor = model->grad_i_factor(i, iterate);
+    lap.mark(SolverCounter::gradient_cycles);
     T grad_i_factor_old = gradients_memory[i];
     // Update gradient memory
     gradients_memory[i] = grad_i_factor;
     T grad_factor_diff = grad_i_factor - grad_i_factor_old;
+    // Reweighted difference used in the descent direction, which remains
+    // unbiased whatever the sampling
+    T weighted_diff = grad_factor_diff * get_sample_weight(i);
     for (ulong j = 0; j < n_features; ++j) {
       T x_ij = x_i._value_dense(j);
       T grad_avg_j = gradients_average[j];
-      iterate[j] -= step * (grad_factor_diff * x_ij + grad_avg_j);
+      iterate[j] -= step * (weighted_diff * x_ij + grad_avg_j);
       // Update the gradients average over seen samples
       gradients_average[j] += grad_factor_diff * x_ij / n_samples;
     }
     // deal with intercept here
     if (use_intercept) {
       iterate[n_features] -=
-          step * (grad_factor_diff + gradients_average[n_features]);
+          step * (weighted_diff + gradients_average[n_features]);
       gradients_average[n_features] += grad_factor_diff / n_samples;
     }
+    lap.mark(SolverCounter::update_cycles);
+    lap.count(SolverCounter::n_nnz, n_features);
     // Call the prox on the iterate
     prox->call(iterate, step, iterate);
+    lap.mark(SolverCounter::prox_cycles);
+    lap.count(SolverCounter::n_prox_calls);
   }
   TStoSolver<T, T>::t += epoch_size;
 }
@@ -125,15 +172,22 @@ void TSAGA<T>::solve_sparse_proba_updates(bool use_intercept,
   // current support (non-zero values) of the sampled vector of features
 
   ulong n_samples = model->get_n_samples();
+  // The separable prox is applied coordinate-wise within the update, so that
+  // its cost is part of update_cycles
+  SolverInstrumentation::Lap lap(instrumentation);
   for (t = 0; t < epoch_size; ++t) {
     // Get next sample index
     ulong i = get_next_i();
+    lap.mark(SolverCounter::sampling_cycles);
+    lap.count(SolverCounter::n_samples);
     // Sparse features vector
     BaseArray<T> x_i = model->get_features(i);
     T grad_i_factor = model->grad_i_factor(i, iterate);
+    lap.mark(SolverCounter::gradient_cycles);
     T grad_i_factor_old = gradients_memory[i];
     gradients_memory[i] = grad_i_factor;
     T grad_factor_diff = grad_i_factor - grad_i_factor_old;
+    T weighted_diff = grad_factor_diff * get_sample_weight(i);
     for (ulong idx_nnz = 0; idx_nnz < x_i.size_sparse(); ++idx_nnz) {
       // Get the index of the idx-th sparse feature of x_i
       ulong j = x_i.indices()[idx_nnz];
@@ -142,7 +196,7 @@ void TSAGA<T>::solve_sparse_proba_updates(bool use_intercept,
       // Step-size correction for coordinate j
       T step_correction = steps_correction[j];
       iterate[j] -=
-          step * (grad_factor_diff * x_ij + step_correction * grad_avg_j);
+          step * (weighted_diff * x_ij + step_correction * grad_avg_j);
       gradients_average[j] += grad_factor_diff * x_ij / n_samples;
       // Prox is separable, apply regularization on the current coordinate
       casted_prox->call_single(j, iterate, step * step_correction, iterate);
@@ -153,10 +207,14 @@ void TSAGA<T>::solve_sparse_proba_updates(bool use_intercept,
     // weird desire to to regularize the intercept)
     if (use_intercept) {
       iterate[n_features] -=
-          step * (grad_factor_diff + gradients_average[n_features]);
+          step * (weighted_diff + gradients_average[n_features]);
       gradients_average[n_features] += grad_factor_diff / n_samples;
       casted_prox->call_single(n_features, iterate, step, iterate);
     }
+    lap.mark(SolverCounter::update_cycles);
+    lap.count(SolverCounter::n_nnz, x_i.size_sparse());
+    lap.count(SolverCounter::n_prox_calls,
+              x_i.size_sparse() + (use_intercept ? 1 : 0));
   }
   TStoSolver<T, T>::t += epoch_size;
 }
@@ -15,6 +15,20 @@ TSDCA<T, K>::TSDCA(T l_l2sq, ulong epoch_size, T tol, RandType rand_type,
   stored_variables_ready = false;
 }
 
+template <class T, class K>
+ulong TSDCA<T, K>::buffers_footprint() const {
+  const ulong n_coeffs = model ? model->get_n_coeffs() : 0;
+  // Dual variables, ascent variables and primal vector before prox
+  return TStoSolver<T, K>::buffers_footprint() +
+         (2 * rand_max + n_coeffs) * sizeof(T);
+}
+
+template <class T, class K>
+ulong TSDCA<T, K>::memory_usage() const {
+  return TStoSolver<T, K>::memory_usage() + tick::array_bytes(delta) +
+         tick::array_bytes(dual_vector) + tick::array_bytes(tmp_primal_vector);
+}
+
 template <class T, class K>
 void TSDCA<T, K>::set_model(std::shared_ptr<TModel<T, K> > model) {
   TStoSolver<T, K>::set_model(model);
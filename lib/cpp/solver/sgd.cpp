@@ -19,13 +19,21 @@ void TSGD<T, K>::solve_one_epoch() {
     Array<T> grad(iterate.size());
     grad.init_to_zero();
 
+    SolverInstrumentation::Lap lap(instrumentation);
     const ulong start_t = t;
     for (t = start_t; t < start_t + epoch_size; ++t) {
       const ulong i = get_next_i();
+      lap.mark(SolverCounter::sampling_cycles);
+      lap.count(SolverCounter::n_samples);
       model->grad_i(i, iterate, grad);
+      lap.mark(SolverCounter::gradient_cycles);
       step_t = get_step_t();
-      iterate.mult_incr(grad, -step_t);
+      iterate.mult_incr(grad, -step_t * get_sample_weight(i));
+      lap.mark(SolverCounter::update_cycles);
+      lap.count(SolverCounter::n_nnz, iterate.size());
       prox->call(iterate, step_t, iterate);
+      lap.mark(SolverCounter::prox_cycles);
+      lap.count(SolverCounter::n_prox_calls);
     }
   }
 }
@@ -37,16 +45,20 @@ void TSGD<T, K>::solve_sparse() {
   ulong n_features = model->get_n_features();
   bool use_intercept = model->use_intercept();
 
+  SolverInstrumentation::Lap lap(instrumentation);
   ulong start_t = t;
   for (t = start_t; t < start_t + epoch_size; ++t) {
     ulong i = get_next_i();
+    lap.mark(SolverCounter::sampling_cycles);
+    lap.count(SolverCounter::n_samples);
     // Sparse features vector
     BaseArray<T> x_i = model->get_features(i);
     // Gradient factor
     T alpha_i = model->grad_i_factor(i, iterate);
+    lap.mark(SolverCounter::gradient_cycles);
     // Update the step
     T step_t = get_step_t();
-    T delta = -step_t * alpha_i;
+    T delta = -step_t * alpha_i * get_sample_weight(i);
     if (use_intercept) {
       // Get the features vector, which is sparse here
       Array<T> iterate_no_interc = view(iterate, 0, n_features);
@@ -56,8 +68,12 @@ void TSGD<T, K>::solve_sparse() {
       // Stochastic gradient descent step
       iterate.mult_incr(x_i, delta);
     }
+    lap.mark(SolverCounter::update_cycles);
+    lap.count(SolverCounter::n_nnz, x_i.size_sparse());
     // Apply the prox. No lazy-updating here yet
     prox->call(iterate, step_t, iterate);
+    lap.mark(SolverCounter::prox_cycles);
+    lap.count(SolverCounter::n_prox_calls);
   }
 }
 
@@ -0,0 +1,45 @@
+// License: BSD 3 clause
+
+#include "tick/solver/solver_instrumentation.h"
+
+#include <thread>
+
+double SolverInstrumentation::cycles_per_second() {
+  static const double estimate = [] {
+    const auto start_time = std::chrono::steady_clock::now();
+    const ulong start_cycles = cycles();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    const ulong end_cycles = cycles();
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start_time;
+    return (end_cycles - start_cycles) / elapsed.count();
+  }();
+  return estimate;
+}
+
+const char *SolverInstrumentation::counter_name(SolverCounter counter) {
+  switch (counter) {
+    case SolverCounter::sampling_cycles:
+      return "sampling_cycles";
+    case SolverCounter::gradient_cycles:
+      return "gradient_cycles";
+    case SolverCounter::update_cycles:
+      return "update_cycles";
+    case SolverCounter::prox_cycles:
+      return "prox_cycles";
+    case SolverCounter::full_gradient_cycles:
+      return "full_gradient_cycles";
+    case SolverCounter::objective_cycles:
+      return "objective_cycles";
+    case SolverCounter::n_samples:
+      return "n_samples";
+    case SolverCounter::n_nnz:
+      return "n_nnz";
+    case SolverCounter::n_prox_calls:
+      return "n_prox_calls";
+    case SolverCounter::n_full_gradients:
+      return "n_full_gradients";
+    default:
+      return "unknown";
+  }
+}
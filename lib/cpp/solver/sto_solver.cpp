@@ -6,18 +6,74 @@
 
 #include "tick/solver/sto_solver.h"
 
+#include <algorithm>
+
 template <class T, class K>
 void TStoSolver<T, K>::init_permutation() {
-  if ((rand_type == RandType::perm) && (rand_max > 0)) {
+  const bool is_perm =
+      rand_type == RandType::perm || rand_type == RandType::block_perm;
+  if (is_perm && (rand_max > 0)) {
     permutation = ArrayULong(rand_max);
     for (ulong i = 0; i < rand_max; ++i) permutation[i] = i;
   }
 }
 
+template <class T, class K>
+void TStoSolver<T, K>::init_importance_sampling() {
+  if (!supports_importance_sampling()) {
+    TICK_ERROR(get_class_name() << " does not support importance sampling");
+  }
+  const Array<T> lip_consts = model->get_lip_consts();
+  if (lip_consts.size() != rand_max) {
+    TICK_ERROR("Importance sampling needs one Lipschitz constant per sample ("
+               << rand_max << ") but model has " << lip_consts.size());
+  }
+  // Half of the probability mass is spread uniformly, so that weights stay
+  // bounded by 2 and samples with a null constant are still drawn
+  const double lip_sum = lip_consts.sum();
+  ArrayDouble probabilities(rand_max);
+  importance_weights = Array<T>(rand_max);
+  for (ulong i = 0; i < rand_max; ++i) {
+    const double lip_probability =
+        lip_sum > 0 ? lip_consts[i] / lip_sum : 1. / rand_max;
+    probabilities[i] = 0.5 / rand_max + 0.5 * lip_probability;
+    importance_weights[i] = 1. / (rand_max * probabilities[i]);
+  }
+  importance_table = AliasTable(probabilities);
+  importance_ready = true;
+}
+
+template <class T, class K>
+Array<T> TStoSolver<T, K>::get_importance_columns_probability(
+    ulong n_features) {
+  if (!importance_ready) init_importance_sampling();
+  Array<T> columns_probability(n_features);
+  columns_probability.init_to_zero();
+  for (ulong i = 0; i < rand_max; ++i) {
+    BaseArray<T> x_i = model->get_features(i);
+    const T probability_i = 1. / (rand_max * importance_weights[i]);
+    for (ulong idx_nnz = 0; idx_nnz < x_i.size_sparse(); ++idx_nnz) {
+      columns_probability[x_i.indices()[idx_nnz]] += probability_i;
+    }
+  }
+  return columns_probability;
+}
+
+template <class T, class K>
+T TStoSolver<T, K>::get_importance_lip_max() {
+  if (!importance_ready) init_importance_sampling();
+  const Array<T> lip_consts = model->get_lip_consts();
+  T lip_max = 0;
+  for (ulong i = 0; i < rand_max; ++i) {
+    lip_max = std::max(lip_max, lip_consts[i] * importance_weights[i]);
+  }
+  return lip_max;
+}
+
 template <class T, class K>
 void TStoSolver<T, K>::reset() {
   t = 1;
-  if (rand_type == RandType::perm) {
+  if (rand_type == RandType::perm || rand_type == RandType::block_perm) {
     i_perm = 0;
     shuffle();
   }
@@ -27,6 +83,8 @@ void TStoSolver<T, K>::reset() {
   objectives.clear();
   last_record_epoch = 0;
   last_record_time = 0;
+  instrumentation.reset();
+  counters_history.clear();
 }
 
 template <class T, class K>
@@ -34,7 +92,8 @@ ulong TStoSolver<T, K>::get_next_i() {
   ulong i = 0;
   if (rand_type == RandType::unif) {
     i = rand_unif(rand_max - 1);
-  } else if (rand_type == RandType::perm) {
+  } else if (rand_type == RandType::perm ||
+             rand_type == RandType::block_perm) {
     if (!permutation_ready) {
       shuffle();
     }
@@ -43,6 +102,16 @@ ulong TStoSolver<T, K>::get_next_i() {
     if (i_perm >= rand_max) {
       shuffle();
     }
+    // The next sample is known in advance, its features can be loaded while
+    // the current sample is processed
+    if (prefetch) {
+      model->prefetch_features(permutation[i_perm]);
+    }
+  } else if (rand_type == RandType::importance) {
+    if (!importance_ready) {
+      init_importance_sampling();
+    }
+    i = importance_table.sample(rand);
   }
   return i;
 }
@@ -50,7 +119,9 @@ ulong TStoSolver<T, K>::get_next_i() {
 // Simulation of a random permutation using Knuth's algorithm
 template <class T, class K>
 void TStoSolver<T, K>::shuffle() {
-  if (rand_type == RandType::perm) {
+  if (rand_type == RandType::block_perm) {
+    block_shuffle();
+  } else if (rand_type == RandType::perm) {
     // A secure check
     if (permutation.size() != rand_max) {
       init_permutation();
@@ -70,21 +141,64 @@ void TStoSolver<T, K>::shuffle() {
   permutation_ready = true;
 }
 
+template <class T, class K>
+void TStoSolver<T, K>::block_shuffle() {
+  if (permutation.size() != rand_max) {
+    init_permutation();
+  }
+  i_perm = 0;
+
+  const ulong n_blocks = (rand_max + perm_block_size - 1) / perm_block_size;
+  ArrayULong blocks(n_blocks);
+  for (ulong b = 0; b < n_blocks; ++b) blocks[b] = b;
+  for (ulong b = 1; b < n_blocks; ++b) {
+    std::swap(blocks[b], blocks[rand_unif(b)]);
+  }
+
+  ulong position = 0;
+  for (ulong b = 0; b < n_blocks; ++b) {
+    const ulong block_start = blocks[b] * perm_block_size;
+    const ulong block_end = std::min(block_start + perm_block_size, rand_max);
+    const ulong block_start_position = position;
+    for (ulong i = block_start; i < block_end; ++i) {
+      permutation[position++] = i;
+    }
+    for (ulong i = 1; i < block_end - block_start; ++i) {
+      std::swap(permutation[block_start_position + i],
+                permutation[block_start_position + rand_unif(i)]);
+    }
+  }
+  permutation_ready = true;
+}
+
 template <class T, class K>
 void TStoSolver<T, K>::solve(size_t n_epochs) {
   KUL_DBG_FUNC_ENTER
   double initial_time = last_record_time;
   size_t initial_epoch = last_record_epoch;
+  // Built here so that threads of a solver never build it concurrently
+  if (rand_type == RandType::importance && !importance_ready) {
+    init_importance_sampling();
+  }
   auto start = std::chrono::steady_clock::now();
   for (size_t epoch = 1; epoch < (n_epochs + 1); ++epoch) {
     Interruption::throw_if_raised();
-    solve_one_epoch();
+    {
+      tick::TraceRegion trace_region("solver_epoch", "solver",
+                                     initial_epoch + epoch,
+                                     initial_epoch + epoch + 1);
+      solve_one_epoch();
+    }
     if ((initial_epoch + epoch) == 1 || ((initial_epoch + epoch) % record_every == 0)) {
       auto end = std::chrono::steady_clock::now();
       double time = ((end - start).count()) * std::chrono::steady_clock::period::num /
           static_cast<double>(std::chrono::steady_clock::period::den);
       save_history(initial_time + time, initial_epoch + epoch);
+      TICK_TRACE_REGION("solver_objective");
+      SolverInstrumentation::Lap lap(instrumentation);
       objectives.emplace_back(model->loss(iterate) + prox->value(iterate));
+      lap.mark(SolverCounter::objective_cycles);
+      counters_history.emplace_back(instrumentation.get_counters());
       auto obj = objectives.back();
       auto rel_obj = prev_obj != 0 ? std::abs(obj - prev_obj) / std::abs(prev_obj)
                                    : std::abs(obj);
@@ -100,6 +214,17 @@ void TStoSolver<T, K>::solve(size_t n_epochs) {
   last_record_epoch = initial_epoch + n_epochs;
 }
 
+template <class T, class K>
+std::vector<double> TStoSolver<T, K>::get_counter_history(
+    SolverCounter counter) const {
+  std::vector<double> history;
+  history.reserve(counters_history.size());
+  for (const auto &counters : counters_history) {
+    history.emplace_back(counters[static_cast<int>(counter)]);
+  }
+  return history;
+}
+
 template <class T, class K>
 void TStoSolver<T, K>::save_history(double time, int epoch) {
   time_history.emplace_back(time);
@@ -109,6 +234,44 @@ void TStoSolver<T, K>::save_history(double time, int epoch) {
   get_iterate(iterate_history.back());
 }
 
+template <class T, class K>
+ulong TStoSolver<T, K>::memory_usage() const {
+  ulong n_bytes = tick::array_bytes(iterate) + tick::array_bytes(permutation) +
+                  tick::array_bytes(importance_weights) +
+                  importance_table.size() * (sizeof(double) + sizeof(ulong));
+  n_bytes += tick::array_bytes(iterate_history);
+  n_bytes += (time_history.size() + objectives.size()) * sizeof(double) +
+             epoch_history.size() * sizeof(int) +
+             counters_history.size() * sizeof(SolverInstrumentation::Counters);
+  return n_bytes;
+}
+
+template <class T, class K>
+ulong TStoSolver<T, K>::buffers_footprint() const {
+  const ulong n_coeffs = model ? model->get_n_coeffs() : iterate.size();
+  ulong n_bytes = n_coeffs * sizeof(K);
+  if (rand_type == RandType::perm || rand_type == RandType::block_perm) {
+    n_bytes += rand_max * sizeof(ulong);
+  } else if (rand_type == RandType::importance) {
+    // Alias table and importance weights
+    n_bytes += rand_max * (sizeof(double) + sizeof(ulong) + sizeof(T));
+  }
+  return n_bytes;
+}
+
+template <class T, class K>
+ulong TStoSolver<T, K>::memory_footprint(ulong n_epochs) const {
+  const ulong n_coeffs = model ? model->get_n_coeffs() : iterate.size();
+  // History is recorded after the first epoch and every record_every epochs
+  const ulong record_every = std::max(this->record_every, 1);
+  ulong n_records = n_epochs / record_every;
+  if (n_epochs > 0 && record_every > 1) n_records++;
+  const ulong record_bytes = n_coeffs * sizeof(T) + 2 * sizeof(double) +
+                             sizeof(int) +
+                             sizeof(SolverInstrumentation::Counters);
+  return buffers_footprint() + n_records * record_bytes;
+}
+
 template <class T, class K>
 void TStoSolver<T, K>::get_minimizer(Array<T> &out) {
   for (ulong i = 0; i < iterate.size(); ++i) {
@@ -34,8 +34,11 @@ void TSVRG<T, K>::prepare_solve() {
   next_iterate = iterate;
   fixed_w = next_iterate;
   // Allocation and computation of the full gradient
+  SolverInstrumentation::Lap lap(instrumentation);
   full_gradient = Array<T>(iterate.size());
   model->grad(fixed_w, full_gradient);
+  lap.mark(SolverCounter::full_gradient_cycles);
+  lap.count(SolverCounter::n_full_gradients);
 
   if (step_type == SVRG_StepType::BarzilaiBorwein && t > 1) {
     Array<T> iterate_diff = iterate;
@@ -47,7 +50,8 @@ void TSVRG<T, K>::prepare_solve() {
   }
 
   if ((model->is_sparse()) && (prox->is_separable())) {
-    if (!ready_step_corrections) {
+    if (!ready_step_corrections ||
+        this->step_corrections_outdated(importance_step_corrections)) {
       compute_step_corrections();
     }
   } else {
@@ -76,12 +80,38 @@ void TSVRG<T, K>::solve_one_epoch() {
   }
 }
 
+template <class T, class K>
+ulong TSVRG<T, K>::buffers_footprint() const {
+  const ulong n_coeffs = model ? model->get_n_coeffs() : 0;
+  // full_gradient, fixed_w, grad_i, grad_i_fixed_w and next_iterate
+  ulong n_bytes =
+      TStoSolver<T, K>::buffers_footprint() + 5 * n_coeffs * sizeof(T);
+  if (model && model->is_sparse()) {
+    n_bytes += model->get_n_features() * sizeof(T);
+  }
+  return n_bytes;
+}
+
+template <class T, class K>
+ulong TSVRG<T, K>::memory_usage() const {
+  return TStoSolver<T, K>::memory_usage() +
+         tick::array_bytes(steps_correction) +
+         tick::array_bytes(full_gradient) + tick::array_bytes(fixed_w) +
+         tick::array_bytes(grad_i) + tick::array_bytes(grad_i_fixed_w) +
+         tick::array_bytes(next_iterate);
+}
+
 template <class T, class K>
 void TSVRG<T, K>::compute_step_corrections() {
   ulong n_features = model->get_n_features();
   std::shared_ptr<TModelLabelsFeatures<T, K>> casted_model;
   casted_model = std::dynamic_pointer_cast<TModelLabelsFeatures<T, K>>(model);
-  Array<T> columns_sparsity = casted_model->get_column_sparsity_view();
+  // Inverse of the probability that a sampled row hits each column
+  importance_step_corrections = rand_type == RandType::importance;
+  Array<T> columns_sparsity =
+      importance_step_corrections
+          ? this->get_importance_columns_probability(n_features)
+          : casted_model->get_column_sparsity_view();
   steps_correction = Array<T>(n_features);
   for (ulong j = 0; j < n_features; ++j) {
     steps_correction[j] = 1. / columns_sparsity[j];
@@ -95,9 +125,10 @@ void TSVRG<T, K>::solve_dense() {
     std::vector<std::thread> threadsV;
     for (size_t i = 0; i < n_threads; i++) {
       threadsV.emplace_back([=]() mutable -> void {
+        SolverInstrumentation::Lap lap(instrumentation, false);
         for (ulong t = 0; t < (epoch_size / n_threads); ++t) {
           ulong next_i(get_next_i());
-          dense_single_thread_solver(next_i);
+          dense_single_thread_solver(next_i, lap);
         }
       });
     }
@@ -106,9 +137,12 @@ void TSVRG<T, K>::solve_dense() {
     }
 
   } else {
+    SolverInstrumentation::Lap lap(instrumentation);
     for (ulong t = 0; t < epoch_size; ++t) {
       ulong next_i = get_next_i();
-      dense_single_thread_solver(next_i);
+      lap.mark(SolverCounter::sampling_cycles);
+      lap.count(SolverCounter::n_samples);
+      dense_single_thread_solver(next_i, lap);
     }
   }
   if (variance_reduction == SVRG_VarianceReductionMethod::Last) {
@@ -139,10 +173,11 @@ void TSVRG<T, K>::solve_sparse_proba_updates(bool use_intercept,
     std::vector<std::thread> threadsV;
     for (size_t i = 0; i < n_threads; i++) {
       threadsV.emplace_back([=]() mutable -> void {
+        SolverInstrumentation::Lap lap(instrumentation, false);
         for (ulong t = 0; t < (epoch_size / n_threads); ++t) {
           ulong next_i(get_next_i());
           sparse_single_thread_solver(next_i, n_features, use_intercept,
-                                      p_casted_prox);
+                                      p_casted_prox, lap);
         }
       });
     }
@@ -150,10 +185,13 @@ void TSVRG<T, K>::solve_sparse_proba_updates(bool use_intercept,
       threadsV[i].join();
     }
   } else {
+    SolverInstrumentation::Lap lap(instrumentation);
     for (ulong t = 0; t < epoch_size; ++t) {
       ulong next_i = get_next_i();
+      lap.mark(SolverCounter::sampling_cycles);
+      lap.count(SolverCounter::n_samples);
       sparse_single_thread_solver(next_i, n_features, use_intercept,
-                                  p_casted_prox);
+                                  p_casted_prox, lap);
     }
   }
 
@@ -170,15 +208,22 @@ void TSVRG<T, K>::set_starting_iterate(Array<T>& new_iterate) {
 }
 
 template <class T, class K>
-void TSVRG<T, K>::dense_single_thread_solver(const ulong& next_i) {
+void TSVRG<T, K>::dense_single_thread_solver(
+    const ulong& next_i, SolverInstrumentation::Lap& lap) {
   const ulong& i = next_i;
   model->grad_i(i, iterate, grad_i);
   model->grad_i(i, fixed_w, grad_i_fixed_w);
+  lap.mark(SolverCounter::gradient_cycles);
+  const T weight = get_sample_weight(i);
   for (ulong j = 0; j < iterate.size(); ++j) {
-    iterate[j] =
-        iterate[j] - step * (grad_i[j] - grad_i_fixed_w[j] + full_gradient[j]);
+    iterate[j] = iterate[j] - step * (weight * (grad_i[j] - grad_i_fixed_w[j]) +
+                                      full_gradient[j]);
   }
+  lap.mark(SolverCounter::update_cycles);
+  lap.count(SolverCounter::n_nnz, iterate.size());
   prox->call(iterate, step, iterate);
+  lap.mark(SolverCounter::prox_cycles);
+  lap.count(SolverCounter::n_prox_calls);
   if (variance_reduction == SVRG_VarianceReductionMethod::Random &&
       t == rand_index) {
     next_iterate = iterate;
@@ -191,7 +236,7 @@ void TSVRG<T, K>::dense_single_thread_solver(const ulong& next_i) {
 template <class T, class K>
 void TSVRG<T, K>::sparse_single_thread_solver(
     const ulong& next_i, const ulong& n_features, const bool use_intercept,
-    TProxSeparable<T, K>*& casted_prox) {
+    TProxSeparable<T, K>*& casted_prox, SolverInstrumentation::Lap& lap) {
   const ulong& i = next_i;
   // Sparse features vector
   BaseArray<T> x_i = model->get_features(i);
@@ -199,6 +244,9 @@ void TSVRG<T, K>::sparse_single_thread_solver(
   // TODO: a grad_i_factor(i, array1, array2) to loop once on the features
   T grad_i_diff =
       model->grad_i_factor(i, iterate) - model->grad_i_factor(i, fixed_w);
+  // Reweighted so that the descent direction remains unbiased
+  grad_i_diff *= get_sample_weight(i);
+  lap.mark(SolverCounter::gradient_cycles);
   // We update the iterate within the support of the features vector, with the
   // probabilistic correction
   for (ulong idx_nnz = 0; idx_nnz < x_i.size_sparse(); ++idx_nnz) {
@@ -229,6 +277,11 @@ void TSVRG<T, K>::sparse_single_thread_solver(
     else
       iterate[n_features] -= descent_direction;
   }
+  // The separable prox is applied within the update
+  lap.mark(SolverCounter::update_cycles);
+  lap.count(SolverCounter::n_nnz, x_i.size_sparse());
+  lap.count(SolverCounter::n_prox_calls,
+            x_i.size_sparse() + (use_intercept ? 1 : 0));
   // Note that the average option for variance reduction with sparse data is a
   // very bad idea, but this is caught in the python class
   if (variance_reduction == SVRG_VarianceReductionMethod::Random &&
@@ -5,16 +5,46 @@
 
 /** @file */
 
+#include <atomic>
+#include <cstdint>
+
 #include "tick/base/debug.h"
 
 #if defined(PYTHON_LINK)
 
 #include <Python.h>
-#define PYDECREF(ref) Py_DECREF(reinterpret_cast<PyObject *>(ref))
-#define PYINCREF(ref) Py_INCREF(reinterpret_cast<PyObject *>(ref))
+#define PYDECREF(ref) (tick::python_decref(ref))
+#define PYINCREF(ref) (tick::python_incref(ref))
 
 namespace tick {
 
+/**
+ * @brief Reference counting of the Python objects owning shared arrays data.
+ * The bindings release the GIL around long computations, during which shared
+ * arrays can be copied or destroyed by any thread: the GIL is then taken for
+ * the time of the update. It costs nothing more than a check when the GIL is
+ * already held
+ */
+inline void python_incref(void *ref) {
+  if (PyGILState_Check()) {
+    Py_INCREF(reinterpret_cast<PyObject *>(ref));
+  } else {
+    PyGILState_STATE gil_state = PyGILState_Ensure();
+    Py_INCREF(reinterpret_cast<PyObject *>(ref));
+    PyGILState_Release(gil_state);
+  }
+}
+
+inline void python_decref(void *ref) {
+  if (PyGILState_Check()) {
+    Py_DECREF(reinterpret_cast<PyObject *>(ref));
+  } else {
+    PyGILState_STATE gil_state = PyGILState_Ensure();
+    Py_DECREF(reinterpret_cast<PyObject *>(ref));
+    PyGILState_Release(gil_state);
+  }
+}
+
 template <typename T>
 void python_free(T *&ptr) {
   PyMem_RawFree(reinterpret_cast<void *>(ptr));
@@ -52,42 +82,87 @@ void python_malloc(T *&ptr, ulong n) {
 
 #endif
 
-#if defined(DEBUG_C_ARRAY)
+namespace tick {
 
-class DEBUGCAllocArrayCount_t {
-  std::int64_t count;
+/**
+ * @brief Global count of the allocations made by arrays. It is always on:
+ * each allocation and deallocation costs a relaxed atomic increment
+ *
+ * Data shared with numpy arrays is allocated by Python and is not counted.
+ * Bytes can only be counted when allocating as frees do not know the size of
+ * the released buffer, hence only the number of live allocations is known.
+ */
+class DLL_PUBLIC AllocationCounter {
+  static std::atomic<std::uint64_t> n_allocations;
+  static std::atomic<std::uint64_t> n_frees;
+  static std::atomic<std::uint64_t> n_bytes_allocated;
 
  public:
-  DEBUGCAllocArrayCount_t() : count(0) {}
+  static inline void on_allocation(std::uint64_t n_bytes) {
+    n_allocations.fetch_add(1, std::memory_order_relaxed);
+    n_bytes_allocated.fetch_add(n_bytes, std::memory_order_relaxed);
+  }
+
+  static inline void on_free() {
+    n_frees.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  //! @brief Number of allocations since start (or last reset)
+  static ulong get_n_allocations() { return n_allocations.load(); }
 
-  void add() { count++; }
-  void remove() { count--; }
+  //! @brief Number of deallocations since start (or last reset)
+  static ulong get_n_frees() { return n_frees.load(); }
 
-  std::int64_t get() const { return count; }
+  //! @brief Number of allocations not freed yet, can be negative after a
+  //! reset
+  static std::int64_t get_n_live_allocations() {
+    return static_cast<std::int64_t>(n_allocations.load()) -
+           static_cast<std::int64_t>(n_frees.load());
+  }
+
+  //! @brief Total number of bytes allocated since start (or last reset)
+  static ulong get_n_bytes_allocated() { return n_bytes_allocated.load(); }
+
+  static void reset();
 };
 
-extern DEBUGCAllocArrayCount_t DEBUGCAllocArrayCount;
+template <typename T>
+inline void counted_python_malloc(T *&ptr, ulong n) {
+  python_malloc<T>(ptr, n);
+  if (ptr != nullptr) AllocationCounter::on_allocation(n * sizeof(T));
+}
+
+template <typename T>
+inline void counted_python_free(T *&ptr) {
+  if (ptr != nullptr) AllocationCounter::on_free();
+  python_free(ptr);
+}
+
+}  // namespace tick
+
+#if defined(DEBUG_C_ARRAY)
 
-#define TICK_PYTHON_FREE(ptr)                                                  \
-  {                                                                            \
-    (tick::python_free(ptr));                                                  \
-    DEBUGCAllocArrayCount.remove();                                            \
-    TICK_WARNING() << "C-array Free ptr=" << ptr                               \
-                   << " --> #AllocArrayCount=" << DEBUGCAllocArrayCount.get(); \
+#define TICK_PYTHON_FREE(ptr)                                           \
+  {                                                                     \
+    (tick::counted_python_free(ptr));                                   \
+    TICK_WARNING() << "C-array Free ptr=" << ptr                        \
+                   << " --> #AllocArrayCount="                          \
+                   << tick::AllocationCounter::get_n_live_allocations(); \
   }
 
-#define TICK_PYTHON_MALLOC(ptr, type, n)                                       \
-  {                                                                            \
-    (tick::python_malloc<type>(ptr, n));                                       \
-    DEBUGCAllocArrayCount.add();                                               \
-    TICK_WARNING() << "C-array Alloc size=" << n << " ptr=" << ptr             \
-                   << " --> #AllocArrayCount=" << DEBUGCAllocArrayCount.get(); \
+#define TICK_PYTHON_MALLOC(ptr, type, n)                                \
+  {                                                                     \
+    (tick::counted_python_malloc<type>(ptr, n));                        \
+    TICK_WARNING() << "C-array Alloc size=" << n << " ptr=" << ptr      \
+                   << " --> #AllocArrayCount="                          \
+                   << tick::AllocationCounter::get_n_live_allocations(); \
   }
 
 #else
 
-#define TICK_PYTHON_FREE(ptr) (tick::python_free(ptr))
-#define TICK_PYTHON_MALLOC(ptr, type, n) (tick::python_malloc<type>(ptr, n))
+#define TICK_PYTHON_FREE(ptr) (tick::counted_python_free(ptr))
+#define TICK_PYTHON_MALLOC(ptr, type, n) \
+  (tick::counted_python_malloc<type>(ptr, n))
 
 #endif  // DEBUG_C_ARRAY
 
@@ -0,0 +1,78 @@
+#ifndef LIB_INCLUDE_TICK_ARRAY_MEMORY_USAGE_H_
+#define LIB_INCLUDE_TICK_ARRAY_MEMORY_USAGE_H_
+
+// License: BSD 3 clause
+
+/** @file */
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "tick/array/basearray.h"
+#include "tick/array/basearray2d.h"
+
+/*
+ * Number of bytes spanned by the buffers of arrays, used by models, solvers
+ * and inference classes to report their memory usage. Views are counted as
+ * well, it is up to the caller to only pass the arrays it owns.
+ */
+
+namespace tick {
+
+template <typename T>
+ulong array_bytes(const BaseArray<T> &array);
+
+template <typename T, typename MAJ>
+ulong array_bytes(const BaseArray2d<T, MAJ> &array);
+
+template <typename A>
+ulong array_bytes(const std::shared_ptr<A> &array);
+
+template <typename A>
+ulong array_bytes(const std::vector<A> &arrays);
+
+template <typename A>
+ulong array_bytes(const std::deque<A> &arrays);
+
+template <typename T>
+ulong array_bytes(const BaseArray<T> &array) {
+  ulong n_bytes = array.size_data() * sizeof(T);
+  if (array.is_sparse()) n_bytes += array.size_sparse() * sizeof(INDICE_TYPE);
+  return n_bytes;
+}
+
+template <typename T, typename MAJ>
+ulong array_bytes(const BaseArray2d<T, MAJ> &array) {
+  ulong n_bytes = array.size_data() * sizeof(T);
+  if (array.is_sparse()) {
+    n_bytes += array.size_sparse() * sizeof(INDICE_TYPE);
+    if (array.row_indices() != nullptr) {
+      n_bytes += (array.n_rows() + 1) * sizeof(INDICE_TYPE);
+    }
+  }
+  return n_bytes;
+}
+
+template <typename A>
+ulong array_bytes(const std::shared_ptr<A> &array) {
+  return array ? array_bytes(*array) : 0;
+}
+
+template <typename A>
+ulong array_bytes(const std::vector<A> &arrays) {
+  ulong n_bytes = 0;
+  for (const A &array : arrays) n_bytes += array_bytes(array);
+  return n_bytes;
+}
+
+template <typename A>
+ulong array_bytes(const std::deque<A> &arrays) {
+  ulong n_bytes = 0;
+  for (const A &array : arrays) n_bytes += array_bytes(array);
+  return n_bytes;
+}
+
+}  // namespace tick
+
+#endif  // LIB_INCLUDE_TICK_ARRAY_MEMORY_USAGE_H_
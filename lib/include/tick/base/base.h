@@ -32,6 +32,8 @@
 
 #include "tick/array/varray.h"
 
+#include "tick/array/memory_usage.h"
+
 #include "tick/array/view.h"
 #include "tick/array/view2d.h"
 
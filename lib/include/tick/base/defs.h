@@ -54,6 +54,13 @@
 #endif
 #endif
 
+// Hint that the cache line holding addr will soon be read
+#ifdef __GNUC__
+#define TICK_PREFETCH(addr) __builtin_prefetch((addr), 0, 1)
+#else
+#define TICK_PREFETCH(addr) ((void)(addr))
+#endif
+
 #ifndef ulong
 typedef std::uint64_t ulong;
 #endif
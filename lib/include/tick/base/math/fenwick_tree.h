@@ -0,0 +1,80 @@
+#ifndef LIB_INCLUDE_TICK_BASE_MATH_FENWICK_TREE_H_
+#define LIB_INCLUDE_TICK_BASE_MATH_FENWICK_TREE_H_
+
+// License: BSD 3 clause
+
+#include "tick/array/array.h"
+
+/**
+ * \class FenwickTree
+ * \brief Binary indexed tree over non-negative weights, giving in O(log n)
+ * the update of one weight, the total weight and the index at which a given
+ * cumulative weight is reached (used to sample an index proportionally to
+ * its weight)
+ */
+class FenwickTree {
+  //! @brief tree[k] is the sum of the weights of indices in
+  //! [k - (k & -k), k) (1-based storage)
+  ArrayDouble tree;
+
+  //! @brief Largest power of 2 lower or equal to the number of weights
+  ulong top_step;
+
+ public:
+  explicit FenwickTree(ulong n = 0) { init(n); }
+
+  //! @brief Resets the tree to n zero weights
+  void init(ulong n) {
+    tree = ArrayDouble(n + 1);
+    tree.init_to_zero();
+    top_step = 1;
+    while (2 * top_step <= n) top_step *= 2;
+  }
+
+  ulong size() const { return tree.size() - 1; }
+
+  //! @brief Rebuilds the tree from scratch in O(n) from the given weights,
+  //! discarding accumulated rounding errors
+  void build(const ArrayDouble &weights) {
+    if (weights.size() != size()) init(weights.size());
+    tree[0] = 0;
+    for (ulong k = 1; k <= size(); ++k) tree[k] = weights[k - 1];
+    for (ulong k = 1; k <= size(); ++k) {
+      const ulong parent = k + (k & (~k + 1));
+      if (parent <= size()) tree[parent] += tree[k];
+    }
+  }
+
+  //! @brief Adds delta to the weight of index i
+  void add(ulong i, double delta) {
+    for (ulong k = i + 1; k <= size(); k += k & (~k + 1)) tree[k] += delta;
+  }
+
+  //! @brief Sum of the weights of indices lower than i
+  double prefix_sum(ulong i) const {
+    double sum = 0;
+    for (ulong k = i; k > 0; k -= k & (~k + 1)) sum += tree[k];
+    return sum;
+  }
+
+  double total() const { return prefix_sum(size()); }
+
+  /**
+   * @brief Finds the first index i whose cumulative weight reaches value
+   * \param value : cumulative weight searched, replaced by its remainder
+   * within the weight of index i
+   * \return The index, or the last one if value exceeds the total weight
+   */
+  ulong find(double &value) const {
+    ulong pos = 0;
+    for (ulong step = top_step; step > 0; step /= 2) {
+      if (pos + step <= size() && tree[pos + step] < value) {
+        pos += step;
+        value -= tree[pos];
+      }
+    }
+    return pos < size() ? pos : size() - 1;
+  }
+};
+
+#endif  // LIB_INCLUDE_TICK_BASE_MATH_FENWICK_TREE_H_
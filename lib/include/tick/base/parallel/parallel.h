@@ -12,6 +12,7 @@
 #include <vector>
 
 #include "parallel_utils.h"
+#include "trace.h"
 #include "tick/base/interruption.h"
 
 /*
@@ -64,6 +65,9 @@ void _parallel_map_execute_task_and_store_result(
   std::tie(min_index, max_index) =
       tick::get_thread_indices(thread_num, num_threads, dim);
 
+  tick::TraceRegion trace_region("parallel_map", "parallel", min_index,
+                                 max_index);
+
   try {
     for (ulong i = min_index; i < max_index; ++i) {
       map_result[i] = (obj->*f)(i, args...);
@@ -258,6 +262,9 @@ void _parallel_run_execute_task(unsigned int thread_num,
   std::tie(min_index, max_index) =
       tick::get_thread_indices(thread_num, num_threads, dim);
 
+  tick::TraceRegion trace_region("parallel_run", "parallel", min_index,
+                                 max_index);
+
   try {
     for (ulong i = min_index; i < max_index; ++i) {
       (obj->*f)(i, args...);
@@ -320,6 +327,9 @@ void _parallel_map_execute_task_and_reduce_result(
   std::tie(min_index, max_index) =
       tick::get_thread_indices(thread_num, num_threads, dim);
 
+  tick::TraceRegion trace_region("parallel_map_reduce", "parallel", min_index,
+                                 max_index);
+
   try {
     for (ulong i = min_index; i < max_index; ++i) {
       result_ref = reduce_function(result_ref, (obj->*f)(i, args...));
@@ -424,6 +434,9 @@ void _parallel_map_array_execute_task_and_reduce_result(
   std::tie(min_index, max_index) =
       tick::get_thread_indices(thread_num, num_threads, dim);
 
+  tick::TraceRegion trace_region("parallel_map_array", "parallel", min_index,
+                                 max_index);
+
   try {
     for (ulong i = min_index; i < max_index; ++i) {
       f(i, local_result, args...);
@@ -17,6 +17,8 @@
 #include <pthread.h>
 #endif
 
+#include "tick/base/parallel/trace.h"
+
 namespace tick {
 
 class ThreadPool{
@@ -66,7 +68,11 @@ class ThreadPool{
               task = std::move(this->m_tasks[0]);
               this->m_tasks.erase(this->m_tasks.begin());
             }
-            task();
+            {
+              // Tasks are not indexed, hence no range is recorded
+              tick::TraceRegion trace_region("thread_pool_task", "parallel");
+              task();
+            }
             this->m_done--;
           }
         }, i);
@@ -0,0 +1,143 @@
+#ifndef LIB_INCLUDE_TICK_BASE_PARALLEL_TRACE_H_
+#define LIB_INCLUDE_TICK_BASE_PARALLEL_TRACE_H_
+
+// License: BSD 3 clause
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "tick/base/defs.h"
+
+/*
+ * Opt-in tracing of tasks run by the parallel layer. When enabled, every task
+ * of parallel_run, parallel_map, parallel_map_reduce, parallel_map_array and
+ * ThreadPool records its start and end times and the thread it ran on. Tasks
+ * of the parallel_* functions also record the range of indices they
+ * processed. Named regions wrapping model and solver calls are recorded the
+ * same way.
+ *
+ * Events are written in a fixed size ring buffer with a single atomic
+ * increment, so that tracing does not serialize threads. Once full, the
+ * oldest events are overwritten. Events are dumped in the Chrome trace-event
+ * format, which can be opened in chrome://tracing or https://ui.perfetto.dev
+ *
+ * When tracing is disabled, a region costs a relaxed atomic load.
+ */
+
+namespace tick {
+
+struct TraceEvent {
+  // Names must be string literals, they are not copied
+  const char *name = nullptr;
+  const char *category = nullptr;
+  std::uint64_t start_ns = 0;
+  std::uint64_t end_ns = 0;
+  std::uint32_t thread_id = 0;
+  ulong first_index = 0;
+  ulong last_index = 0;
+};
+
+class DLL_PUBLIC Tracer {
+ private:
+  std::atomic<bool> enabled{false};
+  std::vector<TraceEvent> events;
+  std::atomic<ulong> n_recorded{0};
+  std::chrono::steady_clock::time_point origin;
+
+  Tracer() = default;
+
+ public:
+  Tracer(const Tracer &) = delete;
+  Tracer &operator=(const Tracer &) = delete;
+
+  static Tracer &instance();
+
+  inline bool is_enabled() const {
+    return enabled.load(std::memory_order_relaxed);
+  }
+
+  // Starts recording in a ring buffer of the given number of events, any
+  // previously recorded event is dropped. The buffer is reallocated without
+  // synchronization with record(), hence this must not be called while traced
+  // code runs on any thread
+  void enable(ulong capacity = 1 << 16);
+
+  void disable();
+
+  // Nanoseconds elapsed since tracing was enabled
+  inline std::uint64_t now_ns() const {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now() - origin)
+        .count();
+  }
+
+  // Small integer identifying the calling thread in traces
+  static std::uint32_t thread_id();
+
+  void record(const TraceEvent &event);
+
+  // Recorded events, oldest first. Must not be called while traced code runs
+  std::vector<TraceEvent> get_events() const;
+
+  // Total number of recorded events, including overwritten ones
+  ulong get_n_recorded() const { return n_recorded.load(); }
+
+  std::string to_chrome_trace() const;
+
+  void dump_chrome_trace(const std::string &path) const;
+};
+
+/**
+ * @brief Records the lifetime of the object as a trace event if tracing is
+ * enabled
+ */
+class TraceRegion {
+  const char *name;
+  const char *category;
+  ulong first_index, last_index;
+  bool active;
+  std::uint64_t start_ns = 0;
+
+ public:
+  explicit TraceRegion(const char *name, const char *category = "region",
+                       ulong first_index = 0, ulong last_index = 0)
+      : name(name),
+        category(category),
+        first_index(first_index),
+        last_index(last_index),
+        active(Tracer::instance().is_enabled()) {
+    if (active) start_ns = Tracer::instance().now_ns();
+  }
+
+  TraceRegion(const TraceRegion &) = delete;
+  TraceRegion &operator=(const TraceRegion &) = delete;
+
+  ~TraceRegion() {
+    if (active) {
+      Tracer &tracer = Tracer::instance();
+      TraceEvent event;
+      event.name = name;
+      event.category = category;
+      event.start_ns = start_ns;
+      event.end_ns = tracer.now_ns();
+      event.thread_id = Tracer::thread_id();
+      event.first_index = first_index;
+      event.last_index = last_index;
+      tracer.record(event);
+    }
+  }
+};
+
+}  // namespace tick
+
+#define TICK_TRACE_CONCAT_(a, b) a##b
+#define TICK_TRACE_CONCAT(a, b) TICK_TRACE_CONCAT_(a, b)
+
+// Traces the enclosing scope under the given name (a string literal)
+#define TICK_TRACE_REGION(name) \
+  tick::TraceRegion TICK_TRACE_CONCAT(tick_trace_region_, __LINE__)(name)
+
+#endif  // LIB_INCLUDE_TICK_BASE_PARALLEL_TRACE_H_
@@ -96,6 +96,14 @@ class DLL_PUBLIC TimeFunction {
 
   double get_norm();
 
+  /**
+   * @brief Returns the sorted times of [start_time, end_time], both included,
+   * between which the function is affine (constant with constant
+   * interpolation modes), namely its sampling times and its border, repeated
+   * every cycle for cyclic functions
+   */
+  ArrayDouble get_breakpoints(double start_time, double end_time);
+
  private:
   SArrayDoublePtr sampled_y;
   SArrayDoublePtr future_max;
@@ -82,6 +82,12 @@ class TModel {
     TICK_CLASS_DOES_NOT_IMPLEMENT(get_class_name());
   }
 
+  /**
+   * @brief Hint that the features of sample i will soon be read. Does
+   * nothing by default
+   */
+  virtual void prefetch_features(const ulong i) const {}
+
   virtual void sdca_primal_dual_relation(const T l_l2sq,
                                          const Array<T> &dual_vector,
                                          Array<T> &out_primal_vector) {
@@ -103,6 +109,13 @@ class TModel {
     TICK_CLASS_DOES_NOT_IMPLEMENT(get_class_name());
   }
 
+  /**
+   * @brief Get the Lipschitz constants of the gradient of each sample
+   */
+  virtual Array<T> get_lip_consts() {
+    TICK_CLASS_DOES_NOT_IMPLEMENT(get_class_name());
+  }
+
   /**
    * @brief Get the maximum of all Lipschits constants
    * @note This will cache the obtained value for later calls
@@ -115,6 +128,19 @@ class TModel {
    */
   virtual T get_lip_mean() { TICK_CLASS_DOES_NOT_IMPLEMENT(get_class_name()); }
 
+  /**
+   * @brief Number of bytes currently held by the arrays the model computes
+   * itself (weights, caches...). The data given to the model is not counted
+   */
+  virtual ulong memory_usage() const { return 0; }
+
+  /**
+   * @brief Estimate of the peak number of bytes held by the model once its
+   * weights are computed. It is available as soon as data is given, before
+   * anything is allocated, so that too large problems can be detected early
+   */
+  virtual ulong memory_footprint() const { return memory_usage(); }
+
  public:
   template <class Archive>
   void serialize(Archive &ar) {}
@@ -86,6 +86,13 @@ class DLL_PUBLIC TModelGeneralizedLinear
 
   virtual bool get_fit_intercept() const { return fit_intercept; }
 
+  ulong memory_usage() const override {
+    return tick::array_bytes(features_norm_sq);
+  }
+
+  // The squared norms of the features are computed for some solvers only
+  ulong memory_footprint() const override { return n_samples * sizeof(T); }
+
   template <class Archive>
   void serialize(Archive &ar) {
     ar(cereal::make_nvp(
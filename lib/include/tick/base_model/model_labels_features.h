@@ -37,6 +37,8 @@ class DLL_PUBLIC TModelLabelsFeatures : public virtual TModel<T, K> {
     return view_row(*features, i);
   }
 
+  void prefetch_features(ulong i) const override;
+
   virtual T get_label(ulong i) const { return (*labels)[i]; }
 
   virtual ulong get_rand_max() const { return n_samples; }
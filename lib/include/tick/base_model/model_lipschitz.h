@@ -46,6 +46,14 @@ class DLL_PUBLIC TModelLipschitz : public virtual TModel<T, K> {
    */
   T get_lip_max() override;
 
+  /**
+   * @brief Get the Lipschitz constants of the gradient of each sample
+   */
+  Array<T> get_lip_consts() override {
+    compute_lip_consts();
+    return lip_consts;
+  }
+
   /**
    * @brief Get the mean of all Lipschits constants
    * @note This will cache the obtained value for later calls
@@ -0,0 +1,101 @@
+#ifndef LIB_INCLUDE_TICK_HAWKES_INFERENCE_HAWKES_ACCELERATED_EM_H_
+#define LIB_INCLUDE_TICK_HAWKES_INFERENCE_HAWKES_ACCELERATED_EM_H_
+
+// License: BSD 3 clause
+
+#include <functional>
+
+#include "tick/base/base.h"
+#include "tick/hawkes/inference/hawkes_basis_kernels.h"
+#include "tick/hawkes/inference/hawkes_em.h"
+#include "tick/hawkes/inference/hawkes_sumgaussians.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////
+//
+//
+// The following class implements the SQUAREM extrapolation scheme (S3 step
+// length) presented in the paper `Simple and Globally Convergent Methods for
+// Accelerating the Convergence of Any EM Algorithm` by Varadhan and Roland,
+// 2008.
+//
+// It drives the iterations of the non parametric Hawkes learners, each call to
+// their `solve` method being one step of the fixed point map that is
+// accelerated. All iterations are performed in C++.
+//
+////////////////////////////////////////////////////////////////////////////////////////////
+
+class DLL_PUBLIC HawkesAcceleratedEM {
+ public:
+  //! @brief One step of the accelerated fixed point map, performed in place on
+  //! the flattened parameters
+  typedef std::function<void(ArrayDouble &)> FixedPointStep;
+
+  //! @brief Objective maximized by the fixed point map (eg. the
+  //! loglikelihood), evaluated on the flattened parameters
+  typedef std::function<double(ArrayDouble &)> Objective;
+
+ private:
+  //! @brief Maximum number of extrapolation cycles
+  ulong max_iter;
+
+  //! @brief Iterations stop when the relative change of the parameters between
+  //! two cycles is below this tolerance
+  double tol;
+
+  //! @brief Multiplicative factor used to adapt the maximum step length
+  double step_factor;
+
+  //! @brief Number of cycles performed during last run
+  ulong n_iter;
+
+  //! @brief Number of calls to the learner `solve` method during last run
+  ulong n_solve_calls;
+
+  //! @brief Number of rejected extrapolations during last run
+  ulong n_rejected;
+
+  //! @brief Relative change of the parameters at the end of last run
+  double rel_change;
+
+ public:
+  HawkesAcceleratedEM(const ulong max_iter, const double tol);
+
+  //! @brief Accelerates HawkesEM iterations
+  //! Extrapolations are safeguarded with the loglikelihood
+  //! \return the number of cycles performed
+  ulong solve(HawkesEM &learner, ArrayDouble &mu, ArrayDouble2d &kernels);
+
+  //! @brief Accelerates HawkesBasisKernels iterations
+  //! \return the number of cycles performed
+  ulong solve(HawkesBasisKernels &learner, ArrayDouble &mu, ArrayDouble2d &gdm,
+              ArrayDouble2d &auvd, ulong max_iter_gdm, double max_tol_gdm);
+
+  //! @brief Accelerates HawkesSumGaussians iterations
+  //! \return the number of cycles performed
+  ulong solve(HawkesSumGaussians &learner, ArrayDouble &mu,
+              ArrayDouble2d &amplitudes);
+
+  //! @brief Runs the accelerated iterations on any fixed point map
+  //! If objective is empty, extrapolations are safeguarded with the fixed
+  //! point residual instead
+  //! \param x : starting point, modified in place with the final iterate
+  //! \return the number of cycles performed
+  ulong run(ArrayDouble &x, FixedPointStep step,
+            Objective objective = Objective());
+
+  ulong get_max_iter() const { return max_iter; }
+  void set_max_iter(const ulong max_iter);
+
+  double get_tol() const { return tol; }
+  void set_tol(const double tol);
+
+  double get_step_factor() const { return step_factor; }
+  void set_step_factor(const double step_factor);
+
+  ulong get_n_iter() const { return n_iter; }
+  ulong get_n_solve_calls() const { return n_solve_calls; }
+  ulong get_n_rejected() const { return n_rejected; }
+  double get_rel_change() const { return rel_change; }
+};
+
+#endif  // LIB_INCLUDE_TICK_HAWKES_INFERENCE_HAWKES_ACCELERATED_EM_H_
@@ -28,6 +28,10 @@ class DLL_PUBLIC HawkesADM4 : public ModelHawkesList {
   //! for realization r: g[r][u][i][v] = \sum_{t_j^v < t_i^u} g(t_i^u - t_j^v)
   ArrayDouble2dList2D g;
 
+  //! @brief If false, g is not stored but recomputed on the fly at each
+  //! iteration with the recursive formula of exponential kernels
+  bool store_weights;
+
   //! @brief Buffer variables used to compute p_ij
   ArrayDouble2d next_C, unnormalized_next_C;
 
@@ -45,6 +49,10 @@ class DLL_PUBLIC HawkesADM4 : public ModelHawkesList {
   void solve(ArrayDouble &mu, ArrayDouble2d &adjacency, ArrayDouble2d &z1,
              ArrayDouble2d &z2, ArrayDouble2d &u1, ArrayDouble2d &u2);
 
+  ulong memory_usage() const override;
+
+  ulong memory_footprint() const override;
+
  private:
   void compute_weights_ru(const ulong r_u, ArrayDouble2d &map_kernel_integral);
 
@@ -54,6 +62,18 @@ class DLL_PUBLIC HawkesADM4 : public ModelHawkesList {
 
   void estimate_ru(const ulong r_u, ArrayDouble &mu, ArrayDouble2d &adjacency);
 
+  //! @brief Same as estimate_ru but g is recomputed while looping over the
+  //! events of node u instead of being read
+  void estimate_ru_streaming(const ulong r_u, ArrayDouble &mu,
+                             ArrayDouble2d &adjacency);
+
+  //! @brief Adds to p_ij buffers the contribution of the i-th event of node u
+  //! given the kernel values g_ru_i
+  void estimate_ru_i(const double mu_u, const ArrayDouble &adjacency_u,
+                     const ArrayDouble &g_ru_i, double &next_mu_ur,
+                     ArrayDouble &next_C_ru,
+                     ArrayDouble &unnormalized_next_C_ru);
+
   void update_adjacency_u(const ulong u, ArrayDouble &adjacency_u,
                           ArrayDouble &z1_u, ArrayDouble &z2_u,
                           ArrayDouble &u1_u, ArrayDouble &u2_u);
@@ -65,6 +85,8 @@ class DLL_PUBLIC HawkesADM4 : public ModelHawkesList {
   void set_decay(const double decay);
   double get_rho() const;
   void set_rho(const double rho);
+  bool get_store_weights() const;
+  void set_store_weights(const bool store_weights);
 };
 
 #endif  // LIB_INCLUDE_TICK_HAWKES_INFERENCE_HAWKES_ADM4_H_
@@ -33,9 +33,28 @@ class DLL_PUBLIC HawkesBasisKernels : public ModelHawkesList {
   //! @brief penalty parameter
   double alpha;
 
-  //! @brief Buffer variables
-  ArrayDouble2d rud, Dudm, Dudm_temp, Cudm, Gdm, a_sum_vd;
-  ArrayDouble2d quvd, quvd_temp;
+  //! @brief Buffer variables computed per node
+  ArrayDouble2d rud, quvd, a_sum_vd;
+
+  //! @brief Basis functions and their primitives stored bin by bin, with shape
+  //! (kernel_size, n_basis), so that the loops on the basis functions run on
+  //! contiguous memory
+  ArrayDouble2d gmd, Gmd;
+
+  //! @brief Buffer variables allocated per thread (and not per node) so that
+  //! their size does not grow with the number of nodes:
+  //! - Cumd and Dumd accumulate, with shape (n_threads, kernel_size * n_basis)
+  //! - Dumd_temp, quvd_temp and v_indices are scratch buffers used for each
+  //! jump, with shapes (n_threads, kernel_size * n_basis),
+  //! (n_threads, n_nodes * n_basis) and (n_threads, n_nodes)
+  ArrayDouble2d Cumd, Dumd, Dumd_temp, quvd_temp;
+  ArrayULong2d v_indices;
+
+  //! @brief Coefficients of the quadratic equations solved for each basis
+  //! function, with shape (n_basis, kernel_size), and the relative error
+  //! reached for each of them
+  ArrayDouble2d Cdm, Ddm;
+  ArrayDouble gdm_rel_errors;
 
  public:
   HawkesBasisKernels(const double kernel_support, const ulong kernel_size,
@@ -45,10 +64,36 @@ class DLL_PUBLIC HawkesBasisKernels : public ModelHawkesList {
   double solve(ArrayDouble &mu, ArrayDouble2d &gdm, ArrayDouble2d &auvd,
                ulong max_iter_gdm, double max_tol_gdm);
 
+  ulong memory_usage() const override;
+
+  ulong memory_footprint() const override;
+
  private:
-  void solve_u(ulong u, ArrayDouble &mu, ArrayDouble2d &gdm,
+  //! @brief A method called in parallel by the method 'solve'
+  //! It runs solve_u on all nodes assigned to this thread
+  //! @param thread_index : index of the thread, tells which buffers to fill
+  void solve_thread(ulong thread_index, ArrayDouble &mu, ArrayDouble2d &auvd);
+
+  //! @brief Accumulates the contribution of node u in the buffers of the
+  //! given thread
+  void solve_u(ulong u, ulong thread_index, ArrayDouble &mu,
                ArrayDouble2d &auvd);
 
+  //! @brief A method called in parallel by the method 'solve' to reduce the
+  //! per thread buffers two by two
+  //! @param i : index of the pair of buffers to reduce at this level
+  //! @param stride : distance between the two buffers reduced together
+  void reduce_thread_buffers(ulong i, ulong stride);
+
+  //! @brief A method called in parallel by the method 'solve' to update the
+  //! amplitudes of node u once all nodes have been processed
+  void update_amplitudes_u(ulong u, ArrayDouble2d &auvd);
+
+  //! @brief A method called in parallel by the method 'solve' to update the
+  //! basis function d
+  void update_basis_d(ulong d, ArrayDouble2d &gdm, ulong max_iter_gdm,
+                      double max_tol_gdm);
+
   void allocate_weights();
 
  public:
@@ -4,6 +4,8 @@
 
 // License: BSD 3 clause
 
+#include <string>
+
 #include "tick/base/base.h"
 
 extern void PointProcessCondLaw(ArrayDouble &y_time, ArrayDouble &z_time,
@@ -12,4 +14,45 @@ extern void PointProcessCondLaw(ArrayDouble &y_time, ArrayDouble &z_time,
                                 double y_lambda, ArrayDouble &res_X,
                                 ArrayDouble &res_Y);
 
+//! @brief Computes the conditional laws of all the (i, j, l) triplets of a
+//! realization, where l is a mark interval of component j.
+//! \param times : arrival times of each component
+//! \param marks : cumulative marks signal of each component
+//! \param mark_intervals : for each component j, the flattened bounds
+//! [min_0, max_0, min_1, max_1, ...] of its mark intervals
+//! \param lags : array of lags of size N + 1
+//! \param T : end time of the realization
+//! \param res_X : abscissa of the conditional laws, of size N
+//! \param res_Y : conditional laws in lexical order on (i, j, l), of shape
+//! (n_index, N)
+//! \param n_threads : number of threads used, (i, j) pairs being dispatched
+//! among them
+extern void PointProcessCondLawBatch(const SArrayDoublePtrList1D &times,
+                                     const SArrayDoublePtrList1D &marks,
+                                     const SArrayDoublePtrList1D &mark_intervals,
+                                     ArrayDouble &lags, double T,
+                                     ArrayDouble &res_X, ArrayDouble2d &res_Y,
+                                     int n_threads = 1);
+
+//! @brief Solves the Fredholm systems giving the kernels phi^ij_l at the
+//! quadrature points from the conditional laws.
+//! \param claw_X : abscissa of the conditional laws
+//! \param claws : conditional laws in lexical order on (i, j, l)
+//! \param n_marks : number of mark intervals of each component
+//! \param mark_probabilities : probabilities of the mark intervals, flattened
+//! in lexical order on (j, l)
+//! \param mean_intensity : mean intensity of each component
+//! \param quad_x : abscissa of the quadrature points
+//! \param quad_w : weights of the quadrature points
+//! \param quad_method : one of 'gauss', 'gauss-', 'log' or 'lin'
+//! \param res_phi : kernels values at quadrature points in lexical order on
+//! (i, j, l), of shape (n_index, n_quad)
+//! \param n_threads : number of threads used, one system being solved per
+//! component i
+extern void HawkesConditionalLawFredholm(
+    ArrayDouble &claw_X, ArrayDouble2d &claws, ArrayULong &n_marks,
+    ArrayDouble &mark_probabilities, ArrayDouble &mean_intensity,
+    ArrayDouble &quad_x, ArrayDouble &quad_w, const std::string &quad_method,
+    ArrayDouble2d &res_phi, int n_threads = 1);
+
 #endif  // LIB_INCLUDE_TICK_HAWKES_INFERENCE_HAWKES_CONDITIONAL_LAW_H_
@@ -10,8 +10,25 @@ class DLL_PUBLIC HawkesCumulant : public ModelHawkesList {
   double integration_support;
   bool are_cumulants_ready;
 
+  //! @brief Mean intensity of each node for each realization
+  ArrayDouble2d mean_intensity_per_realization;
+
+  //! @brief Symmetrized integrated covariance (C) and its J counterpart for
+  //! each realization, stored as rows of size n_nodes * n_nodes
+  ArrayDouble2d covariance_per_realization, J_per_realization;
+
+  //! @brief Terms needed to compute K_c, row r * n_nodes + k stores
+  //! E_c[i, k, 0] for all i in its first n_nodes values and E_c[k, j, 1] for
+  //! all j in its last n_nodes values
+  ArrayDouble2d E_c_per_realization;
+
+  //! @brief Cumulants averaged over all realizations
+  SArrayDoublePtr mean_intensity;
+  SArrayDouble2dPtr covariance, skewness;
+
  public:
-  explicit HawkesCumulant(double integration_support);
+  explicit HawkesCumulant(double integration_support,
+                          const int max_n_threads = 1);
 
   SArrayDoublePtr compute_A_and_I_ij(ulong r, ulong i, ulong j,
                                      double mean_intensity_j);
@@ -20,6 +37,18 @@ class DLL_PUBLIC HawkesCumulant : public ModelHawkesList {
                        double mean_intensity_i, double mean_intensity_j,
                        double J_ij);
 
+  //! @brief Computes mean intensity (L), integrated covariance (C) and
+  //! integrated skewness slice (K_c) in parallel over all realizations
+  void compute_cumulants();
+
+  ulong memory_usage() const override;
+
+  ulong memory_footprint() const override;
+
+  SArrayDoublePtr get_mean_intensity() const { return mean_intensity; }
+  SArrayDouble2dPtr get_covariance() const { return covariance; }
+  SArrayDouble2dPtr get_skewness() const { return skewness; }
+
   double get_integration_support() const { return integration_support; }
 
   void set_integration_support(const double integration_support) {
@@ -33,6 +62,18 @@ class DLL_PUBLIC HawkesCumulant : public ModelHawkesList {
   void set_are_cumulants_ready(const bool are_cumulants_ready) {
     this->are_cumulants_ready = are_cumulants_ready;
   }
+
+ private:
+  void compute_A_and_I_ij(ulong r, ulong i, ulong j, double mean_intensity_j,
+                          double &res_C, double &res_J);
+
+  //! @brief Computes row i of C and J matrices of realization r
+  void compute_C_and_J_ri(const ulong r_i);
+
+  //! @brief Computes all E_c terms which average is taken over the events of
+  //! node k in realization r. Window counts of every node around each of
+  //! these events are computed once and shared by all terms
+  void compute_E_c_rk(const ulong r_k);
 };
 
 #endif  // LIB_INCLUDE_TICK_HAWKES_INFERENCE_HAWKES_CUMULANT_H_
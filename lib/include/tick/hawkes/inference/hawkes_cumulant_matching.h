@@ -0,0 +1,128 @@
+#ifndef LIB_INCLUDE_TICK_HAWKES_INFERENCE_HAWKES_CUMULANT_MATCHING_H_
+#define LIB_INCLUDE_TICK_HAWKES_INFERENCE_HAWKES_CUMULANT_MATCHING_H_
+
+// License: BSD 3 clause
+
+#include <deque>
+
+#include "tick/base/base.h"
+
+enum class HawkesCumulantMatching_Solver : uint16_t {
+  GD = 1,
+  Momentum = 2,
+  AdaGrad = 3,
+  RMSProp = 4,
+  AdaDelta = 5,
+  Adam = 6,
+  LBFGS = 7,
+};
+
+/**
+ * \class HawkesCumulantMatching
+ * \brief Objective, gradient and solvers of the cumulant matching estimation
+ * of the integrated kernels of a Hawkes process, described in the paper
+ * `Uncovering causality from multivariate Hawkes integrated cumulants` by
+ * Achab, Bacry, Gaïffas, Mastromatteo and Muzy (2017) in ICML.
+ *
+ * The objective is minimized over R = (I - G)^{-1} where G is the adjacency
+ * matrix
+ *
+ * (1 - cs_ratio) * mean((K(R) - K_c)^2) + cs_ratio * mean((C(R) - C)^2)
+ *   + strength_lasso * |I - R^{-1}|_1
+ *   + strength_ridge * |I - R^{-1}|_2^2 / 2
+ *
+ * with C(R) = R diag(L) R^T and
+ * K(R) = C (R * R)^T + 2 R (R * C)^T - 2 R diag(L) (R * R)^T
+ * where * is the elementwise product
+ */
+class DLL_PUBLIC HawkesCumulantMatching {
+  //! @brief Mean intensity, integrated covariance and integrated skewness
+  //! slice estimated from the data
+  ArrayDouble mean_intensity;
+  ArrayDouble2d covariance, skewness;
+  ulong n_nodes;
+
+  double cs_ratio;
+  double strength_lasso;
+  double strength_ridge;
+
+  HawkesCumulantMatching_Solver solver;
+  double step;
+
+  //! @brief Momentum of Momentum solver
+  double momentum;
+
+  //! @brief Number of corrections kept by LBFGS solver
+  ulong history_size;
+
+  //! @brief Number of iterations performed since last reset
+  ulong t;
+
+  //! @brief Solvers accumulators
+  ArrayDouble2d accumulator_1, accumulator_2;
+
+  //! @brief LBFGS previous iterate and gradient, and stored corrections
+  ArrayDouble2d previous_R, previous_grad;
+  std::deque<ArrayDouble2d> history_s, history_y;
+
+  //! @brief Buffers used in loss and gradient computations
+  ArrayDouble2d R_L, R_sq, R_C, diff_covariance, diff_skewness, buffer_1,
+      buffer_2, buffer_3, grad;
+
+ public:
+  HawkesCumulantMatching(
+      const double cs_ratio, const double strength_lasso,
+      const double strength_ridge,
+      const HawkesCumulantMatching_Solver solver =
+          HawkesCumulantMatching_Solver::Adam,
+      const double step = 1e-2);
+
+  //! @brief Sets the cumulants estimated by HawkesCumulant
+  void set_cumulants(const ArrayDouble &mean_intensity,
+                     const ArrayDouble2d &covariance,
+                     const ArrayDouble2d &skewness);
+
+  //! @brief Objective value at R
+  double loss(ArrayDouble2d &R);
+
+  //! @brief Fills out with the gradient at R and returns the objective value
+  double grad_loss(ArrayDouble2d &R, ArrayDouble2d &out);
+
+  //! @brief Forgets the state of the solver (accumulators, LBFGS history)
+  void reset();
+
+  //! @brief Performs n_iter iterations of the solver, R being modified in
+  //! place
+  void solve(ArrayDouble2d &R, const ulong n_iter = 1);
+
+  double get_cs_ratio() const { return cs_ratio; }
+  void set_cs_ratio(const double cs_ratio);
+  double get_strength_lasso() const { return strength_lasso; }
+  void set_strength_lasso(const double strength_lasso);
+  double get_strength_ridge() const { return strength_ridge; }
+  void set_strength_ridge(const double strength_ridge);
+  HawkesCumulantMatching_Solver get_solver() const { return solver; }
+  void set_solver(const HawkesCumulantMatching_Solver solver);
+  double get_step() const { return step; }
+  void set_step(const double step);
+  double get_momentum() const { return momentum; }
+  void set_momentum(const double momentum);
+  ulong get_history_size() const { return history_size; }
+  void set_history_size(const ulong history_size);
+
+ private:
+  void check_R(const ArrayDouble2d &R) const;
+
+  //! @brief Fills diff_covariance and diff_skewness with C(R) - C and
+  //! K(R) - K_c and returns the objective without regularization
+  double compute_differences(ArrayDouble2d &R);
+
+  //! @brief Computes the regularization term and adds its gradient to out
+  //! if out is not nullptr
+  double regularization(ArrayDouble2d &R, ArrayDouble2d *out);
+
+  void step_first_order(ArrayDouble2d &R);
+  void step_lbfgs(ArrayDouble2d &R);
+};
+
+#endif  // LIB_INCLUDE_TICK_HAWKES_INFERENCE_HAWKES_CUMULANT_MATCHING_H_
@@ -29,6 +29,11 @@ class DLL_PUBLIC HawkesEM : public ModelHawkesList {
   SArrayDoublePtr kernel_discretization;
 
   //! @brief buffer variables
+  //! They are allocated per thread (and not per realization) so that their
+  //! size does not grow with the number of realizations:
+  //! - next_mu has shape (n_threads, n_nodes)
+  //! - next_kernels has shape (n_threads * n_nodes, n_nodes * kernel_size)
+  //! - unnormalized_kernels has shape (n_threads, n_nodes * kernel_size)
   ArrayDouble2d next_mu;
   ArrayDouble2d next_kernels;
   ArrayDouble2d unnormalized_kernels;
@@ -46,6 +51,10 @@ class DLL_PUBLIC HawkesEM : public ModelHawkesList {
   //! @brief The main method to perform one iteration
   void solve(ArrayDouble &mu, ArrayDouble2d &kernels);
 
+  ulong memory_usage() const override;
+
+  ulong memory_footprint() const override;
+
   //! @brief Compute loglikelihood of a given kernel and baseline
   double loglikelihood(const ArrayDouble &mu, ArrayDouble2d &kernels);
 
@@ -73,32 +82,58 @@ class DLL_PUBLIC HawkesEM : public ModelHawkesList {
 
  private:
   //! @brief A method called in parallel by the method 'solve'
+  //! It runs solve_ur on all (r, u) tasks assigned to this thread
+  //! @param thread_index : index of the thread, tells which buffers to fill
+  void solve_thread(const ulong thread_index, const ArrayDouble &mu,
+                    ArrayDouble2d &kernels);
+
+  //! @brief Accumulates the contribution of node u of realization r in the
+  //! buffers of the given thread
   //! @param r_u : r * n_realizations + u, tells which realization and which
   //! node
-  void solve_ur(const ulong r_u, const ArrayDouble &mu, ArrayDouble2d &kernel);
+  //! @param thread_index : index of the thread whose buffers are filled
+  //! @param kernel_dts : discretization intervals of the kernel
+  void solve_ur(const ulong r_u, const ulong thread_index,
+                const ArrayDouble &mu, ArrayDouble2d &kernel,
+                const ArrayDouble &kernel_dts);
+
+  //! @brief A method called in parallel by the method 'solve' to reduce the
+  //! per thread buffers two by two
+  //! @param i : index of the pair of buffers to reduce at this level
+  //! @param stride : distance between the two buffers reduced together
+  void reduce_thread_buffers(const ulong i, const ulong stride);
 
   //! @brief A method called in parallel by the method 'loglikelihood'
   //! @param r_u : r * n_realizations + u, tells which realization and which
   //! node
+  //! @param kernel_norms : kernel norms, as returned by get_kernel_norms
+  //! @param discretization : kernel discretization, as returned by
+  //! get_kernel_discretization
   double loglikelihood_ur(const ulong r_u, const ArrayDouble &mu,
-                          ArrayDouble2d &kernels);
+                          ArrayDouble2d &kernels,
+                          const ArrayDouble2d &kernel_norms,
+                          const ArrayDouble &discretization);
 
   //! @brief A method called by solve_ur and logliklihood_ur to compute all
   //! intensities at all timestamps occuring in node u of realization r
   //! @param r_u : r * n_realizations + u, tells which realization and which
   //! node
-  //! @param intensity_func : function that will be called for all timestamps
-  //! with the intensity at this timestamp as argument
-  //! @param store_unnormalized_kernel : solve_ur method needs to store an
-  //! unnormalized version of the kernels in the class variable
-  //! unnormalized_kernels
+  //! @param intensity_func : functor that will be called for all timestamps
+  //! with the intensity at this timestamp as argument. It is a template
+  //! parameter so that this call can be inlined
+  //! @param unnormalized_kernel_ru : solve_ur method needs to store an
+  //! unnormalized version of the kernels for each timestamp in this scratch
+  //! array of shape (n_nodes, kernel_size). Set to nullptr if not needed.
+  template <class IntensityFunc>
   void compute_intensities_ur(const ulong r_u, const ArrayDouble &mu,
                               ArrayDouble2d &kernels,
-                              std::function<void(double)> intensity_func,
-                              bool store_unnormalized_kernel);
+                              IntensityFunc intensity_func,
+                              ArrayDouble2d *unnormalized_kernel_ru);
 
   double compute_compensator_ur(const ulong r_u, const ArrayDouble &mu,
-                                ArrayDouble2d &kernels);
+                                ArrayDouble2d &kernels,
+                                const ArrayDouble2d &kernel_norms,
+                                const ArrayDouble &discretization);
 
   void check_baseline_and_kernels(const ArrayDouble &mu,
                                   ArrayDouble2d &kernels) const;
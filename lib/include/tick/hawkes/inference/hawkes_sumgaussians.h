@@ -55,6 +55,11 @@ class DLL_PUBLIC HawkesSumGaussians : public ModelHawkesList {
   //! g_m(t_i^u - t_j^v)
   ArrayDouble2dList2D g;
 
+  //! @brief If false, g is not stored but recomputed on the fly at each
+  //! iteration, only events in a truncated window of the gaussian kernels
+  //! support being considered
+  bool store_weights;
+
   //! @brief Buffer variables used to compute p_ij
   ArrayDouble2d next_C, unnormalized_next_C;
 
@@ -74,6 +79,10 @@ class DLL_PUBLIC HawkesSumGaussians : public ModelHawkesList {
   //! @brief Perform one iteration of the algorithm
   void solve(ArrayDouble &mu, ArrayDouble2d &amplitudes);
 
+  ulong memory_usage() const override;
+
+  ulong memory_footprint() const override;
+
  private:
   void compute_weights_ru(const ulong r_u, ArrayDouble2d &map_kernel_integral);
 
@@ -81,6 +90,18 @@ class DLL_PUBLIC HawkesSumGaussians : public ModelHawkesList {
 
   void estimate_ru(const ulong r_u, ArrayDouble &mu, ArrayDouble2d &amplitudes);
 
+  //! @brief Same as estimate_ru but g is recomputed while looping over the
+  //! events of node u instead of being read
+  void estimate_ru_streaming(const ulong r_u, ArrayDouble &mu,
+                             ArrayDouble2d &amplitudes);
+
+  //! @brief Adds to p_ij buffers the contribution of the i-th event of node u
+  //! given the kernel values g_ru_i
+  void estimate_ru_i(const double mu_u, const ArrayDouble &amplitudes_u,
+                     const ArrayDouble &g_ru_i, double &next_mu_ur,
+                     ArrayDouble &next_C_ru,
+                     ArrayDouble &unnormalized_next_C_ru);
+
   void update_amplitudes_u(const ulong u, ArrayDouble &amplitudes_u);
 
   void prox_amplitudes_u(const ulong u, ArrayDouble2d &amplitudes,
@@ -101,6 +122,8 @@ class DLL_PUBLIC HawkesSumGaussians : public ModelHawkesList {
   void set_strength_lasso(const double strength_lasso);
   double get_strength_grouplasso() const;
   void set_strength_grouplasso(const double strength_grouplasso);
+  bool get_store_weights() const;
+  void set_store_weights(const bool store_weights);
 };
 
 #endif  // LIB_INCLUDE_TICK_HAWKES_INFERENCE_HAWKES_SUMGAUSSIANS_H_
@@ -98,10 +98,24 @@ class DLL_PUBLIC ModelHawkesLogLik : public ModelHawkesList {
    */
   void hessian(const ArrayDouble &coeffs, ArrayDouble &out);
 
+  /**
+   * @brief Compute the compensator increments of each node between its
+   * consecutive jumps (time-rescaled inter-arrival times), for all realizations
+   * \param coeffs : Point in which the compensators are computed
+   * \return For each realization r and node i, an array whose k-th entry is
+   * \f$ \Lambda_i(t_{i,k}) - \Lambda_i(t_{i,k-1}) \f$, with
+   * \f$ t_{i,-1} = 0 \f$
+   */
+  SArrayDoublePtrList2D get_compensator_increments(const ArrayDouble &coeffs);
+
   ulong get_rand_max() const { return get_n_total_jumps(); }
 
   ulong get_n_coeffs() const override;
 
+  ulong memory_usage() const override;
+
+  ulong memory_footprint() const override;
+
   template <class Archive>
   void serialize(Archive &ar) {
     ar(cereal::make_nvp("ModelHawkesList",
@@ -180,6 +194,16 @@ class DLL_PUBLIC ModelHawkesLogLik : public ModelHawkesList {
   void hessian_i_r(const ulong i_r, const ArrayDouble &coeffs,
                    ArrayDouble &out);
 
+  /**
+   * @brief Compute compensator increments for one index between 0 and
+   * n_realizations * n_nodes
+   * \param i_r : r * n_realizations + i, tells which realization and which node
+   * \param coeffs : Point in which the compensator is computed
+   * \param out : List of arrays of each realization whose i-th entry is filled
+   */
+  void compensator_increments_i_r(const ulong i_r, const ArrayDouble &coeffs,
+                                  SArrayDoublePtrList2D &out);
+
   std::pair<ulong, ulong> sampled_i_to_realization(const ulong sampled_i);
 };
 
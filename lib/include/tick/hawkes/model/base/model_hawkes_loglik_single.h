@@ -106,6 +106,26 @@ class DLL_PUBLIC ModelHawkesLogLikSingle : public ModelHawkesSingle {
    */
   void hessian(const ArrayDouble &coeffs, ArrayDouble &out);
 
+  /**
+   * @brief Compute the compensator increments of each node between its
+   * consecutive jumps (time-rescaled inter-arrival times)
+   * \param coeffs : Point in which the compensators are computed
+   * \return For each node i, an array whose k-th entry is
+   * \f$ \Lambda_i(t_{i,k}) - \Lambda_i(t_{i,k-1}) \f$, with
+   * \f$ t_{i,-1} = 0 \f$
+   * \note If the model is well specified, these increments are i.i.d.
+   * standard exponential random variables
+   */
+  SArrayDoublePtrList1D get_compensator_increments(const ArrayDouble &coeffs);
+
+  //! @brief Number of doubles of g, G and sum_G for a realization with
+  //! n_jumps jumps in total and n_kernel_coeffs kernel coefficients per node
+  static ulong n_weights(ulong n_nodes, ulong n_jumps, ulong n_kernel_coeffs);
+
+  ulong memory_usage() const override;
+
+  ulong memory_footprint() const override;
+
  protected:
   virtual void allocate_weights();
   /**
@@ -191,6 +211,15 @@ class DLL_PUBLIC ModelHawkesLogLikSingle : public ModelHawkesSingle {
    */
   void hessian_i(const ulong i, const ArrayDouble &coeffs, ArrayDouble &out);
 
+  /**
+   * @brief Compute compensator increments of component i
+   * \param i : selected component
+   * \param coeffs : Point in which the compensator is computed
+   * \param out : List of arrays whose i-th entry is filled
+   */
+  void compensator_increments_dim_i(const ulong i, const ArrayDouble &coeffs,
+                                    SArrayDoublePtrList1D &out);
+
   /**
    * @brief Return the start of alpha i coefficients in a coeffs vector
    * @param i : selected dimension
@@ -61,6 +61,12 @@ class DLL_PUBLIC ModelHawkesExpKernLeastSq : public ModelHawkesLeastSq {
 
   ulong get_n_coeffs() const override;
 
+  ulong memory_usage() const override;
+
+  //! @brief Weights of all realizations are allocated at once when they are
+  //! computed, before being aggregated
+  ulong memory_footprint() const override;
+
  private:
   /**
    * @brief Compute weights for one index between 0 and n_realizations * n_nodes
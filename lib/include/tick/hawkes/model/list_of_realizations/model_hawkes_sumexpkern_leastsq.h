@@ -59,6 +59,12 @@ class DLL_PUBLIC ModelHawkesSumExpKernLeastSq : public ModelHawkesLeastSq {
   //! @brief Synchronize n_coeffs given other attributes
   ulong get_n_coeffs() const override;
 
+  ulong memory_usage() const override;
+
+  //! @brief Weights of all realizations are allocated at once when they are
+  //! computed, before being aggregated
+  ulong memory_footprint() const override;
+
   ulong get_n_decays() const { return n_decays; }
 
   ulong get_n_baselines() const;
@@ -43,6 +43,13 @@ class DLL_PUBLIC ModelHawkesExpKernLeastSqSingle : public ModelHawkesSingle {
    */
   void compute_weights();
 
+  //! @brief Number of doubles of the weights computed for n_nodes nodes
+  static ulong n_weights(ulong n_nodes);
+
+  ulong memory_usage() const override;
+
+  ulong memory_footprint() const override;
+
   /**
    * @brief Compute loss
    * \param coeffs : Point in which loss is computed
@@ -56,6 +56,14 @@ class DLL_PUBLIC ModelHawkesSumExpKernLeastSqSingle : public ModelHawkesSingle {
    */
   void compute_weights();
 
+  //! @brief Number of doubles of the weights computed for the given
+  //! dimensions
+  static ulong n_weights(ulong n_nodes, ulong n_decays, ulong n_baselines);
+
+  ulong memory_usage() const override;
+
+  ulong memory_footprint() const override;
+
   /**
    * @brief Compute loss
    * \param coeffs : Point in which loss is computed
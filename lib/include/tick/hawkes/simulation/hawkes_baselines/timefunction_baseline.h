@@ -41,6 +41,9 @@ class DLL_PUBLIC HawkesTimeFunctionBaseline : public HawkesBaseline {
   //! @brief get the future maximum reachable value of the baseline after time t
   double get_future_bound(double t) override;
 
+  //! @brief simple getter
+  const TimeFunction &get_time_function() const { return time_function; }
+
   template <class Archive>
   void serialize(Archive &ar) {
     ar(cereal::make_nvp("HawkesBaseline",
@@ -9,6 +9,7 @@
 // License: BSD 3 clause
 
 #include "hawkes_kernel.h"
+#include "hawkes_kernel_sum_exp.h"
 
 #include <cmath>
 
@@ -78,6 +79,22 @@ class DLL_PUBLIC HawkesKernelPowerLaw : public HawkesKernel {
    */
   double get_norm(int nsteps = 10000) override;
 
+  /**
+   * Approximates the kernel on [0, support] by a sum of exponential kernels,
+   * whose convolutions are updated recursively in simulation and inference.
+   * The approximation discretizes, with a trapezoidal rule on a logarithmic
+   * grid of decays, the integral representation
+   * \f$ (\delta + t)^{-\beta} = \Gamma(\beta)^{-1} \int_0^\infty
+   * s^{\beta - 1} e^{-s (\delta + t)} ds \f$
+   * @param relative_error: maximum relative error of the approximation on
+   * [0, support]
+   * @param max_n_decays: maximum number of exponentials used
+   * @return Sum of exponential kernel approximating this kernel. Beyond the
+   * support it keeps decaying instead of being zero
+   */
+  std::shared_ptr<HawkesKernelSumExp> get_sum_exp_approximation(
+      double relative_error = 1e-3, ulong max_n_decays = 200);
+
   template <class Archive>
   void serialize(Archive &ar) {
     ar(cereal::make_nvp("HawkesKernel",
@@ -0,0 +1,117 @@
+#ifndef LIB_INCLUDE_TICK_HAWKES_SIMULATION_SIMU_EVENT_SINK_H_
+#define LIB_INCLUDE_TICK_HAWKES_SIMULATION_SIMU_EVENT_SINK_H_
+
+// License: BSD 3 clause
+
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "tick/array/array.h"
+#include "tick/array/sarray.h"
+
+/*! \class PPEventSink
+ * \brief Receives the jumps of a point process as they are simulated, in
+ * chronological order, instead of storing them in its timestamps
+ */
+class DLL_PUBLIC PPEventSink {
+ public:
+  virtual ~PPEventSink() {}
+
+  //! @brief Called for each jump of the process
+  virtual void push(ulong node, double time) = 0;
+
+  //! @brief Called at the end of each simulation
+  virtual void flush() {}
+};
+
+typedef std::shared_ptr<PPEventSink> PPEventSinkPtr;
+
+/*! \class PPBatchEventSink
+ * \brief Event sink that buffers jumps and hands them batch by batch, as a
+ * structure of arrays (times, nodes), to write_batch_
+ */
+class DLL_PUBLIC PPBatchEventSink : public PPEventSink {
+  ArrayDouble times;
+  ArrayULong nodes;
+  ulong n_buffered;
+
+ public:
+  explicit PPBatchEventSink(ulong batch_size = 1 << 16);
+
+  void push(ulong node, double time) final {
+    times[n_buffered] = time;
+    nodes[n_buffered] = node;
+    if (++n_buffered == times.size()) flush();
+  }
+
+  void flush() override;
+
+  ulong get_batch_size() const { return times.size(); }
+
+ protected:
+  /**
+   * @brief Processes a batch of jumps
+   * \param times : times of the jumps, in chronological order
+   * \param nodes : nodes of the jumps
+   */
+  virtual void write_batch_(const ArrayDouble &times,
+                            const ArrayULong &nodes) = 0;
+};
+
+/*! \class PPFileEventSink
+ * \brief Event sink writing jumps to a binary file. Each batch is written as
+ * its number of jumps (uint64), followed by their times (double) and then by
+ * their nodes (uint64)
+ */
+class DLL_PUBLIC PPFileEventSink : public PPBatchEventSink {
+  std::string path;
+  std::ofstream stream;
+
+ public:
+  explicit PPFileEventSink(const std::string &path,
+                           ulong batch_size = 1 << 16);
+
+  ~PPFileEventSink() override;
+
+  const std::string &get_path() const { return path; }
+
+  void flush() override;
+
+  /**
+   * @brief Reads a file written by a PPFileEventSink
+   * \param path : path of the file
+   * \param n_nodes : number of nodes of the process
+   * \return The timestamps of each node
+   */
+  static SArrayDoublePtrList1D read(const std::string &path, ulong n_nodes);
+
+ protected:
+  void write_batch_(const ArrayDouble &times, const ArrayULong &nodes) override;
+};
+
+/*! \class PPCallbackEventSink
+ * \brief Event sink handing each batch of jumps to a user callback
+ * \note C++ only, it is not wrapped in Python as the callback is run while
+ * the simulation holds no GIL
+ */
+class DLL_PUBLIC PPCallbackEventSink : public PPBatchEventSink {
+ public:
+  typedef std::function<void(const ArrayDouble &, const ArrayULong &)>
+      Callback;
+
+ private:
+  Callback callback;
+
+ public:
+  explicit PPCallbackEventSink(Callback callback, ulong batch_size = 1 << 16);
+
+ protected:
+  void write_batch_(const ArrayDouble &times,
+                    const ArrayULong &nodes) override {
+    callback(times, nodes);
+  }
+};
+
+#endif  // LIB_INCLUDE_TICK_HAWKES_SIMULATION_SIMU_EVENT_SINK_H_
@@ -50,6 +50,27 @@ class DLL_PUBLIC Hawkes : public PP {
   /// @brief The mus
   std::vector<HawkesBaselinePtr> baselines;
 
+ private:
+  // Event-driven simulation state, used when all kernels are exponential or
+  // sum of exponential kernels with non-negative intensities. Node i
+  // excitation is split by decay in
+  // excitation_values[excitation_ptr[i]:excitation_ptr[i + 1]] (with decays
+  // excitation_decays), last updated at excitation_times[i]
+  ArrayULong excitation_ptr;
+  ArrayDouble excitation_decays, excitation_values, excitation_times;
+
+  // Out-adjacency list in CSR format: a jump of node j adds
+  // out_adjacency_weights[k] to excitation_values[out_adjacency_excitations[k]]
+  // of node out_adjacency_nodes[k] for k in
+  // out_adjacency_ptr[j]:out_adjacency_ptr[j + 1], sorted by node
+  ArrayULong out_adjacency_ptr, out_adjacency_nodes, out_adjacency_excitations;
+  ArrayDouble out_adjacency_weights;
+
+  // Set if the event-driven simulation state is up to date with kernels,
+  // baselines and the event_driven_n_total_jumps first jumps
+  bool event_driven_ready = false;
+  ulong event_driven_n_total_jumps = 0;
+
  public:
   /**
    * @brief A constructor for an empty multidimensional Hawkes process
@@ -120,6 +141,56 @@ class DLL_PUBLIC Hawkes : public PP {
    */
   SArrayDoublePtr get_baseline(unsigned int i, ArrayDouble &t);
 
+  /**
+   * @brief Compute the compensator increments of each node between its
+   * consecutive jumps (time-rescaled inter-arrival times) of the simulated
+   * process
+   * \param n_threads : number of threads used, nodes being dispatched among
+   * them. If non-positive, the number of available cores is used
+   * \return For each node i, an array whose k-th entry is
+   * \f$ \Lambda_i(t_{i,k}) - \Lambda_i(t_{i,k-1}) \f$, with
+   * \f$ t_{i,-1} = 0 \f$
+   * \note Only constant baselines and exponential or sum of exponential
+   * kernels are supported, for which this is computed recursively in
+   * linear time
+   */
+  SArrayDoublePtrList1D get_compensator_increments(int n_threads = 1);
+
+  /**
+   * @brief Compute the intensity of each node on a grid of times, given the
+   * events of a realization (e.g. real data replayed on a fitted process)
+   * \param timestamps : events timestamps of each node
+   * \param times : sorted times at which the intensity is computed
+   * \param n_threads : number of threads used, nodes being dispatched among
+   * them. If non-positive, the number of available cores is used
+   * \return For each node i, an array whose p-th entry is the left limit
+   * \f$ \lambda_i(t_p) \f$, events occurring exactly at \f$ t_p \f$ being
+   * ignored
+   * \note Events and times are swept once for exponential and sum of
+   * exponential kernels, other kernels being evaluated on the events within
+   * their support
+   */
+  SArrayDoublePtrList1D get_intensity(const SArrayDoublePtrList1D &timestamps,
+                                      const ArrayDouble &times,
+                                      int n_threads = 1);
+
+  /**
+   * @brief Simulates the process up to end_time from its cluster (immigrant -
+   * offspring) representation, generation after generation. Offspring of
+   * the events of a generation are drawn in parallel and timestamps are
+   * then sorted node by node in parallel
+   * \param end_time : time until the realization is performed
+   * \param n_threads : number of threads used. If non-positive, the number
+   * of available cores is used. The realization only depends on the seed of
+   * the process, not on the number of threads
+   * \note The process must not have been simulated yet. Only constant or
+   * time function baselines and non-negative exponential, sum of
+   * exponential or power law kernels are supported and the spectral radius
+   * of the kernels norms must be smaller than 1. Intensity cannot be track
+   * recorded
+   */
+  void simulate_cluster(double end_time, int n_threads = 1);
+
  private:
   /**
    * @brief Virtual method called once (at startup) to set the initial
@@ -143,6 +214,27 @@ class DLL_PUBLIC Hawkes : public PP {
   virtual bool update_time_shift_(double delay, ArrayDouble &intensity,
                                   double *total_intensity_bound);
 
+  /**
+   * @brief Builds the out-adjacency list and the excitation of each node at
+   * current time, if the process can be simulated event by event
+   */
+  bool init_event_driven_() override;
+
+  double get_event_driven_intensity_(ulong i) override;
+
+  void update_event_driven_jump_(ulong i) override;
+
+  void update_event_driven_bound_(ulong i) override;
+
+  //! @brief Intensities are convolutions of the kernels with past jumps
+  bool requires_timestamps_() const override { return true; }
+
+  /**
+   * @brief Decays the excitation of a specific dimension up to current time
+   * and returns its sum
+   */
+  double update_excitation(ulong i);
+
   /**
    * @brief Get future baseline maximum reachable value for a specific dimension
    * at a given time \param i : the dimension \param t : considered time
@@ -156,6 +248,23 @@ class DLL_PUBLIC Hawkes : public PP {
    */
   void set_baseline(unsigned int i, const HawkesBaselinePtr &baseline);
 
+  /**
+   * @brief Compute compensator increments of a specific dimension
+   * \param i : the dimension
+   * \param out : List of arrays whose i-th entry is filled
+   */
+  void compensator_increments_dim_i(const ulong i, SArrayDoublePtrList1D &out);
+
+  /**
+   * @brief Compute intensity of a specific dimension on a grid of times
+   * \param i : the dimension
+   * \param timestamps : events timestamps of each node
+   * \param times : sorted times at which the intensity is computed
+   * \param out : List of arrays whose i-th entry is filled
+   */
+  void intensity_dim_i(const ulong i, const SArrayDoublePtrList1D &timestamps,
+                       const ArrayDouble &times, SArrayDoublePtrList1D &out);
+
  public:
   template <class Archive>
   void serialize(Archive &ar) {
@@ -0,0 +1,130 @@
+#ifndef LIB_INCLUDE_TICK_HAWKES_SIMULATION_SIMU_HAWKES_MULTI_H_
+#define LIB_INCLUDE_TICK_HAWKES_SIMULATION_SIMU_HAWKES_MULTI_H_
+
+// License: BSD 3 clause
+
+#include <memory>
+#include <vector>
+
+#include "simu_hawkes.h"
+
+/**
+ * @class HawkesMulti
+ * @brief Independent realizations of a same Hawkes process, simulated in
+ * parallel
+ *
+ * Each realization is simulated by its own copy of the model, whose kernels
+ * are duplicated if they hold a simulation state (see
+ * HawkesKernel::duplicate_if_necessary). Copies track record their intensity
+ * if the model does. They are seeded from the given seed, hence simulated
+ * realizations only depend on it and not on the number of threads.
+ */
+class DLL_PUBLIC HawkesMulti {
+  //! @brief One copy of the model per realization
+  std::vector<std::unique_ptr<Hawkes>> realizations;
+
+  //! @brief Seed of each realization, -1 if realizations are randomly seeded
+  std::vector<int> seeds;
+
+ public:
+  /**
+   * @brief Constructor
+   * \param model : Hawkes process whose kernels and baselines are copied
+   * \param n_realizations : number of independent realizations
+   * \param seed : seed from which the seeds of the realizations are drawn. If
+   * negative, each realization is randomly seeded
+   */
+  HawkesMulti(Hawkes &model, ulong n_realizations, int seed = -1);
+
+  // This forbids the unwanted copy of all realizations
+  HawkesMulti(const HawkesMulti &other) = delete;
+  HawkesMulti &operator=(const HawkesMulti &other) = delete;
+
+  /**
+   * @brief Draws new seeds for all realizations
+   * \param seed : seed from which the seeds of the realizations are drawn. If
+   * negative, each realization is randomly seeded
+   */
+  void reseed(int seed);
+
+  /**
+   * @brief Simulates all realizations up to end_time
+   * \param end_time : time until the realizations are performed
+   * \param n_threads : number of threads used, realizations being dispatched
+   * among them. If non-positive, the number of available cores is used
+   */
+  void simulate(double end_time, int n_threads = 1);
+
+  /**
+   * @brief Simulates each realization up to its own end time and stops it if
+   * its number of jumps is reached
+   * \param end_times : time until each realization is performed
+   * \param n_points : maximum number of jumps of each realization
+   * \param n_threads : number of threads used, realizations being dispatched
+   * among them. If non-positive, the number of available cores is used
+   */
+  void simulate(const ArrayDouble &end_times, ulong n_points,
+                int n_threads = 1);
+
+  /**
+   * @brief Resets all realizations as if they were never simulated
+   */
+  void reset();
+
+  ulong get_n_realizations() const { return realizations.size(); }
+
+  //! @brief Returns the timestamps of each realization, sharing their memory
+  SArrayDoublePtrList2D get_timestamps();
+
+  //! @brief Returns the total number of jumps of each realization
+  SArrayULongPtr get_n_total_jumps();
+
+  //! @brief Returns the time each realization has been simulated until
+  SArrayDoublePtr get_simulation_times();
+
+  //! @brief Returns the seed of each realization
+  SArrayIntPtr get_seeds();
+
+  //! @brief Returns the intensity track record of the rth realization
+  VArrayDoublePtrList1D get_itr(ulong r);
+
+  //! @brief Returns the times at which intensity of the rth realization has
+  //! been recorded
+  VArrayDoublePtr get_itr_times(ulong r);
+
+  //! @brief Returns the copy of the model simulating the rth realization
+  Hawkes &get_realization(ulong r);
+
+ private:
+  void simulate_realization(ulong r, const ArrayDouble &end_times,
+                            ulong n_points);
+
+ public:
+  template <class Archive>
+  void save(Archive &ar) const {
+    const ulong n_realizations = realizations.size();
+    ar(CEREAL_NVP(n_realizations));
+    for (const auto &realization : realizations) {
+      ar(cereal::make_nvp("realization", *realization));
+    }
+    ar(CEREAL_NVP(seeds));
+  }
+
+  template <class Archive>
+  void load(Archive &ar) {
+    ulong n_realizations;
+    ar(CEREAL_NVP(n_realizations));
+    realizations.clear();
+    for (ulong r = 0; r < n_realizations; ++r) {
+      std::unique_ptr<Hawkes> realization(new Hawkes(0));
+      ar(cereal::make_nvp("realization", *realization));
+      realizations.push_back(std::move(realization));
+    }
+    ar(CEREAL_NVP(seeds));
+  }
+};
+
+CEREAL_SPECIALIZE_FOR_ALL_ARCHIVES(HawkesMulti,
+                                   cereal::specialization::member_load_save)
+
+#endif  // LIB_INCLUDE_TICK_HAWKES_SIMULATION_SIMU_HAWKES_MULTI_H_
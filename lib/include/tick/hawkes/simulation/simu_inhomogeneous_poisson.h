@@ -16,9 +16,33 @@
  * Their intensities are modeled by TimeFunction
  */
 
+/**
+ * @brief Samples the jumps of a Poisson process of intensity given by a
+ * TimeFunction on ]start_time, end_time[ by inverting its cumulative
+ * intensity, which is exact as the intensity is affine between the breakpoints
+ * of the TimeFunction
+ * \param intensity_function : intensity of the process
+ * \param start_time : start of the sampled interval
+ * \param end_time : end of the sampled interval
+ * \param rand : random generator used
+ * \param out : sorted jumps are appended to it
+ * \return false, without any jump appended, if the intensity is negative
+ */
+DLL_PUBLIC bool sample_inhomogeneous_poisson(TimeFunction &intensity_function,
+                                             double start_time,
+                                             double end_time, Rand &rand,
+                                             VArrayDouble &out);
+
 class DLL_PUBLIC InhomogeneousPoisson : public PP {
   std::vector<TimeFunction> intensities_functions;
 
+  //! @brief Number of threads used to sample the components
+  int n_threads = 1;
+
+  //! @brief Generator whose substreams sample the components, drawn at each
+  //! simulation
+  Rand simulation_rand;
+
  public:
   /**
    * @brief A constructor for a 1 dimensional inhomogeneous Poisson process
@@ -46,6 +70,12 @@ class DLL_PUBLIC InhomogeneousPoisson : public PP {
     return intensities_functions[dimension].value(times_values);
   }
 
+  int get_n_threads() const { return n_threads; }
+
+  //! @brief Sets the number of threads used to sample the components. If
+  //! non-positive, the number of available cores is used
+  void set_n_threads(int n_threads) { this->n_threads = n_threads; }
+
  private:
   /**
    * @brief Virtual method called once (at startup) to set the initial
@@ -68,6 +98,17 @@ class DLL_PUBLIC InhomogeneousPoisson : public PP {
    */
   virtual bool update_time_shift_(double delay, ArrayDouble &intensity,
                                   double *total_intensity_bound);
+
+  /**
+   * @brief Samples the jumps of all components up to end_time, components
+   * being dispatched among threads. Only used if no intensity is negative
+   */
+  bool simulate_exact_(double end_time,
+                       VArrayDoublePtrList1D &new_timestamps) override;
+
+  void sample_component(ulong i, double end_time,
+                        VArrayDoublePtrList1D &new_timestamps,
+                        std::vector<char> &sampled);
 };
 
 #endif  // LIB_INCLUDE_TICK_HAWKES_SIMULATION_SIMU_INHOMOGENEOUS_POISSON_H_
@@ -5,7 +5,9 @@
 // License: BSD 3 clause
 
 #include "tick/array/varray.h"
+#include "tick/base/math/fenwick_tree.h"
 #include "tick/random/rand.h"
+#include "simu_event_sink.h"
 
 #include <cereal/types/vector.hpp>
 
@@ -60,6 +62,18 @@ class DLL_PUBLIC PP {
   // Keeps track of maximum total intensity bound
   double max_total_intensity_bound;
 
+  // Bound of the future intensity of each component, used by event-driven
+  // simulation
+  ArrayDouble node_intensity_bounds;
+
+  // Tree over node_intensity_bounds used to select the jumping component in
+  // O(log n_nodes)
+  FenwickTree node_intensity_bound_tree;
+
+  // Number of updates of node_intensity_bounds since total_intensity_bound
+  // has been summed from scratch
+  ulong n_node_intensity_bound_updates;
+
  protected:
   /// @brief If set then it thresholds negative intensities
   bool threshold_negative_intensity = false;
@@ -79,6 +93,16 @@ class DLL_PUBLIC PP {
   // The time corresponding to the track records of the intensity
   VArrayDoublePtr itr_times;
 
+  // The time step given to activate_itr, itr_time_step being doubled each
+  // time track records are decimated
+  double itr_base_time_step;
+
+  // The maximum number of track records kept (0 if unbounded)
+  ulong itr_max_size;
+
+  // If set, jumps are pushed to it instead of being stored in timestamps
+  PPEventSinkPtr event_sink;
+
   ////////////////////////////////////////////////////////////////////////////////
   //                            Constructors and destructors
   ////////////////////////////////////////////////////////////////////////////////
@@ -119,6 +143,9 @@ class DLL_PUBLIC PP {
    * \param n_points : The number of points until we keep simulating
    * \warning This introduces a small biais especially if the number of points
    * is small
+   * \note If intensity is not track recorded, processes supporting it are
+   * simulated event by event (see init_event_driven_). Random numbers are then
+   * drawn in another order, so a seed gives other jumps than with tracking
    */
   void simulate(double end_time, ulong n_points);
 
@@ -138,8 +165,23 @@ class DLL_PUBLIC PP {
    * @brief (Des)Activate track recording of intensity
    * @param dt : The time step used for track recording the intensity (if
    * negative then Desactivate Track Record)
+   * @param max_size : Maximum number of track records. When it is reached,
+   * one record out of two is dropped and the time step is doubled. If 0,
+   * track records are never decimated
    */
-  void activate_itr(double dt);
+  void activate_itr(double dt, ulong max_size = 0);
+
+  /**
+   * @brief Streams the jumps of next simulations to the given sink instead of
+   * storing them in timestamps
+   * @param event_sink : The sink receiving the jumps, nullptr to store them
+   * in timestamps again
+   * \note Only processes that do not need their past jumps to be simulated
+   * (or that can be simulated event by event) accept a sink
+   */
+  void set_event_sink(PPEventSinkPtr event_sink);
+
+  PPEventSinkPtr get_event_sink() const { return event_sink; }
 
   /**
    * @brief Reseeds the underlying random generator
@@ -167,7 +209,86 @@ class DLL_PUBLIC PP {
    */
   void update_jump(int index);
 
+  /**
+   * @brief Virtual method called at the start of a simulation up to end_time
+   * only, for processes whose jumps can be sampled directly up to end_time
+   * without going through the thinning loop. It must return false if the
+   * process does not support it, the generic simulation being used instead
+   * \param end_time : Time until the realization is performed
+   * \param new_timestamps : Sorted timestamps of the jumps of each component
+   * in ]time, end_time[ to fill
+   */
+  virtual bool simulate_exact_(double end_time,
+                               VArrayDoublePtrList1D &new_timestamps) {
+    return false;
+  }
+
+  /**
+   * @brief Virtual method called at the start of a simulation to set up an
+   * event-driven simulation in which the intensity of each component is
+   * bounded independently (see set_node_intensity_bound). It must return
+   * false if the process does not support it, the generic simulation being
+   * used instead
+   */
+  virtual bool init_event_driven_() { return false; }
+
+  /**
+   * @brief Virtual method returning the intensity of the ith component at
+   * current time, used by event-driven simulation
+   */
+  virtual double get_event_driven_intensity_(ulong i) { return 0; }
+
+  /**
+   * @brief Virtual method called in event-driven simulation once a jump has
+   * been recorded in ith component. It must update the bounds of the
+   * components whose intensity has changed
+   */
+  virtual void update_event_driven_jump_(ulong i) {}
+
+  /**
+   * @brief Virtual method called in event-driven simulation when a jump of
+   * ith component has been rejected. It might tighten its bound
+   */
+  virtual void update_event_driven_bound_(ulong i) {}
+
+  /**
+   * @brief Sets the bound of the future intensity of ith component in
+   * event-driven simulation
+   */
+  void set_node_intensity_bound(ulong i, double bound);
+
+  /**
+   * @brief Random generator of the process, for simulations that do not go
+   * through the generic simulation loop
+   */
+  Rand &get_rand() { return rand; }
+
+  /**
+   * @brief Sets the realization obtained by a simulation that does not go
+   * through the generic simulation loop, no intensity being computed
+   * \param timestamps : sorted timestamps of each node
+   * \param end_time : time up to which the realization has been simulated
+   */
+  void set_realization(VArrayDoublePtrList1D timestamps, double end_time);
+
+  /**
+   * @brief Whether the generic simulation loop of this process reads its
+   * timestamps, in which case they cannot be streamed to an event sink
+   */
+  virtual bool requires_timestamps_() const { return false; }
+
  private:
+  /**
+   * @brief Pushes sorted timestamps of each node to the event sink, in
+   * chronological order
+   */
+  void push_to_event_sink(const VArrayDoublePtrList1D &new_timestamps);
+
+  /**
+   * @brief Drops one track record out of two and doubles the time step
+   */
+  void decimate_itr();
+
   /**
    * @brief Update a time shift of delay seconds and eventually recompute the
    * intensity bound if asked and update track record of intensity if asked
@@ -175,6 +296,13 @@ class DLL_PUBLIC PP {
   void update_time_shift(double delay, bool flag_compute_intensity_bound,
                          bool flag_itr);
 
+  /**
+   * @brief Event-driven simulation loop, in which candidate jumps are drawn
+   * from the sum of the components bounds and accepted according to the
+   * intensity of the selected component only
+   */
+  void simulate_event_driven(double end_time, ulong n_points);
+
   /**
    * @brief Process track record of intensity at current time
    */
@@ -231,6 +359,12 @@ class DLL_PUBLIC PP {
   /// @brief Returns the step with which we record intensity
   inline double get_itr_step() { return itr_time_step; }
 
+  /// @brief Returns the step given to activate_itr, before any decimation
+  inline double get_itr_base_step() const { return itr_base_time_step; }
+
+  /// @brief Returns the maximum number of track records (0 if unbounded)
+  inline ulong get_itr_max_size() const { return itr_max_size; }
+
   /// @brief Get the process (converted into fixed size array)
   SArrayDoublePtrList1D get_timestamps() {
     SArrayDoublePtrList1D shared_process =
@@ -273,6 +407,8 @@ class DLL_PUBLIC PP {
     ar(CEREAL_NVP(itr_time_step));
     ar(CEREAL_NVP(itr));
     ar(CEREAL_NVP(itr_times));
+    itr_base_time_step = itr_time_step;
+    itr_max_size = 0;
 
     int rand_seed;
     ar(CEREAL_NVP(rand_seed));
@@ -0,0 +1,62 @@
+#ifndef LIB_INCLUDE_TICK_RANDOM_ALIAS_TABLE_H_
+#define LIB_INCLUDE_TICK_RANDOM_ALIAS_TABLE_H_
+
+// License: BSD 3 clause
+
+#include <algorithm>
+
+#include "rand.h"
+
+/**
+ * @class AliasTable
+ * @brief Discrete distribution sampled in constant time with Walker's alias
+ * method
+ *
+ * The table is built once from the weights of the events, in linear time.
+ * Each draw then costs one uniform real: its integer part selects a bucket
+ * and its fractional part selects either the bucket event or its alias.
+ */
+class DLL_PUBLIC AliasTable {
+  //! @brief Probability of keeping the bucket event rather than its alias
+  ArrayDouble thresholds;
+
+  //! @brief Event drawn when the bucket event is not kept
+  ArrayULong aliases;
+
+ public:
+  AliasTable() {}
+
+  /**
+   * @brief Builds the table
+   * \param weights : non-negative weights of each event, not necessarily
+   * normalized
+   */
+  explicit AliasTable(const ArrayDouble &weights);
+
+  //! @brief Returns the number of events
+  ulong size() const { return thresholds.size(); }
+
+  /**
+   * @brief Returns a realization of the distribution
+   * \param rand : random generator used
+   */
+  ulong sample(Rand &rand) const {
+    return sample_from_uniform(rand.uniform());
+  }
+
+  /**
+   * @brief Fills an array with realizations of the distribution
+   * \param rand : random generator used
+   * \param out : array to fill
+   */
+  void sample(Rand &rand, ArrayULong &out) const;
+
+ private:
+  ulong sample_from_uniform(double u) const {
+    const double x = u * thresholds.size();
+    const ulong bucket = std::min(static_cast<ulong>(x), thresholds.size() - 1);
+    return x - bucket < thresholds[bucket] ? bucket : aliases[bucket];
+  }
+};
+
+#endif  // LIB_INCLUDE_TICK_RANDOM_ALIAS_TABLE_H_
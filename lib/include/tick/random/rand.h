@@ -5,7 +5,9 @@
 
 #include "tick/base/defs.h"
 
+#include <array>
 #include <cmath>
+#include <cstdint>
 #include <ctime>
 
 #include <iostream>
@@ -20,12 +22,21 @@
  *
  * Each instance wraps a Mersenne Twister random number generator and generate
  * random probability distributions from it.
+ *
+ * Independent generators for threads or realizations are obtained with
+ * substream: the generator of substream k only depends on the key of this
+ * instance and on k, not on how many values have already been drawn. Array
+ * overloads fill a whole array at once, transforming blocks of raw random
+ * words instead of going through a distribution object for each value.
  */
 class DLL_PUBLIC Rand {
  private:
   int seed;
   std::mt19937_64 generator;
 
+  //! @brief Key from which substreams are derived
+  std::array<std::uint32_t, 2> stream_key;
+
   std::uniform_int_distribution<int> uniform_int_dist;
   std::uniform_int_distribution<ulong> uniform_ulong_dist;
   std::uniform_real_distribution<double> uniform_dist;
@@ -63,6 +74,12 @@ class DLL_PUBLIC Rand {
    */
   void init_reusable_distributions();
 
+  /**
+   * @brief Fills out with uniform reals in [0, 1), computed from 53 random
+   * bits each
+   */
+  void fill_uniform(double *out, ulong size);
+
  public:
   /**
    * @brief Returns a random integer between two number (both can be reached)
@@ -130,6 +147,53 @@ class DLL_PUBLIC Rand {
    */
   ulong discrete(ArrayDouble probabilities);
 
+  /**
+   * @brief Fills an array with random integers between two numbers (both can
+   * be reached). Values are the ones that successive calls to uniform_int
+   * would return
+   * \param a : lower bound
+   * \param b : upper bound
+   * \param out : array to fill
+   */
+  void uniform_int(ulong a, ulong b, ArrayULong &out);
+
+  /**
+   * @brief Fills an array with random reals between 0 and 1
+   * \param out : array to fill
+   */
+  void uniform(ArrayDouble &out);
+
+  /**
+   * @brief Fills an array with realizations of a centered gaussian, computed
+   * by pairs with the Box-Muller transform
+   * \param out : array to fill
+   */
+  void gaussian(ArrayDouble &out);
+
+  /**
+   * @brief Fills an array with realizations of an exponential distribution
+   * \param intensity : given intensity
+   * \param out : array to fill
+   */
+  void exponential(double intensity, ArrayDouble &out);
+
+  /**
+   * @brief Fills an array with realizations of a Poisson distribution. Small
+   * rates are sampled by inversion of uniform reals
+   * \param rate : given rate
+   * \param out : array to fill
+   */
+  void poisson(double rate, ArrayInt &out);
+
+  /**
+   * @brief Returns the generator of an independent substream
+   * \param index : index of the substream, for instance a thread, a chunk or
+   * a realization index
+   * \return A generator that only depends on the key of this generator and on
+   * index. Substreams of substreams are independent as well
+   */
+  Rand substream(ulong index) const;
+
   /**
    * @brief Getter for seed variable
    * @return Seed used to construct the random generator
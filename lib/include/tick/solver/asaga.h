@@ -29,6 +29,9 @@ class DLL_PUBLIC AtomicSAGA : public TBaseSAGA<T, T> {
   using TBaseSAGA<T, T>::save_history;
   using TBaseSAGA<T, T>::last_record_epoch;
   using TBaseSAGA<T, T>::last_record_time;
+  using TBaseSAGA<T, T>::rand;
+  using TBaseSAGA<T, T>::rand_type;
+  using TBaseSAGA<T, T>::rand_max;
 
  public:
   using TBaseSAGA<T, T>::set_starting_iterate;
@@ -44,9 +47,15 @@ class DLL_PUBLIC AtomicSAGA : public TBaseSAGA<T, T> {
   Array<std::atomic<T>> gradients_memory;
   Array<std::atomic<T>> gradients_average;
 
+  // Generator drawn at each solve, whose substreams sample the indices of
+  // each thread with uniform sampling
+  Rand threads_rand;
+
   void initialize_solver() override;
   void threaded_solve(int n_epochs, size_t thread);
 
+  ulong buffers_footprint() const override;
+
  public:
   AtomicSAGA() : AtomicSAGA(0, 0, RandType::unif, 0) {}
 
@@ -57,6 +66,8 @@ class DLL_PUBLIC AtomicSAGA : public TBaseSAGA<T, T> {
 
   void solve(size_t n_epochs = 1) override;
 
+  ulong memory_usage() const override;
+
   template <class Archive>
   void load(Archive &ar) {
     ar(cereal::make_nvp("BaseSAGA", cereal::base_class<TBaseSAGA<T, T>>(this)));
@@ -19,6 +19,8 @@ class DLL_PUBLIC TBaseSAGA : public TStoSolver<T, K> {
   using TStoSolver<T, K>::epoch_size;
   using TStoSolver<T, K>::get_next_i;
   using TStoSolver<T, K>::rand_unif;
+  using TStoSolver<T, K>::instrumentation;
+  using TStoSolver<T, K>::rand_type;
 
  public:
   using TStoSolver<T, K>::set_model;
@@ -29,6 +31,8 @@ class DLL_PUBLIC TBaseSAGA : public TStoSolver<T, K> {
  protected:
   bool solver_ready = false;
   bool ready_step_corrections = false;
+  // Whether steps_correction was computed for importance sampling
+  bool importance_step_corrections = false;
   T step = 0;
   // Probabilistic correction of the step-sizes of all model weights,
   // given by the inverse proportion of non-zero entries in each feature column
@@ -44,6 +48,8 @@ class DLL_PUBLIC TBaseSAGA : public TStoSolver<T, K> {
 
   void compute_step_corrections();
 
+  ulong buffers_footprint() const override;
+
  public:
   // This exists soley for cereal/swig
   TBaseSAGA() : TBaseSAGA<T, K>(0, 0, RandType::unif, 0, 0) {}
@@ -53,6 +59,8 @@ class DLL_PUBLIC TBaseSAGA : public TStoSolver<T, K> {
 
   void set_model(std::shared_ptr<TModel<T, K>> model) override;
 
+  ulong memory_usage() const override;
+
   T get_step() const { return step; }
 
   void set_step(T step) { this->step = step; }
@@ -113,12 +121,16 @@ class DLL_PUBLIC TSAGA : public TBaseSAGA<T, T> {
   using TBaseSAGA<T, T>::step;
   using TBaseSAGA<T, T>::t;
   using TBaseSAGA<T, T>::solver_ready;
+  using TBaseSAGA<T, T>::instrumentation;
+
+  bool supports_importance_sampling() const override { return true; }
 
  public:
   using TBaseSAGA<T, T>::set_starting_iterate;
   using TBaseSAGA<T, T>::get_minimizer;
   using TBaseSAGA<T, T>::set_model;
   using TBaseSAGA<T, T>::get_class_name;
+  using TBaseSAGA<T, T>::get_sample_weight;
 
  protected:
   Array<T> gradients_memory;
@@ -126,6 +138,8 @@ class DLL_PUBLIC TSAGA : public TBaseSAGA<T, T> {
 
   void initialize_solver() override;
 
+  ulong buffers_footprint() const override;
+
   void solve_dense(bool use_intercept, ulong n_features);
 
   void solve_sparse_proba_updates(bool use_intercept, ulong n_features);
@@ -139,6 +153,8 @@ class DLL_PUBLIC TSAGA : public TBaseSAGA<T, T> {
  public:
   void solve_one_epoch() override;
 
+  ulong memory_usage() const override;
+
   template <class Archive>
   void serialize(Archive &ar) {
     ar(cereal::make_nvp("BaseSAGA", typename cereal::base_class<TBaseSAGA<T, T>>(this)));
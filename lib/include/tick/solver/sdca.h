@@ -47,6 +47,8 @@ class DLL_PUBLIC TSDCA : public TStoSolver<T, K> {
   // The dual variable
   Array<T> dual_vector;
 
+  ulong buffers_footprint() const override;
+
  public:
   // This exists soley for cereal/swig
   TSDCA() : TSDCA<T, K>(0, 0, 0) {}
@@ -60,6 +62,8 @@ class DLL_PUBLIC TSDCA : public TStoSolver<T, K> {
 
   void set_model(std::shared_ptr<TModel<T, K>> model) override;
 
+  ulong memory_usage() const override;
+
   T get_l_l2sq() const { return l_l2sq; }
 
   void set_l_l2sq(T l_l2sq) { this->l_l2sq = l_l2sq; }
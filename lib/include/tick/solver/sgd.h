@@ -20,9 +20,13 @@ class DLL_PUBLIC TSGD : public TStoSolver<T, K> {
   using TStoSolver<T, K>::prox;
   using TStoSolver<T, K>::epoch_size;
   using TStoSolver<T, K>::get_next_i;
+  using TStoSolver<T, K>::instrumentation;
+
+  bool supports_importance_sampling() const override { return true; }
 
  public:
   using TStoSolver<T, K>::get_class_name;
+  using TStoSolver<T, K>::get_sample_weight;
 
  private:
   T step_t;
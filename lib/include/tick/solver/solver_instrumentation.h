@@ -0,0 +1,108 @@
+#ifndef LIB_INCLUDE_TICK_SOLVER_SOLVER_INSTRUMENTATION_H_
+#define LIB_INCLUDE_TICK_SOLVER_SOLVER_INSTRUMENTATION_H_
+
+// License: BSD 3 clause
+
+#include <array>
+#include <chrono>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "tick/base/defs.h"
+
+// Counters kept by stochastic solvers when instrumentation is enabled. The
+// *_cycles counters accumulate CPU cycles spent in each phase of the solver,
+// the other ones count events
+enum class SolverCounter : int {
+  sampling_cycles = 0,
+  gradient_cycles,
+  update_cycles,
+  prox_cycles,
+  full_gradient_cycles,
+  objective_cycles,
+  n_samples,
+  n_nnz,
+  n_prox_calls,
+  n_full_gradients,
+  n_counters
+};
+
+class DLL_PUBLIC SolverInstrumentation {
+ public:
+  static const int n_counters = static_cast<int>(SolverCounter::n_counters);
+
+  using Counters = std::array<ulong, n_counters>;
+
+ private:
+  bool enabled = false;
+  Counters counters{};
+
+ public:
+  // Time stamp counter of the CPU when available, nanoseconds otherwise
+  static inline ulong cycles() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+#endif
+  }
+
+  // Estimated once by comparing cycles() with a steady clock
+  static double cycles_per_second();
+
+  static const char *counter_name(SolverCounter counter);
+
+  inline bool is_enabled() const { return enabled; }
+
+  inline void set_enabled(bool enabled) { this->enabled = enabled; }
+
+  inline void count(SolverCounter counter, ulong n = 1) {
+    if (enabled) counters[static_cast<int>(counter)] += n;
+  }
+
+  inline ulong get(SolverCounter counter) const {
+    return counters[static_cast<int>(counter)];
+  }
+
+  inline const Counters &get_counters() const { return counters; }
+
+  inline void reset() { counters.fill(0); }
+
+  /**
+   * @brief Attributes the cycles elapsed since the previous mark (or since
+   * its construction) to a phase, so that consecutive phases of a loop are
+   * timed with a single read of the cycle counter each
+   */
+  class Lap {
+    SolverInstrumentation &instrumentation;
+    const bool enabled;
+    ulong last = 0;
+
+   public:
+    // A lap created with active set to false does nothing, which is used by
+    // multi-threaded loops that would race on the counters
+    explicit Lap(SolverInstrumentation &instrumentation, bool active = true)
+        : instrumentation(instrumentation),
+          enabled(active && instrumentation.enabled) {
+      if (enabled) last = cycles();
+    }
+
+    inline void mark(SolverCounter phase) {
+      if (enabled) {
+        const ulong now = cycles();
+        instrumentation.counters[static_cast<int>(phase)] += now - last;
+        last = now;
+      }
+    }
+
+    inline void count(SolverCounter counter, ulong n = 1) {
+      if (enabled) instrumentation.counters[static_cast<int>(counter)] += n;
+    }
+  };
+};
+
+#endif  // LIB_INCLUDE_TICK_SOLVER_SOLVER_INSTRUMENTATION_H_
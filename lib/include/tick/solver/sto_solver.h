@@ -12,7 +12,9 @@
 
 #include "tick/prox/prox.h"
 #include "tick/prox/prox_zero.h"
+#include "tick/random/alias_table.h"
 #include "tick/random/rand.h"
+#include "tick/solver/solver_instrumentation.h"
 
 #include <iostream>
 #include <sstream>
@@ -23,7 +25,7 @@
 // TODO: StoSolver and LabelsFeaturesSolver
 
 // Type of randomness used when sampling at random data points
-enum class RandType { unif = 0, perm };
+enum class RandType { unif = 0, perm, importance, block_perm };
 inline std::ostream &operator<<(std::ostream &s, const RandType &r) {
   typedef std::underlying_type<RandType>::type utype;
   return s << static_cast<utype>(r);
@@ -79,6 +81,21 @@ class DLL_PUBLIC TStoSolver {
   // An array that allows to store the sampled random permutation
   ArrayULong permutation;
 
+  // With block permutation sampling, blocks of perm_block_size consecutive
+  // samples are visited in random order and shuffled within each block, so
+  // that consecutive samples stay close in memory
+  ulong perm_block_size = 1024;
+
+  // If true, the features of the next sample of the permutation are
+  // prefetched while the current one is processed
+  bool prefetch = false;
+
+  // With importance sampling, samples are drawn from an alias table and
+  // their gradients are multiplied by importance_weights to remain unbiased
+  bool importance_ready = false;
+  AliasTable importance_table;
+  Array<T> importance_weights;
+
   int record_every = 1;
   size_t last_record_epoch = 0;
   double last_record_time = 0;
@@ -95,10 +112,39 @@ class DLL_PUBLIC TStoSolver {
   // A vector storing all timings at which history has been stored
   std::vector<Array<T> > iterate_history;
 
+  // Per-phase counters, only updated when instrumentation is enabled, and
+  // their values each time history has been stored
+  SolverInstrumentation instrumentation;
+  std::vector<SolverInstrumentation::Counters> counters_history;
+
  protected:
   // Init permutation array in case of Random is srt to permutation
   void init_permutation();
 
+  // Builds the alias table and the weights of importance sampling from the
+  // Lipschitz constants of the model
+  void init_importance_sampling();
+
+  // Solvers whose updates are weighted by get_sample_weight override this
+  virtual bool supports_importance_sampling() const { return false; }
+
+  // Probability that a sample drawn by importance sampling has a non-zero
+  // entry on each feature. It replaces the column sparsity in the step
+  // corrections of sparse solvers, which assume uniform sampling
+  Array<T> get_importance_columns_probability(ulong n_features);
+
+  // Whether step corrections computed with (or without) importance sampling
+  // are outdated for the current sampling
+  inline bool step_corrections_outdated(bool importance_corrections) const {
+    const bool importance = rand_type == RandType::importance;
+    return importance != importance_corrections ||
+           (importance && !importance_ready);
+  }
+
+  // Estimated number of bytes of the iterate, sampling arrays and buffers
+  // allocated by the solver for its current model
+  virtual ulong buffers_footprint() const;
+
   virtual void save_history(double time, int epoch);
 
  public:
@@ -118,6 +164,7 @@ class DLL_PUBLIC TStoSolver {
   virtual void set_model(std::shared_ptr<TModel<T, K> > _model) {
     this->model = _model;
     permutation_ready = false;
+    importance_ready = false;
     iterate = Array<K>(_model->get_n_coeffs());
     iterate.init_to_zero();
   }
@@ -137,6 +184,10 @@ class DLL_PUBLIC TStoSolver {
 
   void shuffle();
 
+  // Shuffles the order of the blocks of the permutation, then the samples
+  // within each block
+  void block_shuffle();
+
   virtual void solve_one_epoch() { TICK_CLASS_DOES_NOT_IMPLEMENT("TStoSolver<T, K>"); }
 
   virtual void solve(size_t n_epochs = 1);
@@ -164,13 +215,45 @@ class DLL_PUBLIC TStoSolver {
 
   inline RandType get_rand_type() const { return rand_type; }
 
-  inline void set_rand_type(RandType rand_type) { this->rand_type = rand_type; }
+  inline void set_rand_type(RandType rand_type) {
+    this->rand_type = rand_type;
+    importance_ready = false;
+  }
+
+  /**
+   * @brief Largest Lipschitz constant of the reweighted sample gradients,
+   * max_i L_i / (rand_max * p_i). It replaces the largest Lipschitz constant
+   * of the model when tuning the step with importance sampling, and is at
+   * most twice the mean of the Lipschitz constants
+   */
+  T get_importance_lip_max();
+
+  // Returns the weight by which the gradient of sample i is multiplied, which
+  // is 1 / (rand_max * probability of sampling i)
+  inline T get_sample_weight(ulong i) const {
+    return rand_type == RandType::importance ? importance_weights[i] : 1;
+  }
+
+  inline ulong get_perm_block_size() const { return perm_block_size; }
+
+  inline void set_perm_block_size(ulong perm_block_size) {
+    if (perm_block_size == 0) {
+      TICK_ERROR("perm_block_size must be positive");
+    }
+    this->perm_block_size = perm_block_size;
+    permutation_ready = false;
+  }
+
+  inline bool get_prefetch() const { return prefetch; }
+
+  inline void set_prefetch(bool prefetch) { this->prefetch = prefetch; }
 
   inline ulong get_rand_max() const { return rand_max; }
 
   inline void set_rand_max(ulong rand_max) {
     this->rand_max = rand_max;
     permutation_ready = false;
+    importance_ready = false;
   }
 
   inline int get_record_every() const { return record_every; }
@@ -186,8 +269,34 @@ class DLL_PUBLIC TStoSolver {
 
   std::vector<int> get_epoch_history() const { return epoch_history; }
 
+  inline bool get_instrumentation() const {
+    return instrumentation.is_enabled();
+  }
+
+  inline void set_instrumentation(bool enabled) {
+    instrumentation.set_enabled(enabled);
+  }
+
+  inline ulong get_counter(SolverCounter counter) const {
+    return instrumentation.get(counter);
+  }
+
+  std::vector<double> get_counter_history(SolverCounter counter) const;
+
+  // Converts *_cycles counters into seconds
+  double get_cycles_per_second() const {
+    return SolverInstrumentation::cycles_per_second();
+  }
+
   std::vector<std::shared_ptr<SArray<T> > > get_iterate_history() const;
 
+  // Number of bytes currently held by the solver, history included
+  virtual ulong memory_usage() const;
+
+  // Estimated number of bytes held by the solver after n_epochs epochs on its
+  // current model, including the history recorded every record_every epochs
+  ulong memory_footprint(ulong n_epochs = 0) const;
+
   const std::shared_ptr<TModel<T, K> > get_model() { return model; }
   const std::shared_ptr<TProx<T, K> > get_prox() { return prox; }
 
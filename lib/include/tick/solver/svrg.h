@@ -19,9 +19,14 @@ class DLL_PUBLIC TSVRG : public TStoSolver<T, K> {
   using TStoSolver<T, K>::epoch_size;
   using TStoSolver<T, K>::get_next_i;
   using TStoSolver<T, K>::rand_unif;
+  using TStoSolver<T, K>::instrumentation;
+  using TStoSolver<T, K>::rand_type;
+
+  bool supports_importance_sampling() const override { return true; }
 
  public:
   using TStoSolver<T, K>::get_class_name;
+  using TStoSolver<T, K>::get_sample_weight;
   using TStoSolver<T, K>::solve;
 
  private:
@@ -41,6 +46,8 @@ class DLL_PUBLIC TSVRG : public TStoSolver<T, K> {
 
   ulong rand_index;
   bool ready_step_corrections;
+  // Whether steps_correction was computed for importance sampling
+  bool importance_step_corrections = false;
   SVRG_StepType step_type;
 
   void prepare_solve();
@@ -51,7 +58,12 @@ class DLL_PUBLIC TSVRG : public TStoSolver<T, K> {
 
   void compute_step_corrections();
 
-  void dense_single_thread_solver(const ulong& next_i);
+  ulong buffers_footprint() const override;
+
+  // Phases are attributed through lap, which is inactive in multi-threaded
+  // loops
+  void dense_single_thread_solver(const ulong& next_i,
+                                  SolverInstrumentation::Lap& lap);
 
   // TProxSeparable<T, K>* is a raw pointer here as the
   //  ownership of the pointer is handled by
@@ -59,7 +71,8 @@ class DLL_PUBLIC TSVRG : public TStoSolver<T, K> {
   //  scope so a shared_ptr is not needed
   void sparse_single_thread_solver(const ulong& next_i, const ulong& n_features,
                                    const bool use_intercept,
-                                   TProxSeparable<T, K>*& casted_prox);
+                                   TProxSeparable<T, K>*& casted_prox,
+                                   SolverInstrumentation::Lap& lap);
 
  public:
   // This exists soley for cereal/swig
@@ -74,6 +87,8 @@ class DLL_PUBLIC TSVRG : public TStoSolver<T, K> {
 
   void set_model(std::shared_ptr<TModel<T, K>> model) override;
 
+  ulong memory_usage() const override;
+
   T get_step() const { return step; }
 
   void set_step(T step) { TSVRG<T, K>::step = step; }
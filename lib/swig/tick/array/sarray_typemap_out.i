@@ -47,6 +47,8 @@ DLL_PUBLIC PyObject *_XArray2NumpyArray(XARRAY_TYPE *sig)
         PyArray_FLAGS(array) |= NPY_OWNDATA ;
         #endif
         sig->give_data_ownership(array);
+        // Freed by numpy from now on, which is out of our accounting
+        if (sig->data()) tick::AllocationCounter::on_free();
     }
     return (PyObject *) array;
 }
@@ -94,6 +96,8 @@ DLL_PUBLIC PyObject *_XArray2d2NumpyArray(XARRAY2D_TYPE *sig)
         PyArray_FLAGS(array) |= NPY_OWNDATA ;
         #endif
         sig->give_data_ownership(array);
+        // Freed by numpy from now on, which is out of our accounting
+        if (sig->data()) tick::AllocationCounter::on_free();
     }
 
     return (PyObject *) array;
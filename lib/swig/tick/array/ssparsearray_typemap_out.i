@@ -49,6 +49,9 @@ DLL_PUBLIC PyObject *_XSparseArray2NumpyArray(XSPARSEARRAY_TYPE *sig)
         PyArray_FLAGS(array) |= NPY_OWNDATA ;
         #endif
         sig->give_data_indices_owners(array, indices);
+        // Freed by numpy from now on, which is out of our accounting
+        if (sig->data()) tick::AllocationCounter::on_free();
+        if (sig->indices()) tick::AllocationCounter::on_free();
     }
     return (PyObject *) array;
 }
@@ -169,6 +172,10 @@ DLL_PUBLIC PyObject *_XSparseArray2d2NumpyArray(XSPARSEARRAY2D_TYPE *sig)
         PyArray_FLAGS(row_indices) |= NPY_OWNDATA ;
         #endif
         sig->give_data_indices_rowindices_owners(array, indices, row_indices);
+        // Freed by numpy from now on, which is out of our accounting
+        if (sig->data()) tick::AllocationCounter::on_free();
+        if (sig->indices()) tick::AllocationCounter::on_free();
+        if (sig->row_indices()) tick::AllocationCounter::on_free();
     }
 
 #ifdef DEBUG_SHAREDARRAY
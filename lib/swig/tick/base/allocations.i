@@ -0,0 +1,25 @@
+// License: BSD 3 clause
+
+%{
+#include "tick/array/alloc.h"
+%}
+
+%inline %{
+unsigned long allocations_n_allocations() {
+  return tick::AllocationCounter::get_n_allocations();
+}
+
+unsigned long allocations_n_frees() {
+  return tick::AllocationCounter::get_n_frees();
+}
+
+long long allocations_n_live() {
+  return tick::AllocationCounter::get_n_live_allocations();
+}
+
+unsigned long allocations_n_bytes() {
+  return tick::AllocationCounter::get_n_bytes_allocated();
+}
+
+void allocations_reset() { tick::AllocationCounter::reset(); }
+%}
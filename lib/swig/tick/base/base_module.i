@@ -18,3 +18,5 @@
 %include time_func.i
 %include base_test.i
 %include exceptions_test.i
+%include trace.i
+%include allocations.i
@@ -20,11 +20,23 @@ typedef std::uint64_t ulong;
   #include <system_error>
 %}
 
-%define EXCEPTION_ON
-%exception {
-    try {
-        $action
-    } catch (std::invalid_argument& e) {
+%{
+// Releases the GIL for its lifetime. Being destroyed during stack unwinding,
+// it takes the GIL back before C++ exceptions are turned into Python errors
+class TickGILReleaser {
+  PyThreadState *thread_state;
+
+ public:
+  TickGILReleaser() : thread_state(PyEval_SaveThread()) {}
+  ~TickGILReleaser() { PyEval_RestoreThread(thread_state); }
+
+  TickGILReleaser(const TickGILReleaser &) = delete;
+  TickGILReleaser &operator=(const TickGILReleaser &) = delete;
+};
+%}
+
+%define TICK_CATCH_EXCEPTIONS
+    catch (std::invalid_argument& e) {
       SWIG_exception_fail(SWIG_ValueError, e.what() );
     } catch (std::domain_error& e) {
       SWIG_exception_fail(SWIG_ValueError, e.what() );
@@ -43,6 +55,43 @@ typedef std::uint64_t ulong;
     } catch (const std::string& str) {
       SWIG_exception_fail(SWIG_RuntimeError, str.c_str());
     }
+%enddef
+
+// Wrapped functions with the given name run without the GIL, so that other
+// Python threads are not blocked while they compute. They must only work on
+// C++ objects: arguments are converted before and results after the GIL is
+// released
+%define RELEASE_GIL(name)
+%exception name {
+    try {
+        TickGILReleaser tick_gil_releaser;
+        $action
+    } TICK_CATCH_EXCEPTIONS
+}
+%enddef
+
+// Long running entry points of models, solvers, simulations and inference
+%define TICK_RELEASE_GIL_FUNCTIONS
+RELEASE_GIL(solve)
+RELEASE_GIL(simulate)
+RELEASE_GIL(simulate_cluster)
+RELEASE_GIL(loss)
+RELEASE_GIL(grad)
+RELEASE_GIL(loss_and_grad)
+RELEASE_GIL(hessian)
+RELEASE_GIL(compute_weights)
+RELEASE_GIL(compute_cumulants)
+RELEASE_GIL(PointProcessCondLaw)
+RELEASE_GIL(PointProcessCondLawBatch)
+RELEASE_GIL(HawkesConditionalLawFredholm)
+%enddef
+
+%define EXCEPTION_ON
+TICK_RELEASE_GIL_FUNCTIONS
+%exception {
+    try {
+        $action
+    } TICK_CATCH_EXCEPTIONS
 }
 %enddef
 
@@ -51,4 +100,3 @@ typedef std::uint64_t ulong;
 %enddef
 
 EXCEPTION_ON
-
@@ -0,0 +1,27 @@
+// License: BSD 3 clause
+
+%{
+#include "tick/base/parallel/trace.h"
+%}
+
+%inline %{
+void trace_enable(unsigned long capacity) {
+  tick::Tracer::instance().enable(capacity);
+}
+
+void trace_disable() { tick::Tracer::instance().disable(); }
+
+bool trace_is_enabled() { return tick::Tracer::instance().is_enabled(); }
+
+unsigned long trace_n_recorded() {
+  return tick::Tracer::instance().get_n_recorded();
+}
+
+std::string trace_to_chrome_trace() {
+  return tick::Tracer::instance().to_chrome_trace();
+}
+
+void trace_dump(const std::string &path) {
+  tick::Tracer::instance().dump_chrome_trace(path);
+}
+%}
@@ -16,6 +16,8 @@ class TModel{
   virtual T loss(const Array<T>& coeffs);
   virtual unsigned long get_epoch_size() const;
   virtual bool is_sparse() const;
+  virtual unsigned long memory_usage() const;
+  virtual unsigned long memory_footprint() const;
 };
 
 %rename(Model) TModel<double, double>;
@@ -26,6 +28,8 @@ class TModel< double,double > {
   virtual double loss(const ArrayDouble& coeffs);
   virtual unsigned long get_epoch_size() const;
   virtual bool is_sparse() const;
+  virtual unsigned long memory_usage() const;
+  virtual unsigned long memory_footprint() const;
 };
 typedef TModel<double, double> Model;
 typedef std::shared_ptr<Model> ModelPtr;
@@ -38,6 +42,8 @@ class TModel< double,double > {
   virtual double loss(const ArrayDouble& coeffs);
   virtual unsigned long get_epoch_size() const;
   virtual bool is_sparse() const;
+  virtual unsigned long memory_usage() const;
+  virtual unsigned long memory_footprint() const;
 };
 typedef TModel<double, double> ModelDouble;
 typedef std::shared_ptr<ModelDouble> ModelDoublePtr;
@@ -50,6 +56,8 @@ class TModel<float, float> {
   virtual double loss(const ArrayFloat& coeffs);
   virtual unsigned long get_epoch_size() const;
   virtual bool is_sparse() const;
+  virtual unsigned long memory_usage() const;
+  virtual unsigned long memory_footprint() const;
 };
 typedef TModel<float, float> ModelFloat;
 typedef std::shared_ptr<ModelFloat> ModelFloatPtr;
@@ -63,6 +71,8 @@ class TModel<double, std::atomic<double> >{
   virtual double loss(const ArrayAtomicDouble& coeffs);
   virtual unsigned long get_epoch_size() const;
   virtual bool is_sparse() const;
+  virtual unsigned long memory_usage() const;
+  virtual unsigned long memory_footprint() const;
 };
 
 typedef TModel<double, std::atomic<double> > ModelAtomicDouble;
@@ -77,6 +87,8 @@ class TModel<float, std::atomic<float> >{
   virtual float loss(const Array<std::atomic<float>>& coeffs);
   virtual unsigned long get_epoch_size() const;
   virtual bool is_sparse() const;
+  virtual unsigned long memory_usage() const;
+  virtual unsigned long memory_footprint() const;
 };
 typedef TModel<float, std::atomic<float> > ModelAtomicFloat;
 
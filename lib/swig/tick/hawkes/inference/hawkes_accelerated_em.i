@@ -0,0 +1,31 @@
+// License: BSD 3 clause
+
+
+%{
+#include "tick/hawkes/inference/hawkes_accelerated_em.h"
+%}
+
+class HawkesAcceleratedEM {
+ public :
+  HawkesAcceleratedEM(const ulong max_iter, const double tol);
+
+  ulong solve(HawkesEM &learner, ArrayDouble &mu, ArrayDouble2d &kernels);
+  ulong solve(HawkesBasisKernels &learner, ArrayDouble &mu, ArrayDouble2d &gdm,
+              ArrayDouble2d &auvd, ulong max_iter_gdm, double max_tol_gdm);
+  ulong solve(HawkesSumGaussians &learner, ArrayDouble &mu,
+              ArrayDouble2d &amplitudes);
+
+  ulong get_max_iter() const;
+  void set_max_iter(const ulong max_iter);
+
+  double get_tol() const;
+  void set_tol(const double tol);
+
+  double get_step_factor() const;
+  void set_step_factor(const double step_factor);
+
+  ulong get_n_iter() const;
+  ulong get_n_solve_calls() const;
+  ulong get_n_rejected() const;
+  double get_rel_change() const;
+};
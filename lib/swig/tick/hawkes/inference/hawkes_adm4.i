@@ -24,5 +24,7 @@ class HawkesADM4 : public ModelHawkesList {
   void set_decay(const double decay);
   double get_rho() const;
   void set_rho(const double rho);
+  bool get_store_weights() const;
+  void set_store_weights(const bool store_weights);
 };
 
@@ -11,3 +11,16 @@ extern void PointProcessCondLaw(ArrayDouble &y_time,
                                 double y_T,
                                 double y_lambda,
                                 ArrayDouble &res_X, ArrayDouble &res_Y);
+
+extern void PointProcessCondLawBatch(const SArrayDoublePtrList1D &times,
+                                     const SArrayDoublePtrList1D &marks,
+                                     const SArrayDoublePtrList1D &mark_intervals,
+                                     ArrayDouble &lags, double T,
+                                     ArrayDouble &res_X, ArrayDouble2d &res_Y,
+                                     int n_threads = 1);
+
+extern void HawkesConditionalLawFredholm(
+    ArrayDouble &claw_X, ArrayDouble2d &claws, ArrayULong &n_marks,
+    ArrayDouble &mark_probabilities, ArrayDouble &mean_intensity,
+    ArrayDouble &quad_x, ArrayDouble &quad_w, const std::string &quad_method,
+    ArrayDouble2d &res_phi, int n_threads = 1);
@@ -11,7 +11,7 @@
 class HawkesCumulant : public ModelHawkesList {
 
 public:
-  HawkesCumulant(double integration_support);
+  HawkesCumulant(double integration_support, const int max_n_threads = 1);
 
   SArrayDoublePtr compute_A_and_I_ij(ulong r, ulong i, ulong j, double mean_intensity_j);
 
@@ -19,6 +19,12 @@ public:
                        double mean_intensity_i, double mean_intensity_j,
                        double J_ij);
 
+  void compute_cumulants();
+
+  SArrayDoublePtr get_mean_intensity() const;
+  SArrayDouble2dPtr get_covariance() const;
+  SArrayDouble2dPtr get_skewness() const;
+
   double get_integration_support() const;
   void set_integration_support(const double integration_support);
   bool get_are_cumulants_ready() const;
@@ -0,0 +1,51 @@
+// License: BSD 3 clause
+
+
+%{
+#include "tick/hawkes/inference/hawkes_cumulant_matching.h"
+%}
+
+enum class HawkesCumulantMatching_Solver : uint16_t {
+  GD = 1,
+  Momentum = 2,
+  AdaGrad = 3,
+  RMSProp = 4,
+  AdaDelta = 5,
+  Adam = 6,
+  LBFGS = 7,
+};
+
+class HawkesCumulantMatching {
+ public :
+  HawkesCumulantMatching(
+      const double cs_ratio, const double strength_lasso,
+      const double strength_ridge,
+      const HawkesCumulantMatching_Solver solver =
+          HawkesCumulantMatching_Solver::Adam,
+      const double step = 1e-2);
+
+  void set_cumulants(const ArrayDouble &mean_intensity,
+                     const ArrayDouble2d &covariance,
+                     const ArrayDouble2d &skewness);
+
+  double loss(ArrayDouble2d &R);
+  double grad_loss(ArrayDouble2d &R, ArrayDouble2d &out);
+
+  void reset();
+  void solve(ArrayDouble2d &R, const ulong n_iter = 1);
+
+  double get_cs_ratio() const;
+  void set_cs_ratio(const double cs_ratio);
+  double get_strength_lasso() const;
+  void set_strength_lasso(const double strength_lasso);
+  double get_strength_ridge() const;
+  void set_strength_ridge(const double strength_ridge);
+  HawkesCumulantMatching_Solver get_solver() const;
+  void set_solver(const HawkesCumulantMatching_Solver solver);
+  double get_step() const;
+  void set_step(const double step);
+  double get_momentum() const;
+  void set_momentum(const double momentum);
+  ulong get_history_size() const;
+  void set_history_size(const ulong history_size);
+};
@@ -24,3 +24,5 @@
 %include hawkes_basis_kernels.i
 %include hawkes_sumgaussians.i
 %include hawkes_cumulant.i
+%include hawkes_accelerated_em.i
+%include hawkes_cumulant_matching.i
@@ -33,4 +33,6 @@ class HawkesSumGaussians : public ModelHawkesList {
   void set_strength_lasso(const double strength_lasso);
   double get_strength_grouplasso() const;
   void set_strength_grouplasso(const double strength_grouplasso);
+  bool get_store_weights() const;
+  void set_store_weights(const bool store_weights);
 };
\ No newline at end of file
@@ -16,6 +16,8 @@ public:
   double hessian_norm(const ArrayDouble &coeffs, const ArrayDouble &vector);
   void hessian(const ArrayDouble &coeffs, ArrayDouble &out);
 
+  SArrayDoublePtrList2D get_compensator_increments(const ArrayDouble &coeffs);
+
   void incremental_set_data(const SArrayDoublePtrList1D &timestamps, double end_time);
 
   void compute_weights();
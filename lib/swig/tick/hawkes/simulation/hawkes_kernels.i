@@ -58,6 +58,9 @@ class HawkesKernelPowerLaw : public HawkesKernel {
   double get_multiplier();
   double get_exponent();
   double get_cutoff();
+
+  std::shared_ptr<HawkesKernelSumExp> get_sum_exp_approximation(
+      double relative_error = 1e-3, ulong max_n_decays = 200);
 };
 
 TICK_MAKE_PICKLABLE(HawkesKernelPowerLaw, 0.0, 1.0, 1.0);
@@ -11,6 +11,9 @@
 %shared_ptr(HawkesKernelPowerLaw);
 %shared_ptr(HawkesKernelTimeFunc);
 %shared_ptr(HawkesKernel0);
+%shared_ptr(PPEventSink);
+%shared_ptr(PPBatchEventSink);
+%shared_ptr(PPFileEventSink);
 
 %{
 #include "tick/base/tick_python.h"
@@ -18,8 +21,10 @@
 
 %import(module="tick.base") tick/base/base_module.i
 
+%include simu_event_sink.i
 %include simu_point_process.i
 %include simu_poisson_process.i
 %include simu_inhomogeneous_poisson.i
 %include simu_hawkes.i
+%include simu_hawkes_multi.i
 %include hawkes_kernels.i
@@ -0,0 +1,29 @@
+// License: BSD 3 clause
+
+%{
+#include "tick/hawkes/simulation/simu_event_sink.h"
+%}
+
+%nodefaultctor PPEventSink;
+%nodefaultctor PPBatchEventSink;
+
+class PPEventSink {
+ public:
+  virtual void flush();
+};
+
+typedef std::shared_ptr<PPEventSink> PPEventSinkPtr;
+
+class PPBatchEventSink : public PPEventSink {
+ public:
+  ulong get_batch_size() const;
+};
+
+class PPFileEventSink : public PPBatchEventSink {
+ public:
+  PPFileEventSink(const std::string &path, ulong batch_size = 1 << 16);
+
+  const std::string &get_path() const;
+
+  static SArrayDoublePtrList1D read(const std::string &path, ulong n_nodes);
+};
@@ -19,6 +19,14 @@ class Hawkes : public PP {
 
   SArrayDoublePtr get_baseline(unsigned int i, ArrayDouble &t);
   double get_baseline(unsigned int i, double t);
+
+  SArrayDoublePtrList1D get_compensator_increments(int n_threads = 1);
+
+  SArrayDoublePtrList1D get_intensity(const SArrayDoublePtrList1D &timestamps,
+                                      const ArrayDouble &times,
+                                      int n_threads = 1);
+
+  void simulate_cluster(double end_time, int n_threads = 1);
 };
 
 TICK_MAKE_PICKLABLE(Hawkes, 0);
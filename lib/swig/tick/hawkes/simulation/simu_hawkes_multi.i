@@ -0,0 +1,31 @@
+// License: BSD 3 clause
+
+%{
+#include "tick/hawkes/simulation/simu_hawkes_multi.h"
+%}
+
+class HawkesMulti {
+ public :
+
+  HawkesMulti(Hawkes &model, ulong n_realizations, int seed = -1);
+
+  void reseed(int seed);
+
+  void simulate(double end_time, int n_threads = 1);
+  void simulate(const ArrayDouble &end_times, ulong n_points,
+                int n_threads = 1);
+
+  void reset();
+
+  ulong get_n_realizations() const;
+
+  SArrayDoublePtrList2D get_timestamps();
+  SArrayULongPtr get_n_total_jumps();
+  SArrayDoublePtr get_simulation_times();
+  SArrayIntPtr get_seeds();
+
+  VArrayDoublePtrList1D get_itr(ulong r);
+  VArrayDoublePtr get_itr_times(ulong r);
+};
+
+TICK_MAKE_PICKLABLE(HawkesMulti, Hawkes(0), 1);
@@ -15,4 +15,7 @@ class InhomogeneousPoisson : public PP {
         virtual ~InhomogeneousPoisson();
         //TODO: handle it by returning TimeFunctions to Python...
         SArrayDoublePtr intensity_value(int dimension, ArrayDouble & times_values);
+
+        int get_n_threads() const;
+        void set_n_threads(int n_threads);
 };
\ No newline at end of file
@@ -11,7 +11,10 @@ class PP {
   PP(unsigned int n_nodes, int seed = -1);
   virtual ~PP();
 
-  void activate_itr(double dt);
+  void activate_itr(double dt, ulong max_size = 0);
+
+  void set_event_sink(PPEventSinkPtr event_sink);
+  PPEventSinkPtr get_event_sink() const;
 
   void simulate(double run_time);
   void simulate(ulong  n_points);
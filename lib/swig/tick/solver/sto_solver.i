@@ -5,6 +5,7 @@
 
 %{
 #include "tick/solver/sto_solver.h"
+#include "tick/solver/solver_instrumentation.h"
 #include "tick/base_model/model.h"
 %}
 
@@ -20,7 +21,29 @@
 // Type of randomness used when sampling at random data points
 enum class RandType {
     unif = 0,
-    perm
+    perm,
+    importance,
+    block_perm
+};
+
+// Counters kept by stochastic solvers when instrumentation is enabled
+enum class SolverCounter {
+    sampling_cycles = 0,
+    gradient_cycles,
+    update_cycles,
+    prox_cycles,
+    full_gradient_cycles,
+    objective_cycles,
+    n_samples,
+    n_nnz,
+    n_prox_calls,
+    n_full_gradients,
+    n_counters
+};
+
+class SolverInstrumentation {
+ public:
+  static const char *counter_name(SolverCounter counter);
 };
 
 template <class T, class K = T>
@@ -46,6 +69,10 @@ class TStoSolver {
   inline void set_rand_type(RandType rand_type);
   inline RandType get_rand_type() const;
   inline void set_rand_max(unsigned long rand_max);
+  inline void set_perm_block_size(unsigned long perm_block_size);
+  inline unsigned long get_perm_block_size() const;
+  inline void set_prefetch(bool prefetch);
+  inline bool get_prefetch() const;
   inline unsigned long get_rand_max() const;
   inline int get_record_every() const;
   inline void set_record_every(int record_every);
@@ -57,6 +84,16 @@ class TStoSolver {
   void set_first_obj(const double obj);
   double get_first_obj() const;
 
+  inline bool get_instrumentation() const;
+  inline void set_instrumentation(bool enabled);
+  inline unsigned long get_counter(SolverCounter counter) const;
+  std::vector<double> get_counter_history(SolverCounter counter) const;
+  double get_cycles_per_second() const;
+  T get_importance_lip_max();
+
+  virtual unsigned long memory_usage() const;
+  unsigned long memory_footprint(unsigned long n_epochs = 0) const;
+
   std::vector<std::shared_ptr<SArray<T> > > get_iterate_history() const;
 
   virtual void set_model(std::shared_ptr<TModel<T, K> > model);
@@ -87,6 +124,10 @@ class TStoSolver<double, double> {
   inline void set_rand_type(RandType rand_type);
   inline RandType get_rand_type() const;
   inline void set_rand_max(unsigned long rand_max);
+  inline void set_perm_block_size(unsigned long perm_block_size);
+  inline unsigned long get_perm_block_size() const;
+  inline void set_prefetch(bool prefetch);
+  inline bool get_prefetch() const;
   inline unsigned long get_rand_max() const;
   inline int get_record_every() const;
   inline void set_record_every(int record_every);
@@ -98,6 +139,16 @@ class TStoSolver<double, double> {
   void set_first_obj(const double obj);
   double get_first_obj() const;
 
+  inline bool get_instrumentation() const;
+  inline void set_instrumentation(bool enabled);
+  inline unsigned long get_counter(SolverCounter counter) const;
+  std::vector<double> get_counter_history(SolverCounter counter) const;
+  double get_cycles_per_second() const;
+  double get_importance_lip_max();
+
+  virtual unsigned long memory_usage() const;
+  unsigned long memory_footprint(unsigned long n_epochs = 0) const;
+
   SArrayDoublePtrList1D get_iterate_history() const;
 
   virtual void set_model(ModelDoublePtr model);
@@ -130,6 +181,10 @@ class TStoSolver<float, float> {
   inline void set_rand_type(RandType rand_type);
   inline RandType get_rand_type() const;
   inline void set_rand_max(unsigned long rand_max);
+  inline void set_perm_block_size(unsigned long perm_block_size);
+  inline unsigned long get_perm_block_size() const;
+  inline void set_prefetch(bool prefetch);
+  inline bool get_prefetch() const;
   inline unsigned long get_rand_max() const;
   inline int get_record_every() const;
   inline void set_record_every(int record_every);
@@ -140,6 +195,16 @@ class TStoSolver<float, float> {
   void set_prev_obj(const double obj);
   void set_first_obj(const double obj);
   double get_first_obj() const;
+
+  inline bool get_instrumentation() const;
+  inline void set_instrumentation(bool enabled);
+  inline unsigned long get_counter(SolverCounter counter) const;
+  std::vector<double> get_counter_history(SolverCounter counter) const;
+  double get_cycles_per_second() const;
+  float get_importance_lip_max();
+
+  virtual unsigned long memory_usage() const;
+  unsigned long memory_footprint(unsigned long n_epochs = 0) const;
   SArrayFloatPtrList1D get_iterate_history() const;
 
   virtual void set_model(ModelFloatPtr model);
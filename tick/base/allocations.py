@@ -0,0 +1,33 @@
+# License: BSD 3 clause
+
+from tick.base.build.base import allocations_n_allocations, \
+    allocations_n_frees, allocations_n_live, allocations_n_bytes, \
+    allocations_reset
+
+
+def get_allocation_stats():
+    """Counters of the array buffers allocated by the C++ library
+
+    Buffers handed over to numpy are counted as freed as soon as they are
+    returned to Python, as numpy releases them on its own.
+
+    Returns
+    -------
+    output : `dict`
+        Number of allocations (``n_allocations``), of frees (``n_frees``),
+        of currently live allocations (``n_live``) and total number of bytes
+        allocated (``n_bytes``) since start or last call to
+        `reset_allocation_stats`
+    """
+    return {
+        'n_allocations': allocations_n_allocations(),
+        'n_frees': allocations_n_frees(),
+        'n_live': allocations_n_live(),
+        'n_bytes': allocations_n_bytes(),
+    }
+
+
+def reset_allocation_stats():
+    """Resets all allocation counters to zero
+    """
+    allocations_reset()
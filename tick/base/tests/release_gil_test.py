@@ -0,0 +1,91 @@
+# License: BSD 3 clause
+
+import threading
+import time
+import unittest
+
+import numpy as np
+
+from tick.hawkes import SimuHawkesExpKernels
+from tick.hawkes.inference.build.hawkes_inference import \
+    PointProcessCondLawBatch
+from tick.linear_model import ModelLinReg, SimuLinReg
+from tick.prox import ProxL2Sq
+from tick.solver import SAGA
+
+
+class Test(unittest.TestCase):
+    def count_ticks_during(self, func):
+        """Counts how many times another Python thread ticks while func runs
+        """
+        ticks = [0]
+        stop = threading.Event()
+
+        def ticker():
+            while not stop.is_set():
+                ticks[0] += 1
+                time.sleep(1e-3)
+
+        thread = threading.Thread(target=ticker)
+        thread.start()
+        try:
+            while ticks[0] == 0:
+                time.sleep(1e-3)
+            ticks_before = ticks[0]
+            start = time.time()
+            func()
+            elapsed = time.time() - start
+            ticks_during = ticks[0] - ticks_before
+        finally:
+            stop.set()
+            thread.join()
+        return ticks_during, elapsed
+
+    def test_solve_releases_gil(self):
+        """...Test another Python thread runs while a solver solves
+        """
+        np.random.seed(12)
+        n_samples, n_features = 20000, 50
+        weights = np.random.randn(n_features)
+        features, labels = SimuLinReg(weights, n_samples=n_samples,
+                                      verbose=False, seed=12).simulate()
+        model = ModelLinReg(fit_intercept=False).fit(features, labels)
+
+        solver = SAGA(max_iter=200, tol=0, verbose=False, seed=12)
+        solver.set_model(model).set_prox(ProxL2Sq(1e-3))
+
+        ticks_during, elapsed = self.count_ticks_during(solver.solve)
+        self.assertGreater(elapsed, 0.1)
+        self.assertGreater(ticks_during, 5)
+
+    def test_simulate_releases_gil(self):
+        """...Test another Python thread runs while a process is simulated
+        """
+        hawkes = SimuHawkesExpKernels(
+            adjacency=[[0.3, 0.1], [0.2, 0.3]], decays=[[2., 2.], [2., 2.]],
+            baseline=[1., 1.], end_time=1e6, verbose=False, seed=12)
+
+        ticks_during, elapsed = self.count_ticks_during(hawkes.simulate)
+        self.assertGreater(elapsed, 0.1)
+        self.assertGreater(ticks_during, 5)
+
+    def test_error_without_gil(self):
+        """...Test C++ errors raised while the GIL is released are caught
+        """
+        times = [np.array([1., 2.]), np.array([1.5, 3.])]
+        marks = [np.array([1., 2.])]
+        mark_intervals = [np.zeros(2), np.zeros(2)]
+        lags = np.array([0., 0.5, 1.])
+        res_X = np.zeros(2)
+        res_Y = np.zeros((4, 2))
+
+        with self.assertRaisesRegex(RuntimeError, "should have the same size"):
+            PointProcessCondLawBatch(times, marks, mark_intervals, lags, 10.,
+                                     res_X, res_Y, 2)
+
+        # The GIL was taken back, Python objects can still be used
+        self.assertEqual(res_Y.sum(), 0.)
+
+
+if __name__ == "__main__":
+    unittest.main()
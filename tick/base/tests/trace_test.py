@@ -0,0 +1,98 @@
+# License: BSD 3 clause
+
+import json
+import os
+import tempfile
+import unittest
+
+import numpy as np
+
+from tick.base.trace import start_tracing, stop_tracing, is_tracing, \
+    get_trace, tracing, n_traced_events
+from tick.linear_model import ModelLinReg, SimuLinReg
+from tick.prox import ProxL2Sq
+from tick.solver import SVRG
+
+
+class Test(unittest.TestCase):
+    def setUp(self):
+        np.random.seed(123)
+        weights = np.random.randn(5)
+        features, labels = SimuLinReg(weights, n_samples=200, verbose=False,
+                                      seed=123).simulate()
+        model = ModelLinReg(fit_intercept=False).fit(features, labels)
+        self.solver = SVRG(step=1e-2, max_iter=3, tol=0, verbose=False,
+                           seed=123)
+        self.solver.set_model(model).set_prox(ProxL2Sq(1e-3))
+
+    def tearDown(self):
+        stop_tracing()
+
+    @staticmethod
+    def trace_events():
+        return json.loads(get_trace())['traceEvents']
+
+    def test_start_stop_tracing(self):
+        """...Test regions run while tracing is enabled are recorded
+        """
+        self.assertFalse(is_tracing())
+        start_tracing()
+        self.assertTrue(is_tracing())
+        self.solver.solve()
+        stop_tracing()
+        self.assertFalse(is_tracing())
+
+        events = self.trace_events()
+        epochs = [event for event in events if event['name'] == 'solver_epoch']
+        self.assertEqual([event['args']['first_index'] for event in epochs],
+                         [1, 2, 3])
+        self.assertIn('glm_loss', [event['name'] for event in events])
+        for event in events:
+            self.assertEqual(event['ph'], 'X')
+            self.assertGreaterEqual(event['dur'], 0)
+
+        # Nothing is recorded once tracing is stopped
+        self.solver.solve()
+        self.assertEqual(len(self.trace_events()), len(events))
+
+        # Starting again drops previous events
+        start_tracing()
+        stop_tracing()
+        self.assertEqual(self.trace_events(), [])
+
+    def test_tracing_capacity(self):
+        """...Test only the most recent events are kept
+        """
+        start_tracing(capacity=2)
+        self.solver.solve()
+        stop_tracing()
+        self.assertEqual(len(self.trace_events()), 2)
+        self.assertGreater(n_traced_events(), 2)
+
+        # Counting starts again with tracing
+        start_tracing(capacity=2)
+        self.assertEqual(n_traced_events(), 0)
+
+    def test_tracing_context(self):
+        """...Test tracing context manager writes the trace on exit
+        """
+        with tempfile.TemporaryDirectory() as directory:
+            path = os.path.join(directory, 'trace.json')
+            with tracing(path):
+                self.assertTrue(is_tracing())
+                self.solver.solve()
+            self.assertFalse(is_tracing())
+
+            with open(path) as trace_file:
+                events = json.load(trace_file)['traceEvents']
+            self.assertEqual(events, self.trace_events())
+            self.assertGreater(len(events), 0)
+
+        with self.assertRaises(ValueError):
+            with tracing():
+                raise ValueError()
+        self.assertFalse(is_tracing())
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,101 @@
+# License: BSD 3 clause
+
+from contextlib import contextmanager
+
+from tick.base.build.base import trace_enable, trace_disable, \
+    trace_is_enabled, trace_n_recorded, trace_to_chrome_trace, trace_dump
+
+
+def start_tracing(capacity=65536):
+    """Starts recording the tasks run by the C++ parallel layer
+
+    Every task run by a thread (with its start time, duration, thread and
+    range of processed indices) and every named region (solver epochs,
+    model losses and gradients, Hawkes weights computation) is recorded.
+    Previously recorded events are dropped.
+
+    This must not be called while C++ computations run in another thread,
+    as the event buffer is reallocated.
+
+    Parameters
+    ----------
+    capacity : `int`, default=65536
+        Maximum number of events kept, older events are overwritten
+    """
+    trace_enable(capacity)
+
+
+def stop_tracing():
+    """Stops recording, recorded events are kept until the next call to
+    `start_tracing`
+    """
+    trace_disable()
+
+
+def is_tracing():
+    """Whether events are currently recorded
+    """
+    return trace_is_enabled()
+
+
+def n_traced_events():
+    """Number of events recorded since the last call to `start_tracing`,
+    including the ones overwritten once capacity was reached
+
+    Returns
+    -------
+    output : `int`
+        If larger than the capacity given to `start_tracing`, older events
+        have been dropped from the trace
+    """
+    return trace_n_recorded()
+
+
+def get_trace():
+    """Recorded events in the Chrome trace-event JSON format
+
+    Returns
+    -------
+    output : `str`
+        A JSON document that can be loaded in chrome://tracing or
+        https://ui.perfetto.dev
+    """
+    return trace_to_chrome_trace()
+
+
+def dump_trace(path):
+    """Writes recorded events in the Chrome trace-event JSON format
+
+    Parameters
+    ----------
+    path : `str`
+        Path of the JSON file
+    """
+    trace_dump(path)
+
+
+@contextmanager
+def tracing(path=None, capacity=65536):
+    """Records the tasks run while the context is active
+
+    Parameters
+    ----------
+    path : `str`, default=None
+        If given, the trace is written to this file when the context exits
+
+    capacity : `int`, default=65536
+        Maximum number of events kept, older events are overwritten
+
+    Examples
+    --------
+    >>> from tick.base.trace import tracing
+    >>> with tracing('solver.json'):
+    ...     learner.fit(X, y)
+    """
+    start_tracing(capacity)
+    try:
+        yield
+    finally:
+        stop_tracing()
+        if path is not None:
+            dump_trace(path)
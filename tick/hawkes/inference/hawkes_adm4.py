@@ -110,6 +110,13 @@ class HawkesADM4(LearnerHawkesNoParam):
         If None, it will be set given a heuristic which look at last
         relative difference obtained in the main loop.
 
+    store_weights : `bool`, default=True
+        If `True`, the sums of kernel values over past events are computed
+        once and stored, which requires ``n_nodes`` doubles per event. If
+        `False`, they are recomputed at each iteration with the recursive
+        formula of exponential kernels and memory usage does not depend on
+        the number of events
+
     Attributes
     ----------
     n_nodes : `int`
@@ -162,13 +169,16 @@ class HawkesADM4(LearnerHawkesNoParam):
         },
         "approx": {
             "writable": False
+        },
+        "store_weights": {
+            "cpp_setter": "set_store_weights"
         }
     }
 
     def __init__(self, decay, C=1e3, lasso_nuclear_ratio=0.5, max_iter=50,
                  tol=1e-5, n_threads=1, verbose=False, print_every=10,
                  record_every=10, rho=.1, approx=0, em_max_iter=30,
-                 em_tol=None):
+                 em_tol=None, store_weights=True):
 
         LearnerHawkesNoParam.__init__(
             self, verbose=verbose, max_iter=max_iter, print_every=print_every,
@@ -192,6 +202,7 @@ class HawkesADM4(LearnerHawkesNoParam):
         self.em_tol = em_tol
 
         self._learner = _HawkesADM4(decay, rho, n_threads, approx)
+        self.store_weights = store_weights
 
         # TODO add approx to model
         self._model = ModelHawkesExpKernLogLik(self.decay,
@@ -6,10 +6,10 @@ import warnings
 
 import numpy as np
 from numpy.polynomial.legendre import leggauss
-from scipy.linalg import solve
 
-from tick.base import Base, ThreadPool
-from tick.hawkes.inference.build.hawkes_inference import (PointProcessCondLaw)
+from tick.base import Base
+from tick.hawkes.inference.build.hawkes_inference import (
+    PointProcessCondLawBatch, HawkesConditionalLawFredholm)
 
 
 # noinspection PyPep8Naming
@@ -155,9 +155,6 @@ class HawkesConditionalLaw(Base):
     _attrinfos = {
         '_hawkes_object': {},
         '_lags': {},
-        '_lock': {
-            'writable': False
-        },
         '_phi_ijl': {},
         '_norm_ijl': {},
         '_ijl2index': {},
@@ -173,9 +170,6 @@ class HawkesConditionalLaw(Base):
         '_claw1': {},
         '_claw_X': {},
         '_n_events': {},
-        '_int_claw': {},
-        '_IG': {},
-        '_IG2': {},
         '_quad_x': {},
         '_quad_w': {}
     }
@@ -224,7 +218,6 @@ class HawkesConditionalLaw(Base):
         # Represents the conditional laws written above without conditioning by
         # the mark (so a i,j list)
         self._claw1 = None
-        self._lock = None
 
         # quad_x : `np.ndarray`, shape=(n_quad, )
         # The abscissa of the quadrature points used for the Fredholm system
@@ -580,21 +573,10 @@ class HawkesConditionalLaw(Base):
             self._n_events[0, i] += good
             self._n_events[1, i] += bad
 
-        # We might want to use threads, since this is the time consuming part
-        with_multi_processing = self.n_threads > 1
-        if with_multi_processing:
-            pool = ThreadPool(with_lock=True, max_threads=self.n_threads)
-            self._set('_lock', pool.lock)
-
-        for index, (i, j, l) in enumerate(self._index2ijl):
-            if with_multi_processing:
-                pool.add_work(self._PointProcessCondLaw, realization, index, i,
-                              j, l, T)
-            else:
-                self._PointProcessCondLaw(realization, index, i, j, l, T)
-
-        if with_multi_processing:
-            pool.start()
+        # This is the time consuming part, conditional laws of all (i, j, l)
+        # triplets are computed at once, (i, j) pairs being dispatched among
+        # threads
+        self._update_claws(realization, T)
 
         # Here we compute the G^ij (not conditioned to l)
         # It is recomputed each time
@@ -652,41 +634,39 @@ class HawkesConditionalLaw(Base):
                 self._claw[index1] = t
                 self._claw[index2] = t
 
-        # We can remove the thread lock (lock disallows pickling)
-        self._set('_lock', None)
-
         if compute:
             self.compute()
 
-    def _PointProcessCondLaw(self, realization, index, i, j, l, T):
+    def _update_claws(self, realization, T):
+        """Computes the conditional laws of this realization and updates
+        their average over all realizations
+        """
+        times = [np.ascontiguousarray(realization[i][0], dtype=float)
+                 for i in range(self.n_nodes)]
+        marks = [np.ascontiguousarray(realization[i][1], dtype=float)
+                 for i in range(self.n_nodes)]
+        mark_intervals = [
+            np.array(self.marked_components[j], dtype=float).ravel()
+            for j in range(self.n_nodes)
+        ]
 
         claw_X = np.zeros(len(self._lags) - 1)
-        claw_Y = np.zeros(len(self._lags) - 1)
-
-        lambda_i = len(realization[i][0]) / T
+        claws = np.zeros((self._n_index, len(self._lags) - 1))
 
-        PointProcessCondLaw(
-            realization[i][0], realization[j][0], realization[j][1],
-            self._lags, self.marked_components[j][l][0],
-            self.marked_components[j][l][1], T, lambda_i, claw_X, claw_Y)
+        PointProcessCondLawBatch(times, marks, mark_intervals,
+                                 np.ascontiguousarray(self._lags, dtype=float),
+                                 T, claw_X, claws, self.n_threads)
 
         self._claw_X = claw_X
 
-        # TODO: this lock acquire is very expensive here
-        if self.n_threads > 1:
-            self._lock.acquire()
-
         # Update claw
-        if self.n_realizations == 0:
-            self._claw[index] = claw_Y
-        else:
-            self._claw[index] *= self.n_realizations
-            self._claw[index] += claw_Y
-            self._claw[index] /= self.n_realizations + 1
-
-        # Unlock
-        if self.n_threads > 1:
-            self._lock.release()
+        for index in range(self._n_index):
+            if self.n_realizations == 0:
+                self._claw[index] = claws[index]
+            else:
+                self._claw[index] *= self.n_realizations
+                self._claw[index] += claws[index]
+                self._claw[index] /= self.n_realizations + 1
 
     def _compute_lags(self):
         """Computes the lags at which the claw will be computed
@@ -706,109 +686,6 @@ class HawkesConditionalLaw(Base):
         if claw_method == "lin":
             self._lags = np.arange(0., self.max_lag, self.delta_lag)
 
-    def _compute_ints_claw(self):
-        """Computes the claw and its integrals at the difference of
-        quadrature points using a linear interpolation
-        """
-
-        self._int_claw = [0] * self._n_index
-        # Builds a linear interpolation of the claws at the difference of
-        # quadrature (only positive abscissa are kept)
-        for index in range(self._n_index):
-            xe = self._claw_X
-            ye = self._claw[index]
-            xs2 = np.array(
-                [(a - b)
-                 for (a, b) in itertools.product(self._quad_x, repeat=2)])
-            xs2 = np.append(xe, xs2)
-            xs2 = np.append(self._quad_x, xs2)
-            xs2 = np.array(np.lib.arraysetops.unique(xs2))
-            xs2 = np.array(np.core.fromnumeric.sort(xs2))
-            xs2 = xs2[xs2 >= 0.]
-            ys2 = np.zeros(len(xs2))
-            j = 0
-            for i in range(1, len(xe)):
-                while j < len(xs2) and xs2[j] < xe[i]:
-                    ys2[j] = (ye[i - 1]) + ((ye[i]) - (ye[i - 1])) * (
-                        xs2[j] - xe[i - 1]) / (xe[i] - xe[i - 1])
-                    j += 1
-            sc = (xs2, ys2)
-            self._int_claw[index] = sc
-
-        # Computes the integrals of the claws (IG) and the integrals of x
-        # times the claws from 0 to the abscissa we have just computed
-        self._IG = []
-        self._IG2 = []
-        for i in range(self._n_index):
-            xc = self._int_claw[i][0]
-            yc = self._int_claw[i][1]
-
-            iyc_IG = np.append(
-                np.array(0.), np.cumsum(np.diff(xc) * (yc[:-1] + yc[1:]) / 2.))
-            self._IG += [(xc, iyc_IG)]
-
-            iyc_IG2 = np.append(
-                np.array(0.),
-                np.cumsum((yc[:-1] + yc[1:]) / 2. * np.diff(xc) * xc[:-1] +
-                          np.diff(xc) * np.diff(xc) / 3. * np.diff(yc) +
-                          np.diff(xc) * np.diff(xc) / 2. * yc[:-1]))
-            self._IG2 += [(xc, iyc_IG2)]
-
-    @staticmethod
-    def _lin0(sig, t):
-        """Find closest value of a signal, zero value border
-        """
-        x, y = sig
-        if t >= x[-1]:
-            return 0
-        index = np.searchsorted(x, t)
-        if index == len(y) - 1:
-            return y[index]
-        elif np.abs(x[index] - t) < np.abs(x[index + 1] - t):
-            return y[index]
-        else:
-            return y[index + 1]
-
-    @staticmethod
-    def _linc(sig, t):
-        """Find closest value of a signal, continuous border
-        """
-        x, y = sig
-        if t >= x[-1]:
-            return y[-1]
-        index = np.searchsorted(x, t)
-        if np.abs(x[index] - t) < np.abs(x[index + 1] - t):
-            return y[index]
-        else:
-            return y[index + 1]
-
-    def _G(self, i, j, l, t):
-        """Returns the value of a claw at a point
-        Used to fill V and M with 'gauss' method
-        """
-        if t < 0:
-            warnings.warn("G(): should not be called for t < 0")
-        index = self._ijl2index[i][j][l]
-        return HawkesConditionalLaw._lin0(self._int_claw[index], t)
-
-    def _DIG(self, i, j, l, t1, t2):
-        """Returns the integral of a claw between t1 and t2
-        """
-        if t1 >= t2:
-            warnings.warn("t2>t1 wrong in DIG")
-        index = self._ijl2index[i][j][l]
-        return HawkesConditionalLaw._linc(self._IG[index], t2) - \
-               HawkesConditionalLaw._linc(self._IG[index], t1)
-
-    def _DIG2(self, i, j, l, t1, t2):
-        """Returns the integral of x times a claw between t1 and t2
-        """
-        if t1 >= t2:
-            warnings.warn("t2>t1 wrong in DIG2")
-        index = self._ijl2index[i][j][l]
-        return HawkesConditionalLaw._linc(self._IG2[index], t2) - \
-               HawkesConditionalLaw._linc(self._IG2[index], t1)
-
     def compute(self):
         """Computes kernel estimation by solving a Fredholm system.
         """
@@ -853,11 +730,23 @@ class HawkesConditionalLaw(Base):
             self._quad_x = np.array(self._quad_x)
             self._quad_w = np.array(self._quad_w)
 
-        # Computes the claw and its integrals at the difference of
-        # quadrature points using a linear interpolation
-        self._compute_ints_claw()
+        # For each i we write and solve the system V =  M PHI, the claws
+        # being linearly interpolated at the difference of quadrature points
+        claws = np.array(self._claw, dtype=float)
+        n_marks = np.array([len(self.marked_components[j])
+                            for j in range(self.n_nodes)], dtype=np.uint64)
+        mark_probabilities = np.array(
+            [p for j in range(self.n_nodes)
+             for p in self._mark_probabilities[j]], dtype=float)
+        res_phi = np.zeros((self._n_index, self.n_quad))
+
+        HawkesConditionalLawFredholm(
+            np.ascontiguousarray(self._claw_X, dtype=float), claws, n_marks,
+            mark_probabilities, np.array(self.mean_intensity, dtype=float),
+            np.ascontiguousarray(self._quad_x, dtype=float),
+            np.ascontiguousarray(self._quad_w, dtype=float), self.quad_method,
+            res_phi, self.n_threads)
 
-        # For each i we write and solve the system V =  M PHI
         index_first = 0
         self._phi_ijl = []
         self._norm_ijl = []
@@ -865,26 +754,8 @@ class HawkesConditionalLaw(Base):
         self.kernels_norms = np.zeros((self.n_nodes, self.n_nodes))
 
         for i in range(0, self.n_nodes):
-
-            # We must compute the last valid index which corresponds to i
-            index_last = index_first
-            for index_last in range(index_first, self._n_index):
-                (i1, j1, l1) = self._index2ijl[index_last]
-                if i1 != i:
-                    index_last -= 1
-                    break
-
-            # Number of indices corresponding to i
-            n_index = index_last - index_first + 1
-
-            # Compute V and M
-            V = self._compute_V(i, n_index, self.n_quad, index_first,
-                                index_last)
-            M = self._compute_M(n_index, self.n_quad, index_first, index_last,
-                                self.quad_method)
-            # Then we solve it
-            res = solve(M, V)
-
+            index_last = self._ijl2index[i][-1][-1]
+            res = res_phi[index_first:index_last + 1].reshape(-1, 1)
             self._estimate_kernels_and_norms(i, index_first, index_last, res,
                                              self.n_quad, self.quad_method)
 
@@ -893,142 +764,6 @@ class HawkesConditionalLaw(Base):
         self._estimate_baseline()
         self._estimate_mark_functions()
 
-    def _compute_V(self, i, n_index, n_quad, index_first, index_last):
-        V = np.zeros((n_index * n_quad, 1))
-        for index in range(index_first, index_last + 1):
-            (x, j, l) = self._index2ijl[index]
-            for n in range(0, n_quad):
-                index_i_quad = (index - index_first) * n_quad + n
-                V[index_i_quad] = self._G(i, j, l, self._quad_x[n])
-        return V
-
-    def _compute_M(self, n_index, n_quad, index_first, index_last, method):
-        M = np.zeros((n_index * n_quad, n_index * n_quad))
-        for index in range(index_first, index_last + 1):
-            (x, j, l) = self._index2ijl[index]
-            for index1 in range(index_first, index_last + 1):
-                (i1, j1, l1) = self._index2ijl[index1]
-                fact = self.mean_intensity[j1] / self.mean_intensity[j]
-                for n in range(0, n_quad):
-                    for n1 in range(0, n_quad):
-                        if method == 'gauss' or method == 'gauss-':
-                            self._fill_M_for_gauss(M, method, n_quad,
-                                                   index_first, index, index1,
-                                                   j, l, j1, l1, fact, n, n1)
-
-                        elif method == 'log' or method == 'lin':
-                            self._fill_M_for_log_lin(
-                                M, method, n_quad, index_first, index, index1,
-                                j, l, j1, l1, fact, n, n1)
-        return M
-
-    def _fill_M_for_gauss(self, M, method, n_quad, index_first, index, index1,
-                          j, l, j1, l1, fact, n, n1):
-        def x_value(n_lower, n_greater, j_lower, j_greater, l_greater):
-            return self._mark_probabilities[j1][l1] * self._quad_w[n1] * \
-                   self._G(j_lower, j_greater, l_greater,
-                           self._quad_x[n_greater] - self._quad_x[n_lower])
-
-        if n > n1:
-            x = x_value(n1, n, j1, j, l)
-
-        elif n < n1:
-            x = fact * x_value(n, n1, j, j1, l1)
-
-        else:
-            if method == 'gauss-':
-                x = 0
-            else:
-                x1 = x_value(n1, n, j1, j, l)
-                x2 = fact * x_value(n, n1, j, j1, l1)
-                x = (x1 + x2) / 2
-
-        if method == 'gauss-':
-            row = (index - index_first) * n_quad + n
-            col = (index1 - index_first) * n_quad + n
-            M[row, col] -= x
-
-        if l == l1 and j == j1 and n == n1:
-            x += 1
-
-        row = (index - index_first) * n_quad + n
-        col = (index1 - index_first) * n_quad + n1
-        M[row, col] += x
-
-    def _fill_M_for_log_lin(self, M, method, n_quad, index_first, index,
-                            index1, j, l, j1, l1, fact, n, n1):
-
-        mark_probability = self._mark_probabilities[j1][l1]
-
-        ratio_dig = lambda n_q: ((self._quad_x[n] - self._quad_x[n_q]) / self._quad_w[n_q])
-
-        ratio_dig2 = lambda n_q: 1. / self._quad_w[n_q]
-
-        dig_arg_greater = lambda n_q: (j1, j, l, self._quad_x[n] - self._quad_x[n_q] - self._quad_w[n_q], self._quad_x[n] - self._quad_x[n_q])
-
-        dig_arg_lower = lambda n_q: (j, j1, l1, self._quad_x[n_q] - self._quad_x[n], self._quad_x[n_q] - self._quad_x[n] + self._quad_w[n_q])
-
-        x = 0
-        if n > n1:
-            x += mark_probability * self._DIG(*dig_arg_greater(n1))
-
-            if n1 < n_quad - 1:
-                x -= ratio_dig(n1) * mark_probability * \
-                     self._DIG(*dig_arg_greater(n1))
-
-                x += ratio_dig2(n1) * mark_probability * \
-                     self._DIG2(*dig_arg_greater(n1))
-
-            if n1 > 0:
-                x += ratio_dig(n1 - 1) * mark_probability * \
-                     self._DIG(*dig_arg_greater(n1 - 1))
-
-                x -= ratio_dig2(n1 - 1) * mark_probability * \
-                     self._DIG2(*dig_arg_greater(n1 - 1))
-
-        elif n < n1:
-
-            x += fact * mark_probability * self._DIG(*dig_arg_lower(n1))
-
-            if n1 < n_quad - 1:
-                x -= fact * ratio_dig(n1) * mark_probability * \
-                     self._DIG(*dig_arg_lower(n1))
-
-                x -= fact * ratio_dig2(n1) * mark_probability * \
-                     self._DIG2(*dig_arg_lower(n1))
-
-            if n1 > 0:
-                x += fact * ratio_dig(n1 - 1) * mark_probability * \
-                     self._DIG(*dig_arg_lower(n1 - 1))
-
-                x += fact * ratio_dig2(n1 - 1) * mark_probability * \
-                     self._DIG2(*dig_arg_lower(n1 - 1))
-
-        elif n == n1:
-            x += fact * self._mark_probabilities[j1][l1] * \
-                 self._DIG(*dig_arg_lower(n1))
-
-            if n1 < n_quad - 1:
-                x -= fact * ratio_dig(n1) * mark_probability * \
-                     self._DIG(*dig_arg_lower(n1))
-
-                x -= fact * ratio_dig2(n1) * mark_probability * \
-                     self._DIG2(*dig_arg_lower(n1))
-
-            if n1 > 0:
-                x += ratio_dig(n1 - 1) * mark_probability * \
-                     self._DIG(*dig_arg_greater(n1 - 1))
-
-                x -= ratio_dig2(n1 - 1) * mark_probability * \
-                     self._DIG2(*dig_arg_greater(n1 - 1))
-
-        if l == l1 and j == j1 and n == n1:
-            x += 1
-
-        row = (index - index_first) * n_quad + n
-        col = (index1 - index_first) * n_quad + n1
-        M[row, col] += x
-
     def _estimate_kernels_and_norms(self, i, index_first, index_last, res,
                                     n_quad, method):
         # We rearrange the solution vector and compute the norms
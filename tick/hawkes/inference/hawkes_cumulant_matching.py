@@ -1,20 +1,27 @@
-from itertools import product
-
 import numpy as np
 import scipy
 from scipy.linalg import qr, sqrtm, norm
 
 from tick.base import Base
 from tick.hawkes.inference.base import LearnerHawkesNoParam
-from tick.hawkes.inference.build.hawkes_inference import (HawkesCumulant as
-                                                          _HawkesCumulant)
-
-# Tensorflow is not a project requirement but is needed for this class
-try:
-    import tensorflow as tf
-except ImportError:
-    tf = None
-    pass
+from tick.hawkes.inference.build.hawkes_inference import (
+    HawkesCumulant as _HawkesCumulant, HawkesCumulantMatching as
+    _HawkesCumulantMatching, HawkesCumulantMatching_Solver_GD,
+    HawkesCumulantMatching_Solver_Momentum,
+    HawkesCumulantMatching_Solver_AdaGrad,
+    HawkesCumulantMatching_Solver_RMSProp,
+    HawkesCumulantMatching_Solver_AdaDelta,
+    HawkesCumulantMatching_Solver_Adam, HawkesCumulantMatching_Solver_LBFGS)
+
+solver_types = {
+    'gd': HawkesCumulantMatching_Solver_GD,
+    'momentum': HawkesCumulantMatching_Solver_Momentum,
+    'adagrad': HawkesCumulantMatching_Solver_AdaGrad,
+    'rmsprop': HawkesCumulantMatching_Solver_RMSProp,
+    'adadelta': HawkesCumulantMatching_Solver_AdaDelta,
+    'adam': HawkesCumulantMatching_Solver_Adam,
+    'lbfgs': HawkesCumulantMatching_Solver_LBFGS,
+}
 
 
 class HawkesCumulantMatching(LearnerHawkesNoParam):
@@ -24,8 +31,8 @@ class HawkesCumulantMatching(LearnerHawkesNoParam):
     It does not make any assumptions on the kernel shape and recovers
     the kernel norms only.
 
-    This class relies on `Tensorflow`_ to perform the matching of the
-    cumulants. If `Tensorflow`_ is not installed, it will not work.
+    The matching of the cumulants is performed in C++, with an analytic
+    gradient of the objective.
 
     Parameters
     ----------
@@ -45,8 +52,10 @@ class HawkesCumulantMatching(LearnerHawkesNoParam):
         The penalization to use. By default no penalization is used.
         Penalty is only applied to adjacency matrix.
 
-    solver : {'momentum', 'adam', 'adagrad', 'rmsprop', 'adadelta', 'gd'}, default='adam'
-        Name of tensorflow solver that will be used.
+    solver : {'momentum', 'adam', 'adagrad', 'rmsprop', 'adadelta', 'gd', 'lbfgs'}, default='adam'
+        Name of the solver that will be used. First order solvers use the
+        same default hyper parameters as their Tensorflow counterparts.
+        'lbfgs' uses an Armijo backtracking line search.
 
     step : `float`, default=1e-2
         Initial step size used for learning. Also known as learning rate.
@@ -82,7 +91,15 @@ class HawkesCumulantMatching(LearnerHawkesNoParam):
         Used in 'elasticnet' penalty
 
     solver_kwargs : `dict`, default=`None`
-        Extra arguments that will be passed to tensorflow solver
+        Extra arguments of the solver, namely ``momentum`` (default 0.9) for
+        'momentum' solver and ``history_size`` (default 10) for 'lbfgs'
+        solver
+
+    n_threads : `int`, default=1
+        Number of threads used for cumulants computation.
+
+        * if `int <= 0`: the number of physical cores available on the CPU
+        * otherwise the desired number of threads
 
     Attributes
     ----------
@@ -134,7 +151,6 @@ class HawkesCumulantMatching(LearnerHawkesNoParam):
     `In International Conference on Machine Learning (pp. 1-10)`_.
 
     .. _In International Conference on Machine Learning (pp. 1-10): http://proceedings.mlr.press/v70/achab17a.html
-    .. _Tensorflow: https://www.tensorflow.org
     """
     _attrinfos = {
         '_cumulant_computer': {
@@ -146,8 +162,6 @@ class HawkesCumulantMatching(LearnerHawkesNoParam):
         '_elastic_net_ratio': {
             'writable': False
         },
-        '_tf_feed_dict': {},
-        '_tf_graph': {},
         '_events_of_cumulants': {
             'writable': False
         }
@@ -156,18 +170,12 @@ class HawkesCumulantMatching(LearnerHawkesNoParam):
     def __init__(self, integration_support, C=1e3, penalty='none',
                  solver='adam', step=1e-2, tol=1e-8, max_iter=1000,
                  verbose=False, print_every=100, record_every=10,
-                 solver_kwargs=None, cs_ratio=None, elastic_net_ratio=0.95):
-        try:
-            import tensorflow
-        except ImportError:
-            raise ImportError('`tensorflow` >= 1.4.0 must be available to use '
-                              'HawkesCumulantMatching')
-
-        self._tf_graph = tf.Graph()
-
+                 solver_kwargs=None, cs_ratio=None, elastic_net_ratio=0.95,
+                 n_threads=1):
         LearnerHawkesNoParam.__init__(
             self, tol=tol, verbose=verbose, max_iter=max_iter,
-            print_every=print_every, record_every=record_every)
+            print_every=print_every, record_every=record_every,
+            n_threads=n_threads)
 
         self._elastic_net_ratio = None
         self.C = C
@@ -180,10 +188,9 @@ class HawkesCumulantMatching(LearnerHawkesNoParam):
             self.solver_kwargs = {}
 
         self._cumulant_computer = _HawkesCumulantComputer(
-            integration_support=integration_support)
+            integration_support=integration_support, n_threads=n_threads)
         self._learner = self._cumulant_computer._learner
-        self._solver = solver
-        self._tf_feed_dict = None
+        self.solver = solver
         self._events_of_cumulants = None
 
         self.history.print_order = ["n_iter", "objective", "rel_obj"]
@@ -237,33 +244,11 @@ class HawkesCumulantMatching(LearnerHawkesNoParam):
         -------
         Value of objective function
         """
-        cost = self._tf_objective_graph()
-        L, C, K_c = self._tf_placeholders()
-
         if adjacency is not None:
             R = scipy.linalg.inv(np.eye(self.n_nodes) - adjacency)
 
-        with self._tf_graph.as_default():
-            with tf.Session() as sess:
-                sess.run(tf.global_variables_initializer())
-                sess.run(self._tf_model_coeffs.assign(R))
-
-                return sess.run(
-                    cost, feed_dict={
-                        L: self.mean_intensity,
-                        C: self.covariance,
-                        K_c: self.skewness
-                    })
-
-    @property
-    def _tf_model_coeffs(self):
-        """Tensorflow variable of interest, used to perform minimization of
-        objective function
-        """
-        with self._tf_graph.as_default():
-            with tf.variable_scope("model", reuse=tf.AUTO_REUSE):
-                return tf.get_variable("R", [self.n_nodes, self.n_nodes],
-                                       dtype=tf.float64)
+        R = np.array(R, dtype=float)
+        return self._cumulant_matching().loss(R)
 
     @property
     def adjacency(self):
@@ -273,63 +258,31 @@ class HawkesCumulantMatching(LearnerHawkesNoParam):
     def baseline(self):
         return scipy.linalg.inv(self.solution).dot(self.mean_intensity)
 
-    def _tf_placeholders(self):
-        """Tensorflow placeholders to manage cumulants data
+    def _cumulant_matching(self):
+        """C++ object computing the objective and performing the solver
+        iterations, set with the estimated cumulants
         """
-        d = self.n_nodes
-        if self._tf_feed_dict is None:
-            with self._tf_graph.as_default():
-                L = tf.placeholder(tf.float64, d, name='L')
-                C = tf.placeholder(tf.float64, (d, d), name='C')
-                K_c = tf.placeholder(tf.float64, (d, d), name='K_c')
-                self._tf_feed_dict = L, C, K_c
-
-        return self._tf_feed_dict
-
-    def _tf_objective_graph(self):
-        """Objective fonction written as a tensorflow graph
-        """
-        d = self.n_nodes
-
         if self.cs_ratio is None:
             cs_ratio = self.approximate_optimal_cs_ratio()
         else:
             cs_ratio = self.cs_ratio
 
-        with self._tf_graph.as_default():
-            L, C, K_c = self._tf_placeholders()
-            R = self._tf_model_coeffs
-            I = tf.constant(np.eye(d), dtype=tf.float64)
-
-            # Construct model
-            variable_covariance = \
-                tf.matmul(R, tf.matmul(tf.diag(L), R, transpose_b=True))
+        cumulant_matching = _HawkesCumulantMatching(
+            cs_ratio, self.strength_lasso, self.strength_ridge,
+            solver_types[self.solver.lower()], self.step)
 
-            variable_skewness = \
-                tf.matmul(C, tf.square(R), transpose_b=True) \
-                + 2.0 * tf.matmul(R, R * C, transpose_b=True) \
-                - 2.0 * tf.matmul(R, tf.matmul(
-                    tf.diag(L), tf.square(R), transpose_b=True))
+        for key, value in self.solver_kwargs.items():
+            if key == 'momentum':
+                cumulant_matching.set_momentum(value)
+            elif key == 'history_size':
+                cumulant_matching.set_history_size(value)
+            else:
+                raise ValueError('Unknown solver argument {}, accepted ones '
+                                 'are momentum and history_size'.format(key))
 
-            covariance_divergence = tf.reduce_mean(
-                tf.squared_difference(variable_covariance, C))
-
-            skewness_divergence = tf.reduce_mean(
-                tf.squared_difference(variable_skewness, K_c))
-
-            cost = (1 - cs_ratio) * skewness_divergence
-            cost += cs_ratio * covariance_divergence
-
-            # Add potential regularization
-            cost = tf.cast(cost, tf.float64)
-            if self.strength_lasso > 0:
-                reg_l1 = tf.contrib.layers.l1_regularizer(self.strength_lasso)
-                cost += reg_l1((I - tf.matrix_inverse(R)))
-            if self.strength_ridge > 0:
-                reg_l2 = tf.contrib.layers.l2_regularizer(self.strength_ridge)
-                cost += reg_l2((I - tf.matrix_inverse(R)))
-
-            return cost
+        cumulant_matching.set_cumulants(self.mean_intensity, self.covariance,
+                                        self.skewness)
+        return cumulant_matching
 
     def fit(self, events, end_times=None, adjacency_start=None, R_start=None):
         """Fit the model according to the given training data.
@@ -383,7 +336,7 @@ class HawkesCumulantMatching(LearnerHawkesNoParam):
         step : `float`
             The learning rate used by the optimizer.
 
-        solver : {'adam', 'momentum', 'adagrad', 'rmsprop', 'adadelta', 'gd'}, default='adam'
+        solver : {'adam', 'momentum', 'adagrad', 'rmsprop', 'adadelta', 'gd', 'lbfgs'}, default='adam'
             Solver used to minimize the loss. As the loss is not convex, it
             cannot be optimized with `tick.optim.solver` solvers
         """
@@ -398,56 +351,37 @@ class HawkesCumulantMatching(LearnerHawkesNoParam):
             start_point = scipy.linalg.inv(
                 np.eye(self.n_nodes) - adjacency_start)
 
-        cost = self._tf_objective_graph()
-        L, C, K_c = self._tf_placeholders()
-
-        # Launch the graph
-        with self._tf_graph.as_default():
-            with tf.variable_scope("solver", reuse=tf.AUTO_REUSE):
-                tf_solver = self.tf_solver(self.step, **self.solver_kwargs)
-                optimization = tf_solver.minimize(cost)
-
-            with tf.Session() as sess:
-                sess.run(tf.global_variables_initializer())
-                sess.run(self._tf_model_coeffs.assign(start_point))
-                # Training cycle
-                for n_iter in range(self.max_iter):
-                    if self._should_record_iter(n_iter):
-                        # We don't use self.objective here as it would be very
-                        # slow
-                        prev_obj = sess.run(
-                            cost, feed_dict={
-                                L: self.mean_intensity,
-                                C: self.covariance,
-                                K_c: self.skewness
-                            })
-
-                    sess.run(
-                        optimization, feed_dict={
-                            L: self.mean_intensity,
-                            C: self.covariance,
-                            K_c: self.skewness
-                        })
-
-                    if self._should_record_iter(n_iter):
-                        obj = sess.run(
-                            cost, feed_dict={
-                                L: self.mean_intensity,
-                                C: self.covariance,
-                                K_c: self.skewness
-                            })
-                        rel_obj = abs(obj - prev_obj) / abs(prev_obj)
-                        prev_obj = obj
-                        converged = rel_obj < self.tol
-
-                        force = converged or n_iter + 1 == self.max_iter
-                        self._handle_history(n_iter + 1, objective=obj,
-                                             rel_obj=rel_obj, force=force)
-
-                        if converged:
-                            break
-
-                self._set('solution', sess.run(self._tf_model_coeffs))
+        cumulant_matching = self._cumulant_matching()
+        R = np.array(start_point, dtype=float)
+
+        n_iter = 0
+        while n_iter < self.max_iter:
+            # Iterations that are not recorded are all performed in C++
+            n_iter_not_recorded = 0
+            while n_iter + n_iter_not_recorded < self.max_iter and \
+                    not self._should_record_iter(n_iter + n_iter_not_recorded):
+                n_iter_not_recorded += 1
+            cumulant_matching.solve(R, n_iter_not_recorded)
+            n_iter += n_iter_not_recorded
+            if n_iter == self.max_iter:
+                break
+
+            prev_obj = cumulant_matching.loss(R)
+            cumulant_matching.solve(R, 1)
+            obj = cumulant_matching.loss(R)
+
+            rel_obj = abs(obj - prev_obj) / abs(prev_obj)
+            converged = rel_obj < self.tol
+
+            force = converged or n_iter + 1 == self.max_iter
+            self._handle_history(n_iter + 1, objective=obj, rel_obj=rel_obj,
+                                 force=force)
+            n_iter += 1
+
+            if converged:
+                break
+
+        self._set('solution', R)
 
     def approximate_optimal_cs_ratio(self):
         """Heuristic to set covariance skewness ratio close to its
@@ -501,30 +435,13 @@ class HawkesCumulantMatching(LearnerHawkesNoParam):
 
     @solver.setter
     def solver(self, val):
-        available_solvers = [
-            'momentum', 'adam', 'adagrad', 'rmsprop', 'adadelta', 'gd'
-        ]
+        available_solvers = list(solver_types.keys())
         if val.lower() not in available_solvers:
             raise ValueError('solver must be one of {}, recieved {}'.format(
                 available_solvers, val))
 
         self._set('_solver', val)
 
-    @property
-    def tf_solver(self):
-        if self.solver.lower() == 'momentum':
-            return tf.train.MomentumOptimizer
-        elif self.solver.lower() == 'adam':
-            return tf.train.AdamOptimizer
-        elif self.solver.lower() == 'adagrad':
-            return tf.train.AdagradOptimizer
-        elif self.solver.lower() == 'rmsprop':
-            return tf.train.RMSPropOptimizer
-        elif self.solver.lower() == 'adadelta':
-            return tf.train.AdadeltaOptimizer
-        elif self.solver.lower() == 'gd':
-            return tf.train.GradientDescentOptimizer
-
     @property
     def elastic_net_ratio(self):
         return self._elastic_net_ratio
@@ -568,22 +485,18 @@ class _HawkesCumulantComputer(Base):
         'L': {},
         'C': {},
         'K_c': {},
-        '_L_day': {},
-        '_J': {},
         '_events_of_cumulants': {},
     }
 
-    def __init__(self, integration_support=100.):
+    def __init__(self, integration_support=100., n_threads=1):
         Base.__init__(self)
         self.integration_support = integration_support
-        self._learner = _HawkesCumulant(self.integration_support)
+        self._learner = _HawkesCumulant(self.integration_support, n_threads)
 
         self.L = None
         self.C = None
         self.K_c = None
 
-        self._L_day = None
-        self._J = None
         self._events_of_cumulants = None
 
     def compute_cumulants(self, verbose=False, force=False):
@@ -610,11 +523,12 @@ class _HawkesCumulantComputer(Base):
 
         # Remember for which realizations cumulants have been computed
         self._events_of_cumulants = self.realizations
-        self.compute_L()
-        self.compute_C_and_J()
-        self.K_c = self.compute_E_c()
 
-        self._learner.set_are_cumulants_ready(True)
+        # L, C and K_c are computed at once in C++
+        self._learner.compute_cumulants()
+        self.L = self._learner.get_mean_intensity()
+        self.C = self._learner.get_covariance()
+        self.K_c = self._learner.get_skewness()
 
     @staticmethod
     def _same_realizations(events_1, events_2):
@@ -632,60 +546,6 @@ class _HawkesCumulantComputer(Base):
                     return False
         return True
 
-    def compute_L(self):
-        self._L_day = np.zeros((self.n_realizations, self.n_nodes))
-
-        for day, realization in enumerate(self.realizations):
-            for i in range(self.n_nodes):
-                process = realization[i]
-                self._L_day[day][i] = len(process) / self.end_times[day]
-
-        self.L = np.mean(self._L_day, axis=0)
-
-    def compute_C_and_J(self):
-        self.C = np.zeros((self.n_nodes, self.n_nodes))
-        self._J = np.zeros((self.n_realizations, self.n_nodes, self.n_nodes))
-
-        d = self.n_nodes
-        for day in range(len(self.realizations)):
-            C = np.zeros((d, d))
-            J = np.zeros((d, d))
-            for i, j in product(range(d), repeat=2):
-                res = self._learner.compute_A_and_I_ij(day, i, j,
-                                                       self._L_day[day][j])
-                C[i, j] = res[0]
-                J[i, j] = res[1]
-            # we keep the symmetric part to remove edge effects
-            C[:] = 0.5 * (C + C.T)
-            J[:] = 0.5 * (J + J.T)
-            self.C += C / self.n_realizations
-            self._J[day] = J.copy()
-
-    def compute_E_c(self):
-        E_c = np.zeros((self.n_nodes, self.n_nodes, 2))
-
-        d = self.n_nodes
-
-        for day in range(len(self.realizations)):
-            for i in range(d):
-                for j in range(d):
-                    E_c[i, j, 0] += self._learner.compute_E_ijk(
-                        day, i, j, j, self._L_day[day][i], self._L_day[day][j],
-                        self._J[day][i, j])
-
-                    E_c[i, j, 1] += self._learner.compute_E_ijk(
-                        day, j, j, i, self._L_day[day][j], self._L_day[day][j],
-                        self._J[day][j, j])
-
-        E_c /= self.n_realizations
-
-        K_c = np.zeros((self.n_nodes, self.n_nodes))
-        K_c += 2 * E_c[:, :, 0]
-        K_c += E_c[:, :, 1]
-        K_c /= 3.
-
-        return K_c
-
     @property
     def n_nodes(self):
         return self._learner.get_n_nodes()
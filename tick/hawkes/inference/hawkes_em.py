@@ -5,6 +5,8 @@ import numpy as np
 from tick.hawkes.inference.base import LearnerHawkesNoParam
 from tick.hawkes.inference.build.hawkes_inference import (HawkesEM as
                                                           _HawkesEM)
+from tick.hawkes.inference.build.hawkes_inference import (
+    HawkesAcceleratedEM as _HawkesAcceleratedEM)
 from tick.solver.base.utils import relative_distance
 
 
@@ -64,6 +66,12 @@ class HawkesEM(LearnerHawkesNoParam):
         * if `int <= 0`: the number of physical cores available on the CPU
         * otherwise the desired number of threads
 
+    accelerate : `bool`, default=False
+        If `True`, EM iterations are accelerated with SQUAREM extrapolation
+        and run entirely in C++. In this case history is only recorded at
+        the end of the iterations and ``n_iter`` counts extrapolation cycles,
+        each of them performing up to three EM steps
+
     Attributes
     ----------
     n_nodes : `int`
@@ -92,7 +100,8 @@ class HawkesEM(LearnerHawkesNoParam):
 
     def __init__(self, kernel_support=None, kernel_size=10,
                  kernel_discretization=None, tol=1e-5, max_iter=100,
-                 print_every=10, record_every=10, verbose=False, n_threads=1):
+                 print_every=10, record_every=10, verbose=False, n_threads=1,
+                 accelerate=False):
 
         LearnerHawkesNoParam.__init__(
             self, n_threads=n_threads, verbose=verbose, tol=tol,
@@ -107,6 +116,7 @@ class HawkesEM(LearnerHawkesNoParam):
             raise ValueError('Either kernel support or kernel discretization '
                              'must be provided')
 
+        self.accelerate = accelerate
         self.baseline = None
         self.kernel = None
 
@@ -176,6 +186,15 @@ class HawkesEM(LearnerHawkesNoParam):
         else:
             self.baseline = baseline_start.copy()
 
+        if self.accelerate:
+            accelerated_em = _HawkesAcceleratedEM(self.max_iter, self.tol)
+            n_iter = accelerated_em.solve(self._learner, self.baseline,
+                                          self._flat_kernels)
+            rel_change = accelerated_em.get_rel_change()
+            self._handle_history(n_iter, rel_baseline=rel_change,
+                                 rel_kernel=rel_change, force=True)
+            return
+
         for i in range(self.max_iter):
             if self._should_record_iter(i):
                 prev_baseline = self.baseline.copy()
@@ -114,6 +114,13 @@ class HawkesSumGaussians(LearnerHawkesNoParam):
         will stop.
         If None, it will be set given a heuristic which look at last
 
+    store_weights : `bool`, default=True
+        If `True`, the sums of gaussian values over past events are computed
+        once and stored, which requires ``n_nodes * n_gaussians`` doubles per
+        event. If `False`, they are recomputed at each iteration, only
+        considering past events in a truncated window of the gaussians
+        support, and memory usage does not depend on the number of events
+
     Attributes
     ----------
     n_nodes : `int`
@@ -166,13 +173,17 @@ class HawkesSumGaussians(LearnerHawkesNoParam):
         },
         "approx": {
             "writable": False
+        },
+        "store_weights": {
+            "cpp_setter": "set_store_weights"
         }
     }
 
     def __init__(self, max_mean_gaussian, n_gaussians=5, step_size=1e-7, C=1e3,
                  lasso_grouplasso_ratio=0.5, max_iter=50, tol=1e-5,
                  n_threads=1, verbose=False, print_every=10, record_every=10,
-                 approx=0, em_max_iter=30, em_tol=None):
+                 approx=0, em_max_iter=30, em_tol=None,
+                 store_weights=True):
 
         LearnerHawkesNoParam.__init__(
             self, verbose=verbose, max_iter=max_iter, print_every=print_every,
@@ -193,6 +204,7 @@ class HawkesSumGaussians(LearnerHawkesNoParam):
         self._learner = _HawkesSumGaussians(
             n_gaussians, max_mean_gaussian, step_size, strength_lasso,
             strength_grouplasso, em_max_iter, n_threads, approx)
+        self.store_weights = store_weights
 
         self.verbose = verbose
 
@@ -86,6 +86,26 @@ class Test(unittest.TestCase):
         np.testing.assert_array_almost_equal(learner.adjacency, adjacency,
                                              decimal=6)
 
+    def test_hawkes_adm4_store_weights(self):
+        """...Test that HawkesADM4 solution does not depend on weights being
+        stored or recomputed at each iteration
+        """
+        baseline, adjacency, events = self.simulate_sparse_realization()
+        events = events[:20]
+
+        learners = []
+        for store_weights in [True, False]:
+            learner = HawkesADM4(self.decay, n_threads=2, max_iter=11,
+                                 em_max_iter=3, store_weights=store_weights)
+            learner.fit(events, baseline_start=np.zeros(2) + .2,
+                        adjacency_start=np.zeros((2, 2)) + .2)
+            learners += [learner]
+
+        np.testing.assert_array_almost_equal(learners[0].baseline,
+                                             learners[1].baseline)
+        np.testing.assert_array_almost_equal(learners[0].adjacency,
+                                             learners[1].adjacency)
+
     def test_hawkes_adm4_score(self):
         """...Test HawkesADM4 score method
         """
@@ -94,6 +94,24 @@ class Test(InferenceTest):
             model.kernels_norms,
             [[0.46108403, -0.09467477], [-0.04787463, -3.82917571]])
 
+    def test_hawkes_conditional_law_n_threads(self):
+        """...Test HawkesConditionalLaw estimates do not depend on the number
+        of threads
+        """
+        marked_timestamps = [(t, np.cumsum(random(len(t)) * 2))
+                             for t in self.timestamps]
+        models = []
+        for n_threads in [1, 3]:
+            model = HawkesConditionalLaw(n_quad=5, n_threads=n_threads,
+                                         marked_components={0: [0.5, 1.5]})
+            model.incremental_fit(marked_timestamps)
+            models.append(model)
+
+        np.testing.assert_array_equal(models[0].kernels_norms,
+                                      models[1].kernels_norms)
+        np.testing.assert_array_equal(models[0].mark_functions[0][0][1],
+                                      models[1].mark_functions[0][0][1])
+
     def test_incremental_fit(self):
         # This should not raise a warning
         self.model.incremental_fit(self.timestamps, compute=False)
@@ -76,6 +76,46 @@ class Test(unittest.TestCase):
             em.get_kernel_supports(),
             np.ones((self.n_nodes, self.n_nodes)) * 3)
 
+    def test_hawkes_em_fit_n_threads(self):
+        """...Test that HawkesEM fit does not depend on the number of threads
+        """
+        events = [[
+            np.cumsum(np.random.rand(4 + i)) for i in range(self.n_nodes)
+        ] for _ in range(7)]
+
+        kernels = []
+        for n_threads in [1, 3, 8]:
+            em = HawkesEM(kernel_support=3, kernel_size=3, n_threads=n_threads,
+                          max_iter=11, verbose=False)
+            em.fit(events, baseline_start=np.zeros(self.n_nodes) + .2,
+                   kernel_start=np.zeros((self.n_nodes, self.n_nodes, 3)) + .4)
+            kernels += [em.kernel]
+
+        np.testing.assert_array_almost_equal(kernels[0], kernels[1])
+        np.testing.assert_array_almost_equal(kernels[0], kernels[2])
+
+    def test_hawkes_em_fit_accelerate(self):
+        """...Test that accelerated HawkesEM reaches the same optimum as plain
+        HawkesEM
+        """
+        events = [[
+            np.cumsum(np.random.rand(40 + i)) for i in range(self.n_nodes)
+        ] for _ in range(3)]
+
+        kwargs = dict(kernel_support=3, kernel_size=3, tol=1e-10,
+                      max_iter=5000)
+        fit_kwargs = dict(
+            baseline_start=np.zeros(self.n_nodes) + .2,
+            kernel_start=np.zeros((self.n_nodes, self.n_nodes, 3)) + .4)
+
+        em = HawkesEM(**kwargs)
+        em.fit(events, **fit_kwargs)
+
+        accelerated_em = HawkesEM(accelerate=True, **kwargs)
+        accelerated_em.fit(events, **fit_kwargs)
+
+        self.assertAlmostEqual(em.score(), accelerated_em.score(), places=6)
+
     def test_hawkes_em_score(self):
         """...Test score (ie. likelihood) function of Hawkes EM
         """
@@ -81,6 +81,34 @@ class Test(unittest.TestCase):
                                              means_gaussians)
         self.assertEqual(learner.std_gaussian, std_gaussian)
 
+    def test_hawkes_sumgaussians_store_weights(self):
+        """...Test that HawkesSumGaussians solution does not depend on weights
+        being stored or recomputed at each iteration
+        """
+        events = [
+            np.array([1, 1.2, 3.4, 5.8, 10.3, 11, 13.4]),
+            np.array([2, 5, 8.3, 9.10, 15, 18, 20, 33])
+        ]
+        n_nodes = len(events)
+        n_gaussians = 3
+
+        learners = []
+        for store_weights in [True, False]:
+            learner = HawkesSumGaussians(
+                n_gaussians=n_gaussians, max_mean_gaussian=5, step_size=1e-3,
+                C=10, n_threads=3, max_iter=11, em_max_iter=3,
+                store_weights=store_weights)
+            learner.fit(
+                events, baseline_start=np.zeros(n_nodes) + .2,
+                amplitudes_start=np.zeros((n_nodes, n_nodes, n_gaussians)) +
+                .2)
+            learners += [learner]
+
+        np.testing.assert_array_almost_equal(learners[0].baseline,
+                                             learners[1].baseline)
+        np.testing.assert_array_almost_equal(learners[0].amplitudes,
+                                             learners[1].amplitudes)
+
     def test_hawkes_sumgaussians_set_data(self):
         """...Test set_data method of Hawkes SumGaussians
         """
@@ -1,5 +1,6 @@
 # License: BSD 3 clause
 
 from .model_hawkes import ModelHawkes
+from .model_hawkes_loglik import ModelHawkesLogLik
 
-__all__ = ["ModelHawkes"]
+__all__ = ["ModelHawkes", "ModelHawkesLogLik"]
@@ -0,0 +1,42 @@
+# License: BSD 3 clause
+
+import numpy as np
+
+from .model_hawkes import ModelHawkes
+
+
+class ModelHawkesLogLik(ModelHawkes):
+    """Base class of Hawkes models with log likelihood loss
+
+    Notes
+    -----
+    This class should be not used by end-users, it is intended for
+    development only.
+    """
+
+    def compensator_increments(self, coeffs: np.ndarray):
+        """Compensator increments of each node between its consecutive events
+        (time-rescaled inter-arrival times) at the given coefficients
+
+        Parameters
+        ----------
+        coeffs : `np.ndarray`
+            Coefficients of the model, namely baselines followed by the
+            adjacency
+
+        Returns
+        -------
+        output : `list` of `list` of `np.ndarray`
+            `output[r][i][k]` is the compensator of node i of realization r
+            between its events k - 1 and k (or 0 and its first event). If the
+            model is well specified these are i.i.d. standard exponential
+            variables, which can be checked with a Kolmogorov-Smirnov test
+        """
+        if not self._fitted:
+            raise ValueError(
+                "call ``fit`` before using ``compensator_increments``")
+        if coeffs.shape[0] != self.n_coeffs:
+            raise ValueError(
+                ("``coeffs`` has size %i while the model" +
+                 " expects %i coefficients") % (coeffs.shape[0], self.n_coeffs))
+        return self._model.get_compensator_increments(coeffs)
@@ -6,10 +6,10 @@ from tick.base_model import ModelSecondOrder, ModelSelfConcordant, \
     LOSS_AND_GRAD
 from tick.hawkes.model.build.hawkes_model import (ModelHawkesExpKernLogLik as
                                                   _ModelHawkesExpKernLogLik)
-from .base import ModelHawkes
+from .base import ModelHawkes, ModelHawkesLogLik
 
 
-class ModelHawkesExpKernLogLik(ModelHawkes, ModelSecondOrder,
+class ModelHawkesExpKernLogLik(ModelHawkesLogLik, ModelSecondOrder,
                                ModelSelfConcordant):
     """Hawkes process model exponential kernels with fixed and given decay.
     It is modeled with (opposite) log likelihood loss:
@@ -6,10 +6,10 @@ from tick.base_model import ModelSecondOrder, ModelSelfConcordant, \
     LOSS_AND_GRAD
 from tick.hawkes.model.build.hawkes_model import (
     ModelHawkesSumExpKernLogLik as _ModelHawkesSumExpKernLogLik)
-from .base import ModelHawkes
+from .base import ModelHawkes, ModelHawkesLogLik
 
 
-class ModelHawkesSumExpKernLogLik(ModelHawkes, ModelSecondOrder,
+class ModelHawkesSumExpKernLogLik(ModelHawkesLogLik, ModelSecondOrder,
                                   ModelSelfConcordant):
     """Hawkes process model for sum of exponential kernels with fixed and
     given decays.
@@ -57,6 +57,38 @@ class Test(unittest.TestCase):
         self.assertAlmostEqual(integral_approx, -self.model.loss(self.coeffs),
                                places=precision)
 
+    def test_model_hawkes_compensator_increments(self):
+        """...Test that compensator increments sum up to the compensator
+        """
+        increments = self.model_list.compensator_increments(self.coeffs)
+        self.assertEqual(len(increments), self.n_realizations)
+
+        for r, timestamps in enumerate(self.timestamps_list):
+            for i in range(self.n_nodes):
+                t = timestamps[i][-1]
+                compensator = self.baseline[i] * t
+                for j in range(self.n_nodes):
+                    t_j = timestamps[j][timestamps[j] < t]
+                    compensator += self.adjacency[i, j] * np.sum(
+                        1 - np.exp(-self.decay * (t - t_j)))
+
+                self.assertEqual(len(increments[r][i]), len(timestamps[i]))
+                self.assertAlmostEqual(increments[r][i].sum(), compensator)
+
+    def test_model_hawkes_compensator_increments_errors(self):
+        """...Test that compensator increments are not computed on an unfitted
+        model or with coeffs of wrong size
+        """
+        model = ModelHawkesExpKernLogLik(self.decay)
+        msg = "^call ``fit`` before using ``compensator_increments``$"
+        with self.assertRaisesRegex(ValueError, msg):
+            model.compensator_increments(self.coeffs)
+
+        msg = "^``coeffs`` has size 11 while the model expects 12 " \
+              "coefficients$"
+        with self.assertRaisesRegex(ValueError, msg):
+            self.model_list.compensator_increments(self.coeffs[:-1])
+
     def test_model_hawkes_loglik_multiple_events(self):
         """...Test that multiple events list for ModelHawkesExpKernLogLik
         is consistent with direct integral estimation
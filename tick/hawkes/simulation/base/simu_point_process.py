@@ -3,6 +3,8 @@
 import warnings
 
 from tick.base.simulation import Simu
+from tick.hawkes.simulation.build.hawkes_simulation import \
+    PPFileEventSink as _PPFileEventSink
 
 
 class SimuPointProcess(Simu):
@@ -166,7 +168,8 @@ class SimuPointProcess(Simu):
         elif self.end_time is not None and self.max_jumps is not None:
             self._pp.simulate(self.end_time, self.max_jumps)
 
-    def track_intensity(self, intensity_track_step=-1):
+    def track_intensity(self, intensity_track_step=-1,
+                        max_n_tracked_points=None):
         """Activate the tracking of the intensity
 
         Parameters
@@ -175,11 +178,61 @@ class SimuPointProcess(Simu):
             If positive then the step the intensity vector is recorded every,
             otherwise, it is deactivated.
 
+        max_n_tracked_points : `int`, default=None
+            If given, the number of recorded points is kept below this
+            bound: once it is reached, one point out of two is dropped and
+            the recording step is doubled. Hence `intensity_track_step` may
+            be larger than requested after simulation
+
         Notes
         -----
         This method must be called before simulation
         """
-        self._pp.activate_itr(intensity_track_step)
+        if max_n_tracked_points is None:
+            max_n_tracked_points = 0
+        elif max_n_tracked_points < 2:
+            raise ValueError("max_n_tracked_points must be at least 2")
+        self._pp.activate_itr(intensity_track_step, int(max_n_tracked_points))
+
+    def stream_events_to_file(self, path, batch_size=65536):
+        """Write the jumps of next simulations to a binary file instead of
+        keeping them in memory
+
+        Parameters
+        ----------
+        path : `str`
+            Path of the file, overwritten if it exists. Use `read_events` to
+            load it. If `None`, jumps are kept in memory again
+
+        batch_size : `int`, default=65536
+            Number of jumps buffered before being written
+
+        Notes
+        -----
+        `timestamps` stay empty while events are streamed. Hawkes processes
+        can only be streamed if they are simulated event by event, that is
+        with constant baselines and non-negative exponential kernels
+        """
+        if path is None:
+            self._pp.set_event_sink(None)
+        else:
+            self._pp.set_event_sink(
+                _PPFileEventSink(str(path), int(batch_size)))
+
+    def read_events(self, path):
+        """Read jumps written by `stream_events_to_file`
+
+        Parameters
+        ----------
+        path : `str`
+            Path of the file
+
+        Returns
+        -------
+        output : `list` of `np.ndarray`
+            Timestamps of each node
+        """
+        return _PPFileEventSink.read(str(path), self.n_nodes)
 
     def is_intensity_tracked(self):
         """Is intensity tracked thanks to track_intensity or not
@@ -3,6 +3,7 @@
 from tick.hawkes.simulation.build.hawkes_simulation import (
     HawkesKernelPowerLaw as _HawkesKernelPowerLaw)
 from .hawkes_kernel import HawkesKernel
+from .hawkes_kernel_sum_exp import HawkesKernelSumExp
 
 
 class HawkesKernelPowerLaw(HawkesKernel):
@@ -43,6 +44,36 @@ class HawkesKernelPowerLaw(HawkesKernel):
     def exponent(self):
         return self._kernel.get_exponent()
 
+    def approximate_with_sum_exp(self, relative_error=1e-3, max_n_decays=200):
+        """Approximates the kernel on its support by a sum of exponential
+        kernels, whose simulation and log-likelihood cost does not depend on
+        the number of past events
+
+        Parameters
+        ----------
+        relative_error : `float`, default=1e-3
+            Maximum relative error of the approximation on the support of
+            the kernel
+
+        max_n_decays : `int`, default=200
+            Maximum number of exponentials used
+
+        Returns
+        -------
+        output : `HawkesKernelSumExp`
+            Approximating kernel. Its decays can be given to
+            `ModelHawkesSumExpKernLogLik` or `HawkesSumExpKern`
+
+        Notes
+        -----
+        The approximation keeps decaying beyond the support of the kernel
+        instead of being zero
+        """
+        approximation = self._kernel.get_sum_exp_approximation(
+            relative_error, max_n_decays)
+        return HawkesKernelSumExp(approximation.get_intensities(),
+                                  approximation.get_decays())
+
     def __str__(self):
         if self.multiplier == 0:
             return '0'
@@ -65,6 +65,11 @@ class SimuHawkes(SimuPointProcess):
     seed : `int`, default = None
         The seed of the random sampling. If it is None then a random seed
         (different at each run) will be chosen.
+        If intensity is not tracked and all kernels are exponential or sum of
+        exponential with non-negative intensities, the process is simulated
+        event by event. It samples the same law but draws random numbers in
+        another order, so a given seed gives other timestamps than when
+        intensity is tracked (or than before this simulation was added).
 
     force_simulation : `bool`, default = False
         If force is not set to True, simulation won't be run if the matrix of
@@ -250,9 +255,66 @@ class SimuHawkes(SimuPointProcess):
         """
         return self._pp.get_baseline(i, t_values)
 
+    def get_intensity_values(self, timestamps, t_values, n_threads=1):
+        """Outputs value of intensity of all nodes on a grid of times, for a
+        given realization
+
+        Parameters
+        ----------
+        timestamps : `list` of `np.ndarray`
+            Events timestamps of each node, for example real data to score with
+            the parameters of this process
+
+        t_values : `np.ndarray`
+            Sorted values intensity will be computed at
+
+        n_threads : `int`, default=1
+            Number of threads used, nodes being dispatched among them. If
+            non-positive, all available cores are used
+
+        Returns
+        -------
+        output : `list` of `np.ndarray`
+            Value of intensity of each node at `t_values`, events occurring
+            exactly at a given time being excluded (left limit)
+        """
+        timestamps = [np.ascontiguousarray(t, dtype=float) for t in timestamps]
+        t_values = np.ascontiguousarray(t_values, dtype=float)
+        return self._pp.get_intensity(timestamps, t_values, n_threads)
+
+    def compensator_increments(self, n_threads=1):
+        """Compensator increments of each node between its consecutive
+        simulated events (time-rescaled inter-arrival times)
+
+        Parameters
+        ----------
+        n_threads : `int`, default=1
+            Number of threads used, nodes being dispatched among them. If
+            non-positive, all available cores are used
+
+        Returns
+        -------
+        output : `list` of `np.ndarray`
+            `output[i][k]` is the compensator of node i between its events
+            k - 1 and k (or 0 and its first event), which are i.i.d. standard
+            exponential variables
+
+        Notes
+        -----
+        Only constant baselines and exponential or sum of exponential kernels
+        are supported
+        """
+        return self._pp.get_compensator_increments(n_threads)
+
     def _simulate(self):
         """Launch simulation of the Hawkes process by thinning
         """
+        self._check_simulation()
+        SimuPointProcess._simulate(self)
+
+    def _check_simulation(self):
+        """Checks that the Hawkes process can be simulated
+        """
         if self.baseline.dtype == float and np.linalg.norm(self.baseline) == 0:
             warnings.warn("Baselines have not been set, hence this hawkes "
                           "process won't jump")
@@ -265,7 +327,36 @@ class SimuHawkes(SimuPointProcess):
                 "can use force_simulation parameter if you "
                 "really want to simulate it" % self.spectral_radius())
 
-        SimuPointProcess._simulate(self)
+    def simulate_cluster(self, n_threads=1):
+        """Launch simulation of the Hawkes process from its cluster
+        (immigrant - offspring) representation, generation after generation
+
+        Parameters
+        ----------
+        n_threads : `int`, default=1
+            Number of threads used to draw the offspring of each generation
+            and to sort the timestamps. If non-positive, all available cores
+            are used. The realization does not depend on it
+
+        Notes
+        -----
+        The process is simulated from scratch until `end_time`. Only constant
+        or piecewise baselines and non-negative exponential, sum of
+        exponential or power law kernels are supported and the intensity
+        cannot be tracked
+        """
+        if self.end_time is None:
+            raise ValueError('end_time must be set for cluster simulation')
+
+        if self.spectral_radius() >= 1:
+            raise ValueError(
+                "Cluster simulation requires a stable Hawkes process "
+                "(spectral radius of %.2g)" % self.spectral_radius())
+
+        self.reset()
+        self._start_simulation()
+        self._pp.simulate_cluster(float(self.end_time), n_threads)
+        self._end_simulation()
 
     def spectral_radius(self):
         """Compute the spectral radius of the matrix of l1 norm of Hawkes
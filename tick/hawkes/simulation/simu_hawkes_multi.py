@@ -2,16 +2,13 @@
 
 import copy
 import multiprocessing
-from multiprocessing import Pool
+import sys
 
 import numpy as np
 
 from tick.base.simulation import Simu
-
-
-def simulate_single(simulation):
-    simulation.simulate()
-    return simulation
+from tick.hawkes.simulation.build.hawkes_simulation import \
+    HawkesMulti as _HawkesMulti
 
 
 class SimuHawkesMulti(Simu):
@@ -19,7 +16,17 @@ class SimuHawkesMulti(Simu):
 
     The incoming Hawkes simulation is replicated by the number n_simulations. At
     simulation time, the replicated Hawkes processes are run in parallel on a
-    number of threads specified by n_threads.
+    number of threads specified by n_threads. Replicas are held in C++ and
+    simulated on its thread pool, hence nothing is serialized and timestamps
+    share the memory of the simulated realizations.
+
+    Replicas track their intensity if `track_intensity` has been called on the
+    Hawkes simulation before it is given to this object.
+
+    The seed of each replica is drawn from `seed` by the C++ random generator
+    (see `reseed_simulations`), hence a given seed leads to other realizations
+    than the ones obtained with versions of tick drawing them with
+    `np.random`.
 
     Attributes
     ----------
@@ -59,10 +66,19 @@ class SimuHawkesMulti(Simu):
     mean_intensity : `list` of `float`
         List of the mean intensities of the Hawkes processes
 
+    tracked_intensity : `list` of `list` of `np.ndarray`
+        List of the intensities recorded for each process, if intensity is
+        tracked
+
+    intensity_tracked_times : `list` of `np.ndarray`
+        List of the times at which intensity has been recorded for each
+        process, if intensity is tracked
+
     """
 
     _attrinfos = {
-        "_simulations": {},
+        "_multi": {},
+        "_end_times": {},
         "hawkes_simu": {
             "writable": False
         },
@@ -83,15 +99,11 @@ class SimuHawkesMulti(Simu):
         if n_simulations <= 0:
             raise ValueError("n_simulations must be greater or equal to 1")
 
-        self._simulations = [
-            copy.deepcopy(hawkes_simu) for _ in range(n_simulations)
-        ]
+        self._multi = _HawkesMulti(hawkes_simu._pp, n_simulations)
+        self._end_times = [hawkes_simu.end_time] * n_simulations
 
         Simu.__init__(self, seed=self.seed, verbose=hawkes_simu.verbose)
 
-        if self.seed is not None and self.seed >= 0:
-            self.reseed_simulations(self.seed)
-
     @property
     def seed(self):
         return self.hawkes_simu.seed
@@ -108,68 +120,102 @@ class SimuHawkesMulti(Simu):
         Parameters
         ----------
         seed :
-            Seed used to randomly select new seeds
+            Seed used to randomly select new seeds. The seed of the ith
+            simulation only depends on it and on i. If negative, simulations
+            are randomly seeded
         """
         # this updates self.seed
         self.hawkes_simu._pp.reseed_random_generator(seed)
-
-        if seed >= 0:
-            np.random.seed(self.seed)
-            new_seeds = np.random.randint(0, 2 ** 31 - 1, self.n_simulations)
-            new_seeds = new_seeds.astype('int32')
-
-        else:
-            new_seeds = np.ones(self.n_simulations, dtype='int32') * seed
-
-        for simu, seed in zip(self._simulations, new_seeds):
-            simu.seed = seed.item()
+        self._multi.reseed(seed)
 
     @property
     def n_total_jumps(self):
-        return [simu.n_total_jumps for simu in self._simulations]
+        return list(self._multi.get_n_total_jumps())
 
     @property
     def timestamps(self):
-        return [simu.timestamps for simu in self._simulations]
+        return self._multi.get_timestamps()
 
     @property
     def end_time(self):
-        return [simu.end_time for simu in self._simulations]
+        return list(self._end_times)
 
     @end_time.setter
     def end_time(self, end_times):
         if len(end_times) != self.n_simulations:
             raise ValueError('end_time must have length {}'.format(
                 self.n_simulations))
-        for i, simu in enumerate(self._simulations):
-            simu.end_time = end_times[i]
+        self._end_times = list(end_times)
 
     @property
     def max_jumps(self):
-        return [simu.max_jumps for simu in self._simulations]
+        return [self.hawkes_simu.max_jumps] * self.n_simulations
 
     @property
     def simulation_time(self):
-        return [simu.simulation_time for simu in self._simulations]
+        return list(self._multi.get_simulation_times())
 
     @property
     def n_nodes(self):
-        return [simu.n_nodes for simu in self._simulations]
+        return [self.hawkes_simu.n_nodes] * self.n_simulations
 
     @property
     def spectral_radius(self):
-        return [simu.spectral_radius() for simu in self._simulations]
+        return [self.hawkes_simu.spectral_radius()] * self.n_simulations
 
     @property
     def mean_intensity(self):
-        return [simu.mean_intensity() for simu in self._simulations]
+        return [self.hawkes_simu.mean_intensity()] * self.n_simulations
+
+    @property
+    def tracked_intensity(self):
+        if not self.hawkes_simu.is_intensity_tracked():
+            raise ValueError("Intensity has not been tracked, you should call "
+                             "track_intensity on the Hawkes simulation before "
+                             "giving it to SimuHawkesMulti")
+        return [self._multi.get_itr(i) for i in range(self.n_simulations)]
+
+    @property
+    def intensity_tracked_times(self):
+        if not self.hawkes_simu.is_intensity_tracked():
+            raise ValueError("Intensity has not been tracked, you should call "
+                             "track_intensity on the Hawkes simulation before "
+                             "giving it to SimuHawkesMulti")
+        return [
+            self._multi.get_itr_times(i) for i in range(self.n_simulations)
+        ]
 
     def get_single_simulation(self, i):
-        return self._simulations[i]
+        """Returns a copy of the Hawkes simulation holding the ith realization
+
+        Notes
+        -----
+        If intensity is tracked, the intensity of the copy is recomputed from
+        the timestamps of the realization. Use `tracked_intensity` to get the
+        intensity recorded during the simulation
+        """
+        simulation = copy.deepcopy(self.hawkes_simu)
+        simulation.reset()
+        simulation.set_timestamps(self.timestamps[i],
+                                  self.simulation_time[i])
+        simulation.end_time = self._end_times[i]
+        return simulation
 
     def _simulate(self):
-        """ Launches a series of n_simulations Hawkes simulation in a thread
-        pool
+        """ Launches a series of n_simulations Hawkes simulation in the C++
+        thread pool
         """
-        with Pool(self.n_threads) as p:
-            self._simulations = p.map(simulate_single, self._simulations)
+        max_jumps = self.hawkes_simu.max_jumps
+        if max_jumps is None and any(t is None for t in self._end_times):
+            raise ValueError('Either end_time or max_jumps must be set')
+
+        self.hawkes_simu._check_simulation()
+
+        end_times = np.array([
+            sys.float_info.max if t is None else t for t in self._end_times
+        ], dtype=float)
+        if max_jumps is None:
+            max_jumps = np.iinfo(np.int64).max
+
+        self._multi.reset()
+        self._multi.simulate(end_times, int(max_jumps), self.n_threads)
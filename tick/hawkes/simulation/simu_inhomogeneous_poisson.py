@@ -29,6 +29,12 @@ class SimuInhomogeneousPoisson(SimuPointProcess):
     verbose : `bool`, default=True
         If True, simulation information is printed
 
+    n_threads : `int`, default=1
+        Number of threads used to sample the nodes. If non-positive, all
+        available cores are used. Nodes are sampled exactly by inverting their
+        cumulative intensity, unless intensity is tracked, `max_jumps` is set
+        or an intensity is negative, in which case thinning is used
+
     Attributes
     ----------
     n_nodes : `int`
@@ -58,7 +64,7 @@ class SimuInhomogeneousPoisson(SimuPointProcess):
     """
 
     def __init__(self, intensities_functions, end_time=None, max_jumps=None,
-                 seed=None, verbose=True):
+                 seed=None, verbose=True, n_threads=1):
         SimuPointProcess.__init__(self, end_time=end_time, max_jumps=max_jumps,
                                   seed=seed, verbose=verbose)
         cpp_obj_list = [
@@ -66,6 +72,7 @@ class SimuInhomogeneousPoisson(SimuPointProcess):
             for intensity_function in intensities_functions
         ]
         self._pp = _InhomogeneousPoisson(cpp_obj_list, self._pp_init_seed)
+        self._pp.set_n_threads(n_threads)
 
     def intensity_value(self, node, times):
         return self._pp.intensity_value(node, times)
@@ -2,7 +2,9 @@
 
 import unittest
 
-from tick.hawkes import HawkesKernelPowerLaw
+import numpy as np
+
+from tick.hawkes import HawkesKernelPowerLaw, HawkesKernelSumExp
 
 
 class Test(unittest.TestCase):
@@ -29,6 +31,21 @@ class Test(unittest.TestCase):
         """
         self.assertEqual(self.hawkes_kernel_power_law.exponent, self.exponent)
 
+    def test_HawkesKernelPowerLaw_sum_exp_approximation(self):
+        """...Test HawkesKernelPowerLaw sum of exponential approximation
+        """
+        relative_error = 1e-3
+        approximation = self.hawkes_kernel_power_law.approximate_with_sum_exp(
+            relative_error)
+        self.assertIsInstance(approximation, HawkesKernelSumExp)
+
+        t_values = np.linspace(
+            0, 0.99 * self.hawkes_kernel_power_law.get_support(), 1000)
+        np.testing.assert_allclose(
+            approximation.get_values(t_values),
+            self.hawkes_kernel_power_law.get_values(t_values),
+            rtol=relative_error)
+
     def test_HawkesKernelPowerLaw_str(self):
         """...Test HawkesKernelPowerLaw string representation
         """
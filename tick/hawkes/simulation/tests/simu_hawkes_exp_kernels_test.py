@@ -75,6 +75,40 @@ class Test(unittest.TestCase):
                 np.mean(self.hawkes.tracked_intensity[i]), mean_intensity[i],
                 delta=0.1)
 
+    def test_hawkes_event_driven_simulation(self):
+        """...Test that event-driven simulation, used when intensity is not
+        tracked, gives as many jumps as simulation tracking intensity
+        """
+        end_time, n_simulations = 200, 50
+
+        def n_jumps_per_node(track_intensity):
+            n_jumps = np.zeros((n_simulations, self.n_nodes))
+            for r in range(n_simulations):
+                hawkes = SimuHawkesExpKernels(
+                    self.adjacency, self.decays, baseline=self.baseline,
+                    end_time=end_time, seed=1000 + r, verbose=False)
+                if track_intensity:
+                    hawkes.track_intensity(end_time)
+                hawkes.simulate()
+                n_jumps[r] = list(map(len, hawkes.timestamps))
+            return n_jumps
+
+        event_driven_n_jumps = n_jumps_per_node(False)
+        thinning_n_jumps = n_jumps_per_node(True)
+
+        expected_n_jumps = self.hawkes.mean_intensity() * end_time
+        np.testing.assert_allclose(event_driven_n_jumps.mean(axis=0),
+                                   expected_n_jumps, rtol=0.1)
+        np.testing.assert_allclose(thinning_n_jumps.mean(axis=0),
+                                   expected_n_jumps, rtol=0.1)
+
+        # Both simulations sample the same law
+        std = np.sqrt((event_driven_n_jumps.var(axis=0, ddof=1) +
+                       thinning_n_jumps.var(axis=0, ddof=1)) / n_simulations)
+        np.testing.assert_array_less(
+            np.abs(event_driven_n_jumps.mean(axis=0) -
+                   thinning_n_jumps.mean(axis=0)), 3 * std)
+
 
 if __name__ == "__main__":
     unittest.main()
@@ -1,5 +1,6 @@
 # License: BSD 3 clause
 
+import pickle
 import unittest
 
 import numpy as np
@@ -143,6 +144,63 @@ class Test(unittest.TestCase):
         hawkes_multi = SimuHawkesMulti(hawkes, n_simulations=5, n_threads=4)
         hawkes_multi.simulate()
 
+    def test_simu_hawkes_multi_pickle(self):
+        """...Test that simulated SimuHawkesMulti can be pickled
+        """
+        hawkes = SimuHawkes(kernels=self.kernels, baseline=self.baseline,
+                            end_time=10, verbose=False, seed=504)
+        multi = SimuHawkesMulti(hawkes, n_threads=2, n_simulations=3)
+        multi.simulate()
+
+        pickled = pickle.loads(pickle.dumps(multi))
+
+        self.assertEqual(pickled.n_simulations, multi.n_simulations)
+        self.assertEqual(pickled.seed, multi.seed)
+        np.testing.assert_array_equal(pickled.n_total_jumps,
+                                      multi.n_total_jumps)
+        np.testing.assert_array_equal(pickled.simulation_time,
+                                      multi.simulation_time)
+        for timestamps, pickled_timestamps in zip(multi.timestamps,
+                                                  pickled.timestamps):
+            for t, pickled_t in zip(timestamps, pickled_timestamps):
+                np.testing.assert_array_equal(t, pickled_t)
+
+        # Pickled simulations are simulated again from their seeds
+        n_total_jumps = multi.n_total_jumps
+        pickled.simulate()
+        np.testing.assert_array_equal(pickled.n_total_jumps, n_total_jumps)
+
+    def test_simu_hawkes_multi_track_intensity(self):
+        """...Test that replicas track intensity as the Hawkes simulation
+        """
+        hawkes = SimuHawkes(kernels=self.kernels, baseline=self.baseline,
+                            end_time=100, verbose=False, seed=504)
+        multi = SimuHawkesMulti(hawkes, n_threads=2, n_simulations=3)
+        multi.simulate()
+        with self.assertRaisesRegex(ValueError, "track_intensity"):
+            multi.tracked_intensity
+
+        hawkes.track_intensity(0.1, max_n_tracked_points=100)
+        multi = SimuHawkesMulti(hawkes, n_threads=2, n_simulations=3)
+        multi.simulate()
+
+        self.assertEqual(len(multi.tracked_intensity), 3)
+        self.assertEqual(len(multi.intensity_tracked_times), 3)
+        for intensity, times in zip(multi.tracked_intensity,
+                                    multi.intensity_tracked_times):
+            self.assertEqual(len(intensity), hawkes.n_nodes)
+            self.assertLess(len(times), 100)
+            self.assertGreater(len(times), 1)
+            for i in range(hawkes.n_nodes):
+                self.assertEqual(len(intensity[i]), len(times))
+                self.assertGreaterEqual(intensity[i].min(),
+                                        self.baseline[i] - 1e-10)
+
+        # Replicas are different realizations
+        self.assertFalse(
+            np.array_equal(multi.tracked_intensity[0][0],
+                           multi.tracked_intensity[1][0]))
+
 
 if __name__ == "__main__":
     unittest.main()
@@ -104,6 +104,24 @@ class Test(unittest.TestCase):
                 np.mean(hawkes.tracked_intensity[i]), mean_intensity[i],
                 delta=0.3)
 
+    def test_hawkes_get_intensity_values(self):
+        """...Test that intensity values computed on a grid match tracked
+        intensity
+        """
+        hawkes = SimuHawkes(kernels=self.kernels, baseline=self.baseline,
+                            seed=308, end_time=100, verbose=False)
+        hawkes.track_intensity(0.1)
+        hawkes.simulate()
+
+        t_values = hawkes.intensity_tracked_times[::37]
+        for n_threads in [1, 2]:
+            intensity_values = hawkes.get_intensity_values(
+                hawkes.timestamps, t_values, n_threads=n_threads)
+            self.assertEqual(len(intensity_values), hawkes.n_nodes)
+            for i in range(hawkes.n_nodes):
+                np.testing.assert_array_almost_equal(
+                    intensity_values[i], hawkes.tracked_intensity[i][::37])
+
     def test_simu_hawkes_constructor(self):
         """...Test SimuHawkes constructor
         """
@@ -1,11 +1,14 @@
 # License: BSD 3 clause
 
+import os
+import tempfile
 import unittest
 
 import numpy as np
 
 from tick.base import TimeFunction
-from tick.hawkes import SimuInhomogeneousPoisson, SimuPoissonProcess
+from tick.hawkes import SimuInhomogeneousPoisson, SimuPoissonProcess, \
+    SimuHawkesExpKernels, HawkesKernelExp
 
 
 class Test(unittest.TestCase):
@@ -89,6 +92,92 @@ class Test(unittest.TestCase):
         np.testing.assert_array_almost_equal(tracked_intensity[1],
                                              tf_2.value(intensity_times))
 
+    def test_track_intensity_bounded(self):
+        """...Test that the number of tracked intensity points stays bounded
+        """
+        max_n_tracked_points = 100
+        self.poisson_process.end_time = 1000
+        self.poisson_process.track_intensity(0.01, max_n_tracked_points)
+        self.poisson_process.simulate()
+
+        intensity_times = self.poisson_process.intensity_tracked_times
+        self.assertLess(len(intensity_times), max_n_tracked_points)
+        self.assertGreaterEqual(len(intensity_times),
+                                max_n_tracked_points // 2 - 1)
+        self.assertGreater(self.poisson_process.intensity_track_step, 0.01)
+        # Records still span the whole simulation
+        self.assertTrue(np.all(np.diff(intensity_times) >= 0))
+        self.assertGreater(intensity_times[-1], 900)
+        for i, intensity in enumerate(self.intensities):
+            np.testing.assert_array_almost_equal(
+                self.poisson_process.tracked_intensity[i], intensity)
+
+        with self.assertRaises(ValueError):
+            self.poisson_process.track_intensity(0.01, 1)
+
+    def test_stream_events_to_file(self):
+        """...Test that streamed jumps are read back from file
+        """
+        in_memory = SimuPoissonProcess(self.intensities, end_time=self.run_time,
+                                       seed=2937, verbose=False)
+        in_memory.simulate()
+
+        streamed = SimuPoissonProcess(self.intensities, end_time=self.run_time,
+                                      seed=2937, verbose=False)
+        with tempfile.TemporaryDirectory() as directory:
+            path = os.path.join(directory, 'events.bin')
+            streamed.stream_events_to_file(path, batch_size=7)
+            streamed.simulate()
+
+            self.assertEqual(sum(map(len, streamed.timestamps)), 0)
+            self.assertEqual(streamed.n_total_jumps, in_memory.n_total_jumps)
+
+            events = streamed.read_events(path)
+            self.assertEqual(len(events), streamed.n_nodes)
+            for read, expected in zip(events, in_memory.timestamps):
+                np.testing.assert_array_equal(read, expected)
+
+        # Jumps are kept in memory again once the stream is closed
+        streamed.stream_events_to_file(None)
+        streamed.reset()
+        streamed.simulate()
+        self.assertEqual(
+            sum(map(len, streamed.timestamps)), streamed.n_total_jumps)
+
+    def test_stream_hawkes_events_to_file(self):
+        """...Test that streamed Hawkes jumps can be resumed but not
+        rebuilt with new kernels
+        """
+        adjacency = [[0.3, 0.1], [0.2, 0.3]]
+        decays = [[2., 2.], [2., 2.]]
+        baseline = [0.5, 0.8]
+        in_memory = SimuHawkesExpKernels(adjacency, decays, baseline=baseline,
+                                         end_time=100, seed=2937,
+                                         verbose=False)
+        in_memory.simulate()
+        in_memory.end_time = 200
+        in_memory.simulate()
+
+        streamed = SimuHawkesExpKernels(adjacency, decays, baseline=baseline,
+                                        end_time=100, seed=2937, verbose=False)
+        with tempfile.TemporaryDirectory() as directory:
+            path = os.path.join(directory, 'events.bin')
+            streamed.stream_events_to_file(path)
+            streamed.simulate()
+            streamed.end_time = 200
+            streamed.simulate()
+
+            events = streamed.read_events(path)
+            for read, expected in zip(events, in_memory.timestamps):
+                np.testing.assert_array_equal(read, expected)
+
+            # The excitation of streamed jumps cannot be rebuilt
+            streamed.set_kernel(0, 0, HawkesKernelExp(0.1, 2.))
+            streamed.end_time = 300
+            with self.assertRaisesRegex(RuntimeError, "event sink"):
+                streamed.simulate()
+            streamed.stream_events_to_file(None)
+
 
 if __name__ == "__main__":
     unittest.main()
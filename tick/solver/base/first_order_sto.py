@@ -184,10 +184,17 @@ class SolverFirstOrderSto(SolverFirstOrder, SolverSto):
         """
         from tick.solver import SDCA
         if not isinstance(self, SDCA):
-            if step is not None:
-                self.step = step
+            default_step = step is None and self.step is None and \
+                self.rand_type == "importance"
+            if default_step:
+                # Reweighted gradients are smoother than the worst sample
+                step = 1. / self._solver.get_importance_lip_max()
             step, obj, minimizer, prev_minimizer = \
                 self._initialize_values(x0, step, n_empty_vectors=1)
+            if default_step:
+                # Only the C++ solver keeps this step, it is computed again
+                # at next solve since the model might have changed
+                self._set("_step", None)
             self._solver.set_starting_iterate(minimizer)
 
         else:
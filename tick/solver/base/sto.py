@@ -6,8 +6,19 @@ from tick.base import Base
 from tick.base_model import Model
 from tick.prox.base import Prox
 
+from ..build.solver import RandType_block_perm as block_perm
+from ..build.solver import RandType_importance as importance
 from ..build.solver import RandType_perm as perm
 from ..build.solver import RandType_unif as unif
+from ..build.solver import SolverCounter_n_counters as n_counters
+from ..build.solver import SolverInstrumentation
+
+# Names of the counters kept by the C++ solvers when instrumentation is
+# enabled, the *_cycles ones being CPU cycles spent in each phase
+_counter_names = [
+    SolverInstrumentation.counter_name(counter)
+    for counter in range(n_counters)
+]
 
 
 class SolverSto(Base):
@@ -28,11 +39,26 @@ class SolverSto(Base):
         * if ``"perm"`` a random permutation of all possibilities is
           generated and samples are sequentially taken from it. Once all of
           them have been taken, a new random permutation is generated
+        * if ``"importance"`` samples are drawn with probabilities
+          proportional to the Lipschitz constants of the model (mixed with
+          the uniform distribution), their gradients being reweighted. Only
+          available for SGD, SVRG and SAGA
+        * if ``"block_perm"`` blocks of ``perm_block_size`` consecutive
+          samples are taken in random order, and samples are shuffled within
+          each block. It is much more cache friendly than ``"perm"`` on large
+          features matrices. If ``prefetch`` is `True`, the features of the
+          next sample are prefetched while the current one is processed
 
     seed : `int`
         The seed of the random sampling. If it is negative then a random seed
         (different at each run) will be chosen.
 
+    instrumentation : `bool`, default=False
+        If `True`, the C++ solver counts the CPU cycles spent in each phase
+        of an iteration (sampling, gradient, update, prox, full gradient and
+        objective) and the number of processed samples, non zeros, prox calls
+        and full gradients. See ``get_counters``
+
     Notes
     -----
     This class should not be used by end-users
@@ -56,6 +82,15 @@ class SolverSto(Base):
         },
         "seed": {
             "cpp_setter": "set_seed"
+        },
+        "perm_block_size": {
+            "cpp_setter": "set_perm_block_size"
+        },
+        "prefetch": {
+            "cpp_setter": "set_prefetch"
+        },
+        "instrumentation": {
+            "cpp_setter": "set_instrumentation"
         }
     }
 
@@ -72,11 +107,18 @@ class SolverSto(Base):
         self.epoch_size = epoch_size
         self.rand_type = rand_type
         self.seed = seed
+        self.perm_block_size = 1024
+        self.prefetch = False
+        self.instrumentation = False
 
     def set_model(self, model: Model):
         # Give the C++ wrapped model to the solver
         self.dtype = model.dtype
         self._solver.set_model(model._model)
+        # The C++ solver might have been created after these were set
+        self._solver.set_perm_block_size(self.perm_block_size)
+        self._solver.set_prefetch(self.prefetch)
+        self._solver.set_instrumentation(self.instrumentation)
         # If not already specified, we use the model's epoch_size
         if self.epoch_size is None:
             self.epoch_size = model._epoch_size
@@ -103,20 +145,54 @@ class SolverSto(Base):
             return "unif"
         if self._rand_type == perm:
             return "perm"
+        if self._rand_type == importance:
+            return "importance"
+        if self._rand_type == block_perm:
+            return "block_perm"
         else:
             raise ValueError("No known ``rand_type``")
 
     @rand_type.setter
     def rand_type(self, val):
-        if val not in ["unif", "perm"]:
-            raise ValueError("``rand_type`` can be 'unif' or " "'perm'")
+        if val not in ["unif", "perm", "importance", "block_perm"]:
+            raise ValueError("``rand_type`` can be 'unif', 'perm', "
+                             "'importance' or 'block_perm'")
         else:
             if val == "unif":
                 enum_val = unif
             if val == "perm":
                 enum_val = perm
+            if val == "importance":
+                enum_val = importance
+            if val == "block_perm":
+                enum_val = block_perm
             self._set("_rand_type", enum_val)
 
+    def get_counters(self, history: bool = False):
+        """Counters kept by the C++ solver when ``instrumentation`` is `True`
+
+        Parameters
+        ----------
+        history : `bool`, default=False
+            If `True`, values of the counters each time history has been
+            recorded are returned instead of their current values
+
+        Returns
+        -------
+        output : `dict`
+            Counter values by name. The ``cycles_per_second`` entry converts
+            the ``*_cycles`` counters into seconds
+        """
+        counters = {}
+        for counter, name in enumerate(_counter_names):
+            if history:
+                counters[name] = list(
+                    self._solver.get_counter_history(counter))
+            else:
+                counters[name] = self._solver.get_counter(counter)
+        counters["cycles_per_second"] = self._solver.get_cycles_per_second()
+        return counters
+
     def _set_rand_max(self, model):
         model_rand_max = model._rand_max
         self._set("_rand_max", model_rand_max)
@@ -91,13 +91,23 @@ class SAGA(SolverFirstOrderSto):
         Epoch size, by default, this is automatically tuned using
         information from the model object passed through ``set_model``.
 
-    rand_type : {'unif', 'perm'}, default='unif'
+    rand_type : {'unif', 'perm', 'importance', 'block_perm'}, default='unif'
         How samples are randomly selected from the data
 
         * if ``'unif'`` samples are uniformly drawn among all possibilities
         * if ``'perm'`` a random permutation of all possibilities is
           generated and samples are sequentially taken from it. Once all of
           them have been taken, a new random permutation is generated
+        * if ``'importance'`` sample :math:`i` is drawn with probability
+          :math:`(1 / n + L_i / \\sum_j L_j) / 2` where :math:`L_i` are the
+          Lipschitz constants of the model, and its gradient is reweighted
+          accordingly. If ``step`` is not given, it is set to the inverse
+          of the largest Lipschitz constant of the reweighted gradients,
+          which is at most ``2 * model.get_lip_mean()``
+        * if ``'block_perm'`` blocks of ``perm_block_size`` consecutive
+          samples are visited in random order and shuffled within each
+          block, which keeps memory accesses local on large features
+          matrices
 
     print_every : `int`, default=1
         Print history information every time the iteration number is a
@@ -139,6 +149,15 @@ class SAGA(SolverFirstOrderSto):
     dtype : `{'float64', 'float32'}`, default='float64'
         Type of the arrays used. This value is set from model and prox dtypes.
 
+    perm_block_size : `int`, default=1024
+        Number of consecutive samples in a block when
+        ``rand_type='block_perm'``
+
+    prefetch : `bool`, default=False
+        If `True` and ``rand_type`` is ``'perm'`` or ``'block_perm'``, the
+        features of the next sample are prefetched while the current one is
+        processed
+
     References
     ----------
     * A. Defazio, F. Bach, S. Lacoste-Julien, SAGA: A fast incremental gradient
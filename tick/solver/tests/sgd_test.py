@@ -2,6 +2,9 @@
 
 import unittest
 
+import numpy as np
+from scipy.sparse import csr_matrix
+
 from tick.solver import SGD
 from tick.solver.tests import TestSolver
 
@@ -16,6 +19,68 @@ class SGDTest(object):
         self.check_solver(solver, fit_intercept=True, model="logreg",
                           decimal=0)
 
+    def test_solver_sgd_block_perm(self):
+        """...Check SGD solver with block permutation sampling for Logistic
+        Regression with Ridge penalization
+        """
+        solver = SGD(max_iter=100, verbose=False, seed=TestSolver.sto_seed,
+                     step=200, rand_type='block_perm')
+        solver.perm_block_size = 7
+        self.check_solver(solver, fit_intercept=True, model="logreg",
+                          decimal=0)
+
+    def test_sgd_sampling_parameters(self):
+        """...Test SGD block permutation and prefetch parameters reach the
+        C++ solver and prefetching does not change iterates
+        """
+        y, X, _, _ = TestSolver.generate_logistic_data(
+            n_features=10, n_samples=300, dtype=self.dtype)
+
+        solutions = []
+        for prefetch in [False, True]:
+            solver = SGD(max_iter=5, verbose=False, step=1e-1,
+                         seed=TestSolver.sto_seed, rand_type='block_perm')
+            solver.prefetch = prefetch
+            solver.perm_block_size = 16
+            TestSolver.prepare_solver(solver, X, y)
+            self.assertEqual(solver.rand_type, 'block_perm')
+            self.assertEqual(solver._solver.get_perm_block_size(), 16)
+            self.assertEqual(solver._solver.get_prefetch(), prefetch)
+
+            # Parameters set after the model are given to the C++ solver
+            solver.perm_block_size = 32
+            self.assertEqual(solver._solver.get_perm_block_size(), 32)
+            solutions.append(solver.solve())
+
+        np.testing.assert_array_equal(solutions[0], solutions[1])
+
+        with self.assertRaises(ValueError):
+            SGD(rand_type='block')
+
+    def test_sgd_counters(self):
+        """...Test SGD instrumentation counters on dense and sparse features
+        """
+        y, X, _, _ = TestSolver.generate_logistic_data(
+            n_features=10, n_samples=300, dtype=self.dtype)
+        n_epochs = 3
+        for features in [X, csr_matrix(X)]:
+            solver = SGD(max_iter=n_epochs, verbose=False, step=1e-1,
+                         seed=TestSolver.sto_seed, rand_type='perm')
+            solver.instrumentation = True
+            TestSolver.prepare_solver(solver, features, y,
+                                      fit_intercept=False)
+            solver.solve()
+
+            counters = solver.get_counters()
+            self.assertEqual(counters["n_samples"], n_epochs * len(y))
+            self.assertEqual(counters["n_prox_calls"], n_epochs * len(y))
+            # Each sample is seen once per epoch, its non zero features
+            # being updated
+            self.assertEqual(counters["n_nnz"],
+                             n_epochs * np.count_nonzero(X))
+            self.assertEqual(
+                len(solver.get_counters(history=True)["n_samples"]), n_epochs)
+
     def test_sgd_sparse_and_dense_consistency(self):
         """...SGDTest SGD can run all glm models and is consistent with sparsity
         """
@@ -196,6 +196,32 @@ class SVRGTest(object):
             self.assertTrue(issubclass(w[0].category, UserWarning))
             self.assertEqual(str(w[0].message), msg)
 
+    def test_importance_default_step(self):
+        """...Test SVRG importance sampling default step follows the model
+        """
+        X, y = self.simu_linreg_data(dtype=self.dtype, n_samples=500)
+        svrg = SVRG(rand_type='importance', max_iter=10, tol=0, verbose=False,
+                    seed=TestSolver.sto_seed)
+        for scale in [1., 3.]:
+            model = ModelLinReg(fit_intercept=False).fit(
+                (scale * X).astype(self.dtype), y)
+            svrg.set_model(model).set_prox(ProxL1(1e-4))
+            x0 = np.zeros(model.n_coeffs, dtype=self.dtype)
+            svrg.solve(x0)
+
+            # The step is computed for each solve and not kept in the solver
+            self.assertIsNone(svrg.step)
+            np.testing.assert_almost_equal(
+                svrg._solver.get_step(),
+                1. / svrg._solver.get_importance_lip_max(), decimal=5)
+            self.assertLess(svrg.objective(svrg.solution), svrg.objective(x0))
+
+        # A given step is kept
+        svrg.solve(x0, step=1e-3)
+        self.assertEqual(svrg.step, 1e-3)
+        svrg.solve(x0)
+        self.assertEqual(svrg.step, 1e-3)
+
     def test_dense_and_sparse_match(self):
         """...Test in SVRG that dense and sparse code matches in all possible
         settings
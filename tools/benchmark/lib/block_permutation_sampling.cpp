@@ -0,0 +1,108 @@
+#include <chrono>
+
+#include "tick/base/base.h"
+#include "tick/random/test_rand.h"
+#include "tick/linear_model/model_logreg.h"
+#include "tick/prox/prox_l2sq.h"
+#include "tick/solver/saga.h"
+#include "tick/solver/sgd.h"
+#include "tick/solver/svrg.h"
+
+//
+// Benchmark sampling orders of stochastic solvers on a dense features matrix
+// that does not fit in cache. Full permutation is compared to block
+// permutation, with and without prefetching of the next sample.
+// The command lines arguments are the following
+// n_samples : number of observations (number of rows)
+// n_features : number variables per observation (number of columns)
+// n_epochs : number of passes on the data
+// perm_block_size : number of consecutive samples in a block
+//
+// Example
+// Run SGD, SVRG and SAGA on 1000000 rows, 50 columns for 10 epochs with
+// blocks of 1024 samples
+// ./tick_block_permutation_sampling 1000000 50 10 1024
+//
+// Output is tab separated : solver, sampling, mean epoch time in seconds and
+// objective after each epoch
+//
+
+const constexpr int SEED = 1933;
+
+template <class SOLVER>
+void run_solver(const std::string &solver_name,
+                std::shared_ptr<ModelLogReg> model,
+                std::shared_ptr<ProxL2Sq> prox, ulong n_samples,
+                ulong n_epochs, ulong perm_block_size) {
+  const std::vector<std::tuple<std::string, RandType, bool>> samplings = {
+      std::make_tuple("perm", RandType::perm, false),
+      std::make_tuple("perm+prefetch", RandType::perm, true),
+      std::make_tuple("block_perm", RandType::block_perm, false),
+      std::make_tuple("block_perm+prefetch", RandType::block_perm, true)};
+
+  for (const auto &sampling : samplings) {
+    SOLVER solver(n_samples, 0, std::get<1>(sampling),
+                  1. / model->get_lip_max(), 1, SEED);
+    solver.set_rand_max(n_samples);
+    solver.set_model(model);
+    solver.set_prox(prox);
+    solver.set_perm_block_size(perm_block_size);
+    solver.set_prefetch(std::get<2>(sampling));
+
+    // Epochs are timed alone, objectives are computed out of the timed region
+    double epochs_time = 0;
+    std::vector<double> objectives;
+    ArrayDouble iterate(model->get_n_coeffs());
+    for (ulong epoch = 0; epoch < n_epochs; ++epoch) {
+      const auto start = std::chrono::system_clock::now();
+      solver.solve_one_epoch();
+      const auto end = std::chrono::system_clock::now();
+      std::chrono::duration<double> elapsed_seconds = end - start;
+      epochs_time += elapsed_seconds.count();
+
+      solver.get_iterate(iterate);
+      objectives.push_back(model->loss(iterate) + prox->value(iterate));
+    }
+
+    std::cout << solver_name << '\t' << std::get<0>(sampling) << '\t'
+              << epochs_time / n_epochs;
+    for (double objective : objectives) std::cout << '\t' << objective;
+    std::cout << std::endl;
+  }
+}
+
+int main(int nargs, char *args[]) {
+  ulong n_samples = 1000000;
+  if (nargs > 1) n_samples = std::stoul(args[1]);
+
+  ulong n_features = 50;
+  if (nargs > 2) n_features = std::stoul(args[2]);
+
+  ulong n_epochs = 10;
+  if (nargs > 3) n_epochs = std::stoul(args[3]);
+
+  ulong perm_block_size = 1024;
+  if (nargs > 4) perm_block_size = std::stoul(args[4]);
+
+  // generate random data
+  const auto sample = test_uniform(n_samples * n_features, SEED);
+  ArrayDouble2d sample2d(n_samples, n_features, sample->data());
+  const auto features = SArrayDouble2d::new_ptr(sample2d);
+
+  const auto int_sample = test_uniform_int(0, 1, n_samples, SEED);
+  SArrayDoublePtr labels = SArrayDouble::new_ptr(n_samples);
+  for (ulong i = 0; i < n_samples; ++i) {
+    (*labels)[i] = 2. * (*int_sample)[i] - 1;
+  }
+
+  auto model = std::make_shared<ModelLogReg>(features, labels, false, 1);
+  auto prox = std::make_shared<ProxL2Sq>(1. / n_samples, false);
+
+  run_solver<SGD>("SGD", model, prox, n_samples, n_epochs,
+                  perm_block_size);
+  run_solver<SVRG>("SVRG", model, prox, n_samples, n_epochs,
+                   perm_block_size);
+  run_solver<SAGA>("SAGA", model, prox, n_samples, n_epochs,
+                   perm_block_size);
+  return 0;
+}
@@ -0,0 +1,91 @@
+#include <chrono>
+#include <iostream>
+
+#include "tick/hawkes/inference/hawkes_basis_kernels.h"
+#include "tick/hawkes/simulation/simu_hawkes.h"
+
+//
+// Benchmark HawkesBasisKernels solve performances on a simulated Hawkes
+// process
+// The command lines arguments are the following
+// num_nodes : number of nodes in the Hawkes process
+// end_time : end time of the simulation
+// n_basis : number of basis functions used to generate the kernels
+// kernel_size : number of bins used to discretize the basis functions
+// num_iterations : number of iterations (calls to solve) per timing
+// num_threads : number of threads used
+//
+// Example
+// To run 10 iterations with 10 basis functions on a 100 nodes Hawkes process
+// simulated up to time 200 with 30 kernel bins on 4 threads
+// ./tick_hawkes_basis_kernels 100 200 10 30 10 4
+//
+
+SArrayDoublePtrList1D simulate_data(ulong num_nodes, double end_time) {
+  Hawkes hawkes(num_nodes, 1337);
+  for (ulong i = 0; i < num_nodes; ++i) {
+    hawkes.set_baseline(i, 0.1 + 0.01 * i);
+    for (ulong j = 0; j < num_nodes; ++j) {
+      HawkesKernelPtr kernel = std::make_shared<HawkesKernelExp>(
+          (0.5 + 0.2 * ((i + j) % 2)) / num_nodes, 2.);
+      hawkes.set_kernel(i, j, kernel);
+    }
+  }
+  hawkes.simulate(end_time);
+  return hawkes.get_timestamps();
+}
+
+int main(int nargs, char **args) {
+  ulong num_nodes = 100;
+  if (nargs > 1) num_nodes = std::stoul(args[1]);
+
+  double end_time = 200;
+  if (nargs > 2) end_time = std::stod(args[2]);
+
+  ulong n_basis = 10;
+  if (nargs > 3) n_basis = std::stoul(args[3]);
+
+  ulong kernel_size = 30;
+  if (nargs > 4) kernel_size = std::stoul(args[4]);
+
+  ulong num_iterations = 10;
+  if (nargs > 5) num_iterations = std::stoul(args[5]);
+
+  unsigned int num_threads = 1;
+  if (nargs > 6) num_threads = std::stoul(args[6]);
+
+  const ulong num_runs = 5;
+  const double kernel_support = 4.;
+  const double alpha = 0.1;
+  const ulong max_iter_gdm = 100;
+  const double max_tol_gdm = 1e-5;
+
+  SArrayDoublePtrList2D timestamps_list{simulate_data(num_nodes, end_time)};
+  VArrayDoublePtr end_times = VArrayDouble::new_ptr(1);
+  (*end_times)[0] = end_time;
+
+  for (ulong run_i = 0; run_i < num_runs; ++run_i) {
+    HawkesBasisKernels basis_kernels(kernel_support, kernel_size, n_basis,
+                                     alpha, num_threads);
+    basis_kernels.set_data(timestamps_list, end_times);
+
+    ArrayDouble mu(num_nodes);
+    mu.fill(0.1);
+    ArrayDouble2d gdm(n_basis, kernel_size);
+    gdm.fill(0.1);
+    ArrayDouble2d auvd(num_nodes, num_nodes * n_basis);
+    auvd.fill(0.1 / num_nodes);
+
+    const auto start = std::chrono::system_clock::now();
+    for (ulong i = 0; i < num_iterations; ++i) {
+      basis_kernels.solve(mu, gdm, auvd, max_iter_gdm, max_tol_gdm);
+    }
+    const auto end = std::chrono::system_clock::now();
+
+    std::chrono::duration<double> elapsed_seconds = end - start;
+
+    std::cout << elapsed_seconds.count() << '\t' << num_iterations << '\t'
+              << num_threads << '\t' << num_nodes << '\t' << n_basis << '\t'
+              << args[0] << '\t' << std::endl;
+  }
+}
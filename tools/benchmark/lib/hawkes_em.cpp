@@ -0,0 +1,97 @@
+#include <chrono>
+#include <iostream>
+
+#include "tick/hawkes/inference/hawkes_em.h"
+#include "tick/hawkes/simulation/simu_hawkes.h"
+
+//
+// Benchmark HawkesEM solve performances on a simulated Hawkes process
+// The command lines arguments are the following
+// num_nodes : number of nodes in the Hawkes process
+// end_time : end time of the simulation
+// kernel_size : number of bins used to discretize the kernels
+// num_iterations : number of EM iterations (calls to solve) per timing
+// num_threads : number of threads used
+// regular : if 1 kernels are regularly discretized, otherwise a non uniform
+// discretization is used
+//
+// Example
+// To run 10 EM iterations on a 20 nodes Hawkes process simulated up to time
+// 2000 with 30 kernel bins on 2 threads
+// ./tick_hawkes_em 20 2000 30 10 2 1
+//
+
+SArrayDoublePtrList1D simulate_data(ulong num_nodes, double end_time) {
+  Hawkes hawkes(num_nodes, 1337);
+  for (ulong i = 0; i < num_nodes; ++i) {
+    hawkes.set_baseline(i, 0.1 + 0.01 * i);
+    for (ulong j = 0; j < num_nodes; ++j) {
+      HawkesKernelPtr kernel = std::make_shared<HawkesKernelExp>(
+          (0.5 + 0.2 * ((i + j) % 2)) / num_nodes, 2.);
+      hawkes.set_kernel(i, j, kernel);
+    }
+  }
+  hawkes.simulate(end_time);
+  return hawkes.get_timestamps();
+}
+
+int main(int nargs, char **args) {
+  ulong num_nodes = 20;
+  if (nargs > 1) num_nodes = std::stoul(args[1]);
+
+  double end_time = 2000;
+  if (nargs > 2) end_time = std::stod(args[2]);
+
+  ulong kernel_size = 30;
+  if (nargs > 3) kernel_size = std::stoul(args[3]);
+
+  ulong num_iterations = 10;
+  if (nargs > 4) num_iterations = std::stoul(args[4]);
+
+  unsigned int num_threads = 1;
+  if (nargs > 5) num_threads = std::stoul(args[5]);
+
+  bool regular = true;
+  if (nargs > 6) regular = std::stoul(args[6]) != 0;
+
+  const ulong num_runs = 5;
+  const double kernel_support = 4.;
+
+  SArrayDoublePtrList2D timestamps_list{simulate_data(num_nodes, end_time)};
+  VArrayDoublePtr end_times = VArrayDouble::new_ptr(1);
+  (*end_times)[0] = end_time;
+
+  // Non uniform discretization is finer for small time differences
+  SArrayDoublePtr discretization = SArrayDouble::new_ptr(kernel_size + 1);
+  for (ulong m = 0; m <= kernel_size; ++m) {
+    const double ratio = static_cast<double>(m) / kernel_size;
+    (*discretization)[m] = kernel_support * ratio * ratio;
+  }
+
+  for (ulong run_i = 0; run_i < num_runs; ++run_i) {
+    std::unique_ptr<HawkesEM> em;
+    if (regular) {
+      em.reset(new HawkesEM(kernel_support, kernel_size, num_threads));
+    } else {
+      em.reset(new HawkesEM(discretization, num_threads));
+    }
+    em->set_data(timestamps_list, end_times);
+
+    ArrayDouble mu(num_nodes);
+    mu.fill(0.1);
+    ArrayDouble2d kernels(num_nodes, num_nodes * kernel_size);
+    kernels.fill(0.01);
+
+    const auto start = std::chrono::system_clock::now();
+    for (ulong i = 0; i < num_iterations; ++i) {
+      em->solve(mu, kernels);
+    }
+    const auto end = std::chrono::system_clock::now();
+
+    std::chrono::duration<double> elapsed_seconds = end - start;
+
+    std::cout << elapsed_seconds.count() << '\t' << num_iterations << '\t'
+              << num_threads << '\t' << num_nodes << '\t' << args[0] << '\t'
+              << std::endl;
+  }
+}